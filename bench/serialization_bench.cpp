@@ -0,0 +1,192 @@
+/*
+ * Serialize and deserialize time per call of generated messages. The
+ * "per element" rows run the loop the generator emitted for numeric
+ * arrays before they were copied in bulk (Msg::arrayToArr/arrToArray):
+ * every value split into shifted bytes.
+ *
+ *   serialization_bench [scale of the iteration counts, default 1]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include <type_traits>
+#include <vector>
+#include "tiny_ros/sensor_msgs/LaserScan.h"
+#include "tiny_ros/sensor_msgs/PointCloud2.h"
+#include "tiny_ros/sensor_msgs/Imu.h"
+#include "tiny_ros/geometry_msgs/PoseWithCovariance.h"
+
+using namespace tinyros;
+
+static volatile uint32_t sink;  // keeps the reference loops from being optimized away
+
+static double elapsed(std::chrono::steady_clock::time_point start, int iterations) {
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() / iterations;
+}
+
+static void report(const char* name, size_t bytes, double serialize, double deserialize) {
+  printf("%-36s %9zu bytes  serialize %10.3f us  deserialize %10.3f us\n", name, bytes, serialize, deserialize);
+}
+
+template<typename M>
+static void bench(const char* name, M& msg, int iterations) {
+  std::vector<unsigned char> buffer(msg.serializedLength());
+  M out;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) msg.serialize(&buffer[0]);
+  double serialize = elapsed(start, iterations);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) out.deserialize(&buffer[0]);
+  double deserialize = elapsed(start, iterations);
+  report(name, buffer.size(), serialize, deserialize);
+}
+
+/* the arrays of a message as the generator used to write them */
+static int serializeElements(const float* values, uint32_t length, unsigned char* outbuffer) {
+  int offset = 0;
+  for (uint32_t i = 0; i < length; i++) {
+    union {
+      float real;
+      uint32_t base;
+    } u;
+    u.real = values[i];
+    *(outbuffer + offset + 0) = (u.base >> (8 * 0)) & 0xFF;
+    *(outbuffer + offset + 1) = (u.base >> (8 * 1)) & 0xFF;
+    *(outbuffer + offset + 2) = (u.base >> (8 * 2)) & 0xFF;
+    *(outbuffer + offset + 3) = (u.base >> (8 * 3)) & 0xFF;
+    offset += sizeof(float);
+  }
+  return offset;
+}
+
+static int deserializeElements(float* values, uint32_t length, const unsigned char* inbuffer) {
+  int offset = 0;
+  for (uint32_t i = 0; i < length; i++) {
+    union {
+      float real;
+      uint32_t base;
+    } u;
+    u.base = 0;
+    u.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
+    u.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+    u.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+    u.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+    values[i] = u.real;
+    offset += sizeof(float);
+  }
+  return offset;
+}
+
+static int serializeElements(const uint8_t* values, uint32_t length, unsigned char* outbuffer) {
+  int offset = 0;
+  for (uint32_t i = 0; i < length; i++) {
+    *(outbuffer + offset + 0) = (values[i] >> (8 * 0)) & 0xFF;
+    offset += sizeof(uint8_t);
+  }
+  return offset;
+}
+
+static int deserializeElements(uint8_t* values, uint32_t length, const unsigned char* inbuffer) {
+  int offset = 0;
+  for (uint32_t i = 0; i < length; i++) {
+    values[i] = ((uint8_t) (*(inbuffer + offset)));
+    offset += sizeof(uint8_t);
+  }
+  return offset;
+}
+
+/*
+ * The generator makes arrays T* x with x_length, or std::vector<T> x with
+ * --arrays=vector (make GCC_ARRAYS=vector); only one of each pair compiles.
+ */
+typedef std::is_pointer<decltype(sensor_msgs::LaserScan::ranges)>::type PointerArrays;
+
+template<typename M>
+static void resizeScan(M& scan, uint32_t length, std::true_type) {
+  scan.ranges_length = scan.intensities_length = length;
+  scan.ranges = new float[length];
+  scan.intensities = new float[length];
+}
+template<typename M>
+static void resizeScan(M& scan, uint32_t length, std::false_type) {
+  scan.ranges.resize(length);
+  scan.intensities.resize(length);
+}
+
+template<typename M>
+static void resizeCloud(M& cloud, uint32_t length, std::true_type) {
+  cloud.data_length = length;
+  cloud.data = (uint8_t*)malloc(length);
+}
+template<typename M>
+static void resizeCloud(M& cloud, uint32_t length, std::false_type) {
+  cloud.data.resize(length);
+}
+
+/* length: of ranges and of intensities */
+static void benchScanElements(const sensor_msgs::LaserScan& scan, uint32_t length, int iterations) {
+  std::vector<unsigned char> buffer(2 * length * sizeof(float));
+  std::vector<float> ranges(length), intensities(length);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    int offset = serializeElements(&scan.ranges[0], length, &buffer[0]);
+    offset += serializeElements(&scan.intensities[0], length, &buffer[0] + offset);
+    sink = buffer[i % buffer.size()];
+  }
+  double serialize = elapsed(start, iterations);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    int offset = deserializeElements(&ranges[0], length, &buffer[0]);
+    offset += deserializeElements(&intensities[0], length, &buffer[0] + offset);
+    sink = (uint32_t)ranges[i % ranges.size()];
+  }
+  double deserialize = elapsed(start, iterations);
+  report("  arrays per element", buffer.size(), serialize, deserialize);
+}
+
+static void benchCloudElements(const sensor_msgs::PointCloud2& cloud, uint32_t length, int iterations) {
+  std::vector<unsigned char> buffer(length);
+  std::vector<uint8_t> data(length);
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    serializeElements(&cloud.data[0], length, &buffer[0]);
+    sink = buffer[i % buffer.size()];
+  }
+  double serialize = elapsed(start, iterations);
+  start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; i++) {
+    deserializeElements(&data[0], length, &buffer[0]);
+    sink = data[i % data.size()];
+  }
+  double deserialize = elapsed(start, iterations);
+  report("  data per element", buffer.size(), serialize, deserialize);
+}
+
+int main(int argc, char* argv[]) {
+  double scale = argc >= 2 ? atof(argv[1]) : 1.0;
+  if (scale <= 0) scale = 1.0;
+
+  sensor_msgs::LaserScan scan;
+  resizeScan(scan, 1080, PointerArrays());
+  for (int i = 0; i < 1080; i++) {
+    scan.ranges[i] = i * 0.01f;
+    scan.intensities[i] = (float)i;
+  }
+  bench("sensor_msgs/LaserScan 1080+1080", scan, (int)(20000 * scale));
+  benchScanElements(scan, 1080, (int)(20000 * scale));
+
+  sensor_msgs::PointCloud2 cloud;
+  uint32_t length = 640 * 480 * 16;
+  resizeCloud(cloud, length, PointerArrays());
+  memset(&cloud.data[0], 7, length);
+  bench("sensor_msgs/PointCloud2 640x480x16", cloud, (int)(50 * scale) + 1);
+  benchCloudElements(cloud, length, (int)(50 * scale) + 1);
+
+  sensor_msgs::Imu imu;
+  bench("sensor_msgs/Imu", imu, (int)(1000000 * scale));
+
+  geometry_msgs::PoseWithCovariance pose;
+  bench("geometry_msgs/PoseWithCovariance", pose, (int)(1000000 * scale));
+  return 0;
+}
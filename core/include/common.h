@@ -3,23 +3,48 @@
 #include "spdlog/spdlog.h"
 #include "spdlog/sinks/stdout_sinks.h"
 #include "spdlog/sinks/rotating_file_sink.h"
+#include "log_throttle.h"
+// tinyrosdds logs through an async logger set as the default, see socket_node.cpp
 #undef spdlog_trace
-#define spdlog_trace spdlog::get("logger")->trace
+#define spdlog_trace spdlog::default_logger_raw()->trace
 
 #undef spdlog_debug
-#define spdlog_debug spdlog::get("logger")->debug
+#define spdlog_debug spdlog::default_logger_raw()->debug
 
 #undef spdlog_info
-#define spdlog_info spdlog::get("logger")->info
+#define spdlog_info spdlog::default_logger_raw()->info
 
 #undef spdlog_warn
-#define spdlog_warn spdlog::get("logger")->warn
+#define spdlog_warn spdlog::default_logger_raw()->warn
 
 #undef spdlog_error
-#define spdlog_error spdlog::get("logger")->error
+#define spdlog_error spdlog::default_logger_raw()->error
 
 #undef spdlog_critical
-#define spdlog_critical spdlog::get("logger")->critical
+#define spdlog_critical spdlog::default_logger_raw()->critical
+
+// For call sites a client can make repeat at will: at most LogThrottle::BURST
+// messages a second each per key, the session, then "suppressed N similar messages"
+#undef spdlog_throttle
+#define spdlog_throttle(key, level, ...) do { \
+  static tinyros::LogThrottle __tinyros_throttle; \
+  uint64_t __tinyros_suppressed; \
+  if (spdlog::default_logger_raw()->should_log(level) && __tinyros_throttle.allow(key, __tinyros_suppressed)) { \
+    if (__tinyros_suppressed > 0) { \
+      spdlog::default_logger_raw()->log(level, "suppressed {0} messages similar to the next one", __tinyros_suppressed); \
+    } \
+    spdlog::default_logger_raw()->log(level, __VA_ARGS__); \
+  } \
+} while (0)
+
+#undef spdlog_info_throttle
+#define spdlog_info_throttle(key, ...) spdlog_throttle(key, spdlog::level::info, __VA_ARGS__)
+
+#undef spdlog_warn_throttle
+#define spdlog_warn_throttle(key, ...) spdlog_throttle(key, spdlog::level::warn, __VA_ARGS__)
+
+#undef spdlog_error_throttle
+#define spdlog_error_throttle(key, ...) spdlog_throttle(key, spdlog::level::err, __VA_ARGS__)
 
 #undef TCP_SERVER_PORT
 #define TCP_SERVER_PORT (11315)
@@ -0,0 +1,112 @@
+#ifndef TINY_ROS_LOG_LEVELS_H
+#define TINY_ROS_LOG_LEVELS_H
+#include <fnmatch.h>
+#include <stdlib.h>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "tiny_ros/tinyros_msgs/Log.h"
+
+namespace tinyros
+{
+#define TINYROS_LOG_TOPIC "/tinyrosout"
+
+/*
+ * The lowest log level anyone listens to on /tinyrosout, per node. The
+ * sessions subscribing to /tinyrosout are tracked here with the levels
+ * they asked for through ID_LOG_LEVEL; one that did not ask gets every
+ * level. A Recorder recording /tinyrosout listens to every level, too.
+ * Every REQUEST_TOPICS_TIMER each node is told its level, and
+ * tinyros_log_* below it are neither formatted nor sent.
+ */
+class LogLevels
+{
+public:
+  /* nothing is sent while nobody listens */
+  enum { LEVEL_OFF = tinyros::tinyros_msgs::Log::ROSFATAL + 1 };
+
+  static void subscribe(const void* session) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    listeners_[session].subscribed_ = true;
+  }
+
+  static void unsubscribe(const void* session) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::map<const void*, Listener>::iterator it = listeners_.find(session);
+    if (it != listeners_.end()) {
+      it->second.subscribed_ = false;
+    }
+  }
+
+  /* the session is gone */
+  static void release(const void* session) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    listeners_.erase(session);
+  }
+
+  /* overrides: "node=level ...", node may be a pattern */
+  static void request(const void* session, int level, const std::string& overrides) {
+    Listener listener;
+    listener.requested_ = true;
+    listener.level_ = level;
+    std::istringstream stream(overrides);
+    std::string item;
+    while (stream >> item) {
+      size_t pos = item.rfind('=');
+      if (pos != std::string::npos && pos > 0) {
+        listener.overrides_.push_back(std::make_pair(item.substr(0, pos), atoi(item.c_str() + pos + 1)));
+      }
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    listener.subscribed_ = listeners_[session].subscribed_;
+    listeners_[session] = listener;
+  }
+
+  static int level(const std::string& node) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    int level = LEVEL_OFF;
+    std::map<const void*, Listener>::iterator it;
+    for (it = listeners_.begin(); it != listeners_.end(); it++) {
+      if (it->second.subscribed_) {
+        int wanted = it->second.level(node);
+        level = wanted < level ? wanted : level;
+      }
+    }
+    return level;
+  }
+
+private:
+  struct Listener
+  {
+    Listener() : subscribed_(false), requested_(false), level_(tinyros::tinyros_msgs::Log::ROSDEBUG) {}
+
+    int level(const std::string& node) const {
+      if (!requested_) {
+        return tinyros::tinyros_msgs::Log::ROSDEBUG;
+      }
+      for (size_t i = 0; i < overrides_.size(); i++) {
+        if (overrides_[i].first == node || fnmatch(overrides_[i].first.c_str(), node.c_str(), 0) == 0) {
+          return overrides_[i].second;
+        }
+      }
+      return level_;
+    }
+
+    bool subscribed_;
+    bool requested_;
+    int level_;
+    std::vector<std::pair<std::string, int> > overrides_;
+  };
+
+  static std::mutex mutex_;
+  static std::map<const void*, Listener> listeners_;  // by session
+};
+std::mutex LogLevels::mutex_;
+std::map<const void*, LogLevels::Listener> LogLevels::listeners_;
+
+}  // namespace
+
+#endif  // TINY_ROS_LOG_LEVELS_H
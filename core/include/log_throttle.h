@@ -0,0 +1,76 @@
+#ifndef TINY_ROS_LOG_THROTTLE_H
+#define TINY_ROS_LOG_THROTTLE_H
+#include <stdint.h>
+#include <chrono>
+#include <map>
+#include <mutex>
+
+namespace tinyros
+{
+/*
+ * Rate limit of one logging call site, see spdlog_*_throttle in common.h,
+ * kept apart for every key, the session logging: BURST messages per
+ * INTERVAL ms go out, the rest are only counted, and the count goes out
+ * with the next message that does. One noisy client so never silences
+ * the same message of another. Keys quiet for IDLE ms are forgotten.
+ */
+class LogThrottle
+{
+public:
+  enum { BURST = 10, INTERVAL = 1000, IDLE = 60000 };
+
+  LogThrottle() : swept_(0) {}
+
+  /* suppressed: messages of key held back since the last one that went out */
+  bool allow(const void* key, uint64_t& suppressed) {
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (now - swept_ >= IDLE) {
+      sweep(now);
+    }
+    Window& window = windows_[key];
+    if (now - window.start_ >= INTERVAL) {
+      window.start_ = now;
+      window.count_ = 0;
+    }
+    if (window.count_ >= BURST) {
+      window.suppressed_++;
+      return false;
+    }
+    window.count_++;
+    suppressed = window.suppressed_;
+    window.suppressed_ = 0;
+    return true;
+  }
+
+private:
+  struct Window
+  {
+    Window() : start_(0), count_(0), suppressed_(0) {}
+    int64_t start_;
+    uint32_t count_;
+    uint64_t suppressed_;
+  };
+
+  /* mutex_ held; a count a forgotten key still held is lost with it */
+  void sweep(int64_t now) {
+    std::map<const void*, Window>::iterator it;
+    for (it = windows_.begin(); it != windows_.end(); ) {
+      if (now - it->second.start_ >= IDLE) {
+        windows_.erase(it++);
+      } else {
+        it++;
+      }
+    }
+    swept_ = now;
+  }
+
+  std::mutex mutex_;
+  std::map<const void*, Window> windows_;  // by key
+  int64_t swept_;
+};
+
+}  // namespace
+
+#endif  // TINY_ROS_LOG_THROTTLE_H
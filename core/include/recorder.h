@@ -0,0 +1,233 @@
+#ifndef TINY_ROS_RECORDER_H
+#define TINY_ROS_RECORDER_H
+#include <fnmatch.h>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "tiny_ros/ros/bag.h"
+#include "tiny_ros/ros/trace.h"
+#include "topic_handlers.h"
+#include "log_levels.h"
+#include "common.h"
+
+namespace tinyros
+{
+typedef std::shared_ptr<BagWriter> BagWriterPtr;
+
+/*
+ * Records topics into a bag from inside tinyrosdds: a slot on the
+ * Rostopic::signal_ of every topic matching the patterns, including
+ * topics that show up while recording. The slot only appends the payload
+ * to the chunk of the BagWriter, whose own thread writes to the disk, so
+ * fan-out to the subscribers never waits for it; once the disk falls too
+ * far behind, messages are dropped from the bag instead.
+ * Locking order: Rostopic::topics_mutex_, mutex_, then a signal's mutex.
+ */
+class Recorder
+{
+public:
+  /*
+   * Runs a command of ID_RECORD, returns the reply:
+   *   start <bag> [--compression=zlib] [--chunk-size=KB] <topic or pattern>...
+   *   stop
+   *   status
+   */
+  static std::string command(const std::string& line) {
+    std::vector<std::string> args;
+    std::istringstream stream(line);
+    std::string arg;
+    while (stream >> arg) {
+      args.push_back(arg);
+    }
+    if (args.empty() || args[0] == "status") {
+      std::unique_lock<std::mutex> lock(mutex_);
+      return status();
+    } else if (args[0] == "start") {
+      return start(args);
+    } else if (args[0] == "stop") {
+      return stop();
+    }
+    return "unknown record command [" + args[0] + "]";
+  }
+
+  /* a topic was created, Rostopic::topics_mutex_ held */
+  static void attach(const RostopicPtr& rostopic) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (writer_ && matches(rostopic->topic_name_)) {
+      connect(rostopic);
+    }
+  }
+
+  /*
+   * A topic a subscriber of any type created got its type from the first
+   * publisher, Rostopic::topics_mutex_ held. The slot copied the empty type
+   * and is connected again; no message went through the topic before.
+   */
+  static void retype(const RostopicPtr& rostopic) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < connections_.size(); i++) {
+      if (connections_[i].rostopic_.lock() == rostopic) {
+        rostopic->signal_->disconnect(connections_[i].id_);
+        connections_.erase(connections_.begin() + i);
+        connect(rostopic);
+        return;
+      }
+    }
+  }
+
+private:
+  struct Connection
+  {
+    std::weak_ptr<Rostopic> rostopic_;
+    int id_;
+  };
+
+  static std::string start(const std::vector<std::string>& args) {
+    BagFormat::Compression compression = BagFormat::COMPRESSION_NONE;
+    uint32_t chunk_size = BagWriter::DEFAULT_CHUNK_SIZE;
+    std::string bag;
+    std::vector<std::string> patterns;
+    for (size_t i = 1; i < args.size(); i++) {
+      if (args[i] == "--compression=zlib") {
+        compression = BagFormat::COMPRESSION_ZLIB;
+      } else if (args[i].compare(0, 13, "--chunk-size=") == 0) {
+        chunk_size = (uint32_t)atoi(args[i].c_str() + 13) * 1024;
+      } else if (bag.empty()) {
+        bag = args[i];
+      } else {
+        patterns.push_back(args[i]);
+      }
+    }
+    if (bag.empty() || patterns.empty()) {
+      return "usage: start <bag> [--compression=zlib] [--chunk-size=KB] <topic or pattern>...";
+    }
+
+    std::unique_lock<std::mutex> topics_lock(Rostopic::topics_mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (writer_) {
+      return "already recording, " + status();
+    }
+    BagWriterPtr writer(new BagWriter());
+    if (!writer->open(bag, compression, chunk_size)) {
+      return "cannot open [" + bag + "] for writing";
+    }
+    writer_ = writer;
+    bag_ = bag;
+    patterns_ = patterns;
+    // logs only reach /tinyrosout once it exists, and the nodes only send them while someone listens
+    if (matches(TINYROS_LOG_TOPIC)) {
+      if (!Rostopic::topics_.count(TINYROS_LOG_TOPIC)) {
+        tinyros::tinyros_msgs::Log log;
+        tinyros::tinyros_msgs::TopicInfo topic_info;
+        topic_info.topic_name = TINYROS_LOG_TOPIC;
+        topic_info.message_type = log.getType();
+        topic_info.md5sum = log.getMD5();
+        Rostopic::topics_[TINYROS_LOG_TOPIC] = RostopicPtr(new Rostopic(topic_info));
+      }
+      LogLevels::subscribe(&writer_);
+    }
+    std::map<std::string, RostopicPtr>::iterator it;
+    for (it = Rostopic::topics_.begin(); it != Rostopic::topics_.end(); it++) {
+      if (matches(it->first)) {
+        connect(it->second);
+      }
+    }
+    spdlog_info("Recorder start(bag: {0}, topics: {1})", bag_.c_str(), patterns_.size());
+    return "started, " + status();
+  }
+
+  static std::string stop() {
+    BagWriterPtr writer;
+    std::string bag;
+    std::string reply;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (!writer_) {
+        return "not recording";
+      }
+      reply = status();
+      for (size_t i = 0; i < connections_.size(); i++) {
+        RostopicPtr rostopic = connections_[i].rostopic_.lock();
+        if (rostopic) {
+          rostopic->signal_->disconnect(connections_[i].id_);
+        }
+      }
+      connections_.clear();
+      LogLevels::release(&writer_);
+      writer.swap(writer_);
+      bag = bag_;
+    }
+
+    // no slot runs any more, the rest of the bag and its index go to the disk
+    writer->close();
+    spdlog_info("Recorder stop(bag: {0}, messages: {1}, dropped: {2})",
+      bag.c_str(), writer->getMessages(), writer->getDropped());
+    if (writer->failed()) {
+      return "stopped, writing [" + bag + "] failed, the bag is incomplete";
+    }
+    return "stopped, " + reply;
+  }
+
+  /* mutex_ held */
+  static std::string status() {
+    if (!writer_) {
+      return "not recording";
+    }
+    std::ostringstream out;
+    out << "recording [" << bag_ << "]: " << writer_->getMessages() << " messages, "
+      << writer_->getDropped() << " dropped, topics:";
+    for (size_t i = 0; i < connections_.size(); i++) {
+      RostopicPtr rostopic = connections_[i].rostopic_.lock();
+      if (rostopic) {
+        out << " " << rostopic->topic_name_;
+      }
+    }
+    return out.str();
+  }
+
+  /* mutex_ held */
+  static bool matches(const std::string& topic) {
+    for (size_t i = 0; i < patterns_.size(); i++) {
+      if (patterns_[i] == topic || fnmatch(patterns_[i].c_str(), topic.c_str(), 0) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /* mutex_ held */
+  static void connect(const RostopicPtr& rostopic) {
+    BagWriterPtr writer = writer_;
+    std::string topic = rostopic->topic_name_;
+    std::string type = rostopic->message_type_;
+    std::string md5 = rostopic->md5sum_;
+    Connection connection;
+    connection.rostopic_ = rostopic;
+    connection.id_ = rostopic->signal_->connect([writer, topic, type, md5](tinyros::serialization::IStream& stream) {
+      uint32_t length = stream.getLength();
+      const uint8_t* trailer = Trace::find(stream.getData(), length);
+      if (trailer) {
+        length -= TRACE_SIZE;
+      }
+      writer->write(topic, type, md5, Time::now(), stream.getData(), length);
+    });
+    connections_.push_back(connection);
+  }
+
+  static std::mutex mutex_;
+  static BagWriterPtr writer_;  // NULL unless recording
+  static std::string bag_;
+  static std::vector<std::string> patterns_;
+  static std::vector<Connection> connections_;
+};
+std::mutex Recorder::mutex_;
+BagWriterPtr Recorder::writer_;
+std::string Recorder::bag_;
+std::vector<std::string> Recorder::patterns_;
+std::vector<Recorder::Connection> Recorder::connections_;
+
+}  // namespace
+
+#endif  // TINY_ROS_RECORDER_H
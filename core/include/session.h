@@ -14,6 +14,8 @@
 #include "tiny_ros/std_msgs/String.h"
 #include "serialization.h"
 #include "topic_handlers.h"
+#include "recorder.h"
+#include "log_levels.h"
 #include "tcp_stream.h"
 
 namespace tinyros
@@ -39,8 +41,6 @@ std::map<int, SessionPtr> TcpServer_::sessions_;
 
 namespace tinyros
 {
-#define TINYROS_LOG_TOPIC "/tinyrosout"
-
 #define REQUEST_TOPICS_TIMER (1)
 
 #define REQUEST_TOPICS_ALIVE_TIME (15) // seconds
@@ -51,6 +51,9 @@ typedef std::shared_ptr<Buffer> BufferPtr;
 struct Writebuffer {
   struct sockaddr_in addr = {0};
   BufferPtr buffer = nullptr;
+  int trace_offset = -1;
+  TraceStatsPtr trace_stats = nullptr;
+  bool time_sync = false; // an ID_TIME frame, its send time is stamped when written
 };
 typedef std::shared_ptr<Writebuffer> WritebufferPtr;
 typedef std::deque<WritebufferPtr> AsyncWritebuffer;
@@ -67,6 +70,7 @@ public:
     , stream_type_(type)
     , message_in_thread_(nullptr)
     , message_write_thread_(nullptr)
+    , log_session_(false)
   {
     if (type == tinyros::UDP_STREAM) {
       session_id_ = "session_udp";
@@ -97,6 +101,10 @@ public:
     callbacks_[TopicInfo::ID_LOG] = std::bind(&Session::handle_log, this, std::placeholders::_1);
     callbacks_[TopicInfo::ID_TIME] = std::bind(&Session::handle_time, this, std::placeholders::_1);
     callbacks_[TopicInfo::ID_SESSION_ID] = std::bind(&Session::handle_session_id, this, std::placeholders::_1);
+    callbacks_[TopicInfo::ID_LOG_SESSION_ID] = std::bind(&Session::handle_log_session_id, this, std::placeholders::_1);
+    callbacks_[TopicInfo::ID_UNREGISTER] = std::bind(&Session::handle_unregister, this, std::placeholders::_1);
+    callbacks_[TopicInfo::ID_RECORD] = std::bind(&Session::handle_record, this, std::placeholders::_1);
+    callbacks_[TopicInfo::ID_LOG_LEVEL] = std::bind(&Session::handle_log_level, this, std::placeholders::_1);
 
     active_ = true;
     
@@ -161,6 +169,7 @@ public:
       callbacks_.clear();    // 1
       subscribers_.clear();  // 2
       publishers_.clear();   // 3
+      LogLevels::release(this);
     
       spdlog_warn("[{0}] {1} services clear begin.", session_id_.c_str(), __FUNCTION__);
       std::unique_lock<std::mutex> lock(ServiceServerCore::services_mutex_);
@@ -278,10 +287,10 @@ public:
             } catch(tinyros::serialization::StreamOverrunException e) {
             }
           } else {
-            spdlog_warn("[{0}] {1} Received message with unrecognized topicId ({2}).", session_id_.c_str(), __FUNCTION__, topic);
+            spdlog_warn_throttle(this, "[{0}] {1} Received message with unrecognized topicId ({2}).", session_id_.c_str(), __FUNCTION__, topic);
           }
         } else {
-          spdlog_warn("[{0}] {1} Rejecting message on topicId({2}), bytes({3}) with bad checksum.", 
+          spdlog_warn_throttle(this, "[{0}] {1} Rejecting message on topicId({2}), bytes({3}) with bad checksum.", 
             session_id_.c_str(), __FUNCTION__, topic, bytes);
         }
       } while(0);
@@ -425,10 +434,10 @@ private:
               } catch(tinyros::serialization::StreamOverrunException e) {
               }
             } else {
-              spdlog_warn("[{0}] {1} Received message with unrecognized topicId ({2}).", session_id_.c_str(), __FUNCTION__, topic);
+              spdlog_warn_throttle(this, "[{0}] {1} Received message with unrecognized topicId ({2}).", session_id_.c_str(), __FUNCTION__, topic);
             }
           } else {
-            spdlog_warn("[{0}] {1} Rejecting message on topicId({2}), bytes({3}) with bad checksum.", 
+            spdlog_warn_throttle(this, "[{0}] {1} Rejecting message on topicId({2}), bytes({3}) with bad checksum.", 
               session_id_.c_str(), __FUNCTION__, topic, bytes);
           }
         }
@@ -446,7 +455,7 @@ private:
 
   //// SENDING MESSAGES ////
 
-  void write_message(Buffer& message, const uint32_t topic_id) {
+  void write_message(Buffer& message, const uint32_t topic_id, bool time_sync = false) {
     if (!is_active()) return;
     
     uint8_t overhead_bytes = 12;
@@ -469,11 +478,12 @@ private:
     WritebufferPtr write_buffer_ptr(new Writebuffer());
     write_buffer_ptr->addr = from_;
     write_buffer_ptr->buffer = buffer_ptr;
+    write_buffer_ptr->time_sync = time_sync;
     async_write_buffers_.push_back(write_buffer_ptr);
     async_write_cond_.notify_one();
   }
 
-  void write_message_stream(tinyros::serialization::IStream& message, struct sockaddr_in &to, const uint32_t topic_id) {
+  void write_message_stream(tinyros::serialization::IStream& message, struct sockaddr_in &to, const uint32_t topic_id, TraceStatsPtr trace_stats) {
     if (!is_active()) return;
     
     uint8_t msg_checksum;
@@ -485,15 +495,28 @@ private:
     uint8_t msg_len_checksum = 255 - checksum((uint32_t)message.getLength());
 
     stream << (uint16_t)0xb9ff << (uint32_t)message.getLength() << msg_len_checksum << topic_id;
-    msg_checksum = 255 - (checksum(message) + checksum(topic_id));
 
-    memcpy(stream.advance(message.getLength()), message.getData(), message.getLength());
+    uint8_t* payload = stream.advance(message.getLength());
+    memcpy(payload, message.getData(), message.getLength());
+
+    // Stamp the copy so that every subscriber gets its own enqueue time
+    int trace_offset = -1;
+    uint8_t* trailer = (uint8_t*)Trace::find(payload, message.getLength());
+    if (trailer) {
+      Trace::putStamp(trailer, TRACE_DDS_ENQUEUE, Trace::toNSec(Time::now()));
+      trace_offset = (int)(trailer - &buffer_ptr->at(0));
+    }
+
+    tinyros::serialization::IStream checksum_stream(payload, message.getLength());
+    msg_checksum = 255 - (checksum(checksum_stream) + checksum(topic_id));
     stream << msg_checksum;
 
     std::unique_lock<std::mutex> lock(async_write_mutex_);
     WritebufferPtr write_buffer_ptr(new Writebuffer());
     write_buffer_ptr->addr = to;
     write_buffer_ptr->buffer = buffer_ptr;
+    write_buffer_ptr->trace_offset = trace_offset;
+    write_buffer_ptr->trace_stats = trace_stats;
     async_write_buffers_.push_back(write_buffer_ptr);
     async_write_cond_.notify_one();
   }
@@ -513,6 +536,13 @@ private:
       lock.unlock();
 
       if (is_active() && write_buffer_ptr) {
+        if (write_buffer_ptr->trace_offset >= 0) {
+          trace_dequeue(write_buffer_ptr);
+        }
+        if (write_buffer_ptr->time_sync) {
+          time_dequeue(write_buffer_ptr);
+        }
+
         int ret = 0;
         if (stream_type_ == tinyros::UDP_STREAM) {
           ret = socket_.write_some_udp((uint8_t*)write_buffer_ptr->buffer->data(), (int)write_buffer_ptr->buffer->size(), write_buffer_ptr->addr);
@@ -532,6 +562,39 @@ private:
   }
 
   //// HELPERS ////
+  void trace_dequeue(WritebufferPtr write_buffer_ptr) {
+    Buffer& buffer = *write_buffer_ptr->buffer;
+    uint8_t* trailer = &buffer[write_buffer_ptr->trace_offset];
+    uint8_t old_sum = 0, new_sum = 0;
+    for (int i = 0; i < 8; i++) old_sum += trailer[4 + TRACE_DDS_DEQUEUE * 8 + i];
+    uint64_t now = Trace::toNSec(Time::now());
+    Trace::putStamp(trailer, TRACE_DDS_DEQUEUE, now);
+    for (int i = 0; i < 8; i++) new_sum += trailer[4 + TRACE_DDS_DEQUEUE * 8 + i];
+
+    // patch the message checksum for the rewritten stamp
+    buffer.back() = (uint8_t)(buffer.back() - (uint8_t)(new_sum - old_sum));
+
+    if (write_buffer_ptr->trace_stats) {
+      write_buffer_ptr->trace_stats->record(TraceStats::SEG_DDS_QUEUE, Trace::getStamp(trailer, TRACE_DDS_ENQUEUE), now);
+    }
+  }
+
+  // The send time of SyncTime, see handle_time_done: the time spent queued
+  // would otherwise lengthen the way back only and bias the node's offset
+  void time_dequeue(WritebufferPtr write_buffer_ptr) {
+    // 11 bytes of header before the payload, its checksum after it, see write_message
+    Buffer& buffer = *write_buffer_ptr->buffer;
+    uint32_t length = buffer.size() - 12;
+    uint8_t* payload = &buffer[11];
+    tinyros::tinyros_msgs::SyncTime time;
+    time.deserialize(payload);
+    time.data = tinyros::Time::now();
+    time.serialize(payload);
+
+    tinyros::serialization::IStream checksum_stream(payload, length);
+    buffer.back() = 255 - (checksum(checksum_stream) + checksum((uint32_t)tinyros::tinyros_msgs::TopicInfo::ID_TIME));
+  }
+
   void request_topics() {
     while(require_check_running_) {
       if (stream_type_ != tinyros::UDP_STREAM) {
@@ -540,13 +603,18 @@ private:
 
         // Post dds time
         handle_time_done();
+
+        // Post the lowest log level listened to once the node is known, its log connection has no use for it
+        if (!session_id_.empty() && !log_session_) {
+          handle_log_level_done();
+        }
       } else {
         std::map<uint32_t, PublisherPtr>::iterator pit;
         for(pit = publishers_.begin(); pit != publishers_.end(); ) {
           PublisherPtr pub = pit->second;
           uint64_t now = std::chrono::system_clock::now().time_since_epoch().count() * 1e-9;
           if ((now - pub->alive_time_) > REQUEST_TOPICS_ALIVE_TIME) {
-            spdlog_info("[{0}] Publisher remove(topic_id: {1}, topic_name: {2}, node_name: {3})", 
+            spdlog_info_throttle(this, "[{0}] Publisher remove(topic_id: {1}, topic_name: {2}, node_name: {3})", 
               session_id_.c_str(), pub->topic_id_, pub->topic_name_.c_str(), pub->node_name_.c_str());
             callbacks_.erase(pit->first);
             publishers_.erase(pit++);
@@ -560,7 +628,7 @@ private:
           SubscriberPtr sub = sit->second;
           uint64_t now = std::chrono::system_clock::now().time_since_epoch().count() * 1e-9;
           if ((now - sub->alive_time_) > REQUEST_TOPICS_ALIVE_TIME) {
-            spdlog_info("[{0}] Subscriber remove(topic_id: {1}, topic_name: {2}, node_name: {3})", 
+            spdlog_info_throttle(this, "[{0}] Subscriber remove(topic_id: {1}, topic_name: {2}, node_name: {3})", 
               session_id_.c_str(), sub->topic_id_, sub->topic_name_.c_str(), sub->node_name_.c_str());
             subscribers_.erase(sit++);
           } else {
@@ -609,11 +677,18 @@ private:
       std::unique_lock<std::mutex> lock(Rostopic::topics_mutex_);
       if (!Rostopic::topics_.count(topic_info.topic_name)) {
         Rostopic::topics_[topic_info.topic_name] = RostopicPtr(new Rostopic(topic_info));
+        Recorder::attach(Rostopic::topics_[topic_info.topic_name]);
       }
 
       // fake connection for stop
       RostopicConnection connection;
       connection.rostopic_ = Rostopic::topics_[topic_info.topic_name];
+      if (connection.rostopic_->message_type_.empty()) {
+        // created by a subscriber of any type, the publisher tells what it is
+        connection.rostopic_->message_type_ = topic_info.message_type;
+        connection.rostopic_->md5sum_ = topic_info.md5sum;
+        Recorder::retype(connection.rostopic_);
+      }
       connection.rostopic_->ref_count_++;
       publishers_[topic_info.topic_id]->connection_ = connection;
     } else {
@@ -631,16 +706,21 @@ private:
     if (!subscribers_.count(topic_info.topic_id)) {
       spdlog_info("[{0}] setup_subscriber(topic_id: {1}, topic_name: {2}, node_name: {3}, md5sum: {4})", 
         session_id_.c_str(), topic_info.topic_id, topic_info.topic_name.c_str(), topic_info.node.c_str(), topic_info.md5sum.c_str());
-      SubscriberPtr sub(new SubscriberCore(topic_info, std::bind(&Session::write_message_stream, this, std::placeholders::_1, std::placeholders::_2, topic_info.topic_id)));
-      sub->from_ = from_;
-      sub->alive_time_ = std::chrono::system_clock::now().time_since_epoch().count() * 1e-9;
-      subscribers_[topic_info.topic_id] = sub;
-
       std::unique_lock<std::mutex> lock(Rostopic::topics_mutex_);
       if (!Rostopic::topics_.count(topic_info.topic_name)) {
         Rostopic::topics_[topic_info.topic_name] = RostopicPtr(new Rostopic(topic_info));
+        Recorder::attach(Rostopic::topics_[topic_info.topic_name]);
       }
 
+      SubscriberPtr sub(new SubscriberCore(topic_info, std::bind(&Session::write_message_stream, this, std::placeholders::_1, std::placeholders::_2, 
+        topic_info.topic_id, Rostopic::topics_[topic_info.topic_name]->trace_)));
+      if (topic_info.topic_name == TINYROS_LOG_TOPIC) {
+        LogLevels::subscribe(this);
+      }
+      sub->from_ = from_;
+      sub->alive_time_ = std::chrono::system_clock::now().time_since_epoch().count() * 1e-9;
+      subscribers_[topic_info.topic_id] = sub;
+
       RostopicConnection connection;
       connection.rostopic_ = Rostopic::topics_[topic_info.topic_name];
       connection.rostopic_->ref_count_++;
@@ -649,6 +729,16 @@ private:
     } else {
       subscribers_[topic_info.topic_id]->alive_time_ = std::chrono::system_clock::now().time_since_epoch().count() * 1e-9;
     }
+
+    if (topic_info.message_type.empty()) {
+      // a subscriber of any type learns the type of the topic
+      std::unique_lock<std::mutex> lock(Rostopic::topics_mutex_);
+      std::map<std::string, RostopicPtr>::iterator it = Rostopic::topics_.find(topic_info.topic_name);
+      if (it != Rostopic::topics_.end()) {
+        topic_info.message_type = it->second->message_type_;
+        topic_info.md5sum = it->second->md5sum_;
+      }
+    }
     
     topic_info.negotiated = true;
     
@@ -663,7 +753,7 @@ private:
     if (!ServiceServerCore::services_.count(topic_info.topic_name)) {
       spdlog_info("[{0}] setup_service_server(topic_id: {1}, topic_name: {2}, node_name: {3}, md5sum: {4})", 
         session_id_.c_str(), topic_info.topic_id, topic_info.topic_name.c_str(), topic_info.node.c_str(), topic_info.md5sum.c_str());
-      ServiceServerPtr srv(new ServiceServerCore(topic_info, std::bind(&Session::write_message_stream, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)));
+      ServiceServerPtr srv(new ServiceServerCore(topic_info, std::bind(&Session::write_message_stream, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, nullptr)));
       callbacks_[topic_info.topic_id] = std::bind(&ServiceServerCore::handle, srv, std::placeholders::_1);
       ServiceServerCore::services_[topic_info.topic_name] = srv;
       ServiceServerCore::services_[topic_info.topic_name]->setTopicId(topic_info.topic_id);
@@ -685,7 +775,7 @@ private:
         spdlog_info("[{0}] setup_service_client(topic_id: {1}, topic_name: {2}, node_name: {3}, md5sum: {4})", 
           session_id_.c_str(), topic_info.topic_id, topic_info.topic_name.c_str(), topic_info.node.c_str(), topic_info.md5sum.c_str());
         ServiceServerPtr service = ServiceServerCore::services_[topic_info.topic_name];
-        ServiceClientPtr client(new ServiceClientCore(topic_info, std::bind(&Session::write_message_stream, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3)));
+        ServiceClientPtr client(new ServiceClientCore(topic_info, std::bind(&Session::write_message_stream, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, nullptr)));
         client->setTopicId(topic_info.topic_id);
         client->client_connection_ = client->signal_->connect(std::bind(&ServiceServerCore::callback, service, std::placeholders::_1));
         client->service_connection_ = service->signal_->connect(std::bind(&ServiceClientCore::callback, client, std::placeholders::_1));
@@ -716,20 +806,40 @@ private:
     }
   }
 
+  /* a frame of ID_LOG holds one or more tinyros_msgs/Log back to back */
   void handle_log(tinyros::serialization::IStream& stream) {
-    if (Rostopic::topics_.count(TINYROS_LOG_TOPIC)) {
-      Rostopic::topics_[TINYROS_LOG_TOPIC]->signal_->emit(stream);
+    if (!Rostopic::topics_.count(TINYROS_LOG_TOPIC)) {
+      return;
+    }
+    RostopicPtr rostopic = Rostopic::topics_[TINYROS_LOG_TOPIC];
+    while (stream.getLength() >= 5) {
+      uint8_t* data = stream.getData();
+      uint32_t size = data[1] | (data[2] << 8) | (data[3] << 16) | ((uint32_t)data[4] << 24);
+      // a length field past the frame drops the rest of it, checked before 5 + size can wrap
+      if (size > stream.getLength() - 5) {
+        break;
+      }
+      uint32_t length = 5 + size;
+      tinyros::serialization::IStream record(data, length);
+      rostopic->signal_->emit(record);
+      stream.advance(length);
     }
   }
 
+  // A node timing an exchange, see ClockSync: its request comes back with our receive and send time
   void handle_time(tinyros::serialization::IStream& stream) {
-    handle_time_done();
+    tinyros::Time receive = tinyros::Time::now();
+    tinyros::tinyros_msgs::SyncTime request;
+    tinyros::serialization::Serializer<tinyros::tinyros_msgs::SyncTime>::read(stream, request);
+    handle_time_done(request.data, receive);
   }
 
-  void handle_time_done() {
+  void handle_time_done(const tinyros::Time& request = tinyros::Time(), const tinyros::Time& receive = tinyros::Time()) {
     tinyros::tinyros_msgs::SyncTime time;
-    time.data = tinyros::Time::now();
     time.tick = REQUEST_TOPICS_TIMER*1000;
+    time.request = request;
+    time.receive = receive;
+    time.data = tinyros::Time::now(); // stamped again by time_dequeue
 
     size_t length = tinyros::serialization::serializationLength(time);
     std::vector<uint8_t> message(length);
@@ -737,7 +847,7 @@ private:
     tinyros::serialization::OStream ostream(&message[0], length);
     tinyros::serialization::Serializer<tinyros::tinyros_msgs::SyncTime>::write(ostream, time);
 
-    write_message(message, tinyros::tinyros_msgs::TopicInfo::ID_TIME);
+    write_message(message, tinyros::tinyros_msgs::TopicInfo::ID_TIME, true);
   }
 
   void handle_negotiated(const tinyros::tinyros_msgs::TopicInfo& topic_info) {
@@ -794,6 +904,26 @@ private:
     write_message(message, tinyros::tinyros_msgs::TopicInfo::ID_ROSSERVICE_REQUEST);
   }
 
+  // A /tinyrosout subscriber tells which levels it wants, msg holds per node overrides
+  void handle_log_level(tinyros::serialization::IStream& stream) {
+    tinyros::tinyros_msgs::Log request;
+    tinyros::serialization::Serializer<tinyros::tinyros_msgs::Log>::read(stream, request);
+    LogLevels::request(this, request.level, request.msg);
+  }
+
+  void handle_log_level_done() {
+    tinyros::tinyros_msgs::Log level;
+    level.level = (uint8_t)LogLevels::level(session_id_);
+
+    size_t length = tinyros::serialization::serializationLength(level);
+    std::vector<uint8_t> message(length);
+
+    tinyros::serialization::OStream ostream(&message[0], length);
+    tinyros::serialization::Serializer<tinyros::tinyros_msgs::Log>::write(ostream, level);
+
+    write_message(message, tinyros::tinyros_msgs::TopicInfo::ID_LOG_LEVEL);
+  }
+
   void handle_session_id(tinyros::serialization::IStream& stream) {
     tinyros::std_msgs::String session_info;
     tinyros::serialization::Serializer<tinyros::std_msgs::String>::read(stream, session_info);
@@ -802,6 +932,46 @@ private:
     socket_.session_id_ = session_id_;
   }
 
+  // The log connection of a node tells its session id, see handle_session_id
+  void handle_log_session_id(tinyros::serialization::IStream& stream) {
+    log_session_ = true;
+    handle_session_id(stream);
+  }
+
+  // Starts, stops or reports the recorder, see Recorder::command
+  void handle_record(tinyros::serialization::IStream& stream) {
+    tinyros::std_msgs::String command;
+    tinyros::serialization::Serializer<tinyros::std_msgs::String>::read(stream, command);
+    spdlog_info("[{0}] record({1})", session_id_.c_str(), command.data.c_str());
+    tinyros::std_msgs::String reply;
+    reply.data = Recorder::command(command.data);
+    size_t length = tinyros::serialization::serializationLength(reply);
+    std::vector<uint8_t> message(length);
+    tinyros::serialization::OStream ostream(&message[0], length);
+    tinyros::serialization::Serializer<tinyros::std_msgs::String>::write(ostream, reply);
+    write_message(message, tinyros::tinyros_msgs::TopicInfo::ID_RECORD);
+  }
+
+  // The client dropped a publisher or subscriber, its topic_id may come back for another endpoint
+  void handle_unregister(tinyros::serialization::IStream& stream) {
+    tinyros::tinyros_msgs::TopicInfo topic_info;
+    tinyros::serialization::Serializer<tinyros::tinyros_msgs::TopicInfo>::read(stream, topic_info);
+    if (publishers_.count(topic_info.topic_id)) {
+      spdlog_info("[{0}] Publisher unregister(topic_id: {1}, topic_name: {2}, node_name: {3})",
+        session_id_.c_str(), topic_info.topic_id, topic_info.topic_name.c_str(), topic_info.node.c_str());
+      callbacks_.erase(topic_info.topic_id);
+      publishers_.erase(topic_info.topic_id);
+    }
+    if (subscribers_.count(topic_info.topic_id)) {
+      spdlog_info("[{0}] Subscriber unregister(topic_id: {1}, topic_name: {2}, node_name: {3})",
+        session_id_.c_str(), topic_info.topic_id, topic_info.topic_name.c_str(), topic_info.node.c_str());
+      if (subscribers_[topic_info.topic_id]->topic_name_ == TINYROS_LOG_TOPIC) {
+        LogLevels::unsubscribe(this);
+      }
+      subscribers_.erase(topic_info.topic_id);
+    }
+  }
+
   std::mutex async_write_mutex_;
   std::condition_variable async_write_cond_;
   AsyncWritebuffer async_write_buffers_;
@@ -823,6 +993,7 @@ private:
   std::thread* message_in_thread_;
 
   std::thread* message_write_thread_;
+  bool log_session_; // sent ID_LOG_SESSION_ID, the log connection of a node
 
   std::thread* require_check_thread_;
   bool require_check_running_;
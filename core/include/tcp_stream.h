@@ -24,11 +24,11 @@ public:
       if (rv > 0) {
         totalsent += rv;
       } else if (rv == 0) {
-        spdlog_error("[{0}] TcpStream::write_some socket close: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
+        spdlog_error_throttle(this, "[{0}] TcpStream::write_some socket close: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
         return -1;
       } else {
         if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR)) {
-          spdlog_error("[{0}] TcpStream::write_some error: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
+          spdlog_error_throttle(this, "[{0}] TcpStream::write_some error: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
           return -1;
         }
       }
@@ -42,11 +42,11 @@ public:
     if (rv > 0) {
       return rv;
     } else if (rv == 0) {
-      spdlog_error("[{0}] TcpStream::read_some socket close: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
+      spdlog_error_throttle(this, "[{0}] TcpStream::read_some socket close: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
       return -1;
     } else {
       if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR))  {
-        spdlog_error("[{0}] TcpStream::read_some error: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
+        spdlog_error_throttle(this, "[{0}] TcpStream::read_some error: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
         return -1;
       }
       return 0;
@@ -3,6 +3,7 @@
 #include <thread>
 #include <memory>
 #include "signals.h"
+#include "tiny_ros/ros/trace.h"
 #include "tiny_ros/tinyros_msgs/TopicInfo.h"
 
 namespace tinyros
@@ -33,6 +34,7 @@ public:
     buffer_size_ = topic_info.buffer_size;
     ref_count_ = 0;
     signal_ = std::shared_ptr<Signal<tinyros::serialization::IStream&> >(new Signal<tinyros::serialization::IStream&>);
+    trace_ = TraceStatsPtr(new TraceStats());
   }
 
 public:
@@ -41,6 +43,7 @@ public:
 
 public:
   std::shared_ptr<Signal<tinyros::serialization::IStream&> > signal_;
+  TraceStatsPtr trace_;
   std::string topic_name_;
   std::string message_type_;
   std::string md5sum_;
@@ -72,7 +75,14 @@ public:
   
   void handle(tinyros::serialization::IStream& stream) {
     if (Rostopic::topics_.count(topic_name_)) {
-      Rostopic::topics_[topic_name_]->signal_->emit(stream);
+      RostopicPtr rostopic = Rostopic::topics_[topic_name_];
+      uint8_t* trailer = (uint8_t*)Trace::find(stream.getData(), stream.getLength());
+      if (trailer) {
+        uint64_t now = Trace::toNSec(Time::now());
+        Trace::putStamp(trailer, TRACE_DDS_RECV, now);
+        rostopic->trace_->record(TraceStats::SEG_PUB_TO_DDS, Trace::getStamp(trailer, TRACE_PUBLISH), now);
+      }
+      rostopic->signal_->emit(stream);
     }
   }
 
@@ -43,7 +43,7 @@ public:
      socklen_t from_len = sizeof(from);
      int rv = recvfrom(sock_fd_, data, length, 0, (struct sockaddr*)&from, &from_len);
      if (rv < 0) {
-      spdlog_error("[{0}] UdpStream::read_some: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
+      spdlog_error_throttle(this, "[{0}] UdpStream::read_some: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
      }
      return (rv > 0 ? rv : 0);
   } 
@@ -52,7 +52,7 @@ public:
     struct sockaddr_in addr = to;
     int s = sendto(sock_fd_, data, length, 0, (struct sockaddr *)&addr, sizeof(addr));
     if(s <= 0) {
-      spdlog_error("[{0}] UdpStream::write_some: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
+      spdlog_error_throttle(this, "[{0}] UdpStream::write_some: {1}(errno: {2})", session_id_.c_str(), strerror(errno), errno);
       return 0;
     }
     return s;
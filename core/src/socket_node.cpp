@@ -4,10 +4,28 @@
 #include "session.h"
 #include "signals.h"
 #include "common.h"
+#include "spdlog/async.h"
 
 #define LOG_ROTATION_PATH    "tinyros_logs/"
 #define LOG_ROTATION_SIZE    (2*1024*1024) //2MB
 #define LOG_ROTATION_FILES   (5)
+#define TRACE_REPORT_TIMER   (10) // seconds
+#define LOG_QUEUE_SIZE       (8192) // messages waiting for the log thread
+#define LOG_FLUSH_TIMER      (1) // seconds
+
+static void print_usage() {
+  printf("\nUsage: tinyrosdds [-l LOG_LEVEL]\n");
+  printf("\nLOG_LEVEL: trace, debug, info, warning, error, critical or off, trace by default.\n");
+  printf("At runtime SIGUSR1 logs one level more, SIGUSR2 one level less.\n\n");
+}
+
+/* kill -USR1/-USR2: the level is an atomic of the logger, nothing else is touched here */
+static void log_level_signal(int sig) {
+  int level = spdlog::default_logger_raw()->level() + (sig == SIGUSR1 ? -1 : 1);
+  if (level >= spdlog::level::trace && level <= spdlog::level::off) {
+    spdlog::default_logger_raw()->set_level((spdlog::level::level_enum)level);
+  }
+}
 
 static void udp_service_run(int server_port, int client_port) {
   tinyros::UdpStream stream;
@@ -22,6 +40,21 @@ static void udp_service_run(int server_port, int client_port) {
   }
 }
 
+static void trace_report_run() {
+  while (1) {
+    sleep(TRACE_REPORT_TIMER);
+    std::unique_lock<std::mutex> lock(tinyros::Rostopic::topics_mutex_);
+    std::map<std::string, tinyros::RostopicPtr>::iterator it;
+    for (it = tinyros::Rostopic::topics_.begin(); it != tinyros::Rostopic::topics_.end(); it++) {
+      std::string report = it->second->trace_->report();
+      if (!report.empty()) {
+        spdlog_info("trace topic: {0}, last {1}s\n{2}", it->first.c_str(), TRACE_REPORT_TIMER, report.c_str());
+        it->second->trace_->reset();
+      }
+    }
+  }
+}
+
 #ifdef TINYROS_WITH_WEBSOCKETS
 #include "uWS.h"
 static void web_service_run(int web_server_port) {
@@ -60,21 +93,46 @@ static void web_service_run(int web_server_port) {
 int main(int argc, char* argv[]) {
   signal(SIGPIPE, SIG_IGN);
 
+  spdlog::level::level_enum level = spdlog::level::trace;
+  if (argc >= 2) {
+    if (argc >= 3 && !strcmp(argv[1], "-l")) {
+      level = spdlog::level::from_str(argv[2]);
+      if (level == spdlog::level::off && strcmp(argv[2], "off")) {
+        printf("Invalid log level: %s\n", argv[2]);
+        return 0;
+      }
+    } else {
+      print_usage();
+      return 0;
+    }
+  }
+
+  // Sessions only queue their messages, one thread writes them out and a
+  // flush goes out every LOG_FLUSH_TIMER or on an error
+  spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
   auto stdout_sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
   auto rotating_file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>
     (LOG_ROTATION_PATH "tinyrosdds.log", LOG_ROTATION_SIZE, LOG_ROTATION_FILES);
   stdout_sink->set_level(spdlog::level::warn);
   rotating_file_sink->set_level(spdlog::level::trace);
   spdlog::sinks_init_list sinks = {rotating_file_sink, stdout_sink};
-  auto logger = std::make_shared<spdlog::logger>("logger", sinks);
-  logger->set_level(spdlog::level::trace);
-  logger->flush_on(spdlog::level::trace);
+  auto logger = std::make_shared<spdlog::async_logger>("logger", sinks, spdlog::thread_pool(),
+    spdlog::async_overflow_policy::overrun_oldest);
+  logger->set_level(level);
+  logger->flush_on(spdlog::level::err);
   logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%l] %v");
   spdlog::register_logger(logger);
+  spdlog::set_default_logger(logger);
+  spdlog::flush_every(std::chrono::seconds(LOG_FLUSH_TIMER));
+  signal(SIGUSR1, log_level_signal);
+  signal(SIGUSR2, log_level_signal);
 
   std::thread tidudp(std::bind(udp_service_run, UDP_SERVER_PORT, UDP_CLIENT_PORT));
   tidudp.detach();
 
+  std::thread tidtrace(trace_report_run);
+  tidtrace.detach();
+
 #ifdef TINYROS_WITH_WEBSOCKETS
   std::thread tidws(std::bind(web_service_run, WEB_SERVER_PORT));
   tidws.detach();
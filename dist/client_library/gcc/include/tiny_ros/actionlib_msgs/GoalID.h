@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace actionlib_msgs
 {
 
+  class GoalIDView;
+
   class GoalID : public tinyros::Msg
   {
     public:
@@ -85,28 +89,65 @@ namespace actionlib_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("stamp");
+      writer.value(this->stamp);
+      writer.raw(',');
+      writer.key("id");
+      writer.value(this->id);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_stamp;
-      ss_stamp << "\"stamp\":{\"sec\":" << stamp.sec;
-      ss_stamp << ",\"nsec\":" << stamp.nsec << "},";
-      string_echo += ss_stamp.str();
-      std::size_t id_pos = id.find("\"");
-      while(id_pos != std::string::npos){
-        id.replace(id_pos, 1,"\\\"");
-        id_pos = id.find("\"", id_pos+2);
-      }
-      string_echo += "\"id\":\"";
-      string_echo += id;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "actionlib_msgs/GoalID"; }
     virtual std::string getMD5(){ return "a6cee90e5a185f4cb050de49bc4fa1f4"; }
+    typedef GoalIDView View;
+
+  };
+
+  /* GoalID read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GoalIDView
+  {
+    public:
+    typedef GoalID MsgType;
+
+    GoalIDView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(1)
+    {
+      offsets_[1] = 8;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::Time stamp() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 0); }
+    tinyros::StringView id() const { return tinyros::StringView(buffer_ + 8); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
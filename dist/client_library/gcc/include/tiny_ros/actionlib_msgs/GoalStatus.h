@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/actionlib_msgs/GoalID.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace actionlib_msgs
 {
 
+  class GoalStatusView;
+
   class GoalStatus : public tinyros::Msg
   {
     public:
@@ -84,29 +88,71 @@ namespace actionlib_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("goal_id");
+      writer.value(this->goal_id);
+      writer.raw(',');
+      writer.key("status");
+      writer.value(this->status);
+      writer.raw(',');
+      writer.key("text");
+      writer.value(this->text);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"goal_id\":";
-      string_echo += this->goal_id.echo();
-      string_echo += ",";
-      std::stringstream ss_status; ss_status << "\"status\":" << (uint16_t)status <<",";
-      string_echo += ss_status.str();
-      std::size_t text_pos = text.find("\"");
-      while(text_pos != std::string::npos){
-        text.replace(text_pos, 1,"\\\"");
-        text_pos = text.find("\"", text_pos+2);
-      }
-      string_echo += "\"text\":\"";
-      string_echo += text;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "actionlib_msgs/GoalStatus"; }
     virtual std::string getMD5(){ return "086be35ea957e692de83fc3477e4ef0b"; }
+    typedef GoalStatusView View;
+
+  };
+
+  /* GoalStatus read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GoalStatusView
+  {
+    public:
+    typedef GoalStatus MsgType;
+
+    GoalStatusView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::actionlib_msgs::GoalIDView goal_id() const { return tinyros::actionlib_msgs::GoalIDView(buffer_ + 0); }
+    uint8_t status() const { return tinyros::viewRead<uint8_t>(buffer_ + fieldOffset(1)); }
+    tinyros::StringView text() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::actionlib_msgs::GoalIDView(p).serializedLength(); break;
+          case 1: length = 1; break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
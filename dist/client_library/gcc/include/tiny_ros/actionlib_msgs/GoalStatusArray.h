@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/actionlib_msgs/GoalStatus.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace actionlib_msgs
 {
 
+  class GoalStatusArrayView;
+
   class GoalStatusArray : public tinyros::Msg
   {
     public:
@@ -76,30 +80,69 @@ namespace actionlib_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("status_list", this->status_list, this->status_list_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "status_list:[";
-      for( uint32_t i = 0; i < status_list_length; i++) {
-        if( i == (status_list_length - 1)) {
-          string_echo += this->status_list[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->status_list[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "actionlib_msgs/GoalStatusArray"; }
     virtual std::string getMD5(){ return "53f6501f7c14f5f3963638de4bbe3a71"; }
+    typedef GoalStatusArrayView View;
+
+  };
+
+  /* GoalStatusArray read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GoalStatusArrayView
+  {
+    public:
+    typedef GoalStatusArray MsgType;
+
+    GoalStatusArrayView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::ViewList<tinyros::actionlib_msgs::GoalStatusView> status_list() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::ViewList<tinyros::actionlib_msgs::GoalStatusView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::ViewList<tinyros::actionlib_msgs::GoalStatusView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -75,19 +77,19 @@ static const char ADDDIAGNOSTICS[] = "diagnostic_msgs/AddDiagnostics";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("load_namespace");
+      writer.value(this->load_namespace);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t load_namespace_pos = load_namespace.find("\"");
-      while(load_namespace_pos != std::string::npos){
-        load_namespace.replace(load_namespace_pos, 1,"\\\"");
-        load_namespace_pos = load_namespace.find("\"", load_namespace_pos+2);
-      }
-      string_echo += "\"load_namespace\":\"";
-      string_echo += load_namespace;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return ADDDIAGNOSTICS; }
@@ -177,21 +179,22 @@ static const char ADDDIAGNOSTICS[] = "diagnostic_msgs/AddDiagnostics";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("message");
+      writer.value(this->message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t message_pos = message.find("\"");
-      while(message_pos != std::string::npos){
-        message.replace(message_pos, 1,"\\\"");
-        message_pos = message.find("\"", message_pos+2);
-      }
-      string_echo += "\"message\":\"";
-      string_echo += message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return ADDDIAGNOSTICS; }
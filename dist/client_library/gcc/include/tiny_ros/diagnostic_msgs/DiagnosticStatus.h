@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/diagnostic_msgs/KeyValue.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace diagnostic_msgs
 {
 
+  class DiagnosticStatusView;
+
   class DiagnosticStatus : public tinyros::Msg
   {
     public:
@@ -152,53 +156,83 @@ namespace diagnostic_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("level");
+      writer.value(this->level);
+      writer.raw(',');
+      writer.key("name");
+      writer.value(this->name);
+      writer.raw(',');
+      writer.key("message");
+      writer.value(this->message);
+      writer.raw(',');
+      writer.key("hardware_id");
+      writer.value(this->hardware_id);
+      writer.raw(',');
+      writer.array("values", this->values, this->values_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_level; ss_level << "\"level\":" << (int16_t)level <<",";
-      string_echo += ss_level.str();
-      std::size_t name_pos = name.find("\"");
-      while(name_pos != std::string::npos){
-        name.replace(name_pos, 1,"\\\"");
-        name_pos = name.find("\"", name_pos+2);
-      }
-      string_echo += "\"name\":\"";
-      string_echo += name;
-      string_echo += "\",";
-      std::size_t message_pos = message.find("\"");
-      while(message_pos != std::string::npos){
-        message.replace(message_pos, 1,"\\\"");
-        message_pos = message.find("\"", message_pos+2);
-      }
-      string_echo += "\"message\":\"";
-      string_echo += message;
-      string_echo += "\",";
-      std::size_t hardware_id_pos = hardware_id.find("\"");
-      while(hardware_id_pos != std::string::npos){
-        hardware_id.replace(hardware_id_pos, 1,"\\\"");
-        hardware_id_pos = hardware_id.find("\"", hardware_id_pos+2);
-      }
-      string_echo += "\"hardware_id\":\"";
-      string_echo += hardware_id;
-      string_echo += "\",";
-      string_echo += "values:[";
-      for( uint32_t i = 0; i < values_length; i++) {
-        if( i == (values_length - 1)) {
-          string_echo += this->values[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->values[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "diagnostic_msgs/DiagnosticStatus"; }
     virtual std::string getMD5(){ return "9ec892d2145f478061efd60bb1762361"; }
+    typedef DiagnosticStatusView View;
+
+  };
+
+  /* DiagnosticStatus read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class DiagnosticStatusView
+  {
+    public:
+    typedef DiagnosticStatus MsgType;
+
+    DiagnosticStatusView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(1)
+    {
+      offsets_[1] = 1;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(5); }
+
+    int8_t level() const { return tinyros::viewRead<int8_t>(buffer_ + 0); }
+    tinyros::StringView name() const { return tinyros::StringView(buffer_ + 1); }
+    tinyros::StringView message() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+    tinyros::StringView hardware_id() const { return tinyros::StringView(buffer_ + fieldOffset(3)); }
+    tinyros::ViewList<tinyros::diagnostic_msgs::KeyValueView> values() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(4);
+      return tinyros::ViewList<tinyros::diagnostic_msgs::KeyValueView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+          case 3: length = tinyros::StringView(p).serializedLength(); break;
+          case 4: length = 4 + tinyros::ViewList<tinyros::diagnostic_msgs::KeyValueView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[6];
+    mutable uint32_t known_;
   };
 
 }
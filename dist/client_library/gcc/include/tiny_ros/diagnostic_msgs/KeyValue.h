@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace diagnostic_msgs
 {
 
+  class KeyValueView;
+
   class KeyValue : public tinyros::Msg
   {
     public:
@@ -79,32 +83,66 @@ namespace diagnostic_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("key");
+      writer.value(this->key);
+      writer.raw(',');
+      writer.key("value");
+      writer.value(this->value);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t key_pos = key.find("\"");
-      while(key_pos != std::string::npos){
-        key.replace(key_pos, 1,"\\\"");
-        key_pos = key.find("\"", key_pos+2);
-      }
-      string_echo += "\"key\":\"";
-      string_echo += key;
-      string_echo += "\",";
-      std::size_t value_pos = value.find("\"");
-      while(value_pos != std::string::npos){
-        value.replace(value_pos, 1,"\\\"");
-        value_pos = value.find("\"", value_pos+2);
-      }
-      string_echo += "\"value\":\"";
-      string_echo += value;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "diagnostic_msgs/KeyValue"; }
     virtual std::string getMD5(){ return "1baa904b80c685c77d1a42a872ca1d07"; }
+    typedef KeyValueView View;
+
+  };
+
+  /* KeyValue read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class KeyValueView
+  {
+    public:
+    typedef KeyValue MsgType;
+
+    KeyValueView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::StringView key() const { return tinyros::StringView(buffer_ + 0); }
+    tinyros::StringView value() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
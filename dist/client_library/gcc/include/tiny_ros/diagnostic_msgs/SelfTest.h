@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/diagnostic_msgs/DiagnosticStatus.h"
 
 namespace tinyros
@@ -56,11 +58,17 @@ static const char SELFTEST[] = "diagnostic_msgs/SelfTest";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SELFTEST; }
@@ -179,32 +187,24 @@ static const char SELFTEST[] = "diagnostic_msgs/SelfTest";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("id");
+      writer.value(this->id);
+      writer.raw(',');
+      writer.key("passed");
+      writer.value(this->passed);
+      writer.raw(',');
+      writer.array("status", this->status, this->status_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t id_pos = id.find("\"");
-      while(id_pos != std::string::npos){
-        id.replace(id_pos, 1,"\\\"");
-        id_pos = id.find("\"", id_pos+2);
-      }
-      string_echo += "\"id\":\"";
-      string_echo += id;
-      string_echo += "\",";
-      std::stringstream ss_passed; ss_passed << "\"passed\":" << (int16_t)passed <<",";
-      string_echo += ss_passed.str();
-      string_echo += "status:[";
-      for( uint32_t i = 0; i < status_length; i++) {
-        if( i == (status_length - 1)) {
-          string_echo += this->status[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->status[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SELFTEST; }
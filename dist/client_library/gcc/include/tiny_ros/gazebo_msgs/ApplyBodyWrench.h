@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/duration.h"
 #include "tiny_ros/geometry_msgs/Wrench.h"
 #include "tiny_ros/ros/time.h"
@@ -161,41 +163,34 @@ static const char APPLYBODYWRENCH[] = "gazebo_msgs/ApplyBodyWrench";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("body_name");
+      writer.value(this->body_name);
+      writer.raw(',');
+      writer.key("reference_frame");
+      writer.value(this->reference_frame);
+      writer.raw(',');
+      writer.key("reference_point");
+      writer.value(this->reference_point);
+      writer.raw(',');
+      writer.key("wrench");
+      writer.value(this->wrench);
+      writer.raw(',');
+      writer.key("start_time");
+      writer.value(this->start_time);
+      writer.raw(',');
+      writer.key("duration");
+      writer.value(this->duration);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t body_name_pos = body_name.find("\"");
-      while(body_name_pos != std::string::npos){
-        body_name.replace(body_name_pos, 1,"\\\"");
-        body_name_pos = body_name.find("\"", body_name_pos+2);
-      }
-      string_echo += "\"body_name\":\"";
-      string_echo += body_name;
-      string_echo += "\",";
-      std::size_t reference_frame_pos = reference_frame.find("\"");
-      while(reference_frame_pos != std::string::npos){
-        reference_frame.replace(reference_frame_pos, 1,"\\\"");
-        reference_frame_pos = reference_frame.find("\"", reference_frame_pos+2);
-      }
-      string_echo += "\"reference_frame\":\"";
-      string_echo += reference_frame;
-      string_echo += "\",";
-      string_echo += "\"reference_point\":";
-      string_echo += this->reference_point.echo();
-      string_echo += ",";
-      string_echo += "\"wrench\":";
-      string_echo += this->wrench.echo();
-      string_echo += ",";
-      std::stringstream ss_start_time;
-      ss_start_time << "\"start_time\":{\"sec\":" << start_time.sec;
-      ss_start_time << ",\"nsec\":" << start_time.nsec << "},";
-      string_echo += ss_start_time.str();
-      std::stringstream ss_duration;
-      ss_duration << "\"duration\":{\"sec\":" << duration.sec;
-      ss_duration << ",\"nsec\":" << duration.nsec << "}";
-      string_echo += ss_duration.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return APPLYBODYWRENCH; }
@@ -285,21 +280,22 @@ static const char APPLYBODYWRENCH[] = "gazebo_msgs/ApplyBodyWrench";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return APPLYBODYWRENCH; }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/duration.h"
 #include "tiny_ros/ros/time.h"
 
@@ -160,29 +162,28 @@ static const char APPLYJOINTEFFORT[] = "gazebo_msgs/ApplyJointEffort";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("joint_name");
+      writer.value(this->joint_name);
+      writer.raw(',');
+      writer.key("effort");
+      writer.value(this->effort);
+      writer.raw(',');
+      writer.key("start_time");
+      writer.value(this->start_time);
+      writer.raw(',');
+      writer.key("duration");
+      writer.value(this->duration);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t joint_name_pos = joint_name.find("\"");
-      while(joint_name_pos != std::string::npos){
-        joint_name.replace(joint_name_pos, 1,"\\\"");
-        joint_name_pos = joint_name.find("\"", joint_name_pos+2);
-      }
-      string_echo += "\"joint_name\":\"";
-      string_echo += joint_name;
-      string_echo += "\",";
-      std::stringstream ss_effort; ss_effort << "\"effort\":" << effort <<",";
-      string_echo += ss_effort.str();
-      std::stringstream ss_start_time;
-      ss_start_time << "\"start_time\":{\"sec\":" << start_time.sec;
-      ss_start_time << ",\"nsec\":" << start_time.nsec << "},";
-      string_echo += ss_start_time.str();
-      std::stringstream ss_duration;
-      ss_duration << "\"duration\":{\"sec\":" << duration.sec;
-      ss_duration << ",\"nsec\":" << duration.nsec << "}";
-      string_echo += ss_duration.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return APPLYJOINTEFFORT; }
@@ -272,21 +273,22 @@ static const char APPLYJOINTEFFORT[] = "gazebo_msgs/ApplyJointEffort";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return APPLYJOINTEFFORT; }
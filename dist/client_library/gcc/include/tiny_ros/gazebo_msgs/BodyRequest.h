@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -75,19 +77,19 @@ static const char BODYREQUEST[] = "gazebo_msgs/BodyRequest";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("body_name");
+      writer.value(this->body_name);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t body_name_pos = body_name.find("\"");
-      while(body_name_pos != std::string::npos){
-        body_name.replace(body_name_pos, 1,"\\\"");
-        body_name_pos = body_name.find("\"", body_name_pos+2);
-      }
-      string_echo += "\"body_name\":\"";
-      string_echo += body_name;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return BODYREQUEST; }
@@ -138,11 +140,17 @@ static const char BODYREQUEST[] = "gazebo_msgs/BodyRequest";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return BODYREQUEST; }
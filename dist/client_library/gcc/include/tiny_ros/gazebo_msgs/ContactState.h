@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Wrench.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace gazebo_msgs
 {
 
+  class ContactStateView;
+
   class ContactState : public tinyros::Msg
   {
     public:
@@ -103,22 +107,8 @@ namespace gazebo_msgs
       *(outbuffer + offset + 2) = (this->depths_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->depths_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->depths_length);
-      for( uint32_t i = 0; i < depths_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_depthsi;
-        u_depthsi.real = this->depths[i];
-        *(outbuffer + offset + 0) = (u_depthsi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_depthsi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_depthsi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_depthsi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_depthsi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_depthsi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_depthsi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_depthsi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->depths[i]);
-      }
+      arrayToArr(outbuffer + offset, this->depths, depths_length);
+      offset += depths_length * sizeof(double);
       return offset;
     }
 
@@ -197,24 +187,8 @@ namespace gazebo_msgs
       if(depths_lengthT > depths_length)
         this->depths = (double*)realloc(this->depths, depths_lengthT * sizeof(double));
       depths_length = depths_lengthT;
-      for( uint32_t i = 0; i < depths_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_depths;
-        u_st_depths.base = 0;
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_depths.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_depths = u_st_depths.real;
-        offset += sizeof(this->st_depths);
-        memcpy( &(this->depths[i]), &(this->st_depths), sizeof(double));
-      }
+      arrToArray(this->depths, inbuffer + offset, depths_length);
+      offset += depths_length * sizeof(double);
       return offset;
     }
 
@@ -244,93 +218,112 @@ namespace gazebo_msgs
         length += this->contact_normals[i].serializedLength();
       }
       length += sizeof(this->depths_length);
-      for( uint32_t i = 0; i < depths_length; i++) {
-        length += sizeof(this->depths[i]);
-      }
+      length += depths_length * sizeof(double);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("info");
+      writer.value(this->info);
+      writer.raw(',');
+      writer.key("collision1_name");
+      writer.value(this->collision1_name);
+      writer.raw(',');
+      writer.key("collision2_name");
+      writer.value(this->collision2_name);
+      writer.raw(',');
+      writer.array("wrenches", this->wrenches, this->wrenches_length);
+      writer.raw(',');
+      writer.key("total_wrench");
+      writer.value(this->total_wrench);
+      writer.raw(',');
+      writer.array("contact_positions", this->contact_positions, this->contact_positions_length);
+      writer.raw(',');
+      writer.array("contact_normals", this->contact_normals, this->contact_normals_length);
+      writer.raw(',');
+      writer.array("depths", this->depths, this->depths_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t info_pos = info.find("\"");
-      while(info_pos != std::string::npos){
-        info.replace(info_pos, 1,"\\\"");
-        info_pos = info.find("\"", info_pos+2);
-      }
-      string_echo += "\"info\":\"";
-      string_echo += info;
-      string_echo += "\",";
-      std::size_t collision1_name_pos = collision1_name.find("\"");
-      while(collision1_name_pos != std::string::npos){
-        collision1_name.replace(collision1_name_pos, 1,"\\\"");
-        collision1_name_pos = collision1_name.find("\"", collision1_name_pos+2);
-      }
-      string_echo += "\"collision1_name\":\"";
-      string_echo += collision1_name;
-      string_echo += "\",";
-      std::size_t collision2_name_pos = collision2_name.find("\"");
-      while(collision2_name_pos != std::string::npos){
-        collision2_name.replace(collision2_name_pos, 1,"\\\"");
-        collision2_name_pos = collision2_name.find("\"", collision2_name_pos+2);
-      }
-      string_echo += "\"collision2_name\":\"";
-      string_echo += collision2_name;
-      string_echo += "\",";
-      string_echo += "wrenches:[";
-      for( uint32_t i = 0; i < wrenches_length; i++) {
-        if( i == (wrenches_length - 1)) {
-          string_echo += this->wrenches[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->wrenches[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "\"total_wrench\":";
-      string_echo += this->total_wrench.echo();
-      string_echo += ",";
-      string_echo += "contact_positions:[";
-      for( uint32_t i = 0; i < contact_positions_length; i++) {
-        if( i == (contact_positions_length - 1)) {
-          string_echo += this->contact_positions[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->contact_positions[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "contact_normals:[";
-      for( uint32_t i = 0; i < contact_normals_length; i++) {
-        if( i == (contact_normals_length - 1)) {
-          string_echo += this->contact_normals[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->contact_normals[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "depths:[";
-      for( uint32_t i = 0; i < depths_length; i++) {
-        if( i == (depths_length - 1)) {
-          std::stringstream ss_depthsi; ss_depthsi << depths[i] <<"";
-          string_echo += ss_depthsi.str();
-        } else {
-          std::stringstream ss_depthsi; ss_depthsi << depths[i] <<",";
-          string_echo += ss_depthsi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "gazebo_msgs/ContactState"; }
     virtual std::string getMD5(){ return "d82d0f0cae88aebf6b2cc86caea33a2b"; }
+    typedef ContactStateView View;
+
+  };
+
+  /* ContactState read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ContactStateView
+  {
+    public:
+    typedef ContactState MsgType;
+
+    ContactStateView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(8); }
+
+    tinyros::StringView info() const { return tinyros::StringView(buffer_ + 0); }
+    tinyros::StringView collision1_name() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+    tinyros::StringView collision2_name() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+    tinyros::Span<tinyros::geometry_msgs::WrenchView> wrenches() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::Span<tinyros::geometry_msgs::WrenchView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::geometry_msgs::WrenchView total_wrench() const { return tinyros::geometry_msgs::WrenchView(buffer_ + fieldOffset(4)); }
+    tinyros::Span<tinyros::geometry_msgs::Vector3View> contact_positions() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(5);
+      return tinyros::Span<tinyros::geometry_msgs::Vector3View>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<tinyros::geometry_msgs::Vector3View> contact_normals() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(6);
+      return tinyros::Span<tinyros::geometry_msgs::Vector3View>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> depths() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(7);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+          case 3: length = 4 + tinyros::viewRead<uint32_t>(p) * 48; break;
+          case 4: length = tinyros::geometry_msgs::WrenchView(p).serializedLength(); break;
+          case 5: length = 4 + tinyros::viewRead<uint32_t>(p) * 24; break;
+          case 6: length = 4 + tinyros::viewRead<uint32_t>(p) * 24; break;
+          case 7: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[9];
+    mutable uint32_t known_;
   };
 
 }
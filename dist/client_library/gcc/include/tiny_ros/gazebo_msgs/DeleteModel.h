@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -75,19 +77,19 @@ static const char DELETEMODEL[] = "gazebo_msgs/DeleteModel";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("model_name");
+      writer.value(this->model_name);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t model_name_pos = model_name.find("\"");
-      while(model_name_pos != std::string::npos){
-        model_name.replace(model_name_pos, 1,"\\\"");
-        model_name_pos = model_name.find("\"", model_name_pos+2);
-      }
-      string_echo += "\"model_name\":\"";
-      string_echo += model_name;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return DELETEMODEL; }
@@ -177,21 +179,22 @@ static const char DELETEMODEL[] = "gazebo_msgs/DeleteModel";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return DELETEMODEL; }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -75,19 +77,19 @@ static const char GETJOINTPROPERTIES[] = "gazebo_msgs/GetJointProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("joint_name");
+      writer.value(this->joint_name);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t joint_name_pos = joint_name.find("\"");
-      while(joint_name_pos != std::string::npos){
-        joint_name.replace(joint_name_pos, 1,"\\\"");
-        joint_name_pos = joint_name.find("\"", joint_name_pos+2);
-      }
-      string_echo += "\"joint_name\":\"";
-      string_echo += joint_name;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETJOINTPROPERTIES; }
@@ -155,64 +157,22 @@ static const char GETJOINTPROPERTIES[] = "gazebo_msgs/GetJointProperties";
       *(outbuffer + offset + 2) = (this->damping_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->damping_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->damping_length);
-      for( uint32_t i = 0; i < damping_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_dampingi;
-        u_dampingi.real = this->damping[i];
-        *(outbuffer + offset + 0) = (u_dampingi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_dampingi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_dampingi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_dampingi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_dampingi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_dampingi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_dampingi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_dampingi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->damping[i]);
-      }
+      arrayToArr(outbuffer + offset, this->damping, damping_length);
+      offset += damping_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->position_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->position_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->position_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->position_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->position_length);
-      for( uint32_t i = 0; i < position_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_positioni;
-        u_positioni.real = this->position[i];
-        *(outbuffer + offset + 0) = (u_positioni.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_positioni.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_positioni.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_positioni.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_positioni.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_positioni.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_positioni.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_positioni.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->position[i]);
-      }
+      arrayToArr(outbuffer + offset, this->position, position_length);
+      offset += position_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->rate_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->rate_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->rate_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->rate_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->rate_length);
-      for( uint32_t i = 0; i < rate_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_ratei;
-        u_ratei.real = this->rate[i];
-        *(outbuffer + offset + 0) = (u_ratei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_ratei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_ratei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_ratei.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_ratei.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_ratei.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_ratei.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_ratei.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->rate[i]);
-      }
+      arrayToArr(outbuffer + offset, this->rate, rate_length);
+      offset += rate_length * sizeof(double);
       union {
         bool real;
         uint8_t base;
@@ -246,24 +206,8 @@ static const char GETJOINTPROPERTIES[] = "gazebo_msgs/GetJointProperties";
       if(damping_lengthT > damping_length)
         this->damping = (double*)realloc(this->damping, damping_lengthT * sizeof(double));
       damping_length = damping_lengthT;
-      for( uint32_t i = 0; i < damping_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_damping;
-        u_st_damping.base = 0;
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_damping = u_st_damping.real;
-        offset += sizeof(this->st_damping);
-        memcpy( &(this->damping[i]), &(this->st_damping), sizeof(double));
-      }
+      arrToArray(this->damping, inbuffer + offset, damping_length);
+      offset += damping_length * sizeof(double);
       uint32_t position_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       position_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       position_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -272,24 +216,8 @@ static const char GETJOINTPROPERTIES[] = "gazebo_msgs/GetJointProperties";
       if(position_lengthT > position_length)
         this->position = (double*)realloc(this->position, position_lengthT * sizeof(double));
       position_length = position_lengthT;
-      for( uint32_t i = 0; i < position_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_position;
-        u_st_position.base = 0;
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_position = u_st_position.real;
-        offset += sizeof(this->st_position);
-        memcpy( &(this->position[i]), &(this->st_position), sizeof(double));
-      }
+      arrToArray(this->position, inbuffer + offset, position_length);
+      offset += position_length * sizeof(double);
       uint32_t rate_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       rate_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       rate_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -298,24 +226,8 @@ static const char GETJOINTPROPERTIES[] = "gazebo_msgs/GetJointProperties";
       if(rate_lengthT > rate_length)
         this->rate = (double*)realloc(this->rate, rate_lengthT * sizeof(double));
       rate_length = rate_lengthT;
-      for( uint32_t i = 0; i < rate_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_rate;
-        u_st_rate.base = 0;
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_rate.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_rate = u_st_rate.real;
-        offset += sizeof(this->st_rate);
-        memcpy( &(this->rate[i]), &(this->st_rate), sizeof(double));
-      }
+      arrToArray(this->rate, inbuffer + offset, rate_length);
+      offset += rate_length * sizeof(double);
       union {
         bool real;
         uint8_t base;
@@ -341,17 +253,11 @@ static const char GETJOINTPROPERTIES[] = "gazebo_msgs/GetJointProperties";
       int length = 0;
       length += sizeof(this->type);
       length += sizeof(this->damping_length);
-      for( uint32_t i = 0; i < damping_length; i++) {
-        length += sizeof(this->damping[i]);
-      }
+      length += damping_length * sizeof(double);
       length += sizeof(this->position_length);
-      for( uint32_t i = 0; i < position_length; i++) {
-        length += sizeof(this->position[i]);
-      }
+      length += position_length * sizeof(double);
       length += sizeof(this->rate_length);
-      for( uint32_t i = 0; i < rate_length; i++) {
-        length += sizeof(this->rate[i]);
-      }
+      length += rate_length * sizeof(double);
       length += sizeof(this->success);
       uint32_t length_status_message = this->status_message.size();
       length += 4;
@@ -359,56 +265,31 @@ static const char GETJOINTPROPERTIES[] = "gazebo_msgs/GetJointProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("type");
+      writer.value(this->type);
+      writer.raw(',');
+      writer.array("damping", this->damping, this->damping_length);
+      writer.raw(',');
+      writer.array("position", this->position, this->position_length);
+      writer.raw(',');
+      writer.array("rate", this->rate, this->rate_length);
+      writer.raw(',');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_type; ss_type << "\"type\":" << (uint16_t)type <<",";
-      string_echo += ss_type.str();
-      string_echo += "damping:[";
-      for( uint32_t i = 0; i < damping_length; i++) {
-        if( i == (damping_length - 1)) {
-          std::stringstream ss_dampingi; ss_dampingi << damping[i] <<"";
-          string_echo += ss_dampingi.str();
-        } else {
-          std::stringstream ss_dampingi; ss_dampingi << damping[i] <<",";
-          string_echo += ss_dampingi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "position:[";
-      for( uint32_t i = 0; i < position_length; i++) {
-        if( i == (position_length - 1)) {
-          std::stringstream ss_positioni; ss_positioni << position[i] <<"";
-          string_echo += ss_positioni.str();
-        } else {
-          std::stringstream ss_positioni; ss_positioni << position[i] <<",";
-          string_echo += ss_positioni.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "rate:[";
-      for( uint32_t i = 0; i < rate_length; i++) {
-        if( i == (rate_length - 1)) {
-          std::stringstream ss_ratei; ss_ratei << rate[i] <<"";
-          string_echo += ss_ratei.str();
-        } else {
-          std::stringstream ss_ratei; ss_ratei << rate[i] <<",";
-          string_echo += ss_ratei.str();
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETJOINTPROPERTIES; }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/gazebo_msgs/LinkState.h"
 
 namespace tinyros
@@ -96,27 +98,22 @@ static const char GETLINKSTATE[] = "gazebo_msgs/GetLinkState";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("link_name");
+      writer.value(this->link_name);
+      writer.raw(',');
+      writer.key("reference_frame");
+      writer.value(this->reference_frame);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t link_name_pos = link_name.find("\"");
-      while(link_name_pos != std::string::npos){
-        link_name.replace(link_name_pos, 1,"\\\"");
-        link_name_pos = link_name.find("\"", link_name_pos+2);
-      }
-      string_echo += "\"link_name\":\"";
-      string_echo += link_name;
-      string_echo += "\",";
-      std::size_t reference_frame_pos = reference_frame.find("\"");
-      while(reference_frame_pos != std::string::npos){
-        reference_frame.replace(reference_frame_pos, 1,"\\\"");
-        reference_frame_pos = reference_frame.find("\"", reference_frame_pos+2);
-      }
-      string_echo += "\"reference_frame\":\"";
-      string_echo += reference_frame;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETLINKSTATE; }
@@ -212,24 +209,25 @@ static const char GETLINKSTATE[] = "gazebo_msgs/GetLinkState";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("link_state");
+      writer.value(this->link_state);
+      writer.raw(',');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"link_state\":";
-      string_echo += this->link_state.echo();
-      string_echo += ",";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETLINKSTATE; }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -75,19 +77,19 @@ static const char GETMODELPROPERTIES[] = "gazebo_msgs/GetModelProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("model_name");
+      writer.value(this->model_name);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t model_name_pos = model_name.find("\"");
-      while(model_name_pos != std::string::npos){
-        model_name.replace(model_name_pos, 1,"\\\"");
-        model_name_pos = model_name.find("\"", model_name_pos+2);
-      }
-      string_echo += "\"model_name\":\"";
-      string_echo += model_name;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETMODELPROPERTIES; }
@@ -408,139 +410,39 @@ static const char GETMODELPROPERTIES[] = "gazebo_msgs/GetModelProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("parent_model_name");
+      writer.value(this->parent_model_name);
+      writer.raw(',');
+      writer.key("canonical_body_name");
+      writer.value(this->canonical_body_name);
+      writer.raw(',');
+      writer.array("body_names", this->body_names, this->body_names_length);
+      writer.raw(',');
+      writer.array("geom_names", this->geom_names, this->geom_names_length);
+      writer.raw(',');
+      writer.array("joint_names", this->joint_names, this->joint_names_length);
+      writer.raw(',');
+      writer.array("child_model_names", this->child_model_names, this->child_model_names_length);
+      writer.raw(',');
+      writer.key("is_static");
+      writer.value(this->is_static);
+      writer.raw(',');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t parent_model_name_pos = parent_model_name.find("\"");
-      while(parent_model_name_pos != std::string::npos){
-        parent_model_name.replace(parent_model_name_pos, 1,"\\\"");
-        parent_model_name_pos = parent_model_name.find("\"", parent_model_name_pos+2);
-      }
-      string_echo += "\"parent_model_name\":\"";
-      string_echo += parent_model_name;
-      string_echo += "\",";
-      std::size_t canonical_body_name_pos = canonical_body_name.find("\"");
-      while(canonical_body_name_pos != std::string::npos){
-        canonical_body_name.replace(canonical_body_name_pos, 1,"\\\"");
-        canonical_body_name_pos = canonical_body_name.find("\"", canonical_body_name_pos+2);
-      }
-      string_echo += "\"canonical_body_name\":\"";
-      string_echo += canonical_body_name;
-      string_echo += "\",";
-      string_echo += "body_names:[";
-      for( uint32_t i = 0; i < body_names_length; i++) {
-        if( i == (body_names_length - 1)) {
-          std::stringstream ss_body_namesi; ss_body_namesi << "\"";
-          string_echo += ss_body_namesi.str();
-          std::size_t body_namesi_pos = body_names[i].find("\"");
-          while(body_namesi_pos != std::string::npos){
-            body_names[i].replace(body_namesi_pos, 1,"\\\"");
-            body_namesi_pos = body_names[i].find("\"", body_namesi_pos+2);
-          }
-          string_echo += body_names[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_body_namesi; ss_body_namesi << "\"";
-          string_echo += ss_body_namesi.str();
-          std::size_t body_namesi_pos = body_names[i].find("\"");
-          while(body_namesi_pos != std::string::npos){
-            body_names[i].replace(body_namesi_pos, 1,"\\\"");
-            body_namesi_pos = body_names[i].find("\"", body_namesi_pos+2);
-          }
-          string_echo += body_names[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "geom_names:[";
-      for( uint32_t i = 0; i < geom_names_length; i++) {
-        if( i == (geom_names_length - 1)) {
-          std::stringstream ss_geom_namesi; ss_geom_namesi << "\"";
-          string_echo += ss_geom_namesi.str();
-          std::size_t geom_namesi_pos = geom_names[i].find("\"");
-          while(geom_namesi_pos != std::string::npos){
-            geom_names[i].replace(geom_namesi_pos, 1,"\\\"");
-            geom_namesi_pos = geom_names[i].find("\"", geom_namesi_pos+2);
-          }
-          string_echo += geom_names[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_geom_namesi; ss_geom_namesi << "\"";
-          string_echo += ss_geom_namesi.str();
-          std::size_t geom_namesi_pos = geom_names[i].find("\"");
-          while(geom_namesi_pos != std::string::npos){
-            geom_names[i].replace(geom_namesi_pos, 1,"\\\"");
-            geom_namesi_pos = geom_names[i].find("\"", geom_namesi_pos+2);
-          }
-          string_echo += geom_names[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "joint_names:[";
-      for( uint32_t i = 0; i < joint_names_length; i++) {
-        if( i == (joint_names_length - 1)) {
-          std::stringstream ss_joint_namesi; ss_joint_namesi << "\"";
-          string_echo += ss_joint_namesi.str();
-          std::size_t joint_namesi_pos = joint_names[i].find("\"");
-          while(joint_namesi_pos != std::string::npos){
-            joint_names[i].replace(joint_namesi_pos, 1,"\\\"");
-            joint_namesi_pos = joint_names[i].find("\"", joint_namesi_pos+2);
-          }
-          string_echo += joint_names[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_joint_namesi; ss_joint_namesi << "\"";
-          string_echo += ss_joint_namesi.str();
-          std::size_t joint_namesi_pos = joint_names[i].find("\"");
-          while(joint_namesi_pos != std::string::npos){
-            joint_names[i].replace(joint_namesi_pos, 1,"\\\"");
-            joint_namesi_pos = joint_names[i].find("\"", joint_namesi_pos+2);
-          }
-          string_echo += joint_names[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "child_model_names:[";
-      for( uint32_t i = 0; i < child_model_names_length; i++) {
-        if( i == (child_model_names_length - 1)) {
-          std::stringstream ss_child_model_namesi; ss_child_model_namesi << "\"";
-          string_echo += ss_child_model_namesi.str();
-          std::size_t child_model_namesi_pos = child_model_names[i].find("\"");
-          while(child_model_namesi_pos != std::string::npos){
-            child_model_names[i].replace(child_model_namesi_pos, 1,"\\\"");
-            child_model_namesi_pos = child_model_names[i].find("\"", child_model_namesi_pos+2);
-          }
-          string_echo += child_model_names[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_child_model_namesi; ss_child_model_namesi << "\"";
-          string_echo += ss_child_model_namesi.str();
-          std::size_t child_model_namesi_pos = child_model_names[i].find("\"");
-          while(child_model_namesi_pos != std::string::npos){
-            child_model_names[i].replace(child_model_namesi_pos, 1,"\\\"");
-            child_model_namesi_pos = child_model_names[i].find("\"", child_model_namesi_pos+2);
-          }
-          string_echo += child_model_names[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_is_static; ss_is_static << "\"is_static\":" << is_static <<",";
-      string_echo += ss_is_static.str();
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETMODELPROPERTIES; }
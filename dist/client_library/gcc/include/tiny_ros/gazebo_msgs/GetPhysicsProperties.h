@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
 #include "tiny_ros/gazebo_msgs/ODEPhysics.h"
 
@@ -57,11 +59,17 @@ static const char GETPHYSICSPROPERTIES[] = "gazebo_msgs/GetPhysicsProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETPHYSICSPROPERTIES; }
@@ -248,33 +256,37 @@ static const char GETPHYSICSPROPERTIES[] = "gazebo_msgs/GetPhysicsProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("time_step");
+      writer.value(this->time_step);
+      writer.raw(',');
+      writer.key("pause");
+      writer.value(this->pause);
+      writer.raw(',');
+      writer.key("max_update_rate");
+      writer.value(this->max_update_rate);
+      writer.raw(',');
+      writer.key("gravity");
+      writer.value(this->gravity);
+      writer.raw(',');
+      writer.key("ode_config");
+      writer.value(this->ode_config);
+      writer.raw(',');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_time_step; ss_time_step << "\"time_step\":" << time_step <<",";
-      string_echo += ss_time_step.str();
-      std::stringstream ss_pause; ss_pause << "\"pause\":" << pause <<",";
-      string_echo += ss_pause.str();
-      std::stringstream ss_max_update_rate; ss_max_update_rate << "\"max_update_rate\":" << max_update_rate <<",";
-      string_echo += ss_max_update_rate.str();
-      string_echo += "\"gravity\":";
-      string_echo += this->gravity.echo();
-      string_echo += ",";
-      string_echo += "\"ode_config\":";
-      string_echo += this->ode_config.echo();
-      string_echo += ",";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETPHYSICSPROPERTIES; }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -55,11 +57,17 @@ static const char GETWORLDPROPERTIES[] = "gazebo_msgs/GetWorldProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETWORLDPROPERTIES; }
@@ -244,50 +252,30 @@ static const char GETWORLDPROPERTIES[] = "gazebo_msgs/GetWorldProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("sim_time");
+      writer.value(this->sim_time);
+      writer.raw(',');
+      writer.array("model_names", this->model_names, this->model_names_length);
+      writer.raw(',');
+      writer.key("rendering_enabled");
+      writer.value(this->rendering_enabled);
+      writer.raw(',');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_sim_time; ss_sim_time << "\"sim_time\":" << sim_time <<",";
-      string_echo += ss_sim_time.str();
-      string_echo += "model_names:[";
-      for( uint32_t i = 0; i < model_names_length; i++) {
-        if( i == (model_names_length - 1)) {
-          std::stringstream ss_model_namesi; ss_model_namesi << "\"";
-          string_echo += ss_model_namesi.str();
-          std::size_t model_namesi_pos = model_names[i].find("\"");
-          while(model_namesi_pos != std::string::npos){
-            model_names[i].replace(model_namesi_pos, 1,"\\\"");
-            model_namesi_pos = model_names[i].find("\"", model_namesi_pos+2);
-          }
-          string_echo += model_names[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_model_namesi; ss_model_namesi << "\"";
-          string_echo += ss_model_namesi.str();
-          std::size_t model_namesi_pos = model_names[i].find("\"");
-          while(model_namesi_pos != std::string::npos){
-            model_names[i].replace(model_namesi_pos, 1,"\\\"");
-            model_namesi_pos = model_names[i].find("\"", model_namesi_pos+2);
-          }
-          string_echo += model_names[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_rendering_enabled; ss_rendering_enabled << "\"rendering_enabled\":" << rendering_enabled <<",";
-      string_echo += ss_rendering_enabled.str();
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETWORLDPROPERTIES; }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -75,19 +77,19 @@ static const char JOINTREQUEST[] = "gazebo_msgs/JointRequest";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("joint_name");
+      writer.value(this->joint_name);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t joint_name_pos = joint_name.find("\"");
-      while(joint_name_pos != std::string::npos){
-        joint_name.replace(joint_name_pos, 1,"\\\"");
-        joint_name_pos = joint_name.find("\"", joint_name_pos+2);
-      }
-      string_echo += "\"joint_name\":\"";
-      string_echo += joint_name;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return JOINTREQUEST; }
@@ -138,11 +140,17 @@ static const char JOINTREQUEST[] = "gazebo_msgs/JointRequest";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return JOINTREQUEST; }
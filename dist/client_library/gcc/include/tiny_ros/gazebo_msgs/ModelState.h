@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Pose.h"
 #include "tiny_ros/geometry_msgs/Twist.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace gazebo_msgs
 {
 
+  class ModelStateView;
+
   class ModelState : public tinyros::Msg
   {
     public:
@@ -93,38 +97,76 @@ namespace gazebo_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("model_name");
+      writer.value(this->model_name);
+      writer.raw(',');
+      writer.key("pose");
+      writer.value(this->pose);
+      writer.raw(',');
+      writer.key("twist");
+      writer.value(this->twist);
+      writer.raw(',');
+      writer.key("reference_frame");
+      writer.value(this->reference_frame);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t model_name_pos = model_name.find("\"");
-      while(model_name_pos != std::string::npos){
-        model_name.replace(model_name_pos, 1,"\\\"");
-        model_name_pos = model_name.find("\"", model_name_pos+2);
-      }
-      string_echo += "\"model_name\":\"";
-      string_echo += model_name;
-      string_echo += "\",";
-      string_echo += "\"pose\":";
-      string_echo += this->pose.echo();
-      string_echo += ",";
-      string_echo += "\"twist\":";
-      string_echo += this->twist.echo();
-      string_echo += ",";
-      std::size_t reference_frame_pos = reference_frame.find("\"");
-      while(reference_frame_pos != std::string::npos){
-        reference_frame.replace(reference_frame_pos, 1,"\\\"");
-        reference_frame_pos = reference_frame.find("\"", reference_frame_pos+2);
-      }
-      string_echo += "\"reference_frame\":\"";
-      string_echo += reference_frame;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "gazebo_msgs/ModelState"; }
     virtual std::string getMD5(){ return "dee4d802363b4d6bd1ed61e20c2c4635"; }
+    typedef ModelStateView View;
+
+  };
+
+  /* ModelState read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ModelStateView
+  {
+    public:
+    typedef ModelState MsgType;
+
+    ModelStateView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(4); }
+
+    tinyros::StringView model_name() const { return tinyros::StringView(buffer_ + 0); }
+    tinyros::geometry_msgs::PoseView pose() const { return tinyros::geometry_msgs::PoseView(buffer_ + fieldOffset(1)); }
+    tinyros::geometry_msgs::TwistView twist() const { return tinyros::geometry_msgs::TwistView(buffer_ + fieldOffset(2)); }
+    tinyros::StringView reference_frame() const { return tinyros::StringView(buffer_ + fieldOffset(3)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = tinyros::geometry_msgs::PoseView(p).serializedLength(); break;
+          case 2: length = tinyros::geometry_msgs::TwistView(p).serializedLength(); break;
+          case 3: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[5];
+    mutable uint32_t known_;
   };
 
 }
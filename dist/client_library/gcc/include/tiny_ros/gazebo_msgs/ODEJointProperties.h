@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace gazebo_msgs
 {
 
+  class ODEJointPropertiesView;
+
   class ODEJointProperties : public tinyros::Msg
   {
     public:
@@ -79,211 +83,71 @@ namespace gazebo_msgs
       *(outbuffer + offset + 2) = (this->damping_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->damping_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->damping_length);
-      for( uint32_t i = 0; i < damping_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_dampingi;
-        u_dampingi.real = this->damping[i];
-        *(outbuffer + offset + 0) = (u_dampingi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_dampingi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_dampingi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_dampingi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_dampingi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_dampingi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_dampingi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_dampingi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->damping[i]);
-      }
+      arrayToArr(outbuffer + offset, this->damping, damping_length);
+      offset += damping_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->hiStop_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->hiStop_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->hiStop_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->hiStop_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->hiStop_length);
-      for( uint32_t i = 0; i < hiStop_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_hiStopi;
-        u_hiStopi.real = this->hiStop[i];
-        *(outbuffer + offset + 0) = (u_hiStopi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_hiStopi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_hiStopi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_hiStopi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_hiStopi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_hiStopi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_hiStopi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_hiStopi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->hiStop[i]);
-      }
+      arrayToArr(outbuffer + offset, this->hiStop, hiStop_length);
+      offset += hiStop_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->loStop_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->loStop_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->loStop_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->loStop_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->loStop_length);
-      for( uint32_t i = 0; i < loStop_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_loStopi;
-        u_loStopi.real = this->loStop[i];
-        *(outbuffer + offset + 0) = (u_loStopi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_loStopi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_loStopi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_loStopi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_loStopi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_loStopi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_loStopi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_loStopi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->loStop[i]);
-      }
+      arrayToArr(outbuffer + offset, this->loStop, loStop_length);
+      offset += loStop_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->erp_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->erp_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->erp_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->erp_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->erp_length);
-      for( uint32_t i = 0; i < erp_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_erpi;
-        u_erpi.real = this->erp[i];
-        *(outbuffer + offset + 0) = (u_erpi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_erpi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_erpi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_erpi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_erpi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_erpi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_erpi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_erpi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->erp[i]);
-      }
+      arrayToArr(outbuffer + offset, this->erp, erp_length);
+      offset += erp_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->cfm_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->cfm_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->cfm_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->cfm_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->cfm_length);
-      for( uint32_t i = 0; i < cfm_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_cfmi;
-        u_cfmi.real = this->cfm[i];
-        *(outbuffer + offset + 0) = (u_cfmi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_cfmi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_cfmi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_cfmi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_cfmi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_cfmi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_cfmi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_cfmi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->cfm[i]);
-      }
+      arrayToArr(outbuffer + offset, this->cfm, cfm_length);
+      offset += cfm_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->stop_erp_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->stop_erp_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->stop_erp_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->stop_erp_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->stop_erp_length);
-      for( uint32_t i = 0; i < stop_erp_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_stop_erpi;
-        u_stop_erpi.real = this->stop_erp[i];
-        *(outbuffer + offset + 0) = (u_stop_erpi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_stop_erpi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_stop_erpi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_stop_erpi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_stop_erpi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_stop_erpi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_stop_erpi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_stop_erpi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->stop_erp[i]);
-      }
+      arrayToArr(outbuffer + offset, this->stop_erp, stop_erp_length);
+      offset += stop_erp_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->stop_cfm_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->stop_cfm_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->stop_cfm_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->stop_cfm_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->stop_cfm_length);
-      for( uint32_t i = 0; i < stop_cfm_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_stop_cfmi;
-        u_stop_cfmi.real = this->stop_cfm[i];
-        *(outbuffer + offset + 0) = (u_stop_cfmi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_stop_cfmi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_stop_cfmi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_stop_cfmi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_stop_cfmi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_stop_cfmi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_stop_cfmi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_stop_cfmi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->stop_cfm[i]);
-      }
+      arrayToArr(outbuffer + offset, this->stop_cfm, stop_cfm_length);
+      offset += stop_cfm_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->fudge_factor_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->fudge_factor_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->fudge_factor_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->fudge_factor_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->fudge_factor_length);
-      for( uint32_t i = 0; i < fudge_factor_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_fudge_factori;
-        u_fudge_factori.real = this->fudge_factor[i];
-        *(outbuffer + offset + 0) = (u_fudge_factori.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_fudge_factori.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_fudge_factori.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_fudge_factori.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_fudge_factori.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_fudge_factori.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_fudge_factori.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_fudge_factori.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->fudge_factor[i]);
-      }
+      arrayToArr(outbuffer + offset, this->fudge_factor, fudge_factor_length);
+      offset += fudge_factor_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->fmax_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->fmax_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->fmax_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->fmax_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->fmax_length);
-      for( uint32_t i = 0; i < fmax_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_fmaxi;
-        u_fmaxi.real = this->fmax[i];
-        *(outbuffer + offset + 0) = (u_fmaxi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_fmaxi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_fmaxi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_fmaxi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_fmaxi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_fmaxi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_fmaxi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_fmaxi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->fmax[i]);
-      }
+      arrayToArr(outbuffer + offset, this->fmax, fmax_length);
+      offset += fmax_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->vel_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->vel_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->vel_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->vel_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->vel_length);
-      for( uint32_t i = 0; i < vel_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_veli;
-        u_veli.real = this->vel[i];
-        *(outbuffer + offset + 0) = (u_veli.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_veli.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_veli.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_veli.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_veli.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_veli.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_veli.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_veli.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->vel[i]);
-      }
+      arrayToArr(outbuffer + offset, this->vel, vel_length);
+      offset += vel_length * sizeof(double);
       return offset;
     }
 
@@ -298,24 +162,8 @@ namespace gazebo_msgs
       if(damping_lengthT > damping_length)
         this->damping = (double*)realloc(this->damping, damping_lengthT * sizeof(double));
       damping_length = damping_lengthT;
-      for( uint32_t i = 0; i < damping_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_damping;
-        u_st_damping.base = 0;
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_damping.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_damping = u_st_damping.real;
-        offset += sizeof(this->st_damping);
-        memcpy( &(this->damping[i]), &(this->st_damping), sizeof(double));
-      }
+      arrToArray(this->damping, inbuffer + offset, damping_length);
+      offset += damping_length * sizeof(double);
       uint32_t hiStop_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       hiStop_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       hiStop_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -324,24 +172,8 @@ namespace gazebo_msgs
       if(hiStop_lengthT > hiStop_length)
         this->hiStop = (double*)realloc(this->hiStop, hiStop_lengthT * sizeof(double));
       hiStop_length = hiStop_lengthT;
-      for( uint32_t i = 0; i < hiStop_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_hiStop;
-        u_st_hiStop.base = 0;
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_hiStop.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_hiStop = u_st_hiStop.real;
-        offset += sizeof(this->st_hiStop);
-        memcpy( &(this->hiStop[i]), &(this->st_hiStop), sizeof(double));
-      }
+      arrToArray(this->hiStop, inbuffer + offset, hiStop_length);
+      offset += hiStop_length * sizeof(double);
       uint32_t loStop_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       loStop_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       loStop_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -350,24 +182,8 @@ namespace gazebo_msgs
       if(loStop_lengthT > loStop_length)
         this->loStop = (double*)realloc(this->loStop, loStop_lengthT * sizeof(double));
       loStop_length = loStop_lengthT;
-      for( uint32_t i = 0; i < loStop_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_loStop;
-        u_st_loStop.base = 0;
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_loStop.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_loStop = u_st_loStop.real;
-        offset += sizeof(this->st_loStop);
-        memcpy( &(this->loStop[i]), &(this->st_loStop), sizeof(double));
-      }
+      arrToArray(this->loStop, inbuffer + offset, loStop_length);
+      offset += loStop_length * sizeof(double);
       uint32_t erp_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       erp_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       erp_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -376,24 +192,8 @@ namespace gazebo_msgs
       if(erp_lengthT > erp_length)
         this->erp = (double*)realloc(this->erp, erp_lengthT * sizeof(double));
       erp_length = erp_lengthT;
-      for( uint32_t i = 0; i < erp_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_erp;
-        u_st_erp.base = 0;
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_erp.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_erp = u_st_erp.real;
-        offset += sizeof(this->st_erp);
-        memcpy( &(this->erp[i]), &(this->st_erp), sizeof(double));
-      }
+      arrToArray(this->erp, inbuffer + offset, erp_length);
+      offset += erp_length * sizeof(double);
       uint32_t cfm_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       cfm_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       cfm_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -402,24 +202,8 @@ namespace gazebo_msgs
       if(cfm_lengthT > cfm_length)
         this->cfm = (double*)realloc(this->cfm, cfm_lengthT * sizeof(double));
       cfm_length = cfm_lengthT;
-      for( uint32_t i = 0; i < cfm_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_cfm;
-        u_st_cfm.base = 0;
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_cfm.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_cfm = u_st_cfm.real;
-        offset += sizeof(this->st_cfm);
-        memcpy( &(this->cfm[i]), &(this->st_cfm), sizeof(double));
-      }
+      arrToArray(this->cfm, inbuffer + offset, cfm_length);
+      offset += cfm_length * sizeof(double);
       uint32_t stop_erp_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       stop_erp_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       stop_erp_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -428,24 +212,8 @@ namespace gazebo_msgs
       if(stop_erp_lengthT > stop_erp_length)
         this->stop_erp = (double*)realloc(this->stop_erp, stop_erp_lengthT * sizeof(double));
       stop_erp_length = stop_erp_lengthT;
-      for( uint32_t i = 0; i < stop_erp_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_stop_erp;
-        u_st_stop_erp.base = 0;
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_stop_erp.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_stop_erp = u_st_stop_erp.real;
-        offset += sizeof(this->st_stop_erp);
-        memcpy( &(this->stop_erp[i]), &(this->st_stop_erp), sizeof(double));
-      }
+      arrToArray(this->stop_erp, inbuffer + offset, stop_erp_length);
+      offset += stop_erp_length * sizeof(double);
       uint32_t stop_cfm_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       stop_cfm_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       stop_cfm_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -454,24 +222,8 @@ namespace gazebo_msgs
       if(stop_cfm_lengthT > stop_cfm_length)
         this->stop_cfm = (double*)realloc(this->stop_cfm, stop_cfm_lengthT * sizeof(double));
       stop_cfm_length = stop_cfm_lengthT;
-      for( uint32_t i = 0; i < stop_cfm_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_stop_cfm;
-        u_st_stop_cfm.base = 0;
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_stop_cfm.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_stop_cfm = u_st_stop_cfm.real;
-        offset += sizeof(this->st_stop_cfm);
-        memcpy( &(this->stop_cfm[i]), &(this->st_stop_cfm), sizeof(double));
-      }
+      arrToArray(this->stop_cfm, inbuffer + offset, stop_cfm_length);
+      offset += stop_cfm_length * sizeof(double);
       uint32_t fudge_factor_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       fudge_factor_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       fudge_factor_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -480,24 +232,8 @@ namespace gazebo_msgs
       if(fudge_factor_lengthT > fudge_factor_length)
         this->fudge_factor = (double*)realloc(this->fudge_factor, fudge_factor_lengthT * sizeof(double));
       fudge_factor_length = fudge_factor_lengthT;
-      for( uint32_t i = 0; i < fudge_factor_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_fudge_factor;
-        u_st_fudge_factor.base = 0;
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_fudge_factor.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_fudge_factor = u_st_fudge_factor.real;
-        offset += sizeof(this->st_fudge_factor);
-        memcpy( &(this->fudge_factor[i]), &(this->st_fudge_factor), sizeof(double));
-      }
+      arrToArray(this->fudge_factor, inbuffer + offset, fudge_factor_length);
+      offset += fudge_factor_length * sizeof(double);
       uint32_t fmax_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       fmax_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       fmax_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -506,24 +242,8 @@ namespace gazebo_msgs
       if(fmax_lengthT > fmax_length)
         this->fmax = (double*)realloc(this->fmax, fmax_lengthT * sizeof(double));
       fmax_length = fmax_lengthT;
-      for( uint32_t i = 0; i < fmax_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_fmax;
-        u_st_fmax.base = 0;
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_fmax.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_fmax = u_st_fmax.real;
-        offset += sizeof(this->st_fmax);
-        memcpy( &(this->fmax[i]), &(this->st_fmax), sizeof(double));
-      }
+      arrToArray(this->fmax, inbuffer + offset, fmax_length);
+      offset += fmax_length * sizeof(double);
       uint32_t vel_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       vel_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       vel_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -532,24 +252,8 @@ namespace gazebo_msgs
       if(vel_lengthT > vel_length)
         this->vel = (double*)realloc(this->vel, vel_lengthT * sizeof(double));
       vel_length = vel_lengthT;
-      for( uint32_t i = 0; i < vel_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_vel;
-        u_st_vel.base = 0;
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_vel.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_vel = u_st_vel.real;
-        offset += sizeof(this->st_vel);
-        memcpy( &(this->vel[i]), &(this->st_vel), sizeof(double));
-      }
+      arrToArray(this->vel, inbuffer + offset, vel_length);
+      offset += vel_length * sizeof(double);
       return offset;
     }
 
@@ -557,168 +261,158 @@ namespace gazebo_msgs
     {
       int length = 0;
       length += sizeof(this->damping_length);
-      for( uint32_t i = 0; i < damping_length; i++) {
-        length += sizeof(this->damping[i]);
-      }
+      length += damping_length * sizeof(double);
       length += sizeof(this->hiStop_length);
-      for( uint32_t i = 0; i < hiStop_length; i++) {
-        length += sizeof(this->hiStop[i]);
-      }
+      length += hiStop_length * sizeof(double);
       length += sizeof(this->loStop_length);
-      for( uint32_t i = 0; i < loStop_length; i++) {
-        length += sizeof(this->loStop[i]);
-      }
+      length += loStop_length * sizeof(double);
       length += sizeof(this->erp_length);
-      for( uint32_t i = 0; i < erp_length; i++) {
-        length += sizeof(this->erp[i]);
-      }
+      length += erp_length * sizeof(double);
       length += sizeof(this->cfm_length);
-      for( uint32_t i = 0; i < cfm_length; i++) {
-        length += sizeof(this->cfm[i]);
-      }
+      length += cfm_length * sizeof(double);
       length += sizeof(this->stop_erp_length);
-      for( uint32_t i = 0; i < stop_erp_length; i++) {
-        length += sizeof(this->stop_erp[i]);
-      }
+      length += stop_erp_length * sizeof(double);
       length += sizeof(this->stop_cfm_length);
-      for( uint32_t i = 0; i < stop_cfm_length; i++) {
-        length += sizeof(this->stop_cfm[i]);
-      }
+      length += stop_cfm_length * sizeof(double);
       length += sizeof(this->fudge_factor_length);
-      for( uint32_t i = 0; i < fudge_factor_length; i++) {
-        length += sizeof(this->fudge_factor[i]);
-      }
+      length += fudge_factor_length * sizeof(double);
       length += sizeof(this->fmax_length);
-      for( uint32_t i = 0; i < fmax_length; i++) {
-        length += sizeof(this->fmax[i]);
-      }
+      length += fmax_length * sizeof(double);
       length += sizeof(this->vel_length);
-      for( uint32_t i = 0; i < vel_length; i++) {
-        length += sizeof(this->vel[i]);
-      }
+      length += vel_length * sizeof(double);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("damping", this->damping, this->damping_length);
+      writer.raw(',');
+      writer.array("hiStop", this->hiStop, this->hiStop_length);
+      writer.raw(',');
+      writer.array("loStop", this->loStop, this->loStop_length);
+      writer.raw(',');
+      writer.array("erp", this->erp, this->erp_length);
+      writer.raw(',');
+      writer.array("cfm", this->cfm, this->cfm_length);
+      writer.raw(',');
+      writer.array("stop_erp", this->stop_erp, this->stop_erp_length);
+      writer.raw(',');
+      writer.array("stop_cfm", this->stop_cfm, this->stop_cfm_length);
+      writer.raw(',');
+      writer.array("fudge_factor", this->fudge_factor, this->fudge_factor_length);
+      writer.raw(',');
+      writer.array("fmax", this->fmax, this->fmax_length);
+      writer.raw(',');
+      writer.array("vel", this->vel, this->vel_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "damping:[";
-      for( uint32_t i = 0; i < damping_length; i++) {
-        if( i == (damping_length - 1)) {
-          std::stringstream ss_dampingi; ss_dampingi << damping[i] <<"";
-          string_echo += ss_dampingi.str();
-        } else {
-          std::stringstream ss_dampingi; ss_dampingi << damping[i] <<",";
-          string_echo += ss_dampingi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "hiStop:[";
-      for( uint32_t i = 0; i < hiStop_length; i++) {
-        if( i == (hiStop_length - 1)) {
-          std::stringstream ss_hiStopi; ss_hiStopi << hiStop[i] <<"";
-          string_echo += ss_hiStopi.str();
-        } else {
-          std::stringstream ss_hiStopi; ss_hiStopi << hiStop[i] <<",";
-          string_echo += ss_hiStopi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "loStop:[";
-      for( uint32_t i = 0; i < loStop_length; i++) {
-        if( i == (loStop_length - 1)) {
-          std::stringstream ss_loStopi; ss_loStopi << loStop[i] <<"";
-          string_echo += ss_loStopi.str();
-        } else {
-          std::stringstream ss_loStopi; ss_loStopi << loStop[i] <<",";
-          string_echo += ss_loStopi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "erp:[";
-      for( uint32_t i = 0; i < erp_length; i++) {
-        if( i == (erp_length - 1)) {
-          std::stringstream ss_erpi; ss_erpi << erp[i] <<"";
-          string_echo += ss_erpi.str();
-        } else {
-          std::stringstream ss_erpi; ss_erpi << erp[i] <<",";
-          string_echo += ss_erpi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "cfm:[";
-      for( uint32_t i = 0; i < cfm_length; i++) {
-        if( i == (cfm_length - 1)) {
-          std::stringstream ss_cfmi; ss_cfmi << cfm[i] <<"";
-          string_echo += ss_cfmi.str();
-        } else {
-          std::stringstream ss_cfmi; ss_cfmi << cfm[i] <<",";
-          string_echo += ss_cfmi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "stop_erp:[";
-      for( uint32_t i = 0; i < stop_erp_length; i++) {
-        if( i == (stop_erp_length - 1)) {
-          std::stringstream ss_stop_erpi; ss_stop_erpi << stop_erp[i] <<"";
-          string_echo += ss_stop_erpi.str();
-        } else {
-          std::stringstream ss_stop_erpi; ss_stop_erpi << stop_erp[i] <<",";
-          string_echo += ss_stop_erpi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "stop_cfm:[";
-      for( uint32_t i = 0; i < stop_cfm_length; i++) {
-        if( i == (stop_cfm_length - 1)) {
-          std::stringstream ss_stop_cfmi; ss_stop_cfmi << stop_cfm[i] <<"";
-          string_echo += ss_stop_cfmi.str();
-        } else {
-          std::stringstream ss_stop_cfmi; ss_stop_cfmi << stop_cfm[i] <<",";
-          string_echo += ss_stop_cfmi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "fudge_factor:[";
-      for( uint32_t i = 0; i < fudge_factor_length; i++) {
-        if( i == (fudge_factor_length - 1)) {
-          std::stringstream ss_fudge_factori; ss_fudge_factori << fudge_factor[i] <<"";
-          string_echo += ss_fudge_factori.str();
-        } else {
-          std::stringstream ss_fudge_factori; ss_fudge_factori << fudge_factor[i] <<",";
-          string_echo += ss_fudge_factori.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "fmax:[";
-      for( uint32_t i = 0; i < fmax_length; i++) {
-        if( i == (fmax_length - 1)) {
-          std::stringstream ss_fmaxi; ss_fmaxi << fmax[i] <<"";
-          string_echo += ss_fmaxi.str();
-        } else {
-          std::stringstream ss_fmaxi; ss_fmaxi << fmax[i] <<",";
-          string_echo += ss_fmaxi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "vel:[";
-      for( uint32_t i = 0; i < vel_length; i++) {
-        if( i == (vel_length - 1)) {
-          std::stringstream ss_veli; ss_veli << vel[i] <<"";
-          string_echo += ss_veli.str();
-        } else {
-          std::stringstream ss_veli; ss_veli << vel[i] <<",";
-          string_echo += ss_veli.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "gazebo_msgs/ODEJointProperties"; }
     virtual std::string getMD5(){ return "a9e264dbf3eff8e202d2bebecf081639"; }
+    typedef ODEJointPropertiesView View;
+
+  };
+
+  /* ODEJointProperties read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ODEJointPropertiesView
+  {
+    public:
+    typedef ODEJointProperties MsgType;
+
+    ODEJointPropertiesView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(10); }
+
+    tinyros::Span<double> damping() const
+    {
+      const unsigned char* p = buffer_ + 0;
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> hiStop() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> loStop() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> erp() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> cfm() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(4);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> stop_erp() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(5);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> stop_cfm() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(6);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> fudge_factor() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(7);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> fmax() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(8);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> vel() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(9);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 3: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 4: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 5: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 6: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 7: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 8: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 9: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[11];
+    mutable uint32_t known_;
   };
 
 }
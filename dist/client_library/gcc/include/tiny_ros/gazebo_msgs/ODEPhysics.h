@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace gazebo_msgs
 {
 
+  class ODEPhysicsView;
+
   class ODEPhysics : public tinyros::Msg
   {
     public:
@@ -37,6 +41,8 @@ namespace gazebo_msgs
       typedef uint32_t _max_contacts_type;
       _max_contacts_type max_contacts;
 
+      static constexpr uint32_t kSerializedSize = 61;
+
     ODEPhysics():
       auto_disable_bodies(0),
       sor_pgs_precon_iters(0),
@@ -53,281 +59,108 @@ namespace gazebo_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        bool real;
-        uint8_t base;
-      } u_auto_disable_bodies;
-      u_auto_disable_bodies.real = this->auto_disable_bodies;
-      *(outbuffer + offset + 0) = (u_auto_disable_bodies.base >> (8 * 0)) & 0xFF;
-      offset += sizeof(this->auto_disable_bodies);
-      *(outbuffer + offset + 0) = (this->sor_pgs_precon_iters >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->sor_pgs_precon_iters >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->sor_pgs_precon_iters >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->sor_pgs_precon_iters >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->sor_pgs_precon_iters);
-      *(outbuffer + offset + 0) = (this->sor_pgs_iters >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->sor_pgs_iters >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->sor_pgs_iters >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->sor_pgs_iters >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->sor_pgs_iters);
-      union {
-        double real;
-        uint64_t base;
-      } u_sor_pgs_w;
-      u_sor_pgs_w.real = this->sor_pgs_w;
-      *(outbuffer + offset + 0) = (u_sor_pgs_w.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_sor_pgs_w.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_sor_pgs_w.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_sor_pgs_w.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_sor_pgs_w.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_sor_pgs_w.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_sor_pgs_w.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_sor_pgs_w.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->sor_pgs_w);
-      union {
-        double real;
-        uint64_t base;
-      } u_sor_pgs_rms_error_tol;
-      u_sor_pgs_rms_error_tol.real = this->sor_pgs_rms_error_tol;
-      *(outbuffer + offset + 0) = (u_sor_pgs_rms_error_tol.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_sor_pgs_rms_error_tol.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_sor_pgs_rms_error_tol.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_sor_pgs_rms_error_tol.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_sor_pgs_rms_error_tol.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_sor_pgs_rms_error_tol.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_sor_pgs_rms_error_tol.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_sor_pgs_rms_error_tol.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->sor_pgs_rms_error_tol);
-      union {
-        double real;
-        uint64_t base;
-      } u_contact_surface_layer;
-      u_contact_surface_layer.real = this->contact_surface_layer;
-      *(outbuffer + offset + 0) = (u_contact_surface_layer.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_contact_surface_layer.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_contact_surface_layer.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_contact_surface_layer.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_contact_surface_layer.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_contact_surface_layer.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_contact_surface_layer.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_contact_surface_layer.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->contact_surface_layer);
-      union {
-        double real;
-        uint64_t base;
-      } u_contact_max_correcting_vel;
-      u_contact_max_correcting_vel.real = this->contact_max_correcting_vel;
-      *(outbuffer + offset + 0) = (u_contact_max_correcting_vel.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_contact_max_correcting_vel.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_contact_max_correcting_vel.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_contact_max_correcting_vel.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_contact_max_correcting_vel.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_contact_max_correcting_vel.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_contact_max_correcting_vel.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_contact_max_correcting_vel.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->contact_max_correcting_vel);
-      union {
-        double real;
-        uint64_t base;
-      } u_cfm;
-      u_cfm.real = this->cfm;
-      *(outbuffer + offset + 0) = (u_cfm.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_cfm.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_cfm.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_cfm.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_cfm.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_cfm.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_cfm.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_cfm.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->cfm);
-      union {
-        double real;
-        uint64_t base;
-      } u_erp;
-      u_erp.real = this->erp;
-      *(outbuffer + offset + 0) = (u_erp.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_erp.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_erp.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_erp.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_erp.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_erp.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_erp.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_erp.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->erp);
-      *(outbuffer + offset + 0) = (this->max_contacts >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->max_contacts >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->max_contacts >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->max_contacts >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->max_contacts);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->auto_disable_bodies, 1);
+      arrayToArr(outbuffer + 1, &this->sor_pgs_precon_iters, 1);
+      arrayToArr(outbuffer + 5, &this->sor_pgs_iters, 1);
+      arrayToArr(outbuffer + 9, &this->sor_pgs_w, 1);
+      arrayToArr(outbuffer + 17, &this->sor_pgs_rms_error_tol, 1);
+      arrayToArr(outbuffer + 25, &this->contact_surface_layer, 1);
+      arrayToArr(outbuffer + 33, &this->contact_max_correcting_vel, 1);
+      arrayToArr(outbuffer + 41, &this->cfm, 1);
+      arrayToArr(outbuffer + 49, &this->erp, 1);
+      arrayToArr(outbuffer + 57, &this->max_contacts, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        bool real;
-        uint8_t base;
-      } u_auto_disable_bodies;
-      u_auto_disable_bodies.base = 0;
-      u_auto_disable_bodies.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      this->auto_disable_bodies = u_auto_disable_bodies.real;
-      offset += sizeof(this->auto_disable_bodies);
-      this->sor_pgs_precon_iters =  ((uint32_t) (*(inbuffer + offset)));
-      this->sor_pgs_precon_iters |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->sor_pgs_precon_iters |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->sor_pgs_precon_iters |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->sor_pgs_precon_iters);
-      this->sor_pgs_iters =  ((uint32_t) (*(inbuffer + offset)));
-      this->sor_pgs_iters |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->sor_pgs_iters |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->sor_pgs_iters |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->sor_pgs_iters);
-      union {
-        double real;
-        uint64_t base;
-      } u_sor_pgs_w;
-      u_sor_pgs_w.base = 0;
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_sor_pgs_w.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->sor_pgs_w = u_sor_pgs_w.real;
-      offset += sizeof(this->sor_pgs_w);
-      union {
-        double real;
-        uint64_t base;
-      } u_sor_pgs_rms_error_tol;
-      u_sor_pgs_rms_error_tol.base = 0;
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_sor_pgs_rms_error_tol.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->sor_pgs_rms_error_tol = u_sor_pgs_rms_error_tol.real;
-      offset += sizeof(this->sor_pgs_rms_error_tol);
-      union {
-        double real;
-        uint64_t base;
-      } u_contact_surface_layer;
-      u_contact_surface_layer.base = 0;
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_contact_surface_layer.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->contact_surface_layer = u_contact_surface_layer.real;
-      offset += sizeof(this->contact_surface_layer);
-      union {
-        double real;
-        uint64_t base;
-      } u_contact_max_correcting_vel;
-      u_contact_max_correcting_vel.base = 0;
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_contact_max_correcting_vel.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->contact_max_correcting_vel = u_contact_max_correcting_vel.real;
-      offset += sizeof(this->contact_max_correcting_vel);
-      union {
-        double real;
-        uint64_t base;
-      } u_cfm;
-      u_cfm.base = 0;
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_cfm.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->cfm = u_cfm.real;
-      offset += sizeof(this->cfm);
-      union {
-        double real;
-        uint64_t base;
-      } u_erp;
-      u_erp.base = 0;
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_erp.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->erp = u_erp.real;
-      offset += sizeof(this->erp);
-      this->max_contacts =  ((uint32_t) (*(inbuffer + offset)));
-      this->max_contacts |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->max_contacts |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->max_contacts |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->max_contacts);
-      return offset;
+      arrToArray(&this->auto_disable_bodies, inbuffer + 0, 1);
+      arrToArray(&this->sor_pgs_precon_iters, inbuffer + 1, 1);
+      arrToArray(&this->sor_pgs_iters, inbuffer + 5, 1);
+      arrToArray(&this->sor_pgs_w, inbuffer + 9, 1);
+      arrToArray(&this->sor_pgs_rms_error_tol, inbuffer + 17, 1);
+      arrToArray(&this->contact_surface_layer, inbuffer + 25, 1);
+      arrToArray(&this->contact_max_correcting_vel, inbuffer + 33, 1);
+      arrToArray(&this->cfm, inbuffer + 41, 1);
+      arrToArray(&this->erp, inbuffer + 49, 1);
+      arrToArray(&this->max_contacts, inbuffer + 57, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->auto_disable_bodies);
-      length += sizeof(this->sor_pgs_precon_iters);
-      length += sizeof(this->sor_pgs_iters);
-      length += sizeof(this->sor_pgs_w);
-      length += sizeof(this->sor_pgs_rms_error_tol);
-      length += sizeof(this->contact_surface_layer);
-      length += sizeof(this->contact_max_correcting_vel);
-      length += sizeof(this->cfm);
-      length += sizeof(this->erp);
-      length += sizeof(this->max_contacts);
-      return length;
+      writer.raw('{');
+      writer.key("auto_disable_bodies");
+      writer.value(this->auto_disable_bodies);
+      writer.raw(',');
+      writer.key("sor_pgs_precon_iters");
+      writer.value(this->sor_pgs_precon_iters);
+      writer.raw(',');
+      writer.key("sor_pgs_iters");
+      writer.value(this->sor_pgs_iters);
+      writer.raw(',');
+      writer.key("sor_pgs_w");
+      writer.value(this->sor_pgs_w);
+      writer.raw(',');
+      writer.key("sor_pgs_rms_error_tol");
+      writer.value(this->sor_pgs_rms_error_tol);
+      writer.raw(',');
+      writer.key("contact_surface_layer");
+      writer.value(this->contact_surface_layer);
+      writer.raw(',');
+      writer.key("contact_max_correcting_vel");
+      writer.value(this->contact_max_correcting_vel);
+      writer.raw(',');
+      writer.key("cfm");
+      writer.value(this->cfm);
+      writer.raw(',');
+      writer.key("erp");
+      writer.value(this->erp);
+      writer.raw(',');
+      writer.key("max_contacts");
+      writer.value(this->max_contacts);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_auto_disable_bodies; ss_auto_disable_bodies << "\"auto_disable_bodies\":" << auto_disable_bodies <<",";
-      string_echo += ss_auto_disable_bodies.str();
-      std::stringstream ss_sor_pgs_precon_iters; ss_sor_pgs_precon_iters << "\"sor_pgs_precon_iters\":" << sor_pgs_precon_iters <<",";
-      string_echo += ss_sor_pgs_precon_iters.str();
-      std::stringstream ss_sor_pgs_iters; ss_sor_pgs_iters << "\"sor_pgs_iters\":" << sor_pgs_iters <<",";
-      string_echo += ss_sor_pgs_iters.str();
-      std::stringstream ss_sor_pgs_w; ss_sor_pgs_w << "\"sor_pgs_w\":" << sor_pgs_w <<",";
-      string_echo += ss_sor_pgs_w.str();
-      std::stringstream ss_sor_pgs_rms_error_tol; ss_sor_pgs_rms_error_tol << "\"sor_pgs_rms_error_tol\":" << sor_pgs_rms_error_tol <<",";
-      string_echo += ss_sor_pgs_rms_error_tol.str();
-      std::stringstream ss_contact_surface_layer; ss_contact_surface_layer << "\"contact_surface_layer\":" << contact_surface_layer <<",";
-      string_echo += ss_contact_surface_layer.str();
-      std::stringstream ss_contact_max_correcting_vel; ss_contact_max_correcting_vel << "\"contact_max_correcting_vel\":" << contact_max_correcting_vel <<",";
-      string_echo += ss_contact_max_correcting_vel.str();
-      std::stringstream ss_cfm; ss_cfm << "\"cfm\":" << cfm <<",";
-      string_echo += ss_cfm.str();
-      std::stringstream ss_erp; ss_erp << "\"erp\":" << erp <<",";
-      string_echo += ss_erp.str();
-      std::stringstream ss_max_contacts; ss_max_contacts << "\"max_contacts\":" << max_contacts <<"";
-      string_echo += ss_max_contacts.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "gazebo_msgs/ODEPhysics"; }
     virtual std::string getMD5(){ return "67a077e58362b50f63dc189c25d01418"; }
+    typedef ODEPhysicsView View;
+
+  };
+
+  /* ODEPhysics read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ODEPhysicsView
+  {
+    public:
+    typedef ODEPhysics MsgType;
+
+    ODEPhysicsView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 61; }
+
+    bool auto_disable_bodies() const { return tinyros::viewRead<bool>(buffer_ + 0); }
+    uint32_t sor_pgs_precon_iters() const { return tinyros::viewRead<uint32_t>(buffer_ + 1); }
+    uint32_t sor_pgs_iters() const { return tinyros::viewRead<uint32_t>(buffer_ + 5); }
+    double sor_pgs_w() const { return tinyros::viewRead<double>(buffer_ + 9); }
+    double sor_pgs_rms_error_tol() const { return tinyros::viewRead<double>(buffer_ + 17); }
+    double contact_surface_layer() const { return tinyros::viewRead<double>(buffer_ + 25); }
+    double contact_max_correcting_vel() const { return tinyros::viewRead<double>(buffer_ + 33); }
+    double cfm() const { return tinyros::viewRead<double>(buffer_ + 41); }
+    double erp() const { return tinyros::viewRead<double>(buffer_ + 49); }
+    uint32_t max_contacts() const { return tinyros::viewRead<uint32_t>(buffer_ + 57); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
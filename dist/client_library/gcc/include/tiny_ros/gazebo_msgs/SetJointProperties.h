@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/gazebo_msgs/ODEJointProperties.h"
 
 namespace tinyros
@@ -82,22 +84,22 @@ static const char SETJOINTPROPERTIES[] = "gazebo_msgs/SetJointProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("joint_name");
+      writer.value(this->joint_name);
+      writer.raw(',');
+      writer.key("ode_joint_config");
+      writer.value(this->ode_joint_config);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t joint_name_pos = joint_name.find("\"");
-      while(joint_name_pos != std::string::npos){
-        joint_name.replace(joint_name_pos, 1,"\\\"");
-        joint_name_pos = joint_name.find("\"", joint_name_pos+2);
-      }
-      string_echo += "\"joint_name\":\"";
-      string_echo += joint_name;
-      string_echo += "\",";
-      string_echo += "\"ode_joint_config\":";
-      string_echo += this->ode_joint_config.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETJOINTPROPERTIES; }
@@ -187,21 +189,22 @@ static const char SETJOINTPROPERTIES[] = "gazebo_msgs/SetJointProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETJOINTPROPERTIES; }
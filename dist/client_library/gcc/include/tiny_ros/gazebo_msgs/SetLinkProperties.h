@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Pose.h"
 
 namespace tinyros
@@ -332,38 +334,46 @@ static const char SETLINKPROPERTIES[] = "gazebo_msgs/SetLinkProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("link_name");
+      writer.value(this->link_name);
+      writer.raw(',');
+      writer.key("com");
+      writer.value(this->com);
+      writer.raw(',');
+      writer.key("gravity_mode");
+      writer.value(this->gravity_mode);
+      writer.raw(',');
+      writer.key("mass");
+      writer.value(this->mass);
+      writer.raw(',');
+      writer.key("ixx");
+      writer.value(this->ixx);
+      writer.raw(',');
+      writer.key("ixy");
+      writer.value(this->ixy);
+      writer.raw(',');
+      writer.key("ixz");
+      writer.value(this->ixz);
+      writer.raw(',');
+      writer.key("iyy");
+      writer.value(this->iyy);
+      writer.raw(',');
+      writer.key("iyz");
+      writer.value(this->iyz);
+      writer.raw(',');
+      writer.key("izz");
+      writer.value(this->izz);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t link_name_pos = link_name.find("\"");
-      while(link_name_pos != std::string::npos){
-        link_name.replace(link_name_pos, 1,"\\\"");
-        link_name_pos = link_name.find("\"", link_name_pos+2);
-      }
-      string_echo += "\"link_name\":\"";
-      string_echo += link_name;
-      string_echo += "\",";
-      string_echo += "\"com\":";
-      string_echo += this->com.echo();
-      string_echo += ",";
-      std::stringstream ss_gravity_mode; ss_gravity_mode << "\"gravity_mode\":" << gravity_mode <<",";
-      string_echo += ss_gravity_mode.str();
-      std::stringstream ss_mass; ss_mass << "\"mass\":" << mass <<",";
-      string_echo += ss_mass.str();
-      std::stringstream ss_ixx; ss_ixx << "\"ixx\":" << ixx <<",";
-      string_echo += ss_ixx.str();
-      std::stringstream ss_ixy; ss_ixy << "\"ixy\":" << ixy <<",";
-      string_echo += ss_ixy.str();
-      std::stringstream ss_ixz; ss_ixz << "\"ixz\":" << ixz <<",";
-      string_echo += ss_ixz.str();
-      std::stringstream ss_iyy; ss_iyy << "\"iyy\":" << iyy <<",";
-      string_echo += ss_iyy.str();
-      std::stringstream ss_iyz; ss_iyz << "\"iyz\":" << iyz <<",";
-      string_echo += ss_iyz.str();
-      std::stringstream ss_izz; ss_izz << "\"izz\":" << izz <<"";
-      string_echo += ss_izz.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETLINKPROPERTIES; }
@@ -453,21 +463,22 @@ static const char SETLINKPROPERTIES[] = "gazebo_msgs/SetLinkProperties";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETLINKPROPERTIES; }
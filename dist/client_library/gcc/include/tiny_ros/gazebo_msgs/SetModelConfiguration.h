@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -78,22 +80,8 @@ static const char SETMODELCONFIGURATION[] = "gazebo_msgs/SetModelConfiguration";
       *(outbuffer + offset + 2) = (this->joint_positions_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->joint_positions_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->joint_positions_length);
-      for( uint32_t i = 0; i < joint_positions_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_joint_positionsi;
-        u_joint_positionsi.real = this->joint_positions[i];
-        *(outbuffer + offset + 0) = (u_joint_positionsi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_joint_positionsi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_joint_positionsi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_joint_positionsi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_joint_positionsi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_joint_positionsi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_joint_positionsi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_joint_positionsi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->joint_positions[i]);
-      }
+      arrayToArr(outbuffer + offset, this->joint_positions, joint_positions_length);
+      offset += joint_positions_length * sizeof(double);
       return offset;
     }
 
@@ -151,24 +139,8 @@ static const char SETMODELCONFIGURATION[] = "gazebo_msgs/SetModelConfiguration";
       if(joint_positions_lengthT > joint_positions_length)
         this->joint_positions = (double*)realloc(this->joint_positions, joint_positions_lengthT * sizeof(double));
       joint_positions_length = joint_positions_lengthT;
-      for( uint32_t i = 0; i < joint_positions_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_joint_positions;
-        u_st_joint_positions.base = 0;
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_joint_positions.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_joint_positions = u_st_joint_positions.real;
-        offset += sizeof(this->st_joint_positions);
-        memcpy( &(this->joint_positions[i]), &(this->st_joint_positions), sizeof(double));
-      }
+      arrToArray(this->joint_positions, inbuffer + offset, joint_positions_length);
+      offset += joint_positions_length * sizeof(double);
       return offset;
     }
 
@@ -188,69 +160,30 @@ static const char SETMODELCONFIGURATION[] = "gazebo_msgs/SetModelConfiguration";
         length += length_joint_namesi;
       }
       length += sizeof(this->joint_positions_length);
-      for( uint32_t i = 0; i < joint_positions_length; i++) {
-        length += sizeof(this->joint_positions[i]);
-      }
+      length += joint_positions_length * sizeof(double);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("model_name");
+      writer.value(this->model_name);
+      writer.raw(',');
+      writer.key("urdf_param_name");
+      writer.value(this->urdf_param_name);
+      writer.raw(',');
+      writer.array("joint_names", this->joint_names, this->joint_names_length);
+      writer.raw(',');
+      writer.array("joint_positions", this->joint_positions, this->joint_positions_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t model_name_pos = model_name.find("\"");
-      while(model_name_pos != std::string::npos){
-        model_name.replace(model_name_pos, 1,"\\\"");
-        model_name_pos = model_name.find("\"", model_name_pos+2);
-      }
-      string_echo += "\"model_name\":\"";
-      string_echo += model_name;
-      string_echo += "\",";
-      std::size_t urdf_param_name_pos = urdf_param_name.find("\"");
-      while(urdf_param_name_pos != std::string::npos){
-        urdf_param_name.replace(urdf_param_name_pos, 1,"\\\"");
-        urdf_param_name_pos = urdf_param_name.find("\"", urdf_param_name_pos+2);
-      }
-      string_echo += "\"urdf_param_name\":\"";
-      string_echo += urdf_param_name;
-      string_echo += "\",";
-      string_echo += "joint_names:[";
-      for( uint32_t i = 0; i < joint_names_length; i++) {
-        if( i == (joint_names_length - 1)) {
-          std::stringstream ss_joint_namesi; ss_joint_namesi << "\"";
-          string_echo += ss_joint_namesi.str();
-          std::size_t joint_namesi_pos = joint_names[i].find("\"");
-          while(joint_namesi_pos != std::string::npos){
-            joint_names[i].replace(joint_namesi_pos, 1,"\\\"");
-            joint_namesi_pos = joint_names[i].find("\"", joint_namesi_pos+2);
-          }
-          string_echo += joint_names[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_joint_namesi; ss_joint_namesi << "\"";
-          string_echo += ss_joint_namesi.str();
-          std::size_t joint_namesi_pos = joint_names[i].find("\"");
-          while(joint_namesi_pos != std::string::npos){
-            joint_names[i].replace(joint_namesi_pos, 1,"\\\"");
-            joint_namesi_pos = joint_names[i].find("\"", joint_namesi_pos+2);
-          }
-          string_echo += joint_names[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "joint_positions:[";
-      for( uint32_t i = 0; i < joint_positions_length; i++) {
-        if( i == (joint_positions_length - 1)) {
-          std::stringstream ss_joint_positionsi; ss_joint_positionsi << joint_positions[i] <<"";
-          string_echo += ss_joint_positionsi.str();
-        } else {
-          std::stringstream ss_joint_positionsi; ss_joint_positionsi << joint_positions[i] <<",";
-          string_echo += ss_joint_positionsi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETMODELCONFIGURATION; }
@@ -340,21 +273,22 @@ static const char SETMODELCONFIGURATION[] = "gazebo_msgs/SetModelConfiguration";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETMODELCONFIGURATION; }
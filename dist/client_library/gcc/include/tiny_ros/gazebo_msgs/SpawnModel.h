@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Pose.h"
 
 namespace tinyros
@@ -142,46 +144,31 @@ static const char SPAWNMODEL[] = "gazebo_msgs/SpawnModel";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("model_name");
+      writer.value(this->model_name);
+      writer.raw(',');
+      writer.key("model_xml");
+      writer.value(this->model_xml);
+      writer.raw(',');
+      writer.key("robot_namespace");
+      writer.value(this->robot_namespace);
+      writer.raw(',');
+      writer.key("initial_pose");
+      writer.value(this->initial_pose);
+      writer.raw(',');
+      writer.key("reference_frame");
+      writer.value(this->reference_frame);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t model_name_pos = model_name.find("\"");
-      while(model_name_pos != std::string::npos){
-        model_name.replace(model_name_pos, 1,"\\\"");
-        model_name_pos = model_name.find("\"", model_name_pos+2);
-      }
-      string_echo += "\"model_name\":\"";
-      string_echo += model_name;
-      string_echo += "\",";
-      std::size_t model_xml_pos = model_xml.find("\"");
-      while(model_xml_pos != std::string::npos){
-        model_xml.replace(model_xml_pos, 1,"\\\"");
-        model_xml_pos = model_xml.find("\"", model_xml_pos+2);
-      }
-      string_echo += "\"model_xml\":\"";
-      string_echo += model_xml;
-      string_echo += "\",";
-      std::size_t robot_namespace_pos = robot_namespace.find("\"");
-      while(robot_namespace_pos != std::string::npos){
-        robot_namespace.replace(robot_namespace_pos, 1,"\\\"");
-        robot_namespace_pos = robot_namespace.find("\"", robot_namespace_pos+2);
-      }
-      string_echo += "\"robot_namespace\":\"";
-      string_echo += robot_namespace;
-      string_echo += "\",";
-      string_echo += "\"initial_pose\":";
-      string_echo += this->initial_pose.echo();
-      string_echo += ",";
-      std::size_t reference_frame_pos = reference_frame.find("\"");
-      while(reference_frame_pos != std::string::npos){
-        reference_frame.replace(reference_frame_pos, 1,"\\\"");
-        reference_frame_pos = reference_frame.find("\"", reference_frame_pos+2);
-      }
-      string_echo += "\"reference_frame\":\"";
-      string_echo += reference_frame;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SPAWNMODEL; }
@@ -271,21 +258,22 @@ static const char SPAWNMODEL[] = "gazebo_msgs/SpawnModel";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw(',');
+      writer.key("status_message");
+      writer.value(this->status_message);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<",";
-      string_echo += ss_success.str();
-      std::size_t status_message_pos = status_message.find("\"");
-      while(status_message_pos != std::string::npos){
-        status_message.replace(status_message_pos, 1,"\\\"");
-        status_message_pos = status_message.find("\"", status_message_pos+2);
-      }
-      string_echo += "\"status_message\":\"";
-      string_echo += status_message;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SPAWNMODEL; }
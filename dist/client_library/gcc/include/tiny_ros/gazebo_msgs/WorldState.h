@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Pose.h"
 #include "tiny_ros/geometry_msgs/Twist.h"
@@ -17,6 +19,8 @@ namespace tinyros
 namespace gazebo_msgs
 {
 
+  class WorldStateView;
+
   class WorldState : public tinyros::Msg
   {
     public:
@@ -179,77 +183,93 @@ namespace gazebo_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("name", this->name, this->name_length);
+      writer.raw(',');
+      writer.array("pose", this->pose, this->pose_length);
+      writer.raw(',');
+      writer.array("twist", this->twist, this->twist_length);
+      writer.raw(',');
+      writer.array("wrench", this->wrench, this->wrench_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "name:[";
-      for( uint32_t i = 0; i < name_length; i++) {
-        if( i == (name_length - 1)) {
-          std::stringstream ss_namei; ss_namei << "\"";
-          string_echo += ss_namei.str();
-          std::size_t namei_pos = name[i].find("\"");
-          while(namei_pos != std::string::npos){
-            name[i].replace(namei_pos, 1,"\\\"");
-            namei_pos = name[i].find("\"", namei_pos+2);
-          }
-          string_echo += name[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_namei; ss_namei << "\"";
-          string_echo += ss_namei.str();
-          std::size_t namei_pos = name[i].find("\"");
-          while(namei_pos != std::string::npos){
-            name[i].replace(namei_pos, 1,"\\\"");
-            namei_pos = name[i].find("\"", namei_pos+2);
-          }
-          string_echo += name[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "pose:[";
-      for( uint32_t i = 0; i < pose_length; i++) {
-        if( i == (pose_length - 1)) {
-          string_echo += this->pose[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->pose[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "twist:[";
-      for( uint32_t i = 0; i < twist_length; i++) {
-        if( i == (twist_length - 1)) {
-          string_echo += this->twist[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->twist[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "wrench:[";
-      for( uint32_t i = 0; i < wrench_length; i++) {
-        if( i == (wrench_length - 1)) {
-          string_echo += this->wrench[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->wrench[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "gazebo_msgs/WorldState"; }
     virtual std::string getMD5(){ return "0e1997127271c4d021f99645c28f1c09"; }
+    typedef WorldStateView View;
+
+  };
+
+  /* WorldState read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class WorldStateView
+  {
+    public:
+    typedef WorldState MsgType;
+
+    WorldStateView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(5); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::ViewList<tinyros::StringView> name() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<tinyros::geometry_msgs::PoseView> pose() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::Span<tinyros::geometry_msgs::PoseView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<tinyros::geometry_msgs::TwistView> twist() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::Span<tinyros::geometry_msgs::TwistView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<tinyros::geometry_msgs::WrenchView> wrench() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(4);
+      return tinyros::Span<tinyros::geometry_msgs::WrenchView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 56; break;
+          case 3: length = 4 + tinyros::viewRead<uint32_t>(p) * 48; break;
+          case 4: length = 4 + tinyros::viewRead<uint32_t>(p) * 48; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[6];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Accel.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class AccelStampedView;
+
   class AccelStamped : public tinyros::Msg
   {
     public:
@@ -53,22 +57,66 @@ namespace geometry_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("accel");
+      writer.value(this->accel);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"accel\":";
-      string_echo += this->accel.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/AccelStamped"; }
     virtual std::string getMD5(){ return "fa35432963826361a1073b1df905a559"; }
+    typedef AccelStampedView View;
+
+  };
+
+  /* AccelStamped read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class AccelStampedView
+  {
+    public:
+    typedef AccelStamped MsgType;
+
+    AccelStampedView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::geometry_msgs::AccelView accel() const { return tinyros::geometry_msgs::AccelView(buffer_ + fieldOffset(1)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::geometry_msgs::AccelView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
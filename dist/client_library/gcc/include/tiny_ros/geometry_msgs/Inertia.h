@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class InertiaView;
+
   class Inertia : public tinyros::Msg
   {
     public:
@@ -34,6 +38,8 @@ namespace geometry_msgs
       typedef double _izz_type;
       _izz_type izz;
 
+      static constexpr uint32_t kSerializedSize = 80;
+
     Inertia():
       m(0),
       com(),
@@ -48,262 +54,96 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        double real;
-        uint64_t base;
-      } u_m;
-      u_m.real = this->m;
-      *(outbuffer + offset + 0) = (u_m.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_m.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_m.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_m.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_m.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_m.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_m.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_m.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->m);
-      offset += this->com.serialize(outbuffer + offset);
-      union {
-        double real;
-        uint64_t base;
-      } u_ixx;
-      u_ixx.real = this->ixx;
-      *(outbuffer + offset + 0) = (u_ixx.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_ixx.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_ixx.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_ixx.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_ixx.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_ixx.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_ixx.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_ixx.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->ixx);
-      union {
-        double real;
-        uint64_t base;
-      } u_ixy;
-      u_ixy.real = this->ixy;
-      *(outbuffer + offset + 0) = (u_ixy.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_ixy.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_ixy.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_ixy.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_ixy.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_ixy.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_ixy.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_ixy.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->ixy);
-      union {
-        double real;
-        uint64_t base;
-      } u_ixz;
-      u_ixz.real = this->ixz;
-      *(outbuffer + offset + 0) = (u_ixz.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_ixz.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_ixz.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_ixz.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_ixz.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_ixz.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_ixz.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_ixz.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->ixz);
-      union {
-        double real;
-        uint64_t base;
-      } u_iyy;
-      u_iyy.real = this->iyy;
-      *(outbuffer + offset + 0) = (u_iyy.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_iyy.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_iyy.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_iyy.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_iyy.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_iyy.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_iyy.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_iyy.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->iyy);
-      union {
-        double real;
-        uint64_t base;
-      } u_iyz;
-      u_iyz.real = this->iyz;
-      *(outbuffer + offset + 0) = (u_iyz.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_iyz.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_iyz.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_iyz.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_iyz.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_iyz.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_iyz.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_iyz.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->iyz);
-      union {
-        double real;
-        uint64_t base;
-      } u_izz;
-      u_izz.real = this->izz;
-      *(outbuffer + offset + 0) = (u_izz.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_izz.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_izz.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_izz.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_izz.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_izz.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_izz.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_izz.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->izz);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->m, 1);
+      this->com.serialize(outbuffer + 8);
+      arrayToArr(outbuffer + 32, &this->ixx, 1);
+      arrayToArr(outbuffer + 40, &this->ixy, 1);
+      arrayToArr(outbuffer + 48, &this->ixz, 1);
+      arrayToArr(outbuffer + 56, &this->iyy, 1);
+      arrayToArr(outbuffer + 64, &this->iyz, 1);
+      arrayToArr(outbuffer + 72, &this->izz, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        double real;
-        uint64_t base;
-      } u_m;
-      u_m.base = 0;
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_m.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->m = u_m.real;
-      offset += sizeof(this->m);
-      offset += this->com.deserialize(inbuffer + offset);
-      union {
-        double real;
-        uint64_t base;
-      } u_ixx;
-      u_ixx.base = 0;
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_ixx.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->ixx = u_ixx.real;
-      offset += sizeof(this->ixx);
-      union {
-        double real;
-        uint64_t base;
-      } u_ixy;
-      u_ixy.base = 0;
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_ixy.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->ixy = u_ixy.real;
-      offset += sizeof(this->ixy);
-      union {
-        double real;
-        uint64_t base;
-      } u_ixz;
-      u_ixz.base = 0;
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_ixz.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->ixz = u_ixz.real;
-      offset += sizeof(this->ixz);
-      union {
-        double real;
-        uint64_t base;
-      } u_iyy;
-      u_iyy.base = 0;
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_iyy.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->iyy = u_iyy.real;
-      offset += sizeof(this->iyy);
-      union {
-        double real;
-        uint64_t base;
-      } u_iyz;
-      u_iyz.base = 0;
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_iyz.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->iyz = u_iyz.real;
-      offset += sizeof(this->iyz);
-      union {
-        double real;
-        uint64_t base;
-      } u_izz;
-      u_izz.base = 0;
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_izz.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->izz = u_izz.real;
-      offset += sizeof(this->izz);
-      return offset;
+      arrToArray(&this->m, inbuffer + 0, 1);
+      this->com.deserialize(inbuffer + 8);
+      arrToArray(&this->ixx, inbuffer + 32, 1);
+      arrToArray(&this->ixy, inbuffer + 40, 1);
+      arrToArray(&this->ixz, inbuffer + 48, 1);
+      arrToArray(&this->iyy, inbuffer + 56, 1);
+      arrToArray(&this->iyz, inbuffer + 64, 1);
+      arrToArray(&this->izz, inbuffer + 72, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->m);
-      length += this->com.serializedLength();
-      length += sizeof(this->ixx);
-      length += sizeof(this->ixy);
-      length += sizeof(this->ixz);
-      length += sizeof(this->iyy);
-      length += sizeof(this->iyz);
-      length += sizeof(this->izz);
-      return length;
+      writer.raw('{');
+      writer.key("m");
+      writer.value(this->m);
+      writer.raw(',');
+      writer.key("com");
+      writer.value(this->com);
+      writer.raw(',');
+      writer.key("ixx");
+      writer.value(this->ixx);
+      writer.raw(',');
+      writer.key("ixy");
+      writer.value(this->ixy);
+      writer.raw(',');
+      writer.key("ixz");
+      writer.value(this->ixz);
+      writer.raw(',');
+      writer.key("iyy");
+      writer.value(this->iyy);
+      writer.raw(',');
+      writer.key("iyz");
+      writer.value(this->iyz);
+      writer.raw(',');
+      writer.key("izz");
+      writer.value(this->izz);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_m; ss_m << "\"m\":" << m <<",";
-      string_echo += ss_m.str();
-      string_echo += "\"com\":";
-      string_echo += this->com.echo();
-      string_echo += ",";
-      std::stringstream ss_ixx; ss_ixx << "\"ixx\":" << ixx <<",";
-      string_echo += ss_ixx.str();
-      std::stringstream ss_ixy; ss_ixy << "\"ixy\":" << ixy <<",";
-      string_echo += ss_ixy.str();
-      std::stringstream ss_ixz; ss_ixz << "\"ixz\":" << ixz <<",";
-      string_echo += ss_ixz.str();
-      std::stringstream ss_iyy; ss_iyy << "\"iyy\":" << iyy <<",";
-      string_echo += ss_iyy.str();
-      std::stringstream ss_iyz; ss_iyz << "\"iyz\":" << iyz <<",";
-      string_echo += ss_iyz.str();
-      std::stringstream ss_izz; ss_izz << "\"izz\":" << izz <<"";
-      string_echo += ss_izz.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Inertia"; }
     virtual std::string getMD5(){ return "9116c935782bc29999dad1927624dff0"; }
+    typedef InertiaView View;
+
+  };
+
+  /* Inertia read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class InertiaView
+  {
+    public:
+    typedef Inertia MsgType;
+
+    InertiaView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 80; }
+
+    double m() const { return tinyros::viewRead<double>(buffer_ + 0); }
+    tinyros::geometry_msgs::Vector3View com() const { return tinyros::geometry_msgs::Vector3View(buffer_ + 8); }
+    double ixx() const { return tinyros::viewRead<double>(buffer_ + 32); }
+    double ixy() const { return tinyros::viewRead<double>(buffer_ + 40); }
+    double ixz() const { return tinyros::viewRead<double>(buffer_ + 48); }
+    double iyy() const { return tinyros::viewRead<double>(buffer_ + 56); }
+    double iyz() const { return tinyros::viewRead<double>(buffer_ + 64); }
+    double izz() const { return tinyros::viewRead<double>(buffer_ + 72); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace geometry_msgs
 {
 
+  class Point32View;
+
   class Point32 : public tinyros::Msg
   {
     public:
@@ -23,6 +27,8 @@ namespace geometry_msgs
       typedef float _z_type;
       _z_type z;
 
+      static constexpr uint32_t kSerializedSize = 12;
+
     Point32():
       x(0),
       y(0),
@@ -32,104 +38,66 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        float real;
-        uint32_t base;
-      } u_x;
-      u_x.real = this->x;
-      *(outbuffer + offset + 0) = (u_x.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_x.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_x.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_x.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->x);
-      union {
-        float real;
-        uint32_t base;
-      } u_y;
-      u_y.real = this->y;
-      *(outbuffer + offset + 0) = (u_y.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_y.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_y.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_y.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->y);
-      union {
-        float real;
-        uint32_t base;
-      } u_z;
-      u_z.real = this->z;
-      *(outbuffer + offset + 0) = (u_z.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_z.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_z.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_z.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->z);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->x, 1);
+      arrayToArr(outbuffer + 4, &this->y, 1);
+      arrayToArr(outbuffer + 8, &this->z, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        float real;
-        uint32_t base;
-      } u_x;
-      u_x.base = 0;
-      u_x.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_x.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_x.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_x.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->x = u_x.real;
-      offset += sizeof(this->x);
-      union {
-        float real;
-        uint32_t base;
-      } u_y;
-      u_y.base = 0;
-      u_y.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_y.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_y.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_y.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->y = u_y.real;
-      offset += sizeof(this->y);
-      union {
-        float real;
-        uint32_t base;
-      } u_z;
-      u_z.base = 0;
-      u_z.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_z.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_z.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_z.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->z = u_z.real;
-      offset += sizeof(this->z);
-      return offset;
+      arrToArray(&this->x, inbuffer + 0, 1);
+      arrToArray(&this->y, inbuffer + 4, 1);
+      arrToArray(&this->z, inbuffer + 8, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->x);
-      length += sizeof(this->y);
-      length += sizeof(this->z);
-      return length;
+      writer.raw('{');
+      writer.key("x");
+      writer.value(this->x);
+      writer.raw(',');
+      writer.key("y");
+      writer.value(this->y);
+      writer.raw(',');
+      writer.key("z");
+      writer.value(this->z);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_x; ss_x << "\"x\":" << x <<",";
-      string_echo += ss_x.str();
-      std::stringstream ss_y; ss_y << "\"y\":" << y <<",";
-      string_echo += ss_y.str();
-      std::stringstream ss_z; ss_z << "\"z\":" << z <<"";
-      string_echo += ss_z.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Point32"; }
     virtual std::string getMD5(){ return "b17f2230f465fce816e3773d7d59a841"; }
+    typedef Point32View View;
+
+  };
+
+  /* Point32 read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class Point32View
+  {
+    public:
+    typedef Point32 MsgType;
+
+    Point32View(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 12; }
+
+    float x() const { return tinyros::viewRead<float>(buffer_ + 0); }
+    float y() const { return tinyros::viewRead<float>(buffer_ + 4); }
+    float z() const { return tinyros::viewRead<float>(buffer_ + 8); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Point32.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class PolygonView;
+
   class Polygon : public tinyros::Msg
   {
     public:
@@ -69,27 +73,64 @@ namespace geometry_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("points", this->points, this->points_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "points:[";
-      for( uint32_t i = 0; i < points_length; i++) {
-        if( i == (points_length - 1)) {
-          string_echo += this->points[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->points[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Polygon"; }
     virtual std::string getMD5(){ return "f94a78a947b7879954bd14397db4bc9d"; }
+    typedef PolygonView View;
+
+  };
+
+  /* Polygon read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PolygonView
+  {
+    public:
+    typedef Polygon MsgType;
+
+    PolygonView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(1); }
+
+    tinyros::Span<tinyros::geometry_msgs::Point32View> points() const
+    {
+      const unsigned char* p = buffer_ + 0;
+      return tinyros::Span<tinyros::geometry_msgs::Point32View>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = 4 + tinyros::viewRead<uint32_t>(p) * 12; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[2];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Point.h"
 #include "tiny_ros/geometry_msgs/Quaternion.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class PoseView;
+
   class Pose : public tinyros::Msg
   {
     public:
@@ -23,6 +27,8 @@ namespace geometry_msgs
       typedef tinyros::geometry_msgs::Quaternion _orientation_type;
       _orientation_type orientation;
 
+      static constexpr uint32_t kSerializedSize = 56;
+
     Pose():
       position(),
       orientation()
@@ -31,44 +37,60 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      offset += this->position.serialize(outbuffer + offset);
-      offset += this->orientation.serialize(outbuffer + offset);
-      return offset;
+      this->position.serialize(outbuffer + 0);
+      this->orientation.serialize(outbuffer + 24);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      offset += this->position.deserialize(inbuffer + offset);
-      offset += this->orientation.deserialize(inbuffer + offset);
-      return offset;
+      this->position.deserialize(inbuffer + 0);
+      this->orientation.deserialize(inbuffer + 24);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += this->position.serializedLength();
-      length += this->orientation.serializedLength();
-      return length;
+      writer.raw('{');
+      writer.key("position");
+      writer.value(this->position);
+      writer.raw(',');
+      writer.key("orientation");
+      writer.value(this->orientation);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"position\":";
-      string_echo += this->position.echo();
-      string_echo += ",";
-      string_echo += "\"orientation\":";
-      string_echo += this->orientation.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Pose"; }
     virtual std::string getMD5(){ return "0b42fb88be8cac0efa6e446e13befcae"; }
+    typedef PoseView View;
+
+  };
+
+  /* Pose read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PoseView
+  {
+    public:
+    typedef Pose MsgType;
+
+    PoseView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 56; }
+
+    tinyros::geometry_msgs::PointView position() const { return tinyros::geometry_msgs::PointView(buffer_ + 0); }
+    tinyros::geometry_msgs::QuaternionView orientation() const { return tinyros::geometry_msgs::QuaternionView(buffer_ + 24); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace geometry_msgs
 {
 
+  class Pose2DView;
+
   class Pose2D : public tinyros::Msg
   {
     public:
@@ -23,6 +27,8 @@ namespace geometry_msgs
       typedef double _theta_type;
       _theta_type theta;
 
+      static constexpr uint32_t kSerializedSize = 24;
+
     Pose2D():
       x(0),
       y(0),
@@ -32,128 +38,66 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        double real;
-        uint64_t base;
-      } u_x;
-      u_x.real = this->x;
-      *(outbuffer + offset + 0) = (u_x.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_x.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_x.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_x.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_x.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_x.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_x.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_x.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->x);
-      union {
-        double real;
-        uint64_t base;
-      } u_y;
-      u_y.real = this->y;
-      *(outbuffer + offset + 0) = (u_y.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_y.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_y.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_y.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_y.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_y.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_y.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_y.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->y);
-      union {
-        double real;
-        uint64_t base;
-      } u_theta;
-      u_theta.real = this->theta;
-      *(outbuffer + offset + 0) = (u_theta.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_theta.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_theta.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_theta.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_theta.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_theta.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_theta.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_theta.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->theta);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->x, 1);
+      arrayToArr(outbuffer + 8, &this->y, 1);
+      arrayToArr(outbuffer + 16, &this->theta, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        double real;
-        uint64_t base;
-      } u_x;
-      u_x.base = 0;
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->x = u_x.real;
-      offset += sizeof(this->x);
-      union {
-        double real;
-        uint64_t base;
-      } u_y;
-      u_y.base = 0;
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->y = u_y.real;
-      offset += sizeof(this->y);
-      union {
-        double real;
-        uint64_t base;
-      } u_theta;
-      u_theta.base = 0;
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_theta.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->theta = u_theta.real;
-      offset += sizeof(this->theta);
-      return offset;
+      arrToArray(&this->x, inbuffer + 0, 1);
+      arrToArray(&this->y, inbuffer + 8, 1);
+      arrToArray(&this->theta, inbuffer + 16, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->x);
-      length += sizeof(this->y);
-      length += sizeof(this->theta);
-      return length;
+      writer.raw('{');
+      writer.key("x");
+      writer.value(this->x);
+      writer.raw(',');
+      writer.key("y");
+      writer.value(this->y);
+      writer.raw(',');
+      writer.key("theta");
+      writer.value(this->theta);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_x; ss_x << "\"x\":" << x <<",";
-      string_echo += ss_x.str();
-      std::stringstream ss_y; ss_y << "\"y\":" << y <<",";
-      string_echo += ss_y.str();
-      std::stringstream ss_theta; ss_theta << "\"theta\":" << theta <<"";
-      string_echo += ss_theta.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Pose2D"; }
     virtual std::string getMD5(){ return "509f362ff66c4d3df21020fa7c01f8c6"; }
+    typedef Pose2DView View;
+
+  };
+
+  /* Pose2D read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class Pose2DView
+  {
+    public:
+    typedef Pose2D MsgType;
+
+    Pose2DView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 24; }
+
+    double x() const { return tinyros::viewRead<double>(buffer_ + 0); }
+    double y() const { return tinyros::viewRead<double>(buffer_ + 8); }
+    double theta() const { return tinyros::viewRead<double>(buffer_ + 16); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
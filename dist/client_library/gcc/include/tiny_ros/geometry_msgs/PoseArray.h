@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Pose.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class PoseArrayView;
+
   class PoseArray : public tinyros::Msg
   {
     public:
@@ -76,30 +80,69 @@ namespace geometry_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("poses", this->poses, this->poses_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "poses:[";
-      for( uint32_t i = 0; i < poses_length; i++) {
-        if( i == (poses_length - 1)) {
-          string_echo += this->poses[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->poses[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/PoseArray"; }
     virtual std::string getMD5(){ return "184f43246f3bc9cb5d0613694e6641a6"; }
+    typedef PoseArrayView View;
+
+  };
+
+  /* PoseArray read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PoseArrayView
+  {
+    public:
+    typedef PoseArray MsgType;
+
+    PoseArrayView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::Span<tinyros::geometry_msgs::PoseView> poses() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<tinyros::geometry_msgs::PoseView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 56; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Pose.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class PoseWithCovarianceView;
+
   class PoseWithCovariance : public tinyros::Msg
   {
     public:
@@ -21,6 +25,8 @@ namespace geometry_msgs
       _pose_type pose;
       double covariance[36];
 
+      static constexpr uint32_t kSerializedSize = 344;
+
     PoseWithCovariance():
       pose(),
       covariance()
@@ -29,85 +35,59 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      offset += this->pose.serialize(outbuffer + offset);
-      for( uint32_t i = 0; i < 36; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_covariancei;
-        u_covariancei.real = this->covariance[i];
-        *(outbuffer + offset + 0) = (u_covariancei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_covariancei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_covariancei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_covariancei.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_covariancei.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_covariancei.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_covariancei.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_covariancei.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->covariance[i]);
-      }
-      return offset;
+      this->pose.serialize(outbuffer + 0);
+      arrayToArr(outbuffer + 56, this->covariance, 36);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      offset += this->pose.deserialize(inbuffer + offset);
-      for( uint32_t i = 0; i < 36; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_covariancei;
-        u_covariancei.base = 0;
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->covariance[i] = u_covariancei.real;
-        offset += sizeof(this->covariance[i]);
-      }
-      return offset;
+      this->pose.deserialize(inbuffer + 0);
+      arrToArray(this->covariance, inbuffer + 56, 36);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += this->pose.serializedLength();
-      for( uint32_t i = 0; i < 36; i++) {
-        length += sizeof(this->covariance[i]);
-      }
-      return length;
+      writer.raw('{');
+      writer.key("pose");
+      writer.value(this->pose);
+      writer.raw(',');
+      writer.array("covariance", this->covariance, 36);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"pose\":";
-      string_echo += this->pose.echo();
-      string_echo += ",";
-      string_echo += "covariance:[";
-      for( uint32_t i = 0; i < 36; i++) {
-        if( i == (36 - 1)) {
-          std::stringstream ss_covariancei; ss_covariancei << covariance[i] <<"";
-          string_echo += ss_covariancei.str();
-        } else {
-          std::stringstream ss_covariancei; ss_covariancei << covariance[i] <<",";
-          string_echo += ss_covariancei.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/PoseWithCovariance"; }
     virtual std::string getMD5(){ return "054c6283d50e78f8d9358aaaee5f4c1b"; }
+    typedef PoseWithCovarianceView View;
+
+  };
+
+  /* PoseWithCovariance read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PoseWithCovarianceView
+  {
+    public:
+    typedef PoseWithCovariance MsgType;
+
+    PoseWithCovarianceView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 344; }
+
+    tinyros::geometry_msgs::PoseView pose() const { return tinyros::geometry_msgs::PoseView(buffer_ + 0); }
+    tinyros::Span<double> covariance() const { return tinyros::Span<double>(buffer_ + 56, 36); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
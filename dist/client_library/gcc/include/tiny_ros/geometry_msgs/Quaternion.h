@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace geometry_msgs
 {
 
+  class QuaternionView;
+
   class Quaternion : public tinyros::Msg
   {
     public:
@@ -25,6 +29,8 @@ namespace geometry_msgs
       typedef double _w_type;
       _w_type w;
 
+      static constexpr uint32_t kSerializedSize = 32;
+
     Quaternion():
       x(0),
       y(0),
@@ -35,160 +41,72 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        double real;
-        uint64_t base;
-      } u_x;
-      u_x.real = this->x;
-      *(outbuffer + offset + 0) = (u_x.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_x.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_x.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_x.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_x.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_x.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_x.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_x.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->x);
-      union {
-        double real;
-        uint64_t base;
-      } u_y;
-      u_y.real = this->y;
-      *(outbuffer + offset + 0) = (u_y.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_y.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_y.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_y.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_y.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_y.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_y.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_y.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->y);
-      union {
-        double real;
-        uint64_t base;
-      } u_z;
-      u_z.real = this->z;
-      *(outbuffer + offset + 0) = (u_z.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_z.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_z.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_z.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_z.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_z.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_z.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_z.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->z);
-      union {
-        double real;
-        uint64_t base;
-      } u_w;
-      u_w.real = this->w;
-      *(outbuffer + offset + 0) = (u_w.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_w.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_w.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_w.base >> (8 * 3)) & 0xFF;
-      *(outbuffer + offset + 4) = (u_w.base >> (8 * 4)) & 0xFF;
-      *(outbuffer + offset + 5) = (u_w.base >> (8 * 5)) & 0xFF;
-      *(outbuffer + offset + 6) = (u_w.base >> (8 * 6)) & 0xFF;
-      *(outbuffer + offset + 7) = (u_w.base >> (8 * 7)) & 0xFF;
-      offset += sizeof(this->w);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->x, 1);
+      arrayToArr(outbuffer + 8, &this->y, 1);
+      arrayToArr(outbuffer + 16, &this->z, 1);
+      arrayToArr(outbuffer + 24, &this->w, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        double real;
-        uint64_t base;
-      } u_x;
-      u_x.base = 0;
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_x.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->x = u_x.real;
-      offset += sizeof(this->x);
-      union {
-        double real;
-        uint64_t base;
-      } u_y;
-      u_y.base = 0;
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_y.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->y = u_y.real;
-      offset += sizeof(this->y);
-      union {
-        double real;
-        uint64_t base;
-      } u_z;
-      u_z.base = 0;
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_z.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->z = u_z.real;
-      offset += sizeof(this->z);
-      union {
-        double real;
-        uint64_t base;
-      } u_w;
-      u_w.base = 0;
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-      u_w.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-      this->w = u_w.real;
-      offset += sizeof(this->w);
-      return offset;
+      arrToArray(&this->x, inbuffer + 0, 1);
+      arrToArray(&this->y, inbuffer + 8, 1);
+      arrToArray(&this->z, inbuffer + 16, 1);
+      arrToArray(&this->w, inbuffer + 24, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->x);
-      length += sizeof(this->y);
-      length += sizeof(this->z);
-      length += sizeof(this->w);
-      return length;
+      writer.raw('{');
+      writer.key("x");
+      writer.value(this->x);
+      writer.raw(',');
+      writer.key("y");
+      writer.value(this->y);
+      writer.raw(',');
+      writer.key("z");
+      writer.value(this->z);
+      writer.raw(',');
+      writer.key("w");
+      writer.value(this->w);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_x; ss_x << "\"x\":" << x <<",";
-      string_echo += ss_x.str();
-      std::stringstream ss_y; ss_y << "\"y\":" << y <<",";
-      string_echo += ss_y.str();
-      std::stringstream ss_z; ss_z << "\"z\":" << z <<",";
-      string_echo += ss_z.str();
-      std::stringstream ss_w; ss_w << "\"w\":" << w <<"";
-      string_echo += ss_w.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Quaternion"; }
     virtual std::string getMD5(){ return "175c1571887d10ebed42ba6c042ddd88"; }
+    typedef QuaternionView View;
+
+  };
+
+  /* Quaternion read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class QuaternionView
+  {
+    public:
+    typedef Quaternion MsgType;
+
+    QuaternionView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 32; }
+
+    double x() const { return tinyros::viewRead<double>(buffer_ + 0); }
+    double y() const { return tinyros::viewRead<double>(buffer_ + 8); }
+    double z() const { return tinyros::viewRead<double>(buffer_ + 16); }
+    double w() const { return tinyros::viewRead<double>(buffer_ + 24); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
 #include "tiny_ros/geometry_msgs/Quaternion.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class TransformView;
+
   class Transform : public tinyros::Msg
   {
     public:
@@ -23,6 +27,8 @@ namespace geometry_msgs
       typedef tinyros::geometry_msgs::Quaternion _rotation_type;
       _rotation_type rotation;
 
+      static constexpr uint32_t kSerializedSize = 56;
+
     Transform():
       translation(),
       rotation()
@@ -31,44 +37,60 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      offset += this->translation.serialize(outbuffer + offset);
-      offset += this->rotation.serialize(outbuffer + offset);
-      return offset;
+      this->translation.serialize(outbuffer + 0);
+      this->rotation.serialize(outbuffer + 24);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      offset += this->translation.deserialize(inbuffer + offset);
-      offset += this->rotation.deserialize(inbuffer + offset);
-      return offset;
+      this->translation.deserialize(inbuffer + 0);
+      this->rotation.deserialize(inbuffer + 24);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += this->translation.serializedLength();
-      length += this->rotation.serializedLength();
-      return length;
+      writer.raw('{');
+      writer.key("translation");
+      writer.value(this->translation);
+      writer.raw(',');
+      writer.key("rotation");
+      writer.value(this->rotation);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"translation\":";
-      string_echo += this->translation.echo();
-      string_echo += ",";
-      string_echo += "\"rotation\":";
-      string_echo += this->rotation.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Transform"; }
     virtual std::string getMD5(){ return "2526ee1b1cc2e723e386c3c1b048ba72"; }
+    typedef TransformView View;
+
+  };
+
+  /* Transform read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TransformView
+  {
+    public:
+    typedef Transform MsgType;
+
+    TransformView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 56; }
+
+    tinyros::geometry_msgs::Vector3View translation() const { return tinyros::geometry_msgs::Vector3View(buffer_ + 0); }
+    tinyros::geometry_msgs::QuaternionView rotation() const { return tinyros::geometry_msgs::QuaternionView(buffer_ + 24); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
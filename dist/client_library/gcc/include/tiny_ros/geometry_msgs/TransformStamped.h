@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Transform.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class TransformStampedView;
+
   class TransformStamped : public tinyros::Msg
   {
     public:
@@ -73,30 +77,71 @@ namespace geometry_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("child_frame_id");
+      writer.value(this->child_frame_id);
+      writer.raw(',');
+      writer.key("transform");
+      writer.value(this->transform);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::size_t child_frame_id_pos = child_frame_id.find("\"");
-      while(child_frame_id_pos != std::string::npos){
-        child_frame_id.replace(child_frame_id_pos, 1,"\\\"");
-        child_frame_id_pos = child_frame_id.find("\"", child_frame_id_pos+2);
-      }
-      string_echo += "\"child_frame_id\":\"";
-      string_echo += child_frame_id;
-      string_echo += "\",";
-      string_echo += "\"transform\":";
-      string_echo += this->transform.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/TransformStamped"; }
     virtual std::string getMD5(){ return "e46d447d8e8afc726d6013a3ae4146dd"; }
+    typedef TransformStampedView View;
+
+  };
+
+  /* TransformStamped read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TransformStampedView
+  {
+    public:
+    typedef TransformStamped MsgType;
+
+    TransformStampedView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::StringView child_frame_id() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+    tinyros::geometry_msgs::TransformView transform() const { return tinyros::geometry_msgs::TransformView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = tinyros::geometry_msgs::TransformView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class TwistView;
+
   class Twist : public tinyros::Msg
   {
     public:
@@ -22,6 +26,8 @@ namespace geometry_msgs
       typedef tinyros::geometry_msgs::Vector3 _angular_type;
       _angular_type angular;
 
+      static constexpr uint32_t kSerializedSize = 48;
+
     Twist():
       linear(),
       angular()
@@ -30,44 +36,60 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      offset += this->linear.serialize(outbuffer + offset);
-      offset += this->angular.serialize(outbuffer + offset);
-      return offset;
+      this->linear.serialize(outbuffer + 0);
+      this->angular.serialize(outbuffer + 24);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      offset += this->linear.deserialize(inbuffer + offset);
-      offset += this->angular.deserialize(inbuffer + offset);
-      return offset;
+      this->linear.deserialize(inbuffer + 0);
+      this->angular.deserialize(inbuffer + 24);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += this->linear.serializedLength();
-      length += this->angular.serializedLength();
-      return length;
+      writer.raw('{');
+      writer.key("linear");
+      writer.value(this->linear);
+      writer.raw(',');
+      writer.key("angular");
+      writer.value(this->angular);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"linear\":";
-      string_echo += this->linear.echo();
-      string_echo += ",";
-      string_echo += "\"angular\":";
-      string_echo += this->angular.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Twist"; }
     virtual std::string getMD5(){ return "29e7e4839b73f684ad08b19dc12c9c70"; }
+    typedef TwistView View;
+
+  };
+
+  /* Twist read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TwistView
+  {
+    public:
+    typedef Twist MsgType;
+
+    TwistView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 48; }
+
+    tinyros::geometry_msgs::Vector3View linear() const { return tinyros::geometry_msgs::Vector3View(buffer_ + 0); }
+    tinyros::geometry_msgs::Vector3View angular() const { return tinyros::geometry_msgs::Vector3View(buffer_ + 24); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
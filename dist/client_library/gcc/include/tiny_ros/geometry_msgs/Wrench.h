@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace geometry_msgs
 {
 
+  class WrenchView;
+
   class Wrench : public tinyros::Msg
   {
     public:
@@ -22,6 +26,8 @@ namespace geometry_msgs
       typedef tinyros::geometry_msgs::Vector3 _torque_type;
       _torque_type torque;
 
+      static constexpr uint32_t kSerializedSize = 48;
+
     Wrench():
       force(),
       torque()
@@ -30,44 +36,60 @@ namespace geometry_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      offset += this->force.serialize(outbuffer + offset);
-      offset += this->torque.serialize(outbuffer + offset);
-      return offset;
+      this->force.serialize(outbuffer + 0);
+      this->torque.serialize(outbuffer + 24);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      offset += this->force.deserialize(inbuffer + offset);
-      offset += this->torque.deserialize(inbuffer + offset);
-      return offset;
+      this->force.deserialize(inbuffer + 0);
+      this->torque.deserialize(inbuffer + 24);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += this->force.serializedLength();
-      length += this->torque.serializedLength();
-      return length;
+      writer.raw('{');
+      writer.key("force");
+      writer.value(this->force);
+      writer.raw(',');
+      writer.key("torque");
+      writer.value(this->torque);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"force\":";
-      string_echo += this->force.echo();
-      string_echo += ",";
-      string_echo += "\"torque\":";
-      string_echo += this->torque.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "geometry_msgs/Wrench"; }
     virtual std::string getMD5(){ return "02d01d4a8dc253c7b42d4c9866201aee"; }
+    typedef WrenchView View;
+
+  };
+
+  /* Wrench read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class WrenchView
+  {
+    public:
+    typedef Wrench MsgType;
+
+    WrenchView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 48; }
+
+    tinyros::geometry_msgs::Vector3View force() const { return tinyros::geometry_msgs::Vector3View(buffer_ + 0); }
+    tinyros::geometry_msgs::Vector3View torque() const { return tinyros::geometry_msgs::Vector3View(buffer_ + 24); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -8,22 +8,37 @@
 #define TINYROS_LOG_MAX_SIZE 4096
 
 namespace tinyros {
+std::mutex BinaryLog::mutex_;
+std::vector<std::shared_ptr<LogBuffer> > BinaryLog::buffers_;
+uint64_t BinaryLog::gone_dropped_ = 0;
+
+int logLevel() {
+  return tinyros::nh()->getLogLevel();
+}
+
 void mtrace(int level, const char *chfr, ...) {
-  char buffer[TINYROS_LOG_MAX_SIZE] = {0};
+  /* levels nobody listens to are not even formatted */
+  if (level < tinyros::nh()->getLogLevel()) {
+    return;
+  }
+
+  char buffer[TINYROS_LOG_MAX_SIZE];
   va_list ap;
   va_start(ap, chfr);
 #ifdef WIN32
-  _vsnprintf(buffer, sizeof(buffer) - 1, chfr, ap);
+  int length = _vsnprintf(buffer, sizeof(buffer) - 1, chfr, ap);
 #else
-  vsnprintf(buffer, sizeof(buffer) - 1, chfr, ap);
+  int length = vsnprintf(buffer, sizeof(buffer) - 1, chfr, ap);
 #endif
   va_end(ap);
+  if (length < 0 || length > (int)sizeof(buffer) - 1) {
+    length = (int)sizeof(buffer) - 1;
+  }
 
-  if(level == tinyros::tinyros_msgs::Log::ROSDEBUG) tinyros::logdebug(buffer);
-  else if(level == tinyros::tinyros_msgs::Log::ROSINFO) tinyros::loginfo(buffer);
-  else if(level == tinyros::tinyros_msgs::Log::ROSWARN) tinyros::logwarn(buffer);
-  else if(level == tinyros::tinyros_msgs::Log::ROSERROR) tinyros::logerror(buffer);
-  else if(level == tinyros::tinyros_msgs::Log::ROSFATAL) tinyros::logfatal(buffer);
+  /* no string is built here, the record is copied into the log ring as it is */
+  if (level >= tinyros::tinyros_msgs::Log::ROSDEBUG && level <= tinyros::tinyros_msgs::Log::ROSFATAL) {
+    tinyros::nh()->log((char)level, buffer, (uint32_t)length);
+  }
 }
 }
 
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/nav_msgs/OccupancyGrid.h"
 
 namespace tinyros
@@ -188,19 +190,28 @@ static const char GETMAPROI[] = "map_msgs/GetMapROI";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("x");
+      writer.value(this->x);
+      writer.raw(',');
+      writer.key("y");
+      writer.value(this->y);
+      writer.raw(',');
+      writer.key("l_x");
+      writer.value(this->l_x);
+      writer.raw(',');
+      writer.key("l_y");
+      writer.value(this->l_y);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_x; ss_x << "\"x\":" << x <<",";
-      string_echo += ss_x.str();
-      std::stringstream ss_y; ss_y << "\"y\":" << y <<",";
-      string_echo += ss_y.str();
-      std::stringstream ss_l_x; ss_l_x << "\"l_x\":" << l_x <<",";
-      string_echo += ss_l_x.str();
-      std::stringstream ss_l_y; ss_l_y << "\"l_y\":" << l_y <<"";
-      string_echo += ss_l_y.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETMAPROI; }
@@ -257,14 +268,19 @@ static const char GETMAPROI[] = "map_msgs/GetMapROI";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("sub_map");
+      writer.value(this->sub_map);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"sub_map\":";
-      string_echo += this->sub_map.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETMAPROI; }
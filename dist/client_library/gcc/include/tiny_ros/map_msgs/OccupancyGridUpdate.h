@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace map_msgs
 {
 
+  class OccupancyGridUpdateView;
+
   class OccupancyGridUpdate : public tinyros::Msg
   {
     public:
@@ -81,15 +85,8 @@ namespace map_msgs
       *(outbuffer + offset + 2) = (this->data_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->data_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        union {
-          int8_t real;
-          uint8_t base;
-        } u_datai;
-        u_datai.real = this->data[i];
-        *(outbuffer + offset + 0) = (u_datai.base >> (8 * 0)) & 0xFF;
-        offset += sizeof(this->data[i]);
-      }
+      arrayToArr(outbuffer + offset, this->data, data_length);
+      offset += data_length * sizeof(int8_t);
       return offset;
     }
 
@@ -137,17 +134,8 @@ namespace map_msgs
       if(data_lengthT > data_length)
         this->data = (int8_t*)realloc(this->data, data_lengthT * sizeof(int8_t));
       data_length = data_lengthT;
-      for( uint32_t i = 0; i < data_length; i++) {
-        union {
-          int8_t real;
-          uint8_t base;
-        } u_st_data;
-        u_st_data.base = 0;
-        u_st_data.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        this->st_data = u_st_data.real;
-        offset += sizeof(this->st_data);
-        memcpy( &(this->data[i]), &(this->st_data), sizeof(int8_t));
-      }
+      arrToArray(this->data, inbuffer + offset, data_length);
+      offset += data_length * sizeof(int8_t);
       return offset;
     }
 
@@ -160,44 +148,93 @@ namespace map_msgs
       length += sizeof(this->width);
       length += sizeof(this->height);
       length += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        length += sizeof(this->data[i]);
-      }
+      length += data_length * sizeof(int8_t);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("x");
+      writer.value(this->x);
+      writer.raw(',');
+      writer.key("y");
+      writer.value(this->y);
+      writer.raw(',');
+      writer.key("width");
+      writer.value(this->width);
+      writer.raw(',');
+      writer.key("height");
+      writer.value(this->height);
+      writer.raw(',');
+      writer.array("data", this->data, this->data_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_x; ss_x << "\"x\":" << x <<",";
-      string_echo += ss_x.str();
-      std::stringstream ss_y; ss_y << "\"y\":" << y <<",";
-      string_echo += ss_y.str();
-      std::stringstream ss_width; ss_width << "\"width\":" << width <<",";
-      string_echo += ss_width.str();
-      std::stringstream ss_height; ss_height << "\"height\":" << height <<",";
-      string_echo += ss_height.str();
-      string_echo += "data:[";
-      for( uint32_t i = 0; i < data_length; i++) {
-        if( i == (data_length - 1)) {
-          std::stringstream ss_datai; ss_datai <<(int16_t)data[i] <<"";
-          string_echo += ss_datai.str();
-        } else {
-          std::stringstream ss_datai; ss_datai <<(int16_t)data[i] <<",";
-          string_echo += ss_datai.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "map_msgs/OccupancyGridUpdate"; }
     virtual std::string getMD5(){ return "159b2d7856932f2e2cad9b082ed99ec2"; }
+    typedef OccupancyGridUpdateView View;
+
+  };
+
+  /* OccupancyGridUpdate read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class OccupancyGridUpdateView
+  {
+    public:
+    typedef OccupancyGridUpdate MsgType;
+
+    OccupancyGridUpdateView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(6); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    int32_t x() const { return tinyros::viewRead<int32_t>(buffer_ + fieldOffset(1)); }
+    int32_t y() const { return tinyros::viewRead<int32_t>(buffer_ + fieldOffset(2)); }
+    uint32_t width() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(3)); }
+    uint32_t height() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(4)); }
+    tinyros::Span<int8_t> data() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(5);
+      return tinyros::Span<int8_t>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+          case 3: length = 4; break;
+          case 4: length = 4; break;
+          case 5: length = 4 + tinyros::viewRead<uint32_t>(p) * 1; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[7];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/sensor_msgs/PointCloud2.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace map_msgs
 {
 
+  class PointCloud2UpdateView;
+
   class PointCloud2Update : public tinyros::Msg
   {
     public:
@@ -69,24 +73,71 @@ namespace map_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("type");
+      writer.value(this->type);
+      writer.raw(',');
+      writer.key("points");
+      writer.value(this->points);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_type; ss_type << "\"type\":" << type <<",";
-      string_echo += ss_type.str();
-      string_echo += "\"points\":";
-      string_echo += this->points.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "map_msgs/PointCloud2Update"; }
     virtual std::string getMD5(){ return "e79dfbefd7336861352e1bc7148491c4"; }
+    typedef PointCloud2UpdateView View;
+
+  };
+
+  /* PointCloud2Update read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PointCloud2UpdateView
+  {
+    public:
+    typedef PointCloud2Update MsgType;
+
+    PointCloud2UpdateView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    uint32_t type() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(1)); }
+    tinyros::sensor_msgs::PointCloud2View points() const { return tinyros::sensor_msgs::PointCloud2View(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = tinyros::sensor_msgs::PointCloud2View(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
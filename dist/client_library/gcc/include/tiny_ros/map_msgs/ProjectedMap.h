@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/nav_msgs/OccupancyGrid.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace map_msgs
 {
 
+  class ProjectedMapView;
+
   class ProjectedMap : public tinyros::Msg
   {
     public:
@@ -112,23 +116,71 @@ namespace map_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("map");
+      writer.value(this->map);
+      writer.raw(',');
+      writer.key("min_z");
+      writer.value(this->min_z);
+      writer.raw(',');
+      writer.key("max_z");
+      writer.value(this->max_z);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"map\":";
-      string_echo += this->map.echo();
-      string_echo += ",";
-      std::stringstream ss_min_z; ss_min_z << "\"min_z\":" << min_z <<",";
-      string_echo += ss_min_z.str();
-      std::stringstream ss_max_z; ss_max_z << "\"max_z\":" << max_z <<"";
-      string_echo += ss_max_z.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "map_msgs/ProjectedMap"; }
     virtual std::string getMD5(){ return "cbd5598c259cc16f5aa07335587a7367"; }
+    typedef ProjectedMapView View;
+
+  };
+
+  /* ProjectedMap read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ProjectedMapView
+  {
+    public:
+    typedef ProjectedMap MsgType;
+
+    ProjectedMapView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::nav_msgs::OccupancyGridView map() const { return tinyros::nav_msgs::OccupancyGridView(buffer_ + 0); }
+    double min_z() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(1)); }
+    double max_z() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::nav_msgs::OccupancyGridView(p).serializedLength(); break;
+          case 1: length = 8; break;
+          case 2: length = 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
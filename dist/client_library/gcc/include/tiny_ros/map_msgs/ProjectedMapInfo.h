@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace map_msgs
 {
 
+  class ProjectedMapInfoView;
+
   class ProjectedMapInfo : public tinyros::Msg
   {
     public:
@@ -257,36 +261,91 @@ namespace map_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("frame_id");
+      writer.value(this->frame_id);
+      writer.raw(',');
+      writer.key("x");
+      writer.value(this->x);
+      writer.raw(',');
+      writer.key("y");
+      writer.value(this->y);
+      writer.raw(',');
+      writer.key("width");
+      writer.value(this->width);
+      writer.raw(',');
+      writer.key("height");
+      writer.value(this->height);
+      writer.raw(',');
+      writer.key("min_z");
+      writer.value(this->min_z);
+      writer.raw(',');
+      writer.key("max_z");
+      writer.value(this->max_z);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t frame_id_pos = frame_id.find("\"");
-      while(frame_id_pos != std::string::npos){
-        frame_id.replace(frame_id_pos, 1,"\\\"");
-        frame_id_pos = frame_id.find("\"", frame_id_pos+2);
-      }
-      string_echo += "\"frame_id\":\"";
-      string_echo += frame_id;
-      string_echo += "\",";
-      std::stringstream ss_x; ss_x << "\"x\":" << x <<",";
-      string_echo += ss_x.str();
-      std::stringstream ss_y; ss_y << "\"y\":" << y <<",";
-      string_echo += ss_y.str();
-      std::stringstream ss_width; ss_width << "\"width\":" << width <<",";
-      string_echo += ss_width.str();
-      std::stringstream ss_height; ss_height << "\"height\":" << height <<",";
-      string_echo += ss_height.str();
-      std::stringstream ss_min_z; ss_min_z << "\"min_z\":" << min_z <<",";
-      string_echo += ss_min_z.str();
-      std::stringstream ss_max_z; ss_max_z << "\"max_z\":" << max_z <<"";
-      string_echo += ss_max_z.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "map_msgs/ProjectedMapInfo"; }
     virtual std::string getMD5(){ return "f661365637fb759e63cb5d179a4461e1"; }
+    typedef ProjectedMapInfoView View;
+
+  };
+
+  /* ProjectedMapInfo read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ProjectedMapInfoView
+  {
+    public:
+    typedef ProjectedMapInfo MsgType;
+
+    ProjectedMapInfoView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(7); }
+
+    tinyros::StringView frame_id() const { return tinyros::StringView(buffer_ + 0); }
+    double x() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(1)); }
+    double y() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(2)); }
+    double width() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(3)); }
+    double height() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(4)); }
+    double min_z() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(5)); }
+    double max_z() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(6)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = 8; break;
+          case 2: length = 8; break;
+          case 3: length = 8; break;
+          case 4: length = 8; break;
+          case 5: length = 8; break;
+          case 6: length = 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[8];
+    mutable uint32_t known_;
   };
 
 }
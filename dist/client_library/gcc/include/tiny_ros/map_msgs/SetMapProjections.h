@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/map_msgs/ProjectedMapInfo.h"
 
 namespace tinyros
@@ -56,11 +58,17 @@ static const char SETMAPPROJECTIONS[] = "map_msgs/SetMapProjections";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETMAPPROJECTIONS; }
@@ -140,22 +148,18 @@ static const char SETMAPPROJECTIONS[] = "map_msgs/SetMapProjections";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("projected_maps_info", this->projected_maps_info, this->projected_maps_info_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "projected_maps_info:[";
-      for( uint32_t i = 0; i < projected_maps_info_length; i++) {
-        if( i == (projected_maps_info_length - 1)) {
-          string_echo += this->projected_maps_info[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->projected_maps_info[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETMAPPROJECTIONS; }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/nav_msgs/GetMapActionGoal.h"
 #include "tiny_ros/nav_msgs/GetMapActionResult.h"
 #include "tiny_ros/nav_msgs/GetMapActionFeedback.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace nav_msgs
 {
 
+  class GetMapActionView;
+
   class GetMapAction : public tinyros::Msg
   {
     public:
@@ -60,25 +64,71 @@ namespace nav_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("action_goal");
+      writer.value(this->action_goal);
+      writer.raw(',');
+      writer.key("action_result");
+      writer.value(this->action_result);
+      writer.raw(',');
+      writer.key("action_feedback");
+      writer.value(this->action_feedback);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"action_goal\":";
-      string_echo += this->action_goal.echo();
-      string_echo += ",";
-      string_echo += "\"action_result\":";
-      string_echo += this->action_result.echo();
-      string_echo += ",";
-      string_echo += "\"action_feedback\":";
-      string_echo += this->action_feedback.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "nav_msgs/GetMapAction"; }
     virtual std::string getMD5(){ return "10a4e277d7b8e53bfc3df54d98b3edb1"; }
+    typedef GetMapActionView View;
+
+  };
+
+  /* GetMapAction read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GetMapActionView
+  {
+    public:
+    typedef GetMapAction MsgType;
+
+    GetMapActionView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::nav_msgs::GetMapActionGoalView action_goal() const { return tinyros::nav_msgs::GetMapActionGoalView(buffer_ + 0); }
+    tinyros::nav_msgs::GetMapActionResultView action_result() const { return tinyros::nav_msgs::GetMapActionResultView(buffer_ + fieldOffset(1)); }
+    tinyros::nav_msgs::GetMapActionFeedbackView action_feedback() const { return tinyros::nav_msgs::GetMapActionFeedbackView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::nav_msgs::GetMapActionGoalView(p).serializedLength(); break;
+          case 1: length = tinyros::nav_msgs::GetMapActionResultView(p).serializedLength(); break;
+          case 2: length = tinyros::nav_msgs::GetMapActionFeedbackView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
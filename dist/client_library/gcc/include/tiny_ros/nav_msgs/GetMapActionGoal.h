@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/actionlib_msgs/GoalID.h"
 #include "tiny_ros/nav_msgs/GetMapGoal.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace nav_msgs
 {
 
+  class GetMapActionGoalView;
+
   class GetMapActionGoal : public tinyros::Msg
   {
     public:
@@ -60,25 +64,71 @@ namespace nav_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("goal_id");
+      writer.value(this->goal_id);
+      writer.raw(',');
+      writer.key("goal");
+      writer.value(this->goal);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"goal_id\":";
-      string_echo += this->goal_id.echo();
-      string_echo += ",";
-      string_echo += "\"goal\":";
-      string_echo += this->goal.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "nav_msgs/GetMapActionGoal"; }
     virtual std::string getMD5(){ return "8aea83336b4ee626241742bb14b14d90"; }
+    typedef GetMapActionGoalView View;
+
+  };
+
+  /* GetMapActionGoal read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GetMapActionGoalView
+  {
+    public:
+    typedef GetMapActionGoal MsgType;
+
+    GetMapActionGoalView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::actionlib_msgs::GoalIDView goal_id() const { return tinyros::actionlib_msgs::GoalIDView(buffer_ + fieldOffset(1)); }
+    tinyros::nav_msgs::GetMapGoalView goal() const { return tinyros::nav_msgs::GetMapGoalView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::actionlib_msgs::GoalIDView(p).serializedLength(); break;
+          case 2: length = tinyros::nav_msgs::GetMapGoalView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/actionlib_msgs/GoalStatus.h"
 #include "tiny_ros/nav_msgs/GetMapResult.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace nav_msgs
 {
 
+  class GetMapActionResultView;
+
   class GetMapActionResult : public tinyros::Msg
   {
     public:
@@ -60,25 +64,71 @@ namespace nav_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("status");
+      writer.value(this->status);
+      writer.raw(',');
+      writer.key("result");
+      writer.value(this->result);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"status\":";
-      string_echo += this->status.echo();
-      string_echo += ",";
-      string_echo += "\"result\":";
-      string_echo += this->result.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "nav_msgs/GetMapActionResult"; }
     virtual std::string getMD5(){ return "9c9f64758f2627a010c16b17ea745028"; }
+    typedef GetMapActionResultView View;
+
+  };
+
+  /* GetMapActionResult read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GetMapActionResultView
+  {
+    public:
+    typedef GetMapActionResult MsgType;
+
+    GetMapActionResultView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::actionlib_msgs::GoalStatusView status() const { return tinyros::actionlib_msgs::GoalStatusView(buffer_ + fieldOffset(1)); }
+    tinyros::nav_msgs::GetMapResultView result() const { return tinyros::nav_msgs::GetMapResultView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::actionlib_msgs::GoalStatusView(p).serializedLength(); break;
+          case 2: length = tinyros::nav_msgs::GetMapResultView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/nav_msgs/OccupancyGrid.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace nav_msgs
 {
 
+  class GetMapResultView;
+
   class GetMapResult : public tinyros::Msg
   {
     public:
@@ -46,19 +50,61 @@ namespace nav_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("map");
+      writer.value(this->map);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"map\":";
-      string_echo += this->map.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "nav_msgs/GetMapResult"; }
     virtual std::string getMD5(){ return "dd8eb0759b1a400b141d7f3238732c4d"; }
+    typedef GetMapResultView View;
+
+  };
+
+  /* GetMapResult read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GetMapResultView
+  {
+    public:
+    typedef GetMapResult MsgType;
+
+    GetMapResultView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(1); }
+
+    tinyros::nav_msgs::OccupancyGridView map() const { return tinyros::nav_msgs::OccupancyGridView(buffer_ + 0); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::nav_msgs::OccupancyGridView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[2];
+    mutable uint32_t known_;
   };
 
 }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/PoseStamped.h"
 #include "tiny_ros/nav_msgs/Path.h"
 
@@ -94,19 +96,25 @@ static const char GETPLAN[] = "nav_msgs/GetPlan";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("start");
+      writer.value(this->start);
+      writer.raw(',');
+      writer.key("goal");
+      writer.value(this->goal);
+      writer.raw(',');
+      writer.key("tolerance");
+      writer.value(this->tolerance);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"start\":";
-      string_echo += this->start.echo();
-      string_echo += ",";
-      string_echo += "\"goal\":";
-      string_echo += this->goal.echo();
-      string_echo += ",";
-      std::stringstream ss_tolerance; ss_tolerance << "\"tolerance\":" << tolerance <<"";
-      string_echo += ss_tolerance.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETPLAN; }
@@ -163,14 +171,19 @@ static const char GETPLAN[] = "nav_msgs/GetPlan";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("plan");
+      writer.value(this->plan);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"plan\":";
-      string_echo += this->plan.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return GETPLAN; }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Point.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace nav_msgs
 {
 
+  class GridCellsView;
+
   class GridCells : public tinyros::Msg
   {
     public:
@@ -126,34 +130,79 @@ namespace nav_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("cell_width");
+      writer.value(this->cell_width);
+      writer.raw(',');
+      writer.key("cell_height");
+      writer.value(this->cell_height);
+      writer.raw(',');
+      writer.array("cells", this->cells, this->cells_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_cell_width; ss_cell_width << "\"cell_width\":" << cell_width <<",";
-      string_echo += ss_cell_width.str();
-      std::stringstream ss_cell_height; ss_cell_height << "\"cell_height\":" << cell_height <<",";
-      string_echo += ss_cell_height.str();
-      string_echo += "cells:[";
-      for( uint32_t i = 0; i < cells_length; i++) {
-        if( i == (cells_length - 1)) {
-          string_echo += this->cells[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->cells[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "nav_msgs/GridCells"; }
     virtual std::string getMD5(){ return "13ce9063aaf922c39d3a2207d3926427"; }
+    typedef GridCellsView View;
+
+  };
+
+  /* GridCells read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class GridCellsView
+  {
+    public:
+    typedef GridCells MsgType;
+
+    GridCellsView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(4); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    float cell_width() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(1)); }
+    float cell_height() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(2)); }
+    tinyros::Span<tinyros::geometry_msgs::PointView> cells() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::Span<tinyros::geometry_msgs::PointView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+          case 3: length = 4 + tinyros::viewRead<uint32_t>(p) * 24; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[5];
+    mutable uint32_t known_;
   };
 
 }
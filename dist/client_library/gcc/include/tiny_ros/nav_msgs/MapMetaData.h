@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 #include "tiny_ros/geometry_msgs/Pose.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace nav_msgs
 {
 
+  class MapMetaDataView;
+
   class MapMetaData : public tinyros::Msg
   {
     public:
@@ -29,6 +33,8 @@ namespace nav_msgs
       typedef tinyros::geometry_msgs::Pose _origin_type;
       _origin_type origin;
 
+      static constexpr uint32_t kSerializedSize = 76;
+
     MapMetaData():
       map_load_time(),
       resolution(0),
@@ -40,114 +46,80 @@ namespace nav_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->map_load_time.sec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->map_load_time.sec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->map_load_time.sec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->map_load_time.sec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->map_load_time.sec);
-      *(outbuffer + offset + 0) = (this->map_load_time.nsec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->map_load_time.nsec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->map_load_time.nsec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->map_load_time.nsec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->map_load_time.nsec);
-      union {
-        float real;
-        uint32_t base;
-      } u_resolution;
-      u_resolution.real = this->resolution;
-      *(outbuffer + offset + 0) = (u_resolution.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_resolution.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_resolution.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_resolution.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->resolution);
-      *(outbuffer + offset + 0) = (this->width >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->width >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->width >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->width >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->width);
-      *(outbuffer + offset + 0) = (this->height >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->height >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->height >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->height >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->height);
-      offset += this->origin.serialize(outbuffer + offset);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->map_load_time.sec, 1);
+      arrayToArr(outbuffer + 0 + 4, &this->map_load_time.nsec, 1);
+      arrayToArr(outbuffer + 8, &this->resolution, 1);
+      arrayToArr(outbuffer + 12, &this->width, 1);
+      arrayToArr(outbuffer + 16, &this->height, 1);
+      this->origin.serialize(outbuffer + 20);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->map_load_time.sec =  ((uint32_t) (*(inbuffer + offset)));
-      this->map_load_time.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->map_load_time.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->map_load_time.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->map_load_time.sec);
-      this->map_load_time.nsec =  ((uint32_t) (*(inbuffer + offset)));
-      this->map_load_time.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->map_load_time.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->map_load_time.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->map_load_time.nsec);
-      union {
-        float real;
-        uint32_t base;
-      } u_resolution;
-      u_resolution.base = 0;
-      u_resolution.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_resolution.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_resolution.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_resolution.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->resolution = u_resolution.real;
-      offset += sizeof(this->resolution);
-      this->width =  ((uint32_t) (*(inbuffer + offset)));
-      this->width |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->width |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->width |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->width);
-      this->height =  ((uint32_t) (*(inbuffer + offset)));
-      this->height |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->height |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->height |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->height);
-      offset += this->origin.deserialize(inbuffer + offset);
-      return offset;
+      arrToArray(&this->map_load_time.sec, inbuffer + 0, 1);
+      arrToArray(&this->map_load_time.nsec, inbuffer + 0 + 4, 1);
+      arrToArray(&this->resolution, inbuffer + 8, 1);
+      arrToArray(&this->width, inbuffer + 12, 1);
+      arrToArray(&this->height, inbuffer + 16, 1);
+      this->origin.deserialize(inbuffer + 20);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->map_load_time.sec);
-      length += sizeof(this->map_load_time.nsec);
-      length += sizeof(this->resolution);
-      length += sizeof(this->width);
-      length += sizeof(this->height);
-      length += this->origin.serializedLength();
-      return length;
+      writer.raw('{');
+      writer.key("map_load_time");
+      writer.value(this->map_load_time);
+      writer.raw(',');
+      writer.key("resolution");
+      writer.value(this->resolution);
+      writer.raw(',');
+      writer.key("width");
+      writer.value(this->width);
+      writer.raw(',');
+      writer.key("height");
+      writer.value(this->height);
+      writer.raw(',');
+      writer.key("origin");
+      writer.value(this->origin);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_map_load_time;
-      ss_map_load_time << "\"map_load_time\":{\"sec\":" << map_load_time.sec;
-      ss_map_load_time << ",\"nsec\":" << map_load_time.nsec << "},";
-      string_echo += ss_map_load_time.str();
-      std::stringstream ss_resolution; ss_resolution << "\"resolution\":" << resolution <<",";
-      string_echo += ss_resolution.str();
-      std::stringstream ss_width; ss_width << "\"width\":" << width <<",";
-      string_echo += ss_width.str();
-      std::stringstream ss_height; ss_height << "\"height\":" << height <<",";
-      string_echo += ss_height.str();
-      string_echo += "\"origin\":";
-      string_echo += this->origin.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "nav_msgs/MapMetaData"; }
     virtual std::string getMD5(){ return "328f5a1f2242fff4676d48189bd8b309"; }
+    typedef MapMetaDataView View;
+
+  };
+
+  /* MapMetaData read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MapMetaDataView
+  {
+    public:
+    typedef MapMetaData MsgType;
+
+    MapMetaDataView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 76; }
+
+    tinyros::Time map_load_time() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 0); }
+    float resolution() const { return tinyros::viewRead<float>(buffer_ + 8); }
+    uint32_t width() const { return tinyros::viewRead<uint32_t>(buffer_ + 12); }
+    uint32_t height() const { return tinyros::viewRead<uint32_t>(buffer_ + 16); }
+    tinyros::geometry_msgs::PoseView origin() const { return tinyros::geometry_msgs::PoseView(buffer_ + 20); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
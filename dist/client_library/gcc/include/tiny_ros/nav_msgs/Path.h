@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/PoseStamped.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace nav_msgs
 {
 
+  class PathView;
+
   class Path : public tinyros::Msg
   {
     public:
@@ -76,30 +80,69 @@ namespace nav_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("poses", this->poses, this->poses_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "poses:[";
-      for( uint32_t i = 0; i < poses_length; i++) {
-        if( i == (poses_length - 1)) {
-          string_echo += this->poses[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->poses[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "nav_msgs/Path"; }
     virtual std::string getMD5(){ return "4a185240c929c496a7e0d6202e3c89af"; }
+    typedef PathView View;
+
+  };
+
+  /* Path read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PathView
+  {
+    public:
+    typedef Path MsgType;
+
+    PathView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::ViewList<tinyros::geometry_msgs::PoseStampedView> poses() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::ViewList<tinyros::geometry_msgs::PoseStampedView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::ViewList<tinyros::geometry_msgs::PoseStampedView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/nav_msgs/OccupancyGrid.h"
 #include "tiny_ros/geometry_msgs/PoseWithCovarianceStamped.h"
 
@@ -69,17 +71,22 @@ static const char SETMAP[] = "nav_msgs/SetMap";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("map");
+      writer.value(this->map);
+      writer.raw(',');
+      writer.key("initial_pose");
+      writer.value(this->initial_pose);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"map\":";
-      string_echo += this->map.echo();
-      string_echo += ",";
-      string_echo += "\"initial_pose\":";
-      string_echo += this->initial_pose.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETMAP; }
@@ -149,13 +156,19 @@ static const char SETMAP[] = "nav_msgs/SetMap";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("success");
+      writer.value(this->success);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_success; ss_success << "\"success\":" << success <<"";
-      string_echo += ss_success.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return SETMAP; }
@@ -0,0 +1,99 @@
+#ifndef TINYROS_BUFFER_POOL_H_
+#define TINYROS_BUFFER_POOL_H_
+#include <stdint.h>
+#include <stddef.h>
+#include <mutex>
+#include <vector>
+
+namespace tinyros
+{
+/*
+ * Free lists of buffer owning objects in power of two size classes from
+ * 256 bytes up to max_size. T is constructed as T(capacity, size_class)
+ * and links through its next_ member while it sits in the pool, so a
+ * steady message rate does not touch the heap. The lock only guards a
+ * pointer swap.
+ */
+template<typename T>
+class BufferPool
+{
+public:
+  enum { MIN_SHIFT = 8, CLASSES = 16, MAX_CACHED = 64 };
+
+  BufferPool(int max_size) : max_size_(max_size) {
+    for (int c = 0; c < CLASSES; c++) {
+      free_[c] = NULL;
+      cached_[c] = 0;
+    }
+  }
+
+  ~BufferPool() {
+    for (int c = 0; c < CLASSES; c++) {
+      while (free_[c]) {
+        T* obj = free_[c];
+        free_[c] = obj->next_;
+        delete obj;
+      }
+    }
+  }
+
+  int maxSize() { return max_size_; }
+
+  /* NULL if size exceeds max_size */
+  T* acquire(int size) {
+    if (size > max_size_) {
+      return NULL;
+    }
+    int c = 0;
+    while (c < CLASSES - 1 && (1 << (c + MIN_SHIFT)) < size) c++;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      T* obj = free_[c];
+      if (obj) {
+        free_[c] = obj->next_;
+        cached_[c]--;
+        return obj;
+      }
+    }
+    int capacity = 1 << (c + MIN_SHIFT);
+    return new T(capacity < max_size_ ? capacity : max_size_, c);
+  }
+
+  /* fill the free list of the size class of size up to count objects */
+  void reserve(int size, int count) {
+    std::vector<T*> objs;
+    for (int i = 0; i < count; i++) {
+      T* obj = acquire(size);
+      if (obj == NULL) {
+        break;
+      }
+      objs.push_back(obj);
+    }
+    for (size_t i = 0; i < objs.size(); i++) {
+      release(objs[i]);
+    }
+  }
+
+  void release(T* obj) {
+    int c = obj->size_class_;
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (cached_[c] < MAX_CACHED) {
+      obj->next_ = free_[c];
+      free_[c] = obj;
+      cached_[c]++;
+      return;
+    }
+    lock.unlock();
+    delete obj;
+  }
+
+private:
+  int max_size_;
+  std::mutex mutex_;
+  T* free_[CLASSES];
+  int cached_[CLASSES];
+};
+
+}
+
+#endif
@@ -0,0 +1,165 @@
+#ifndef TINYROS_CLOCK_SYNC_H_
+#define TINYROS_CLOCK_SYNC_H_
+#include <stdint.h>
+#include <math.h>
+#include <mutex>
+#include <deque>
+#include "tiny_ros/ros/time.h"
+
+namespace tinyros
+{
+/* how well Time::dds() follows tinyrosdds, see NodeHandleBase_::getSyncQuality() */
+struct SyncQuality
+{
+  bool synced;       // at least one exchange was answered
+  double rtt;        // ms, round trip of the sample in use
+  double jitter;     // ms, spread of the recent offsets around it
+  double drift;      // ppm, of the monotonic clock against dds
+  double error;      // ms, bound of the dds() error: rtt / 2 + jitter
+  double age;        // s since the last answered exchange
+  uint32_t samples;  // answered exchanges
+};
+
+/*
+ * NTP style estimate of the dds clock. The node sends SyncTime with its
+ * monotonic t0 over ID_TIME, tinyrosdds answers with t0, its receive
+ * time t1 and send time t2, the answer arrives at t3:
+ *
+ *   offset = ((t1 - t0) + (t2 - t3)) / 2   dds - monotonic
+ *   delay  = (t3 - t0) - (t2 - t1)         the round trip on the wire
+ *
+ * Of the last FILTER samples the one with the least delay is used, its
+ * offset suffers the least from queueing. The drift is the slope of
+ * those offsets over the last DRIFT_SAMPLES of them.
+ */
+class ClockSync
+{
+public:
+  enum { FILTER = 8, DRIFT_SAMPLES = 32 };
+  enum { MIN_DRIFT_SPAN = 10 };  // seconds the drift fit needs to span
+  enum { MAX_DRIFT = 500 };  // ppm, as NTP; clocks off by more are not followed
+  enum { MAX_DELAY = 1000 };  // ms, a slower answer is no sample
+
+  ClockSync() : drift_(0), samples_(0), last_(0), best_(0) {}
+
+  /*
+   * An answer to a request, with t0 and t3 of the monotonic clock; true
+   * if Time::dds() was updated.
+   */
+  bool update(const Time& t0, const Time& t1, const Time& t2, const Time& t3) {
+    int64_t m0 = toNSec(t0), d1 = toNSec(t1), d2 = toNSec(t2), m3 = toNSec(t3);
+    int64_t delay = (m3 - m0) - (d2 - d1);
+    if (m0 == 0 || m3 < m0 || delay < 0 || delay > MAX_DELAY * 1000000LL) {
+      return false;
+    }
+    Sample sample;
+    sample.mono = m3;
+    sample.offset = ((d1 - m0) + (d2 - m3)) / 2;
+    sample.delay = delay;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    samples_++;
+    last_ = m3;
+    filter_.push_back(sample);
+    if (filter_.size() > FILTER) {
+      filter_.pop_front();
+    }
+    const Sample* best = &filter_[0];
+    for (size_t i = 1; i < filter_.size(); i++) {
+      if (filter_[i].delay < best->delay) {
+        best = &filter_[i];
+      }
+    }
+    // a sample is picked once, the drift fit needs distinct points
+    if (best->mono != best_) {
+      best_ = best->mono;
+      picked_.push_back(*best);
+      if (picked_.size() > DRIFT_SAMPLES) {
+        picked_.pop_front();
+      }
+    }
+    chosen_ = *best;
+    drift_ = fitDrift();
+
+    std::unique_lock<std::mutex> time_lock(Time::mutex_);
+    Time::setDDS(fromNSec(chosen_.mono + chosen_.offset), fromNSec(chosen_.mono), (int64_t)(drift_ * 1e9));
+    return true;
+  }
+
+  /* the next request is due right away while the filter is filling */
+  bool warmingUp() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return filter_.size() < FILTER;
+  }
+
+  bool synced() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return samples_ > 0;
+  }
+
+  SyncQuality quality() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    SyncQuality quality;
+    quality.synced = samples_ > 0;
+    quality.samples = samples_;
+    quality.rtt = chosen_.delay * 1e-6;
+    double sum = 0;
+    for (size_t i = 0; i < filter_.size(); i++) {
+      // the offsets as of the chosen sample, so drift is not counted as jitter
+      double d = (double)(filter_[i].offset - chosen_.offset) - drift_ * (double)(filter_[i].mono - chosen_.mono);
+      sum += d * d;
+    }
+    quality.jitter = filter_.empty() ? 0 : sqrt(sum / filter_.size()) * 1e-6;
+    quality.drift = drift_ * 1e6;
+    quality.error = quality.rtt / 2 + quality.jitter;
+    quality.age = samples_ > 0 ? (toNSec(Time::monotonic()) - last_) * 1e-9 : 0;
+    return quality;
+  }
+
+private:
+  struct Sample
+  {
+    Sample() : mono(0), offset(0), delay(0) {}
+    int64_t mono;    // t3
+    int64_t offset;
+    int64_t delay;
+  };
+
+  /* least squares slope of offset over mono of the picked samples */
+  double fitDrift() {
+    if (picked_.size() < 3 || picked_.back().mono - picked_.front().mono < MIN_DRIFT_SPAN * 1000000000LL) {
+      return 0;
+    }
+    double n = (double)picked_.size(), sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (size_t i = 0; i < picked_.size(); i++) {
+      double x = (double)(picked_[i].mono - picked_.front().mono);
+      double y = (double)(picked_[i].offset - picked_.front().offset);
+      sx += x; sy += y; sxx += x * x; sxy += x * y;
+    }
+    double d = n * sxx - sx * sx;
+    double slope = d > 0 ? (n * sxy - sx * sy) / d : 0;
+    double limit = MAX_DRIFT * 1e-6;
+    return slope > limit ? limit : (slope < -limit ? -limit : slope);
+  }
+
+  static int64_t toNSec(const Time& t) {
+    return (int64_t)t.sec * 1000000000LL + (int64_t)t.nsec;
+  }
+
+  static Time fromNSec(int64_t ns) {
+    return Time((uint32_t)(ns / 1000000000LL), (uint32_t)(ns % 1000000000LL));
+  }
+
+  std::mutex mutex_;
+  std::deque<Sample> filter_;
+  std::deque<Sample> picked_;
+  Sample chosen_;
+  double drift_;
+  uint32_t samples_;
+  int64_t last_;
+  int64_t best_;  // mono of the last picked sample
+};
+
+}
+
+#endif
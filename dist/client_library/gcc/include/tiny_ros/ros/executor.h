@@ -0,0 +1,304 @@
+#ifndef TINYROS_EXECUTOR_H_
+#define TINYROS_EXECUTOR_H_
+#include <stdint.h>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <vector>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include "tiny_ros/ros/threadpool.h"
+
+namespace tinyros
+{
+/* Runs subscription callbacks */
+class Executor
+{
+public:
+  typedef TaskQueue::Task Task;
+  virtual ~Executor() {}
+  virtual void post(const Task& task) = 0;
+  /* stops the threads; tasks left over still run, but cancelled() */
+  virtual void shutdown() = 0;
+  virtual int threads() = 0;
+
+  /* true while a task runs after shutdown, it should only release what it holds */
+  static bool cancelled() { return cancelling() > 0; }
+
+protected:
+  static int& cancelling() {
+    static thread_local int depth = 0;
+    return depth;
+  }
+
+  static void cancel(const Task& task) {
+    cancelling()++;
+    task();
+    cancelling()--;
+  }
+};
+typedef std::shared_ptr<Executor> ExecutorPtr;
+
+/*
+ * Each worker owns a task queue. Tasks posted from a worker stay on its
+ * queue, tasks posted from other threads are spread round robin, and a
+ * worker whose queue runs dry steals from the others before it sleeps.
+ * There is no single lock every task has to pass through.
+ */
+class WorkStealingExecutor: public Executor
+{
+public:
+  /* threads <= 0 sizes the pool to the machine */
+  WorkStealingExecutor(int threads = 0)
+    : started_(true)
+    , pending_(0)
+    , sleeping_(0)
+    , next_(0) {
+    if (threads <= 0) {
+      threads = (int)std::thread::hardware_concurrency();
+      if (threads <= 0) threads = 1;
+    }
+    for (int i = 0; i < threads; i++) {
+      workers_.push_back(new Worker());
+    }
+    for (int i = 0; i < threads; i++) {
+      workers_[i]->thread_ = new std::thread(std::bind(&WorkStealingExecutor::worker_loop, this, i));
+    }
+  }
+
+  ~WorkStealingExecutor() {
+    shutdown();
+    for (size_t i = 0; i < workers_.size(); i++) {
+      delete workers_[i];
+    }
+    workers_.clear();
+  }
+
+  virtual void post(const Task& task) {
+    Current& current = this_thread();
+    size_t index = (current.executor == this) ? current.index : (next_++ % workers_.size());
+    {
+      std::unique_lock<std::mutex> lock(workers_[index]->mutex_);
+      if (!started_) {
+        lock.unlock();
+        cancel(task);
+        return;
+      }
+      workers_[index]->tasks_.push(task);
+    }
+    pending_++;
+    if (sleeping_.load() > 0) {
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      sleep_cond_.notify_one();
+    }
+  }
+
+  virtual void shutdown() {
+    {
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      if (!started_) {
+        return;
+      }
+      started_ = false;
+      sleep_cond_.notify_all();
+    }
+    for (size_t i = 0; i < workers_.size(); i++) {
+      workers_[i]->thread_->join();
+      delete workers_[i]->thread_;
+      workers_[i]->thread_ = NULL;
+    }
+    /* the tasks hold pooled messages, they get to release them */
+    Task task;
+    while ((task = take(0))) {
+      cancel(task);
+    }
+  }
+
+  virtual int threads() { return (int)workers_.size(); }
+
+private:
+  /* the executor and worker index of the calling thread */
+  struct Current
+  {
+    WorkStealingExecutor* executor;
+    size_t index;
+  };
+
+  static Current& this_thread() {
+    static thread_local Current current = { NULL, 0 };
+    return current;
+  }
+
+  class Worker
+  {
+  public:
+    Worker() : thread_(NULL) {}
+    std::mutex mutex_;
+    TaskQueue tasks_;
+    std::thread* thread_;
+  };
+
+  Task take(size_t index) {
+    Task task = nullptr;
+    for (size_t i = 0; i < workers_.size() && !task; i++) {
+      Worker* worker = workers_[(index + i) % workers_.size()];
+      std::unique_lock<std::mutex> lock(worker->mutex_);
+      task = worker->tasks_.pop();
+    }
+    if (task) {
+      pending_--;
+    }
+    return task;
+  }
+
+  void worker_loop(size_t index) {
+    this_thread().executor = this;
+    this_thread().index = index;
+    while (started_) {
+      Task task = take(index);
+      if (task) {
+        task();
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      sleeping_++;
+      while (started_ && pending_.load() == 0) {
+        sleep_cond_.wait(lock);
+      }
+      sleeping_--;
+    }
+  }
+
+  std::vector<Worker*> workers_;
+  std::atomic<bool> started_;
+  std::atomic<int> pending_;
+  std::atomic<int> sleeping_;
+  std::atomic<size_t> next_;
+  std::mutex sleep_mutex_;
+  std::condition_variable sleep_cond_;
+};
+
+/* Every callback runs on one thread, in posting order */
+class SingleThreadedExecutor: public WorkStealingExecutor
+{
+public:
+  SingleThreadedExecutor() : WorkStealingExecutor(1) {}
+};
+
+/*
+ * Serializes the tasks posted to it on top of an executor: at most one
+ * of them runs at a time, in posting order. The strand occupies a worker
+ * only while it has work and yields it after a batch.
+ */
+class Strand
+{
+public:
+  enum { BATCH = 16 };
+
+  Strand(ExecutorPtr executor) : executor_(executor), running_(false) {}
+
+  void post(const Executor::Task& task) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      tasks_.push(task);
+      if (running_) {
+        return;
+      }
+      running_ = true;
+    }
+    executor_->post([this]() { drain(); });
+  }
+
+  /* nothing is waiting or running, no task of the executor refers to the strand */
+  bool idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return !running_ && tasks_.empty();
+  }
+
+  /* tasks waiting, not counting the running one */
+  size_t size() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return tasks_.size();
+  }
+
+  ExecutorPtr executor() { return executor_; }
+
+private:
+  void drain() {
+    for (int i = 0; i < BATCH; i++) {
+      Executor::Task task;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        task = tasks_.pop();
+        if (!task) {
+          running_ = false;
+          return;
+        }
+      }
+      task();
+    }
+    executor_->post([this]() { drain(); });
+  }
+
+  ExecutorPtr executor_;
+  std::mutex mutex_;
+  TaskQueue tasks_;
+  bool running_;
+};
+typedef std::shared_ptr<Strand> StrandPtr;
+
+/*
+ * Subscriptions are assigned to a named callback group, which decides
+ * where and how their callbacks run:
+ *   MUTUALLY_EXCLUSIVE  one callback of the group at a time
+ *   ORDERED             one callback per subscription at a time, in
+ *                       arrival order; subscriptions run in parallel
+ *   REENTRANT           no ordering, callbacks may run concurrently
+ */
+class CallbackGroup
+{
+public:
+  enum Type { MUTUALLY_EXCLUSIVE = 0, ORDERED = 1, REENTRANT = 2 };
+
+  CallbackGroup(std::string name, Type type, ExecutorPtr executor)
+    : name_(name), type_(type), executor_(executor) {
+    if (type_ == MUTUALLY_EXCLUSIVE) {
+      strand_ = StrandPtr(new Strand(executor_));
+    }
+  }
+
+  /* strand for a new subscription of the group, NULL for REENTRANT groups */
+  StrandPtr strand() {
+    if (type_ == MUTUALLY_EXCLUSIVE) {
+      return strand_;
+    } else if (type_ == ORDERED) {
+      return StrandPtr(new Strand(executor_));
+    }
+    return nullptr;
+  }
+
+  void post(const StrandPtr& strand, const Executor::Task& task) {
+    if (strand) {
+      strand->post(task);
+    } else {
+      executor_->post(task);
+    }
+  }
+
+  std::string name() { return name_; }
+  Type type() { return type_; }
+  ExecutorPtr executor() { return executor_; }
+
+private:
+  std::string name_;
+  Type type_;
+  ExecutorPtr executor_;
+  StrandPtr strand_;
+};
+typedef std::shared_ptr<CallbackGroup> CallbackGroupPtr;
+
+}
+
+#endif
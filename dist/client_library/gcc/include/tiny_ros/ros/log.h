@@ -3,6 +3,7 @@
 
 #include "tiny_ros/ros/time.h"
 #include "tiny_ros/tinyros_msgs/Log.h"
+#include "tiny_ros/ros/log_binary.h"
 
 namespace tinyros
 {
@@ -13,44 +14,70 @@ void mtrace(int level, const char *chfr, ...);
 #define tinyros_log_error(format, ...) tinyros::mtrace(tinyros::tinyros_msgs::Log::ROSERROR, format, ##__VA_ARGS__)
 #define tinyros_log_debug(format, ...) tinyros::mtrace(tinyros::tinyros_msgs::Log::ROSDEBUG, format, ##__VA_ARGS__)
 
+/*
+ * Binary logging: the call site keeps the format, a record only its
+ * address and the raw arguments, and the log thread formats it. format
+ * must be a literal; a %s argument is copied when logged.
+ */
+#define tinyros_blog(level, format, ...) do { \
+  static constexpr tinyros::LogSite __tinyros_log_site(level, format); \
+  tinyros::logBinary(__tinyros_log_site, ##__VA_ARGS__); \
+} while (0)
+#define tinyros_blog_info(format, ...) tinyros_blog(tinyros::tinyros_msgs::Log::ROSINFO, format, ##__VA_ARGS__)
+#define tinyros_blog_warn(format, ...) tinyros_blog(tinyros::tinyros_msgs::Log::ROSWARN, format, ##__VA_ARGS__)
+#define tinyros_blog_error(format, ...) tinyros_blog(tinyros::tinyros_msgs::Log::ROSERROR, format, ##__VA_ARGS__)
+#define tinyros_blog_debug(format, ...) tinyros_blog(tinyros::tinyros_msgs::Log::ROSDEBUG, format, ##__VA_ARGS__)
+
+/* -DTINYROS_BINARY_LOG makes tinyros_log_* binary */
+#ifdef TINYROS_BINARY_LOG
+#undef tinyros_log_info
+#undef tinyros_log_warn
+#undef tinyros_log_error
+#undef tinyros_log_debug
+#define tinyros_log_info tinyros_blog_info
+#define tinyros_log_warn tinyros_blog_warn
+#define tinyros_log_error tinyros_blog_error
+#define tinyros_log_debug tinyros_blog_debug
+#endif
+
 #define TINYROS_LOG_ONCE_TIME_THROTTLE  1
 #define tinyros_log_once_info(format, ...) { \
   static double __once_time = -1.0f; \
   if(__once_time < 0.0f) \
-    __once_time = tinyros::Time::now().toSec(); \
-  double __once_tem_sec =(tinyros::Time::now().toSec() - __once_time); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
+  double __once_tem_sec =(tinyros::Time::monotonic().toSec() - __once_time); \
   if((__once_tem_sec > TINYROS_LOG_ONCE_TIME_THROTTLE) || (__once_tem_sec < 0.0f)) { \
-    __once_time = tinyros::Time::now().toSec(); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
     tinyros::mtrace(tinyros::tinyros_msgs::Log::ROSINFO, format, ##__VA_ARGS__); \
   } \
 }
 #define tinyros_log_once_warn(format, ...) { \
   static double __once_time = -1.0f; \
   if(__once_time < 0.0f) \
-    __once_time = tinyros::Time::now().toSec(); \
-  double __once_tem_sec =(tinyros::Time::now().toSec() - __once_time); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
+  double __once_tem_sec =(tinyros::Time::monotonic().toSec() - __once_time); \
   if((__once_tem_sec > TINYROS_LOG_ONCE_TIME_THROTTLE) || (__once_tem_sec < 0.0f)) { \
-    __once_time = tinyros::Time::now().toSec(); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
     tinyros::mtrace(tinyros::tinyros_msgs::Log::ROSWARN, format, ##__VA_ARGS__); \
   } \
 }
 #define tinyros_log_once_error(format, ...) { \
   static double __once_time = -1.0f; \
   if(__once_time < 0.0f) \
-    __once_time = tinyros::Time::now().toSec(); \
-  double __once_tem_sec =(tinyros::Time::now().toSec() - __once_time); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
+  double __once_tem_sec =(tinyros::Time::monotonic().toSec() - __once_time); \
   if((__once_tem_sec > TINYROS_LOG_ONCE_TIME_THROTTLE) || (__once_tem_sec < 0.0f)) { \
-    __once_time = tinyros::Time::now().toSec(); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
     tinyros::mtrace(tinyros::tinyros_msgs::Log::ROSERROR, format, ##__VA_ARGS__); \
   } \
 }
 #define tinyros_log_once_debug(format, ...) { \
   static double __once_time = -1.0f; \
   if(__once_time < 0.0f) \
-    __once_time = tinyros::Time::now().toSec(); \
-  double __once_tem_sec =(tinyros::Time::now().toSec() - __once_time); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
+  double __once_tem_sec =(tinyros::Time::monotonic().toSec() - __once_time); \
   if((__once_tem_sec > TINYROS_LOG_ONCE_TIME_THROTTLE) || (__once_tem_sec < 0.0f)) { \
-    __once_time = tinyros::Time::now().toSec(); \
+    __once_time = tinyros::Time::monotonic().toSec(); \
     tinyros::mtrace(tinyros::tinyros_msgs::Log::ROSDEBUG, format, ##__VA_ARGS__); \
   } \
 }
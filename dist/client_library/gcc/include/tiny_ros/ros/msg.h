@@ -2,12 +2,20 @@
 #define _TINYROS_MSG_H_
 #include <stdint.h>
 #include <stddef.h>
+#include <string.h>
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <type_traits>
+
+/* The wire format is little endian, big endian hosts swap array elements one by one */
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+#define TINYROS_BIG_ENDIAN 1
+#endif
 
 namespace tinyros
 {
+class Writer;
 
 /* Base Message Type */
 class Msg
@@ -19,6 +27,7 @@ public:
   virtual std::string getType() = 0;
   virtual std::string getMD5() = 0;
   virtual std::string echo() = 0;
+  virtual void echo(Writer& writer) const = 0;
 
   /**
    * @brief This tricky function handles promoting a 32bit float to a 64bit
@@ -111,6 +120,56 @@ public:
       var |= (arr[i] << (8 * i));
   }
 
+  // Copy count primitive elements into a byte array
+  template<typename T>
+  static void arrayToArr(unsigned char* arr, const T* data, uint32_t count)
+  {
+    if (count == 0)
+      return;
+#ifndef TINYROS_BIG_ENDIAN
+    memcpy(arr, data, count * sizeof(T));
+#else
+    for (uint32_t i = 0; i < count; i++) {
+      const unsigned char* p = (const unsigned char*)(data + i);
+      for (size_t b = 0; b < sizeof(T); b++)
+        arr[i * sizeof(T) + b] = p[sizeof(T) - 1 - b];
+    }
+#endif
+  }
+
+  // Copy count primitive elements from a byte array
+  template<typename T>
+  static void arrToArray(T* data, const unsigned char* arr, uint32_t count)
+  {
+    if (count == 0)
+      return;
+#ifndef TINYROS_BIG_ENDIAN
+    memcpy(data, arr, count * sizeof(T));
+#else
+    for (uint32_t i = 0; i < count; i++) {
+      unsigned char* p = (unsigned char*)(data + i);
+      for (size_t b = 0; b < sizeof(T); b++)
+        p[sizeof(T) - 1 - b] = arr[i * sizeof(T) + b];
+    }
+#endif
+  }
+
+};
+
+/*
+ * is_fixed_size<T>::value is true for messages without strings or
+ * variable length arrays. Their serialized length is the constant
+ * T::kSerializedSize, generated into the message class.
+ */
+template<typename T>
+class is_fixed_size
+{
+  template<typename U> static std::true_type test(decltype(&U::kSerializedSize));
+  template<typename U> static std::false_type test(...);
+
+public:
+  typedef decltype(test<T>(NULL)) type;
+  static const bool value = type::value;
 };
 
 }  // namespace tinyros
@@ -0,0 +1,137 @@
+#ifndef TINYROS_MSG_VIEW_H_
+#define TINYROS_MSG_VIEW_H_
+#include <stdint.h>
+#include <stddef.h>
+#include <string>
+#include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/time.h"
+#include "tiny_ros/ros/duration.h"
+
+/*
+ * Read-only access to a serialized message where it was received. The
+ * generated XxxView classes and the types below only hold pointers into
+ * the frame, so they are valid for as long as the frame is: within a
+ * view callback, until it returns.
+ */
+namespace tinyros
+{
+/* A little endian primitive at any alignment */
+template<typename T>
+inline T viewRead(const unsigned char* p)
+{
+  T value;
+  Msg::arrToArray(&value, p, 1);
+  return value;
+}
+
+template<>
+inline bool viewRead<bool>(const unsigned char* p)
+{
+  return p[0] != 0;
+}
+
+template<>
+inline Time viewRead<Time>(const unsigned char* p)
+{
+  return Time(viewRead<uint32_t>(p), viewRead<uint32_t>(p + 4));
+}
+
+template<>
+inline Duration viewRead<Duration>(const unsigned char* p)
+{
+  return Duration(viewRead<int32_t>(p), viewRead<int32_t>(p + 4));
+}
+
+/* size elements of a fixed size type, laid out back to back */
+template<typename T>
+class Span
+{
+public:
+  Span() : data_(NULL), size_(0) {}
+  Span(const unsigned char* data, uint32_t size) : data_(data), size_(size) {}
+
+  uint32_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  T operator[](uint32_t i) const { return viewRead<T>(data_ + i * sizeof(T)); }
+
+  /* the elements as they are on the wire, little endian */
+  const unsigned char* data() const { return data_; }
+  uint32_t bytes() const { return size_ * (uint32_t)sizeof(T); }
+
+  /* copies numeric elements out, in host byte order */
+  void copyTo(T* out) const { Msg::arrToArray(out, data_, size_); }
+
+private:
+  const unsigned char* data_;
+  uint32_t size_;
+};
+
+/* A string field: its characters, not nul terminated */
+class StringView : public Span<char>
+{
+public:
+  StringView() {}
+  StringView(const unsigned char* data) : Span<char>(data + 4, viewRead<uint32_t>(data)) {}
+
+  std::string str() const { return std::string((const char*)data(), size()); }
+  uint32_t serializedLength() const { return 4 + size(); }
+};
+
+/*
+ * size elements of a variable size type (strings, messages). Elements
+ * have to be walked to be found: iterate rather than index in a loop.
+ */
+template<typename E>
+class ViewList
+{
+public:
+  class iterator
+  {
+  public:
+    iterator(const unsigned char* p, uint32_t i) : p_(p), i_(i) {}
+    E operator*() const { return E(p_); }
+    iterator& operator++() {
+      p_ += E(p_).serializedLength();
+      i_++;
+      return *this;
+    }
+    bool operator==(const iterator& other) const { return i_ == other.i_; }
+    bool operator!=(const iterator& other) const { return i_ != other.i_; }
+
+  private:
+    const unsigned char* p_;
+    uint32_t i_;
+  };
+
+  ViewList() : data_(NULL), size_(0) {}
+  ViewList(const unsigned char* data, uint32_t size) : data_(data), size_(size) {}
+
+  uint32_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  iterator begin() const { return iterator(data_, 0); }
+  iterator end() const { return iterator(NULL, size_); }
+
+  E operator[](uint32_t i) const {
+    iterator it = begin();
+    while (i-- > 0) {
+      ++it;
+    }
+    return *it;
+  }
+
+  uint32_t serializedLength() const {
+    const unsigned char* p = data_;
+    for (uint32_t i = 0; i < size_; i++) {
+      p += E(p).serializedLength();
+    }
+    return (uint32_t)(p - data_);
+  }
+
+private:
+  const unsigned char* data_;
+  uint32_t size_;
+};
+
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define TINYROS_NODE_HANDLE_H_
 
 #include <stdint.h>
+#include <atomic>
 #include <mutex>
 #include <memory>
 #include "tiny_ros/ros/log.h"
@@ -10,11 +11,13 @@
 #include "tiny_ros/tinyros_msgs/TopicInfo.h"
 #include "tiny_ros/tinyros_msgs/Log.h"
 #include "tiny_ros/ros/hardware_tcp.h"
+#include "tiny_ros/ros/log_ring.h"
 #include "tiny_ros/ros/msg.h"
 #include "tiny_ros/ros/publisher.h"
 #include "tiny_ros/ros/subscriber.h"
 #include "tiny_ros/ros/service_server.h"
 #include "tiny_ros/ros/service_client.h"
+#include "tiny_ros/ros/topic_registry.h"
 
 #define TINYROS_LOG_TOPIC "/tinyrosout"
 
@@ -28,36 +31,65 @@ protected:
   HardwareTcp hardware_;
   
   HardwareTcp loghd_;
+  std::mutex loghd_mutex_; // the log thread and the writer thread both write to loghd_
   bool loghd_keepalive_;
   ThreadPool loghd_thread_pool_;
-  
-  ThreadPool spin_thread_pool_;
-  ThreadPool spin_log_thread_pool_;
-  ThreadPool spin_srv_thread_pool_;
+
+  // log records wait here for the log thread, which sends them batched
+  LogRing log_ring_;
+  uint64_t batch_dropped_; // log thread only, records of batches loghd_ did not take
+  std::string log_prefix_;
+  ThreadPool log_thread_pool_;
+
+  // lowest level anyone listens to, as tinyrosdds last told
+  std::atomic<int> log_level_;
+  // what this node asks for as a /tinyrosout subscriber, guarded by mutex_
+  bool log_request_;
+  tinyros::tinyros_msgs::Log log_request_msg_;
+
+  bool send_started_;
+  ThreadPool send_thread_pool_;
   
   std::mutex mutex_;
 
-  uint8_t message_in[INPUT_SIZE];
   uint8_t message_tmp[INPUT_SIZE];
-  uint8_t message_out[OUTPUT_SIZE];
 
-  Publisher * publishers[MAX_PUBLISHERS];
-  Subscriber_ * subscribers[MAX_SUBSCRIBERS];
+  TopicRegistry registry_; // publishers and subscribers by topic id, guarded by mutex_
+
+  // the topic_info_ of the endpoints, negotiated again whenever tinyrosdds asks
+  std::mutex negotiate_mutex_;
+  // spin thread only, reused so answering tinyrosdds does not allocate
+  std::vector<TopicRegistry::Entry> negotiate_entries_;
+  tinyros::tinyros_msgs::Log negotiate_log_;
+  TopicInfo negotiated_info_;
 
 private:
   
-  virtual void spin_task(const std::shared_ptr<SpinObject> obj) {
-      if((obj != nullptr) && subscribers[obj->id] && obj->message_in){
-        int64_t time_start = (int64_t)tinyros::Time().now().toMSec();
+  virtual void spin_task(SpinObject* obj) {
+      Subscriber_* s = NULL;
+      if (obj != NULL) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        s = registry_.subscriber(obj->id);
+      }
+      if((s != NULL) && obj->message_in && !Executor::cancelled()){
+        int64_t time_start = (int64_t)tinyros::Time::monotonic().toMSec();
         int64_t timeout_time = time_start + 1000;
         
-        subscribers[obj->id]->callback( obj->message_in );
+        if (obj->traced) obj->stamps[TRACE_SPIN_START] = Trace::stamp();
+        s->callback(obj->message_in, obj->length);
+        if (obj->traced) {
+          obj->stamps[TRACE_SPIN_END] = Trace::stamp();
+          getTraceStats(s->topic_)->record(obj->stamps);
+        }
         
-        int64_t time_end = (int64_t)tinyros::Time().now().toMSec();
+        int64_t time_end = (int64_t)tinyros::Time::monotonic().toMSec();
         if (time_end > timeout_time) {
-          tinyros_log_warn("subscriber topic: %s, time escape: %lld(ms)", subscribers[obj->id]->topic_.c_str(), (time_end - time_start));
+          tinyros_log_warn("subscriber topic: %s, time escape: %lld(ms)", s->topic_.c_str(), (time_end - time_start));
         }
       }
+      if (obj != NULL) {
+        spin_pool_.release(obj);
+      }
   }
   
   virtual void keepalive() {
@@ -67,7 +99,7 @@ private:
         if (loghd_.init(ip_addr_)) {
           tinyros::std_msgs::String msg;
           msg.data = node_name_ + "_log";
-          publish(TopicInfo::ID_SESSION_ID, &msg, true);
+          publish(TopicInfo::ID_LOG_SESSION_ID, &msg, true);
         }
 #ifdef WIN32
         Sleep(1000);
@@ -80,25 +112,114 @@ private:
     }
   }
   
+  /* log thread, drains log_ring_ while the log connection is up */
+  void log_task() {
+    uint64_t reported = 0;
+    while (loghd_keepalive_) {
+      if (!loghd_.connected() || !sendLogBatch(reported)) {
+#ifdef WIN32
+        Sleep(10);
+#else
+        usleep(10 * 1000);
+#endif
+      }
+    }
+  }
+
+  /* a tinyros_msgs/Log at out, as Log::serialize() writes it */
+  uint32_t putLog(uint8_t* out, uint8_t level, const char* text, uint32_t length) {
+    uint32_t size = (uint32_t)log_prefix_.size() + length;
+    out[0] = level;
+    Msg::varToArr(out + 1, size);
+    memcpy(out + 5, log_prefix_.data(), log_prefix_.size());
+    memcpy(out + 5 + log_prefix_.size(), text, length);
+    return 5 + size;
+  }
+
+  /*
+   * One frame of ID_LOG with as many records of log_ring_ as fit, back to
+   * back, then those of tinyros_blog_*, which are formatted here;
+   * tinyrosdds hands them to /tinyrosout one by one. The log thread writes
+   * it to loghd_ itself, so a slow log connection never holds up the send
+   * queue. Records dropped since the last batch are reported in it. False
+   * if there was nothing to send.
+   */
+  bool sendLogBatch(uint64_t& reported) {
+    uint64_t dropped = log_ring_.getDropped() + BinaryLog::getDropped() + batch_dropped_;
+    const LogRing::Record* record = log_ring_.front();
+    if (record == NULL && dropped == reported && !BinaryLog::pending()) {
+      return false;
+    }
+    SendFrame* frame = send_pool_.acquire(LOG_BATCH_SIZE + 12);
+    if (frame == NULL) {
+      return false;
+    }
+    uint8_t* out = frame->buffer_ + 11;
+    uint32_t l = 0;
+    uint64_t records = 0;
+    uint64_t last_reported = reported;
+    if (dropped != reported) {
+      char text[128];
+      int n = snprintf(text, sizeof(text), "%llu log messages dropped, the log buffers were full or the log connection failed",
+        (unsigned long long)(dropped - reported));
+      l += putLog(out, tinyros::tinyros_msgs::Log::ROSWARN, text, (uint32_t)n);
+      reported = dropped;
+    }
+    while ((record = log_ring_.front()) != NULL) {
+      uint32_t size = 5 + (uint32_t)log_prefix_.size() + record->length;
+      if (l + size > (uint32_t)LOG_BATCH_SIZE) {
+        if (l > 0) {
+          break;
+        }
+        log_ring_.pop();  // cannot fit a frame of its own
+        continue;
+      }
+      l += putLog(out + l, record->level, record->text, record->length);
+      log_ring_.pop();
+      records++;
+    }
+    BinaryLog::drain([&](int level, const char* text, uint32_t length) {
+      if (l + 5 + (uint32_t)log_prefix_.size() + length > (uint32_t)LOG_BATCH_SIZE) {
+        return false;  // formatted again for the next batch
+      }
+      l += putLog(out + l, (uint8_t)level, text, length);
+      records++;
+      return true;
+    });
+    if (l > 0) {
+      int length = frameMessage(frame, TopicInfo::ID_LOG, (int)l, false);
+      std::unique_lock<std::mutex> lock(loghd_mutex_);
+      if (!loghd_.write(frame->buffer_, length)) {
+        /* the records are out of the rings already, the next batch reports them */
+        batch_dropped_ += records;
+        reported = last_reported;
+      }
+    }
+    send_pool_.release(frame);
+    return true;
+  }
+
 public:
+  enum { LOG_BATCH_SIZE = 16 * 1024 };
+
   NodeHandle()
     : loghd_keepalive_(false)
     , loghd_thread_pool_(1)
-    , spin_thread_pool_(3)
-    , spin_log_thread_pool_(1)
-    , spin_srv_thread_pool_(3)
+    , batch_dropped_(0)
+    , log_thread_pool_(1)
+    , log_level_(tinyros::tinyros_msgs::Log::ROSDEBUG)
+    , log_request_(false)
+    , send_started_(false)
+    , send_thread_pool_(1)
+    , registry_(ID_TOPIC_BASE)
+    , spin_obj_(NULL)
     , topic_list("")
     , service_list("") {
-
-    for (unsigned int i = 0; i < MAX_PUBLISHERS; i++)
-      publishers[i] = NULL;
-
-    for (unsigned int i = 0; i < MAX_SUBSCRIBERS; i++)
-      subscribers[i] = NULL;
   }
 
   ~NodeHandle() {
     exit();
+    releaseSpinObject();
   }
 
   /* Start a named port, which may be network server IP, initialize buffers */
@@ -111,6 +232,11 @@ public:
     ip_addr_ = ip_addr;
     node_name_ = node_name;
 
+    if (!send_started_) {
+      send_started_ = true;
+      send_thread_pool_.schedule(std::bind(&NodeHandleBase_::send_task, this));
+    }
+
     tinyros::std_msgs::String msg;
     if (hardware_.init(ip_addr_)) {
       msg.data = node_name_;
@@ -118,8 +244,10 @@ public:
     }
 
     if(!loghd_keepalive_) {
+      log_prefix_ = std::string("[") + node_name_ + std::string("] ");
       loghd_keepalive_ = true;
       loghd_thread_pool_.schedule(std::bind(&NodeHandleBase_::keepalive, this));
+      log_thread_pool_.schedule(std::bind(&NodeHandle::log_task, this));
     }
     
     return hardware_.connected();
@@ -128,9 +256,10 @@ public:
   virtual void exit() {
     spin_ = false;
     loghd_keepalive_ = false;
-    spin_thread_pool_.shutdown();
-    spin_log_thread_pool_.shutdown();
-    spin_srv_thread_pool_.shutdown();
+    log_thread_pool_.shutdown();
+    send_queue_.shutdown();
+    send_thread_pool_.shutdown();
+    shutdownCallbackGroups();
     loghd_thread_pool_.shutdown();
     
     loghd_.close();
@@ -146,6 +275,14 @@ protected:
   int checksum_;
   bool spin_;
   int total_bytes_;
+  SpinObject* spin_obj_; // payload of the frame being read
+
+  void releaseSpinObject() {
+    if (spin_obj_ != NULL) {
+      spin_pool_.release(spin_obj_);
+      spin_obj_ = NULL;
+    }
+  }
 
 public:
   virtual int spin() {
@@ -155,13 +292,12 @@ public:
 
     {
       std::unique_lock<std::mutex> lock(mutex_);
-      for (unsigned int i = 0; i < MAX_PUBLISHERS; i++) {
-        if (publishers[i] != NULL)
-          publishers[i]->negotiated_ = false;
-      }
-      for (unsigned int i = 0; i < MAX_SUBSCRIBERS; i++) {
-        if (subscribers[i] != NULL)
-          subscribers[i]->negotiated_ = false;
+      std::vector<TopicRegistry::Entry> entries = registry_.entries();
+      for (size_t i = 0; i < entries.size(); i++) {
+        if (entries[i].pub != NULL)
+          entries[i].pub->negotiated_ = false;
+        if (entries[i].sub != NULL)
+          entries[i].sub->negotiated_ = false;
       }
     }
     
@@ -180,7 +316,9 @@ public:
         continue;
       }
       
-      rv = hardware_.read(message_tmp, len);
+      /* the payload is read straight into the pooled buffer of the frame */
+      uint8_t* data = (mode_ == MODE_MESSAGE) ? spin_obj_->message_in + index_ : message_tmp;
+      rv = hardware_.read(data, len);
       if (rv < 0) {
         mode_ = MODE_FIRST_FF;
         return SPIN_ERR;
@@ -188,14 +326,12 @@ public:
       
       
       for (i = 0; i < rv; i++) {
-        checksum_ += message_tmp[i];
+        checksum_ += data[i];
       }
       
       if (mode_ == MODE_MESSAGE) {
-        for (i = 0; i < rv; i++) {
-          message_in[index_++] = message_tmp[i];
-          bytes_--;
-        }
+        index_ += rv;
+        bytes_ -= rv;
 
         if (bytes_ == 0) {
           len = 1;
@@ -245,6 +381,21 @@ public:
         mode_++;
       } else if (mode_ == MODE_TOPIC_H1) {
         topic_ += message_tmp[0] << 24;
+        releaseSpinObject();
+        /* a full subscription queue discards before the payload is read */
+        if ((uint32_t)topic_ >= ID_TOPIC_BASE) {
+          std::unique_lock<std::mutex> lock(mutex_);
+          Subscriber_* s = registry_.subscriber(topic_);
+          if (s != NULL) {
+            discardStale(s);
+          }
+        }
+        spin_obj_ = spin_pool_.acquire(total_bytes_);
+        if (spin_obj_ == NULL) {
+          tinyros_log_error("Input overflow(%d>%d)", total_bytes_, INPUT_SIZE);
+          mode_ = MODE_FIRST_FF;
+          continue;
+        }
         mode_ = MODE_MESSAGE;
         if (bytes_ == 0)
           mode_ = MODE_MSG_CHECKSUM;
@@ -257,51 +408,52 @@ public:
             negotiateTopics();
           } else if (topic_ == TopicInfo::ID_ROSTOPIC_REQUEST) {
             tinyros::std_msgs::String msg;
-            msg.deserialize(message_in);
+            msg.deserialize(spin_obj_->message_in);
             topic_list = msg.data;
             topic_list_recieved = true;
           } else if (topic_ == TopicInfo::ID_ROSSERVICE_REQUEST) {
             tinyros::std_msgs::String msg;
-            msg.deserialize(message_in);
+            msg.deserialize(spin_obj_->message_in);
             service_list = msg.data;
             service_list_recieved = true;
+          } else if (topic_ == TopicInfo::ID_RECORD) {
+            tinyros::std_msgs::String msg;
+            msg.deserialize(spin_obj_->message_in);
+            record_reply = msg.data;
+            record_reply_recieved = true;
+          } else if (topic_ == TopicInfo::ID_LOG_LEVEL) {
+            tinyros::tinyros_msgs::Log msg;
+            msg.deserialize(spin_obj_->message_in);
+            log_level_ = msg.level;
           } else if (topic_ == TopicInfo::ID_TIME) {
-            sync_time(message_in);
+            sync_time(spin_obj_->message_in);
           } else if (topic_ == TopicInfo::ID_NEGOTIATED) {
-            tinyros::tinyros_msgs::TopicInfo ti;
-            ti.deserialize(message_in);
-            for (int i = 0; i < MAX_PUBLISHERS; i++) {
-              if (publishers[i] != NULL && publishers[i]->id_ == ti.topic_id) {
-                publishers[i]->negotiated_ = ti.negotiated;
-              }
+            TopicInfo& ti = negotiated_info_;
+            ti.deserialize(spin_obj_->message_in);
+            std::unique_lock<std::mutex> lock(mutex_);
+            Publisher* p = registry_.publisher(ti.topic_id);
+            if (p != NULL) {
+              p->negotiated_ = ti.negotiated;
             }
-            
-            for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
-              if (subscribers[i] != NULL && subscribers[i]->id_ == ti.topic_id) {
-                subscribers[i]->negotiated_ = ti.negotiated;
-              }
+            Subscriber_* s = registry_.subscriber(ti.topic_id);
+            if (s != NULL) {
+              s->negotiated_ = ti.negotiated;
+              s->negotiatedType(ti.message_type, ti.md5sum);
             }
           } else {
-            int32_t topic = topic_-100;
-            if ((topic >= 0) && (topic < MAX_SUBSCRIBERS)) {
-              if(subscribers[topic]) {
-                std::shared_ptr<SpinObject> obj = std::shared_ptr<SpinObject> (new SpinObject());
-                obj->id = topic;
-                obj->message_in = (uint8_t*)calloc(total_bytes_, sizeof(uint8_t));
-                memcpy(obj->message_in, message_in, total_bytes_);
-                if (subscribers[topic]->topic_ == TINYROS_LOG_TOPIC) {
-                  spin_log_thread_pool_.schedule(std::bind(&NodeHandleBase_::spin_task, this, obj));
-                } else {
-                  if (subscribers[topic]->srv_flag_) {
-                    spin_srv_thread_pool_.schedule(std::bind(&NodeHandleBase_::spin_task, this, obj));
-                  } else {
-                    spin_thread_pool_.schedule(std::bind(&NodeHandleBase_::spin_task, this, obj));
-                  }
-                }
-              }
+            std::unique_lock<std::mutex> lock(mutex_);
+            Subscriber_* s = registry_.subscriber(topic_);
+            if (s != NULL) {
+              /* hand the buffer over, spin_task gives it back to the pool */
+              SpinObject* obj = spin_obj_;
+              spin_obj_ = NULL;
+              obj->id = topic_;
+              traceIncoming(obj, index_);
+              dispatch(s, obj);
             }
           }
         }
+        releaseSpinObject();
       }
     }
 
@@ -317,180 +469,231 @@ public:
   /* Register a new publisher */
   bool advertise(Publisher & p) {
     std::unique_lock<std::mutex> lock(mutex_);
-    for (int i = 0; i < MAX_PUBLISHERS; i++) {
-      if (publishers[i] == NULL) { // empty slot
-        p.id_ = i + 100 + MAX_SUBSCRIBERS;
-        p.nh_ = this;
-        publishers[i] = &p;
-        lock.unlock();
-        negotiateTopics(publishers[i]);
-        tinyros_log_debug("Publishers[%d] topic_id: %d, topic_name: %s", i, p.id_, p.topic_.c_str());
-        return true;
-      }
+    uint32_t id = registry_.add(&p, NULL);
+    if (id == 0) {
+      return false;
+    }
+    p.id_ = id;
+    p.nh_ = this;
+    lock.unlock();
+    if (p.frame_size_ > 0) {
+      reserveFrames(p.frame_size_);
+    }
+    negotiateTopics(&p);
+    tinyros_log_debug("Publisher topic_id: %u, topic_name: %s", p.id_, p.topic_.c_str());
+    return true;
+  }
+
+  /* Remove a publisher, its topic id may be handed out again */
+  bool unadvertise(Publisher & p) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (p.nh_ != this || registry_.publisher(p.id_) != &p) {
+      return false;
     }
-    return false;
+    registry_.remove(p.id_);
+    p.nh_ = NULL;
+    p.negotiated_ = false;
+    lock.unlock();
+    unregisterTopic(p.id_, p.topic_);
+    return true;
   }
 
-  /* Register a new subscriber */
+  /* Register a new subscriber, callbacks run in the named callback group */
   template<typename SubscriberT>
-  bool subscribe(SubscriberT& s) {
+  bool subscribe(SubscriberT& s, std::string callback_group = "") {
     char buffer[512];
+    if (!attachSubscriber(&s, callback_group, s.topic_ == TINYROS_LOG_TOPIC)) {
+      tinyros_log_error("Subscriber topic_name: %s, unknown callback group: %s", s.topic_.c_str(), callback_group.c_str());
+      return false;
+    }
     std::unique_lock<std::mutex> lock(mutex_);
-    for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
-      if (subscribers[i] == 0) {// empty slot
-        s.id_ = i + 100;
-        subscribers[i] = &s;
-        lock.unlock();
-        negotiateTopics(subscribers[i]);
-        tinyros_log_debug("Subscribers[%d] topic_id: %d, topic_name: %s", i, s.id_, s.topic_.c_str());
-        return true;
-      }
+    uint32_t id = registry_.add(NULL, &s);
+    if (id == 0) {
+      return false;
+    }
+    s.id_ = id;
+    lock.unlock();
+    negotiateTopics(&s);
+    tinyros_log_debug("Subscriber topic_id: %u, topic_name: %s", s.id_, s.topic_.c_str());
+    return true;
+  }
+
+  /*
+   * Remove a subscriber, its topic id may be handed out again. Messages
+   * still waiting are dropped; a callback already running is not waited for.
+   */
+  bool unsubscribe(Subscriber_ & s) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (registry_.subscriber(s.id_) != &s) {
+      return false;
     }
-    return false;
+    registry_.remove(s.id_);
+    s.negotiated_ = false;
+    retireSubscriber(&s);
+    lock.unlock();
+    unregisterTopic(s.id_, s.topic_);
+    return true;
   }
 
   /* Register a new Service Server */
   template<typename MReq, typename MRes, typename ObjT>
   bool advertiseService(ServiceServer<MReq, MRes, ObjT>& srv) {
     char buffer[512];
+    srv.callback_group_ = getCallbackGroup(CALLBACK_GROUP_SERVICE);
+    srv.strand_ = srv.callback_group_->strand();
     std::unique_lock<std::mutex> lock(mutex_);
-    for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
-      if (subscribers[i] == NULL) { // empty slot
-        subscribers[i] = &srv;
-        srv.id_ = i + 100;
-        for (int j = 0; j < MAX_PUBLISHERS; j++) {
-          if (publishers[j] == NULL) { // empty slot
-            publishers[j] = &srv.pub;
-            srv.pub.id_ = srv.id_;
-            srv.pub.nh_ = this;
-            lock.unlock();
-            negotiateTopics(subscribers[i]);
-            negotiateTopics(publishers[j]);
-            tinyros_log_debug("advertiseService Subscribers[%d] topic_id: %d, topic_name: %s | Publishers[%d] topic_id: %d, topic_name: %s",
-              i, srv.id_, srv.topic_.c_str(), j, srv.pub.id_, srv.pub.topic_.c_str());
-            return true;
-          }
-        }
-      }
+    uint32_t id = registry_.add(&srv.pub, &srv);
+    if (id == 0) {
+      return false;
     }
-    return false;
+    srv.id_ = id;
+    srv.pub.id_ = id;
+    srv.pub.nh_ = this;
+    lock.unlock();
+    negotiateTopics(&srv);
+    negotiateTopics(&srv.pub);
+    tinyros_log_debug("advertiseService topic_id: %u, topic_name: %s", srv.id_, srv.topic_.c_str());
+    return true;
   }
 
   /* Register a new Service Client */
   template<typename MReq, typename MRes>
   bool serviceClient(ServiceClient<MReq, MRes>& srv) {
     char buffer[512];
+    srv.callback_group_ = getCallbackGroup(CALLBACK_GROUP_SERVICE);
+    srv.strand_ = srv.callback_group_->strand();
     std::unique_lock<std::mutex> lock(mutex_);
-    for (int i = 0; i < MAX_SUBSCRIBERS; i++) {
-      if (subscribers[i] == NULL) { // empty slot
-        subscribers[i] = &srv;
-        srv.id_ = i + 100;
-        for (int j = 0; j < MAX_PUBLISHERS; j++) {
-          if (publishers[j] == NULL) { // empty slot
-            publishers[j] = &srv.pub;
-            srv.pub.id_ = srv.id_;
-            srv.pub.nh_ = this;
-            lock.unlock();
-            negotiateTopics(subscribers[i]);
-            negotiateTopics(publishers[j]);
-            tinyros_log_debug("serviceClient Subscribers[%d] topic_id: %d, topic_name: %s | Publishers[%d] topic_id: %d, topic_name: %s", 
-              i, srv.id_, srv.topic_.c_str(), j, srv.pub.id_, srv.pub.topic_.c_str());
-            return true;
-          }
-        }
-      }
+    uint32_t id = registry_.add(&srv.pub, &srv);
+    if (id == 0) {
+      return false;
     }
-    return false;
+    srv.id_ = id;
+    srv.pub.id_ = id;
+    srv.pub.nh_ = this;
+    lock.unlock();
+    negotiateTopics(&srv);
+    negotiateTopics(&srv.pub);
+    tinyros_log_debug("serviceClient topic_id: %u, topic_name: %s", srv.id_, srv.topic_.c_str());
+    return true;
   }
 
+  /* built once per topic id, getType() returns a new string every call */
   void negotiateTopics(Publisher * p) {
-    tinyros::tinyros_msgs::TopicInfo ti;
-    ti.topic_id = p->id_;
-    ti.topic_name = p->topic_;
-    ti.message_type = p->msg_->getType();
-    ti.md5sum = p->msg_->getMD5();
-    ti.buffer_size = OUTPUT_SIZE;
+    std::unique_lock<std::mutex> lock(negotiate_mutex_);
+    TopicInfo& ti = p->topic_info_;
+    if (ti.topic_id != p->id_) {
+      ti.topic_id = p->id_;
+      ti.topic_name = p->topic_;
+      ti.message_type = p->msg_->getType();
+      ti.md5sum = p->msg_->getMD5();
+      ti.buffer_size = OUTPUT_SIZE;
+    }
     ti.node = node_name_;
     publish(p->getEndpointType(), &ti);
   }
   
+  /* a subscriber of any type keeps asking until it learned one */
   void negotiateTopics(Subscriber_ * s) {
-    tinyros::tinyros_msgs::TopicInfo ti;
-    ti.topic_id = s->id_;
-    ti.topic_name = s->topic_;
-    ti.message_type = s->getMsgType();
-    ti.md5sum = s->getMsgMD5();
-    ti.buffer_size = INPUT_SIZE;
+    std::unique_lock<std::mutex> lock(negotiate_mutex_);
+    TopicInfo& ti = s->topic_info_;
+    if (ti.topic_id != s->id_ || ti.message_type.empty()) {
+      ti.topic_id = s->id_;
+      ti.topic_name = s->topic_;
+      ti.message_type = s->getMsgType();
+      ti.md5sum = s->getMsgMD5();
+      ti.buffer_size = INPUT_SIZE;
+    }
     ti.node = node_name_;
     publish(s->getEndpointType(), &ti);
   }
 
+  /* spin thread */
   void negotiateTopics() {
-    int i;
-    for (i = 0; i < MAX_PUBLISHERS; i++) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (publishers[i] != NULL) { // non-empty slot
-        lock.unlock();
-        negotiateTopics(publishers[i]);
-      }
+    std::unique_lock<std::mutex> lock(mutex_);
+    registry_.entries(negotiate_entries_);
+    std::vector<TopicRegistry::Entry>& entries = negotiate_entries_;
+    lock.unlock();
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (entries[i].pub != NULL)
+        negotiateTopics(entries[i].pub);
     }
-    for (i = 0; i < MAX_SUBSCRIBERS; i++) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      if (subscribers[i] != NULL) { // non-empty slot
-        lock.unlock();
-        negotiateTopics(subscribers[i]);
-      }
+    for (size_t i = 0; i < entries.size(); i++) {
+      if (entries[i].sub != NULL)
+        negotiateTopics(entries[i].sub);
+    }
+    lock.lock();
+    if (log_request_) {
+      negotiate_log_ = log_request_msg_;
+      lock.unlock();
+      publish(TopicInfo::ID_LOG_LEVEL, &negotiate_log_);
     }
   }
 
+  void unregisterTopic(uint32_t id, std::string topic_name) {
+    tinyros::tinyros_msgs::TopicInfo ti;
+    ti.topic_id = id;
+    ti.topic_name = topic_name;
+    ti.node = node_name_;
+    publish(TopicInfo::ID_UNREGISTER, &ti);
+  }
+
   virtual int publish(uint32_t id, const Msg * msg, bool islog = false) {
-    std::unique_lock<std::mutex> lock(mutex_);
-    /* serialize message */
-    int l = msg->serialize(message_out + 11);
-
-    /* setup the header */
-    message_out[0] = 0xff;
-    message_out[1] = PROTOCOL_VER;
-    message_out[2] = (uint8_t)((uint32_t)l & 0xFF);
-    message_out[3] = (uint8_t)((uint32_t)((l >> 8) & 0xFF));
-    message_out[4] = (uint8_t)((uint32_t)((l >> 16) & 0xFF));
-    message_out[5] = (uint8_t)((uint32_t)((l >> 24) & 0xFF));
-    message_out[6] = 255 - ((message_out[2] + message_out[3] + message_out[4] + message_out[5]) % 256);
-    message_out[7] = (uint8_t)((uint32_t)id & 0xFF);
-    message_out[8] = (uint8_t)((uint32_t)((id >> 8) & 0xFF));
-    message_out[9] = (uint8_t)((uint32_t)((id >> 16) & 0xFF));
-    message_out[10] = (uint8_t)((uint32_t)((id >> 24) & 0xFF));
-
-    /* calculate checksum */
-    int chk = 0;
-    for (int i = 7; i < l + 11; i++)
-      chk += message_out[i];
-    l += 11;
-    message_out[l++] = 255 - (chk % 256);
-
-    if (l <= OUTPUT_SIZE) {
-      if (!islog) {
-        l = hardware_.write(message_out, l) ? l : -1;
-      } else {
-        l = loghd_.write(message_out, l) ? l : -1;
-      }
-      lock.unlock();
-      return l;
+    if (!connected(islog)) {
+      return -1;
+    }
+    return enqueue(id, msg, islog);
+  }
+
+  virtual bool connected(bool islog) {
+    return islog ? loghd_.connected() : hardware_.connected();
+  }
+
+  /* called from the writer thread only */
+  virtual bool write(uint8_t* data, int length, bool islog) {
+    if (!islog) {
+      return hardware_.write(data, length);
     } else {
-      lock.unlock();
-      return -2;
+      std::unique_lock<std::mutex> lock(loghd_mutex_);
+      return loghd_.write(data, length);
     }
   }
 
   void log(char byte, std::string msg) {
-    if (loghd_.connected()) {
-      tinyros::tinyros_msgs::Log l;
-      l.level = byte;
-      l.msg = std::string("[") + node_name_ + std::string("] ") + msg;
-      publish(tinyros::tinyros_msgs::TopicInfo::ID_LOG, &l, true);
+    log(byte, msg.data(), (uint32_t)msg.size());
+  }
+
+  /* never waits: the record is queued for the log thread, or counted as dropped */
+  void log(char byte, const char* text, uint32_t length) {
+    if (byte >= log_level_.load(std::memory_order_relaxed)) {
+      log_ring_.push((uint8_t)byte, text, length);
     }
   }
 
+  /* records below this level are not sent, nobody listens to them */
+  int getLogLevel() {
+    return log_level_.load(std::memory_order_relaxed);
+  }
+
+  /*
+   * For nodes that subscribe to /tinyrosout: the levels they want, which
+   * tinyrosdds passes on to the nodes that log. overrides is a list of
+   * "node=level", node may be a pattern. Repeated on every negotiation.
+   */
+  void requestLogLevel(int level, const std::string& overrides = "") {
+    std::unique_lock<std::mutex> lock(mutex_);
+    log_request_ = true;
+    log_request_msg_.level = (uint8_t)level;
+    log_request_msg_.msg = overrides;
+    tinyros::tinyros_msgs::Log request = log_request_msg_;
+    lock.unlock();
+    publish(TopicInfo::ID_LOG_LEVEL, &request);
+  }
+
+  /* log records dropped because they came faster than they could be sent */
+  uint64_t getLogDropped() {
+    return log_ring_.getDropped() + BinaryLog::getDropped();
+  }
+
   /*********************************************************************/
   private:
     bool topic_list_recieved;
@@ -499,16 +702,19 @@ public:
     bool service_list_recieved;
     std::string service_list;
 
+    bool record_reply_recieved;
+    std::string record_reply;
+
   public:
     std::string getTopicList(int timeout = 1000)
     {
       tinyros::std_msgs::String msg;
       topic_list_recieved = false;
       publish(TopicInfo::ID_ROSTOPIC_REQUEST, &msg);
-      int64_t to = (int64_t)(tinyros::Time().now().toMSec() + timeout);
+      int64_t to = (int64_t)(tinyros::Time::monotonic().toMSec() + timeout);
       while (!topic_list_recieved)
       {
-        int64_t now = (int64_t)tinyros::Time().now().toMSec();
+        int64_t now = (int64_t)tinyros::Time::monotonic().toMSec();
         if (now > to ) {
           printf("Failed to get getTopicList: timeout expired\n");
           return "";
@@ -527,10 +733,10 @@ public:
       tinyros::std_msgs::String msg;
       service_list_recieved = false;
       publish(TopicInfo::ID_ROSSERVICE_REQUEST, &msg);
-      int64_t to = (int64_t)(tinyros::Time().now().toMSec() + timeout);
+      int64_t to = (int64_t)(tinyros::Time::monotonic().toMSec() + timeout);
       while (!service_list_recieved)
       {
-        int64_t now = (int64_t)tinyros::Time().now().toMSec();
+        int64_t now = (int64_t)tinyros::Time::monotonic().toMSec();
         if (now > to) {
           printf("Failed to get getServiceList: timeout expired\n");
           return "";
@@ -543,6 +749,30 @@ public:
       }
       return service_list;
     }
+
+    /* Sends a command to the recorder of tinyrosdds, returns its reply */
+    std::string record(const std::string& command, int timeout = 3000)
+    {
+      tinyros::std_msgs::String msg;
+      msg.data = command;
+      record_reply_recieved = false;
+      publish(TopicInfo::ID_RECORD, &msg);
+      int64_t to = (int64_t)(tinyros::Time::monotonic().toMSec() + timeout);
+      while (!record_reply_recieved)
+      {
+        int64_t now = (int64_t)tinyros::Time::monotonic().toMSec();
+        if (now > to) {
+          printf("Failed to get record: timeout expired\n");
+          return "";
+        }
+#ifdef WIN32
+        Sleep(100);
+#else
+        usleep(100*1000);
+#endif
+      }
+      return record_reply;
+    }
 };
 
 NodeHandle* nh();
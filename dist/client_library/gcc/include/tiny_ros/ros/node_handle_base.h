@@ -4,14 +4,23 @@
 #include <stdint.h>
 #include <mutex>
 #include <memory>
+#include <map>
+#include <vector>
 #include "tiny_ros/ros/time.h"
+#include "tiny_ros/ros/clock_sync.h"
+#include "tiny_ros/ros/trace.h"
+#include "tiny_ros/ros/send_queue.h"
+#include "tiny_ros/ros/buffer_pool.h"
+#include "tiny_ros/ros/executor.h"
+#include "tiny_ros/ros/subscriber.h"
 #include "tiny_ros/tinyros_msgs/SyncTime.h"
+#include "tiny_ros/tinyros_msgs/TopicInfo.h"
 
 namespace tinyros {
-const int MAX_SUBSCRIBERS = 100;
-const int MAX_PUBLISHERS = 100;
 const int INPUT_SIZE = 64*1024; // bytes
 const int OUTPUT_SIZE = 64*1024; // bytes
+const int RESERVED_FRAMES = 8; // pooled up front for each fixed size publisher
+const int CONTROL_SIZE = 256; // bytes, frames of TopicInfo, SyncTime and the like, pooled up front
 
 const uint8_t MODE_FIRST_FF = 0;
 const uint8_t MODE_PROTOCOL_VER   = 1;
@@ -31,14 +40,112 @@ const uint8_t MODE_MSG_CHECKSUM   = 12;
 const int SPIN_OK = 0;
 const int SPIN_ERR = -1;
 
-const int SYNC_TIME_SCOPE = 10;  // milliseconds
+const int SYNC_TIME_SCOPE = 10;  // milliseconds, for the broadcast until an exchange was answered
 
+const uint32_t ID_TOPIC_BASE = 100; // ids below are reserved for TopicInfo::ID_*
+
+const char* const CALLBACK_GROUP_DEFAULT = "default";         // ORDERED, pool sized to the machine
+const char* const CALLBACK_GROUP_LOG = "tinyros_log";         // MUTUALLY_EXCLUSIVE, one thread
+const char* const CALLBACK_GROUP_SERVICE = "tinyros_service"; // REENTRANT, three threads
+
+/* A received message on its way to a subscriber callback, recycled through SpinObjectPool */
 class SpinObject {
 public:
   uint32_t id;
-  uint8_t *message_in;
-  SpinObject() { message_in = NULL; }
-  ~SpinObject() { if(message_in) free((void*)message_in); }
+  uint8_t *message_in; // payload, points into buffer_
+  uint32_t length; // bytes of the payload, without a trace trailer
+  bool traced;
+  uint64_t stamps[TRACE_STAMPS];
+  SpinObject* next_;
+  uint8_t* buffer_;
+  int capacity_;
+  int size_class_;
+  SpinObject(int capacity, int size_class) {
+    id = 0;
+    length = 0;
+    traced = false;
+    next_ = NULL;
+    capacity_ = capacity;
+    size_class_ = size_class;
+    buffer_ = (uint8_t*)malloc(capacity_);
+    message_in = buffer_;
+  }
+  ~SpinObject() { if(buffer_) free((void*)buffer_); }
+};
+typedef BufferPool<SpinObject> SpinObjectPool;
+
+/*
+ * Messages of one subscription waiting for its callback, at most
+ * capacity of them. Every message that enters posts one delivery task
+ * that takes the oldest waiting message; when a message is evicted its
+ * task is left to deliver a newer one instead.
+ */
+class SpinInbox {
+public:
+  SpinInbox(int capacity)
+    : objects_(capacity > 0 ? capacity : 1, NULL)
+    , head_(0)
+    , count_(0)
+    , orphans_(0) {}
+
+  /* drop the oldest message if the inbox is full, NULL otherwise */
+  SpinObject* evict() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return count_ == objects_.size() ? evictLocked() : NULL;
+  }
+
+  /* false if the message rides on the task of an evicted one */
+  bool push(SpinObject* obj, SpinObject*& evicted) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    evicted = (count_ == objects_.size()) ? evictLocked() : NULL;
+    objects_[(head_ + count_) % objects_.size()] = obj;
+    count_++;
+    if (orphans_ > 0) {
+      orphans_--;
+      return false;
+    }
+    return true;
+  }
+
+  /* called by the delivery tasks only, NULL if their message was discarded */
+  SpinObject* pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (count_ == 0) {
+      if (orphans_ > 0) orphans_--;
+      return NULL;
+    }
+    SpinObject* obj = objects_[head_];
+    head_ = (head_ + 1) % objects_.size();
+    count_--;
+    return obj;
+  }
+
+  /* take a waiting message, its task is left behind; NULL if none waits */
+  SpinObject* discard() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return count_ > 0 ? evictLocked() : NULL;
+  }
+
+  /* no delivery task is posted, so nothing refers to the inbox any more */
+  bool idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return count_ == 0 && orphans_ == 0;
+  }
+
+private:
+  SpinObject* evictLocked() {
+    SpinObject* obj = objects_[head_];
+    head_ = (head_ + 1) % objects_.size();
+    count_--;
+    orphans_++;
+    return obj;
+  }
+
+  std::mutex mutex_;
+  std::vector<SpinObject*> objects_;
+  size_t head_;
+  size_t count_;
+  int orphans_;
 };
 
 class NodeHandleBase_
@@ -47,23 +154,398 @@ protected:
   std::string ip_addr_;
   std::string node_name_;
 
+  bool trace_;
+  std::mutex trace_mutex_;
+  std::map<std::string, TraceStatsPtr> trace_stats_;
+
+  SendFramePool send_pool_;
+  SendQueue send_queue_;
+
+  SpinObjectPool spin_pool_;
+
+  ClockSync clock_sync_;
+
+  bool single_threaded_;
+  std::mutex groups_mutex_;
+  std::map<std::string, CallbackGroupPtr> callback_groups_;
+
+  /* strands and inboxes of removed subscribers that tasks may still reach */
+  struct Retired
+  {
+    StrandPtr strand;
+    std::shared_ptr<SpinInbox> inbox;
+  };
+  std::vector<Retired> retired_;  // guarded by the subscriber lock of the NodeHandle
+
+  /* an empty name picks the built-in group matching the subscription */
+  CallbackGroupPtr resolveCallbackGroup(std::string name, bool srv, bool log) {
+    if (name.empty()) {
+      name = srv ? CALLBACK_GROUP_SERVICE : (log ? CALLBACK_GROUP_LOG : CALLBACK_GROUP_DEFAULT);
+    }
+    return getCallbackGroup(name);
+  }
+
+  /* bind the subscription to its callback group and queue */
+  bool attachSubscriber(Subscriber_* s, std::string callback_group, bool log) {
+    CallbackGroupPtr group = resolveCallbackGroup(callback_group, s->srv_flag_, log);
+    if (group == nullptr) {
+      return false;
+    }
+    s->callback_group_ = group;
+    s->strand_ = group->strand();
+    if (s->queue_size_ > 0) {
+      int capacity = (s->queue_policy_ == Subscriber_::QUEUE_KEEP_LATEST) ? 1 : s->queue_size_;
+      s->inbox_ = std::shared_ptr<SpinInbox>(new SpinInbox(capacity));
+    }
+    return true;
+  }
+
+  /*
+   * With the subscriber lock held: drop the messages waiting for s and
+   * keep its strand and inbox until the tasks already posted are done.
+   * Strands of MUTUALLY_EXCLUSIVE groups belong to the group and stay.
+   */
+  void retireSubscriber(Subscriber_* s) {
+    Retired retired;
+    if (s->strand_ && s->strand_.use_count() == 1) {
+      retired.strand = s->strand_;
+    }
+    if (s->inbox_) {
+      SpinObject* obj;
+      while ((obj = s->inbox_->discard()) != NULL) {
+        spin_pool_.release(obj);
+      }
+      retired.inbox = s->inbox_;
+    }
+    s->strand_ = nullptr;
+    s->inbox_ = nullptr;
+    reapRetired();
+    if (retired.strand || retired.inbox) {
+      retired_.push_back(retired);
+    }
+  }
+
+  /* free the retired entries nothing but retired_ refers to any more */
+  void reapRetired() {
+    for (size_t i = 0; i < retired_.size();) {
+      Retired& retired = retired_[i];
+      bool done = (!retired.strand || (retired.strand.use_count() == 1 && retired.strand->idle()))
+        && (!retired.inbox || (retired.inbox.use_count() == 1 && retired.inbox->idle()));
+      if (done) {
+        retired_[i] = retired_.back();
+        retired_.pop_back();
+      } else {
+        i++;
+      }
+    }
+  }
+
+  /* make room before the next message of a full subscription is read */
+  void discardStale(Subscriber_* s) {
+    if (s->inbox_) {
+      SpinObject* stale = s->inbox_->evict();
+      if (stale != NULL) {
+        s->dropped_++;
+        spin_pool_.release(stale);
+      }
+    }
+  }
+
+  /* hand a received message to the callback group of its subscription */
+  void dispatch(Subscriber_* s, SpinObject* obj) {
+    /* two pointers fit the small object buffer of std::function */
+    if (!s->inbox_) {
+      s->callback_group_->post(s->strand_, [this, obj]() { spin_task(obj); });
+      return;
+    }
+    SpinInbox* inbox = s->inbox_.get();
+    SpinObject* evicted = NULL;
+    bool post = inbox->push(obj, evicted);
+    if (evicted != NULL) {
+      s->dropped_++;
+      spin_pool_.release(evicted);
+    }
+    if (post) {
+      s->callback_group_->post(s->strand_, [this, inbox]() {
+        SpinObject* obj = inbox->pop();
+        if (obj != NULL) spin_task(obj);
+      });
+    }
+  }
+
+  void shutdownCallbackGroups() {
+    std::unique_lock<std::mutex> lock(groups_mutex_);
+    std::map<std::string, CallbackGroupPtr>::iterator it;
+    for (it = callback_groups_.begin(); it != callback_groups_.end(); it++) {
+      it->second->executor()->shutdown();
+    }
+  }
+
+  /* serialize into a pooled frame and queue it for the writer thread */
+  int enqueue(uint32_t id, const Msg* msg, bool islog) {
+    int64_t start = SendQueue::now();
+    bool traced = trace_ && !islog && id >= ID_TOPIC_BASE;
+    SendFrame* frame = send_pool_.acquire(msg->serializedLength() + (traced ? TRACE_SIZE : 0) + 12);
+    if (frame == NULL) {
+      return -2;
+    }
+    int l = msg->serialize(frame->buffer_ + 11);
+    return pushFrame(frame, id, l, traced, islog, start);
+  }
+
+  /* frame the serialized message of length l at buffer_ + 11 and queue it */
+  int pushFrame(SendFrame* frame, uint32_t id, int l, bool traced, bool islog, int64_t start) {
+    l = frameMessage(frame, id, l, traced);
+    frame->islog_ = islog;
+    frame->time_sync_ = (id == tinyros::tinyros_msgs::TopicInfo::ID_TIME);
+    if (!send_queue_.push(frame)) {
+      send_pool_.release(frame);
+      return -1;
+    }
+    send_queue_.recordPublish(start);
+    return l;
+  }
+
+  /* header and checksums around the message of length l at buffer_ + 11, the length of the frame */
+  int frameMessage(SendFrame* frame, uint32_t id, int l, bool traced) {
+    /* the trace trailer goes behind the body */
+    uint8_t* message_out = frame->buffer_;
+    if (traced) {
+      l += Trace::append(message_out + 11, l, Trace::stamp());
+    }
+
+    /* setup the header */
+    message_out[0] = 0xff;
+    message_out[1] = PROTOCOL_VER;
+    message_out[2] = (uint8_t)((uint32_t)l & 0xFF);
+    message_out[3] = (uint8_t)((uint32_t)((l >> 8) & 0xFF));
+    message_out[4] = (uint8_t)((uint32_t)((l >> 16) & 0xFF));
+    message_out[5] = (uint8_t)((uint32_t)((l >> 24) & 0xFF));
+    message_out[6] = 255 - ((message_out[2] + message_out[3] + message_out[4] + message_out[5]) % 256);
+    message_out[7] = (uint8_t)((uint32_t)id & 0xFF);
+    message_out[8] = (uint8_t)((uint32_t)((id >> 8) & 0xFF));
+    message_out[9] = (uint8_t)((uint32_t)((id >> 16) & 0xFF));
+    message_out[10] = (uint8_t)((uint32_t)((id >> 24) & 0xFF));
+
+    /* calculate checksum */
+    int chk = 0;
+    for (int i = 7; i < l + 11; i++)
+      chk += message_out[i];
+    l += 11;
+    message_out[l++] = 255 - (chk % 256);
+
+    frame->length_ = l;
+    return l;
+  }
+
+  virtual bool write(uint8_t*, int, bool) { return false; }
+
+  /* set the payload length of a received user message and pick up its stamps */
+  void traceIncoming(SpinObject* obj, uint32_t length) {
+    const uint8_t* trailer = Trace::find(obj->message_in, length);
+    obj->length = trailer ? length - TRACE_SIZE : length;
+    obj->traced = false;
+    if (trace_ && trailer) {
+      memset(obj->stamps, 0, sizeof(obj->stamps));
+      for (int hop = TRACE_PUBLISH; hop <= TRACE_DDS_DEQUEUE; hop++) {
+        obj->stamps[hop] = Trace::getStamp(trailer, hop);
+      }
+      obj->stamps[TRACE_SUB_RECV] = Trace::stamp();
+      obj->traced = true;
+    }
+  }
+
 public:
+  NodeHandleBase_() : trace_(false), send_pool_(OUTPUT_SIZE), spin_pool_(INPUT_SIZE), single_threaded_(false) {
+    /* answering tinyrosdds finds its frames pooled, however few messages went before */
+    send_pool_.reserve(CONTROL_SIZE, RESERVED_FRAMES);
+    spin_pool_.reserve(CONTROL_SIZE, RESERVED_FRAMES);
+  }
+
+  /* Run the default callback group on one thread, call before subscribing */
+  void setSingleThreaded(bool enable) {
+    single_threaded_ = enable;
+  }
+
+  /*
+   * Create a named callback group to pass to subscribe(). threads == 0
+   * shares the executor of the default group, threads == 1 gives the
+   * group its own thread and threads > 1 its own work stealing pool.
+   */
+  bool createCallbackGroup(std::string name, CallbackGroup::Type type, int threads = 0) {
+    ExecutorPtr executor;
+    if (threads == 0) {
+      executor = getCallbackGroup(CALLBACK_GROUP_DEFAULT)->executor();
+    }
+    std::unique_lock<std::mutex> lock(groups_mutex_);
+    if (callback_groups_.count(name)) {
+      return false;
+    }
+    if (threads == 1) {
+      executor = ExecutorPtr(new SingleThreadedExecutor());
+    } else if (threads > 1) {
+      executor = ExecutorPtr(new WorkStealingExecutor(threads));
+    }
+    callback_groups_[name] = CallbackGroupPtr(new CallbackGroup(name, type, executor));
+    return true;
+  }
+
+  /* NULL if no group of that name exists, built-in groups are created on first use */
+  CallbackGroupPtr getCallbackGroup(std::string name) {
+    std::unique_lock<std::mutex> lock(groups_mutex_);
+    if (callback_groups_.count(name)) {
+      return callback_groups_[name];
+    }
+    CallbackGroupPtr group = nullptr;
+    if (name == CALLBACK_GROUP_DEFAULT) {
+      ExecutorPtr executor = single_threaded_ ? ExecutorPtr(new SingleThreadedExecutor()) : ExecutorPtr(new WorkStealingExecutor());
+      group = CallbackGroupPtr(new CallbackGroup(name, CallbackGroup::ORDERED, executor));
+    } else if (name == CALLBACK_GROUP_LOG) {
+      group = CallbackGroupPtr(new CallbackGroup(name, CallbackGroup::MUTUALLY_EXCLUSIVE, ExecutorPtr(new SingleThreadedExecutor())));
+    } else if (name == CALLBACK_GROUP_SERVICE) {
+      group = CallbackGroupPtr(new CallbackGroup(name, CallbackGroup::REENTRANT, ExecutorPtr(new WorkStealingExecutor(3))));
+    } else {
+      return nullptr;
+    }
+    callback_groups_[name] = group;
+    return group;
+  }
+
+  /*
+   * Publish returns once the frame is queued for the writer thread. With
+   * POLICY_BLOCK publishers wait while capacity frames are queued, with
+   * POLICY_DROP the message is dropped and publish returns -1.
+   */
+  void setPublishPolicy(SendQueue::Policy policy, int capacity = 1024) {
+    send_queue_.setPolicy(policy);
+    send_queue_.setCapacity(capacity);
+  }
+
+  /* queue counters and publish / send latencies */
+  std::string getPublishStats() {
+    return send_queue_.report();
+  }
+
+  /* Stamp outgoing user messages and aggregate per-hop latencies of traced incoming ones */
+  void setTrace(bool enable) {
+    trace_ = enable;
+  }
+
+  bool getTrace() {
+    return trace_;
+  }
+
+  TraceStatsPtr getTraceStats(std::string topic) {
+    std::unique_lock<std::mutex> lock(trace_mutex_);
+    if (!trace_stats_.count(topic)) {
+      trace_stats_[topic] = TraceStatsPtr(new TraceStats());
+    }
+    return trace_stats_[topic];
+  }
+
   virtual bool initNode(std::string node_name, std::string ip_addr) { return false; }
   virtual int publish(uint32_t id, const Msg* msg, bool islog = false) { return 0; }
+  virtual bool connected(bool) { return false; }
+
+  /*
+   * publish() for messages with a constant serialized size: the frame
+   * is sized without asking the message and serialize is called
+   * directly instead of through the vtable.
+   */
+  template<typename MsgT>
+  int publishFixed(uint32_t id, const MsgT* msg, bool islog = false) {
+    if (!connected(islog)) {
+      return -1;
+    }
+    int64_t start = SendQueue::now();
+    bool traced = trace_ && !islog && id >= ID_TOPIC_BASE;
+    SendFrame* frame = send_pool_.acquire(MsgT::kSerializedSize + (traced ? TRACE_SIZE : 0) + 12);
+    if (frame == NULL) {
+      return -2;
+    }
+    int l = msg->MsgT::serialize(frame->buffer_ + 11);
+    return pushFrame(frame, id, l, traced, islog, start);
+  }
+
+  /* how well Time::dds() agrees with tinyrosdds */
+  SyncQuality getSyncQuality() {
+    return clock_sync_.quality();
+  }
+
+  /* keep count frames for messages of size bytes in the pool */
+  void reserveFrames(int size, int count = RESERVED_FRAMES) {
+    send_pool_.reserve(size + TRACE_SIZE + 12, count);
+  }
   virtual int spin() { return -1; }
   virtual void exit() {}
   virtual bool ok() { return false; }
-  virtual void spin_task(const std::shared_ptr<SpinObject> obj) {}
+  virtual void spin_task(SpinObject*) {}
   virtual void keepalive() {}
+
+  /* writer thread, drains the send queue until exit() */
+  void send_task() {
+    while (true) {
+      SendFrame* frame = send_queue_.pop(100);
+      if (frame) {
+        if (frame->time_sync_) {
+          timeDequeue(frame);
+        }
+        send_queue_.recordWrite(frame, write(frame->buffer_, frame->length_, frame->islog_));
+        send_pool_.release(frame);
+      } else if (!send_queue_.started()) {
+        break;
+      }
+    }
+  }
+
+  /*
+   * The send time of SyncTime, see requestSyncTime(): the time spent queued
+   * behind data frames would otherwise lengthen the way out only and bias
+   * the offset by half of it.
+   */
+  void timeDequeue(SendFrame* frame) {
+    /* 11 bytes of header before the payload, its checksum after it, see frameMessage() */
+    uint8_t* message_out = frame->buffer_;
+    tinyros::tinyros_msgs::SyncTime request;
+    request.deserialize(message_out + 11);
+    request.data = Time::monotonic();
+    request.serialize(message_out + 11);
+
+    int chk = 0;
+    for (int i = 7; i < frame->length_ - 1; i++)
+      chk += message_out[i];
+    message_out[frame->length_ - 1] = 255 - (chk % 256);
+  }
+
+  /* the answer comes back to sync_time(), see ClockSync */
+  void requestSyncTime() {
+     tinyros::tinyros_msgs::SyncTime request;
+     request.data = Time::monotonic(); // stamped again by timeDequeue()
+     publish(tinyros::tinyros_msgs::TopicInfo::ID_TIME, &request);
+  }
+
   virtual void sync_time(unsigned char* data) {
      tinyros::tinyros_msgs::SyncTime t;
      t.deserialize(data);
-     int64_t now = (int64_t)(Time::now().toMSec());
+     Time monotonic = Time::monotonic();
+     if (t.request.sec != 0 || t.request.nsec != 0) {
+        clock_sync_.update(t.request, t.receive, t.data, monotonic);
+        if (clock_sync_.warmingUp()) {
+           requestSyncTime();
+        }
+        return;
+     }
+
+     /* the broadcast of every second starts an exchange, and sets the clock itself until one was answered */
+     requestSyncTime();
+     if (clock_sync_.synced()) {
+        return;
+     }
+     int64_t now = (int64_t)(monotonic.toMSec());
      std::unique_lock<std::mutex> lock(Time::mutex_);
      int64_t scope = now - Time::time_last_ - t.tick;
      if ((Time::time_start_ == 0) || (scope >= 0 && scope <= SYNC_TIME_SCOPE)) {
-        Time::time_dds_ = (int64_t)(t.data.toMSec());
-        Time::time_start_ = now;
+        Time::setDDS(t.data, monotonic);
      }
      Time::time_last_ = now;
   }
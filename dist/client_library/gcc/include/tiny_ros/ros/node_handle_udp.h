@@ -17,14 +17,14 @@ class NodeHandleUdp: public NodeHandleBase_
 private:
   HardwareUdp hardware_;
   std::mutex mutex_;
-  uint8_t message_in[INPUT_SIZE];
-  uint8_t message_out[OUTPUT_SIZE];
 
   bool spin_;
-  ThreadPool spin_thread_pool_;
   
   bool negotiate_keepalive_;
   ThreadPool negotiate_thread_pool_;
+
+  bool send_started_;
+  ThreadPool send_thread_pool_;
   
   std::map<uint32_t, Publisher*> publishers_;
   std::map<uint32_t, Subscriber_ *> subscribers_;
@@ -58,18 +58,32 @@ private:
     return h;
   }
   
-  virtual void spin_task(const std::shared_ptr<SpinObject> obj) {
-    if((obj != nullptr) && obj->message_in){
-      int64_t time_start = (int64_t)tinyros::Time().now().toMSec();
+  virtual void spin_task(SpinObject* obj) {
+    Subscriber_* s = NULL;
+    if (obj != NULL) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      std::map<uint32_t, Subscriber_*>::iterator it = subscribers_.find(obj->id);
+      s = (it != subscribers_.end()) ? it->second : NULL;
+    }
+    if((s != NULL) && obj->message_in && !Executor::cancelled()){
+      int64_t time_start = (int64_t)tinyros::Time::monotonic().toMSec();
       int64_t timeout_time = time_start + 1000;
 
-      subscribers_[obj->id]->callback(obj->message_in );
+      if (obj->traced) obj->stamps[TRACE_SPIN_START] = Trace::stamp();
+      s->callback(obj->message_in, obj->length);
+      if (obj->traced) {
+        obj->stamps[TRACE_SPIN_END] = Trace::stamp();
+        getTraceStats(s->topic_)->record(obj->stamps);
+      }
       
-      int64_t time_end = (int64_t)tinyros::Time().now().toMSec();
+      int64_t time_end = (int64_t)tinyros::Time::monotonic().toMSec();
       if (time_end > timeout_time) {
-        tinyros_log_warn("subscriber topic: %s, time escape: %lld(ms)", subscribers_[obj->id]->topic_.c_str(), (time_end - time_start));
+        tinyros_log_warn("subscriber topic: %s, time escape: %lld(ms)", s->topic_.c_str(), (time_end - time_start));
       }
     }
+    if (obj != NULL) {
+      spin_pool_.release(obj);
+    }
   }
 
   void negotiateTopics(Publisher * p) {
@@ -95,22 +109,27 @@ private:
   }
 
   void negotiateTopics() {
+    /* copies, unadvertise and unsubscribe may run meanwhile */
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::map<uint32_t, Publisher*> publishers = publishers_;
+    std::map<uint32_t, Subscriber_*> subscribers = subscribers_;
+    lock.unlock();
     std::map<uint32_t, Publisher*>::iterator pit;
     std::map<uint32_t, Subscriber_*>::iterator sit;
-    std::unique_lock<std::mutex> lock(mutex_);
-    for(pit = publishers_.begin(); pit != publishers_.end(); pit++) {
-      Publisher* p = pit->second;
-      lock.unlock();
-      negotiateTopics(p);
-      lock.lock();
+    for(pit = publishers.begin(); pit != publishers.end(); pit++) {
+      negotiateTopics(pit->second);
     }
-    for(sit = subscribers_.begin(); sit != subscribers_.end(); sit++) {
-      Subscriber_* s = sit->second;
-      lock.unlock();
-      negotiateTopics(s);
-      lock.lock();
+    for(sit = subscribers.begin(); sit != subscribers.end(); sit++) {
+      negotiateTopics(sit->second);
     }
-    lock.unlock();
+  }
+
+  void unregisterTopic(uint32_t id, std::string topic_name) {
+    tinyros::tinyros_msgs::TopicInfo ti;
+    ti.topic_id = id;
+    ti.topic_name = topic_name;
+    ti.node = node_name_;
+    publish(tinyros::tinyros_msgs::TopicInfo::ID_UNREGISTER, &ti);
   }
 
   virtual void keepalive() {
@@ -126,8 +145,9 @@ private:
 
 public:
   NodeHandleUdp()
-    : spin_thread_pool_(3)
-    , negotiate_thread_pool_(1) {
+    : negotiate_thread_pool_(1)
+    , send_started_(false)
+    , send_thread_pool_(1) {
   }
   
   ~NodeHandleUdp() {
@@ -141,13 +161,20 @@ public:
       negotiate_keepalive_ = true;
       negotiate_thread_pool_.schedule(std::bind(&NodeHandleBase_::keepalive, this));
     }
+
+    if (!send_started_) {
+      send_started_ = true;
+      send_thread_pool_.schedule(std::bind(&NodeHandleBase_::send_task, this));
+    }
     
     return hardware_.init(ip_addr_);
   }
   
   virtual void exit() {
     spin_ = false;
-    spin_thread_pool_.shutdown();
+    send_queue_.shutdown();
+    send_thread_pool_.shutdown();
+    shutdownCallbackGroups();
     hardware_.close();
   }
     
@@ -157,24 +184,38 @@ public:
   
    /* Register a new publisher */
   bool advertise(Publisher & p) {
-    if (publishers_.size() >= MAX_PUBLISHERS) {
-      return false;
-    }
-    
     std::unique_lock<std::mutex> lock(mutex_);
     p.id_ = generate_id();
     p.nh_ = this;
     p.negotiated_ = true;
     publishers_[p.id_] = &p;
     lock.unlock();
+    if (p.frame_size_ > 0) {
+      reserveFrames(p.frame_size_);
+    }
     negotiateTopics(&p);
     return true;
   }
 
-  /* Register a new subscriber */
+  /* Remove a publisher */
+  bool unadvertise(Publisher & p) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (p.nh_ != this || !publishers_.count(p.id_)) {
+      return false;
+    }
+    publishers_.erase(p.id_);
+    p.nh_ = NULL;
+    p.negotiated_ = false;
+    lock.unlock();
+    unregisterTopic(p.id_, p.topic_);
+    return true;
+  }
+
+  /* Register a new subscriber, callbacks run in the named callback group */
   template<typename SubscriberT>
-  bool subscribe(SubscriberT& s) {
-    if (subscribers_.size() >= MAX_SUBSCRIBERS) {
+  bool subscribe(SubscriberT& s, std::string callback_group = "") {
+    if (!attachSubscriber(&s, callback_group, false)) {
+      tinyros_log_error("Subscriber topic_name: %s, unknown callback group: %s", s.topic_.c_str(), callback_group.c_str());
       return false;
     }
     
@@ -187,6 +228,21 @@ public:
     return true;
   }
 
+  /* Remove a subscriber, a callback already running is not waited for */
+  bool unsubscribe(Subscriber_ & s) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    std::map<uint32_t, Subscriber_*>::iterator it = subscribers_.find(s.id_);
+    if (it == subscribers_.end() || it->second != &s) {
+      return false;
+    }
+    subscribers_.erase(it);
+    s.negotiated_ = false;
+    retireSubscriber(&s);
+    lock.unlock();
+    unregisterTopic(s.id_, s.topic_);
+    return true;
+  }
+
   virtual int spin() {
     spin_ = true;
     while (spin_ && ok()) {
@@ -199,6 +255,9 @@ public:
         continue;
       }
       
+      /* the datagram is received straight into a pooled buffer */
+      SpinObject* obj = spin_pool_.acquire(INPUT_SIZE);
+      uint8_t* message_in = obj->buffer_;
       int32_t rv = hardware_.read(message_in, INPUT_SIZE);
       if (INPUT_SIZE >= rv && rv > 0) {
         uint32_t topic = 0;
@@ -251,54 +310,41 @@ public:
           }
 
           if ((checksum % 256) == 255) {
-            if(subscribers_.count(topic) == 1) {
-              std::shared_ptr<SpinObject> obj = std::shared_ptr<SpinObject> (new SpinObject());
-              int total_bytes = bytes > 0 ? bytes : 1;
+            std::unique_lock<std::mutex> lock(mutex_);
+            std::map<uint32_t, Subscriber_*>::iterator it = subscribers_.find(topic);
+            if(it != subscribers_.end()) {
               obj->id = topic;
-              obj->message_in = (uint8_t*)calloc(total_bytes, sizeof(uint8_t));
-              memcpy(obj->message_in, message_in + index, total_bytes);
-              spin_thread_pool_.schedule(std::bind(&NodeHandleBase_::spin_task, this, obj));
+              obj->message_in = message_in + index;
+              traceIncoming(obj, bytes);
+              dispatch(it->second, obj);
+              obj = NULL;
             }
           }
         } while(0);
       }
+      if (obj != NULL) {
+        spin_pool_.release(obj);
+      }
     }
 
     return true;
   }
   
   virtual int publish(uint32_t id, const Msg * msg, bool islog = false) {
-      std::unique_lock<std::mutex> lock(mutex_);
-      /* serialize message */
-      int l = msg->serialize(message_out + 11);
-  
-      /* setup the header */
-      message_out[0] = 0xff;
-      message_out[1] = 0xb9;
-      message_out[2] = (uint8_t)((uint32_t)l & 0xFF);
-      message_out[3] = (uint8_t)((uint32_t)((l >> 8) & 0xFF));
-      message_out[4] = (uint8_t)((uint32_t)((l >> 16) & 0xFF));
-      message_out[5] = (uint8_t)((uint32_t)((l >> 24) & 0xFF));
-      message_out[6] = 255 - ((message_out[2] + message_out[3] + message_out[4] + message_out[5]) % 256);
-      message_out[7] = (uint8_t)((uint32_t)id & 0xFF);
-      message_out[8] = (uint8_t)((uint32_t)((id >> 8) & 0xFF));
-      message_out[9] = (uint8_t)((uint32_t)((id >> 16) & 0xFF));
-      message_out[10] = (uint8_t)((uint32_t)((id >> 24) & 0xFF));
-  
-      /* calculate checksum */
-      int chk = 0;
-      for (int i = 7; i < l + 11; i++)
-        chk += message_out[i];
-      l += 11;
-      message_out[l++] = 255 - (chk % 256);
-  
-      if (l <= OUTPUT_SIZE) {
-        l = hardware_.write(message_out, l) ? l : -1;
-        return l;
-      } else {
-        return -2;
-      }
+    if (!connected(islog)) {
+      return -1;
     }
+    return enqueue(id, msg, islog);
+  }
+
+  virtual bool connected(bool) {
+    return hardware_.connected();
+  }
+
+  /* called from the writer thread only */
+  virtual bool write(uint8_t* data, int length, bool) {
+    return hardware_.write(data, length);
+  }
 
 };
 
@@ -1,16 +1,37 @@
 #ifndef TINYROS_SUBSCRIBER_H_
 #define TINYROS_SUBSCRIBER_H_
 
+#include <functional>
+#include <mutex>
+#include <memory>
+#include <vector>
 #include "tiny_ros/tinyros_msgs/TopicInfo.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/executor.h"
 
 namespace tinyros
 {
+class SpinInbox;
 
 /* Base class for objects subscribers. */
 class Subscriber_
 {
 public:
+  /* what to discard once queue_size messages wait for the callback */
+  enum QueuePolicy { QUEUE_DROP_OLDEST = 0, QUEUE_KEEP_LATEST = 1 };
+
+  Subscriber_()
+    : id_(0)
+    , negotiated_(false)
+    , srv_flag_(false)
+    , queue_size_(0)
+    , queue_policy_(QUEUE_DROP_OLDEST)
+    , dropped_(0) {}
+  virtual ~Subscriber_() {}
+
   virtual void callback(unsigned char *data) = 0;
+  /* NodeHandle calls this one, length excludes a trace trailer */
+  virtual void callback(unsigned char *data, uint32_t) { callback(data); }
   virtual int getEndpointType() = 0;
 
   // id_ is set by NodeHandle when we advertise
@@ -19,11 +40,69 @@ public:
   virtual std::string getMsgType() = 0;
   virtual std::string getMsgMD5() = 0;
   virtual bool negotiated() { return negotiated_; }
+  /* the type and md5 tinyrosdds answered the negotiation with */
+  virtual void negotiatedType(const std::string&, const std::string&) {}
   std::string topic_;
 
   // negotiated_ is set by NodeHandle when we negotiateTopics
   bool negotiated_;
   bool srv_flag_;
+
+  // what NodeHandle negotiates the topic with, kept to renegotiate it without allocating
+  tinyros::tinyros_msgs::TopicInfo topic_info_;
+
+  // callback_group_ and strand_ are set by NodeHandle when we subscribe
+  CallbackGroupPtr callback_group_;
+  StrandPtr strand_;
+
+  /*
+   * Call before subscribing. At most size messages wait for the callback
+   * (0 is unbounded); QUEUE_KEEP_LATEST only keeps the newest one.
+   */
+  void setQueueSize(int size, QueuePolicy policy = QUEUE_DROP_OLDEST) {
+    queue_size_ = size;
+    queue_policy_ = policy;
+  }
+
+  /* messages discarded because the queue was full */
+  uint64_t getDropped() { return dropped_; }
+
+  int queue_size_;
+  QueuePolicy queue_policy_;
+  uint64_t dropped_;
+  // inbox_ is set by NodeHandle when we subscribe with a queue_size_
+  std::shared_ptr<SpinInbox> inbox_;
+};
+
+/*
+ * Deserialization targets of a subscriber. A message is handed out again
+ * once nobody else holds it, so strings and arrays keep their capacity
+ * and a steady message flow does not allocate.
+ */
+template<typename MsgT>
+class MessagePool
+{
+public:
+  enum { MAX_POOLED = 16 };
+
+  std::shared_ptr<MsgT> acquire()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < pool_.size(); i++) {
+      if (pool_[i].use_count() == 1) {
+        return pool_[i];
+      }
+    }
+    std::shared_ptr<MsgT> msg = std::make_shared<MsgT>();
+    if (pool_.size() < MAX_POOLED) {
+      pool_.push_back(msg);
+    }
+    return msg;
+  }
+
+private:
+  std::mutex mutex_;
+  std::vector<std::shared_ptr<MsgT> > pool_;
 };
 
 /* Bound function subscriber. */
@@ -31,11 +110,25 @@ template<typename MsgT, typename ObjT = void>
 class Subscriber: public Subscriber_
 {
 public:
+  typedef std::shared_ptr<const MsgT> ConstPtr;
   typedef void(ObjT::*CallbackT)(const MsgT&);
+  typedef void(ObjT::*ConstPtrCallbackT)(const ConstPtr&);
   MsgT msg;
 
   Subscriber(std::string topic_name, CallbackT cb, ObjT* obj, int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_SUBSCRIBER) :
     cb_(cb),
+    ptr_cb_(NULL),
+    obj_(obj),
+    endpoint_(endpoint) {
+    topic_ = topic_name;
+    negotiated_ = false;
+    srv_flag_ = false;
+  }
+
+  /* The callback may keep the message, it is not reused while referenced */
+  Subscriber(std::string topic_name, ConstPtrCallbackT cb, ObjT* obj, int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_SUBSCRIBER) :
+    cb_(NULL),
+    ptr_cb_(cb),
     obj_(obj),
     endpoint_(endpoint) {
     topic_ = topic_name;
@@ -45,9 +138,13 @@ public:
 
   virtual void callback(unsigned char* data)
   {
-    MsgT tmsg;
-    tmsg.deserialize(data);
-    (obj_->*cb_)(tmsg);
+    std::shared_ptr<MsgT> tmsg = pool_.acquire();
+    tmsg->deserialize(data);
+    if (ptr_cb_) {
+      (obj_->*ptr_cb_)(tmsg);
+    } else {
+      (obj_->*cb_)(*tmsg);
+    }
   }
 
   virtual std::string getMsgType()
@@ -65,8 +162,10 @@ public:
 
 private:
   CallbackT cb_;
+  ConstPtrCallbackT ptr_cb_;
   ObjT* obj_;
   int endpoint_;
+  MessagePool<MsgT> pool_;
 };
 
 /* Standalone function subscriber. */
@@ -74,10 +173,118 @@ template<typename MsgT>
 class Subscriber<MsgT, void>: public Subscriber_
 {
 public:
+  typedef std::shared_ptr<const MsgT> ConstPtr;
   typedef void(*CallbackT)(const MsgT&);
+  typedef void(*ConstPtrCallbackT)(const ConstPtr&);
   MsgT msg;
 
   Subscriber(std::string topic_name, CallbackT cb, int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_SUBSCRIBER) :
+    cb_(cb),
+    ptr_cb_(NULL),
+    endpoint_(endpoint) {
+    topic_ = topic_name;
+    negotiated_ = false;
+    srv_flag_ = false;
+  }
+
+  /* The callback may keep the message, it is not reused while referenced */
+  Subscriber(std::string topic_name, ConstPtrCallbackT cb, int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_SUBSCRIBER) :
+    cb_(NULL),
+    ptr_cb_(cb),
+    endpoint_(endpoint) {
+    topic_ = topic_name;
+    negotiated_ = false;
+    srv_flag_ = false;
+  }
+
+  virtual void callback(unsigned char* data)
+  {
+    std::shared_ptr<MsgT> tmsg = pool_.acquire();
+    tmsg->deserialize(data);
+    if (this->ptr_cb_) {
+      this->ptr_cb_(tmsg);
+    } else {
+      this->cb_(*tmsg);
+    }
+  }
+
+  virtual std::string getMsgType()
+  {
+    return this->msg.getType();
+  }
+  virtual std::string getMsgMD5()
+  {
+    return this->msg.getMD5();
+  }
+  virtual int getEndpointType()
+  {
+    return endpoint_;
+  }
+
+private:
+  CallbackT cb_;
+  ConstPtrCallbackT ptr_cb_;
+  int endpoint_;
+  MessagePool<MsgT> pool_;
+};
+
+/*
+ * Subscriber that reads messages where they were received: the callback
+ * gets a MsgT::View of the frame, nothing is deserialized or copied. The
+ * view and the spans taken from it are only valid until it returns.
+ */
+template<typename MsgT, typename ObjT = void>
+class ViewSubscriber: public Subscriber_
+{
+public:
+  typedef typename MsgT::View View;
+  typedef void(ObjT::*CallbackT)(const View&);
+  MsgT msg;
+
+  ViewSubscriber(std::string topic_name, CallbackT cb, ObjT* obj, int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_SUBSCRIBER) :
+    cb_(cb),
+    obj_(obj),
+    endpoint_(endpoint) {
+    topic_ = topic_name;
+    negotiated_ = false;
+    srv_flag_ = false;
+  }
+
+  virtual void callback(unsigned char* data)
+  {
+    View view(data);
+    (obj_->*cb_)(view);
+  }
+
+  virtual std::string getMsgType()
+  {
+    return this->msg.getType();
+  }
+  virtual std::string getMsgMD5()
+  {
+    return this->msg.getMD5();
+  }
+  virtual int getEndpointType()
+  {
+    return endpoint_;
+  }
+
+private:
+  CallbackT cb_;
+  ObjT* obj_;
+  int endpoint_;
+};
+
+/* Standalone function view subscriber. */
+template<typename MsgT>
+class ViewSubscriber<MsgT, void>: public Subscriber_
+{
+public:
+  typedef typename MsgT::View View;
+  typedef void(*CallbackT)(const View&);
+  MsgT msg;
+
+  ViewSubscriber(std::string topic_name, CallbackT cb, int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_SUBSCRIBER) :
     cb_(cb),
     endpoint_(endpoint) {
     topic_ = topic_name;
@@ -87,9 +294,8 @@ public:
 
   virtual void callback(unsigned char* data)
   {
-    MsgT tmsg;
-    tmsg.deserialize(data);
-    this->cb_(tmsg);
+    View view(data);
+    this->cb_(view);
   }
 
   virtual std::string getMsgType()
@@ -110,6 +316,68 @@ private:
   int endpoint_;
 };
 
+/*
+ * Subscriber of any message type: the callback gets the payload as it was
+ * received, nothing is deserialized or copied, and the span is only valid
+ * until it returns. With an empty type and md5 it takes whatever the topic
+ * carries, as reported by tinyrosdds when the topic is negotiated.
+ */
+class RawSubscriber: public Subscriber_
+{
+public:
+  typedef std::function<void(const Span<uint8_t>&)> CallbackT;
+
+  RawSubscriber(std::string topic_name, CallbackT cb, std::string type = "", std::string md5 = "",
+      int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_SUBSCRIBER) :
+    cb_(cb),
+    type_(type),
+    md5_(md5),
+    endpoint_(endpoint) {
+    topic_ = topic_name;
+    negotiated_ = false;
+    srv_flag_ = false;
+  }
+
+  /* not used, NodeHandle passes the length along */
+  virtual void callback(unsigned char*) {}
+
+  virtual void callback(unsigned char* data, uint32_t length)
+  {
+    cb_(Span<uint8_t>(data, length));
+  }
+
+  virtual void negotiatedType(const std::string& type, const std::string& md5)
+  {
+    std::unique_lock<std::mutex> lock(type_mutex_);
+    if (type_.empty() && !type.empty()) {
+      type_ = type;
+      md5_ = md5;
+    }
+  }
+
+  virtual std::string getMsgType()
+  {
+    std::unique_lock<std::mutex> lock(type_mutex_);
+    return type_;
+  }
+  virtual std::string getMsgMD5()
+  {
+    std::unique_lock<std::mutex> lock(type_mutex_);
+    return md5_;
+  }
+  virtual int getEndpointType()
+  {
+    return endpoint_;
+  }
+
+private:
+  CallbackT cb_;
+  std::mutex type_mutex_;
+  std::string type_;
+  std::string md5_;
+  int endpoint_;
+};
+
 }
 
 #endif
@@ -3,17 +3,67 @@
 #include <stdint.h>
 #include <vector>
 #include <utility>
-#include <deque>
 #include <thread>
 #include <functional>
 #include <mutex>
 #include <condition_variable>
 
 namespace tinyros {
-class ThreadPool{
+/* FIFO of tasks in a ring buffer that only grows, so pushing does not allocate once warmed up */
+class TaskQueue {
 public:
   typedef std::function<void()> Task;
 
+  TaskQueue(size_t capacity = 16) : tasks_(capacity), head_(0), count_(0) {}
+
+  bool empty() const { return count_ == 0; }
+  size_t size() const { return count_; }
+
+  void push(const Task& task) {
+    if (count_ == tasks_.size()) {
+      grow();
+    }
+    tasks_[(head_ + count_) % tasks_.size()] = task;
+    count_++;
+  }
+
+  Task pop() {
+    Task task = nullptr;
+    if (count_ > 0) {
+      task.swap(tasks_[head_]);
+      head_ = (head_ + 1) % tasks_.size();
+      count_--;
+    }
+    return task;
+  }
+
+  void clear() {
+    for (size_t i = 0; i < tasks_.size(); i++) {
+      tasks_[i] = nullptr;
+    }
+    head_ = 0;
+    count_ = 0;
+  }
+
+private:
+  void grow() {
+    std::vector<Task> tasks(tasks_.size() * 2);
+    for (size_t i = 0; i < count_; i++) {
+      tasks[i].swap(tasks_[(head_ + i) % tasks_.size()]);
+    }
+    tasks_.swap(tasks);
+    head_ = 0;
+  }
+
+  std::vector<Task> tasks_;
+  size_t head_;
+  size_t count_;
+};
+
+class ThreadPool{
+public:
+  typedef TaskQueue::Task Task;
+
   ThreadPool(int init_threads = 1) {
     started_ = true;
     threads_.reserve(init_threads);
@@ -21,7 +71,7 @@ public:
       threads_.push_back(new std::thread(std::bind(&ThreadPool::thread_loop, this)));
     }
   }
-  
+
   ~ThreadPool() {
     shutdown();
   }
@@ -40,11 +90,11 @@ public:
     }
     threads_.clear();
   }
-  
+
   void schedule(const Task& task) {
     if (started_) {
       std::unique_lock<std::mutex> lock(mutex_);
-      tasks_.push_back(task);
+      tasks_.push(task);
       cond_.notify_one();
     }
   }
@@ -53,12 +103,12 @@ private:
   void thread_loop() {
     while(started_) {
       Task task = take();
-      if(started_ && task) { 
+      if(started_ && task) {
         task();
       }
     }
   }
-  
+
   Task take() {
     std::unique_lock<std::mutex> lock(mutex_);
     while(tasks_.empty() && started_) {
@@ -66,18 +116,16 @@ private:
     }
 
     Task task = nullptr;
-    if(started_ && !tasks_.empty()) {
-      task = tasks_.front();
-      tasks_.pop_front();
+    if(started_) {
+      task = tasks_.pop();
     }
     return task;
   }
 
   typedef std::vector<std::thread*> Threads;
-  typedef std::deque<Task> Tasks;
 
   Threads threads_;
-  Tasks tasks_;
+  TaskQueue tasks_;
 
   std::mutex mutex_;
   std::condition_variable cond_;
@@ -87,4 +135,3 @@ private:
 }
 
 #endif //TINYROS_THREADPOOL_H_
-
@@ -4,6 +4,7 @@
 #include "tiny_ros/ros/duration.h"
 #include <math.h>
 #include <stdint.h>
+#include <atomic>
 #include <mutex>
 
 namespace tinyros
@@ -46,12 +47,22 @@ public:
   Time& operator +=(const Duration &rhs);
   Time& operator -=(const Duration &rhs);
 
+  /*
+   * The dds clock is time_dds_ at time_start_ of the monotonic clock, both
+   * in nanoseconds, and runs time_drift_ ppb faster. Published through a
+   * seqlock, dds() never waits; writers hold mutex_, see setDDS().
+   */
   static std::mutex mutex_;
-  static int64_t time_start_;
-  static int64_t time_last_;
-  static int64_t time_dds_;
+  static std::atomic<uint32_t> dds_seq_;
+  static std::atomic<int64_t> time_start_;
+  static std::atomic<int64_t> time_dds_;
+  static std::atomic<int64_t> time_drift_;
+  static int64_t time_last_;  // monotonic milliseconds of the last sync, guarded by mutex_
+  static void setDDS(const Time& dds, const Time& start, int64_t drift = 0);
   static Time dds();
   static Time now();
+  /* for measuring durations: a clock from an unspecified start that wall clock changes do not move */
+  static Time monotonic();
   static void setNow(Time & new_now);
 };
 
@@ -0,0 +1,121 @@
+#ifndef TINYROS_TOPIC_REGISTRY_H_
+#define TINYROS_TOPIC_REGISTRY_H_
+#include <stdint.h>
+#include <stddef.h>
+#include <vector>
+
+namespace tinyros
+{
+class Publisher;
+class Subscriber_;
+
+/*
+ * Endpoints of a NodeHandle by topic id. An id is ID_TOPIC_BASE plus a
+ * slot index in the low INDEX_BITS and the generation of the slot above
+ * them, so lookup is an index into the slot table. Removed slots are
+ * reused, each time under a new id, which keeps frames still in flight
+ * for a removed endpoint from reaching the one that took its slot.
+ * Services register their publisher and subscriber under one id.
+ * Not thread safe, NodeHandle guards it with its mutex.
+ */
+class TopicRegistry
+{
+public:
+  enum { INDEX_BITS = 16, INDEX_MASK = (1 << INDEX_BITS) - 1, MAX_ENDPOINTS = 1 << INDEX_BITS };
+
+  struct Entry
+  {
+    uint32_t id;  // 0 while the slot is free
+    uint32_t generation;
+    Publisher* pub;
+    Subscriber_* sub;
+  };
+
+  TopicRegistry(uint32_t base) : base_(base), count_(0) {}
+
+  /* new id for the endpoints, 0 if every slot is taken */
+  uint32_t add(Publisher* pub, Subscriber_* sub) {
+    size_t index;
+    if (!free_.empty()) {
+      index = free_.back();
+      free_.pop_back();
+    } else if (entries_.size() < MAX_ENDPOINTS) {
+      index = entries_.size();
+      Entry entry = { 0, 0, NULL, NULL };
+      entries_.push_back(entry);
+    } else {
+      return 0;
+    }
+    Entry& entry = entries_[index];
+    entry.id = base_ + ((entry.generation << INDEX_BITS) | (uint32_t)index);
+    entry.pub = pub;
+    entry.sub = sub;
+    count_++;
+    return entry.id;
+  }
+
+  bool remove(uint32_t id) {
+    Entry* entry = find(id);
+    if (entry == NULL) {
+      return false;
+    }
+    entry->id = 0;
+    entry->generation = (entry->generation + 1) % ((0xffffffffu - base_) >> INDEX_BITS);
+    entry->pub = NULL;
+    entry->sub = NULL;
+    free_.push_back(entry - &entries_[0]);
+    count_--;
+    return true;
+  }
+
+  Publisher* publisher(uint32_t id) {
+    Entry* entry = find(id);
+    return entry ? entry->pub : NULL;
+  }
+
+  Subscriber_* subscriber(uint32_t id) {
+    Entry* entry = find(id);
+    return entry ? entry->sub : NULL;
+  }
+
+  /* copy of the registered endpoints, to walk them without the lock */
+  std::vector<Entry> entries() {
+    std::vector<Entry> entries;
+    this->entries(entries);
+    return entries;
+  }
+
+  /* the same into entries, which keeps its capacity from call to call */
+  void entries(std::vector<Entry>& entries) {
+    entries.clear();
+    entries.reserve(count_);
+    for (size_t i = 0; i < entries_.size(); i++) {
+      if (entries_[i].id != 0) {
+        entries.push_back(entries_[i]);
+      }
+    }
+  }
+
+  size_t size() { return count_; }
+
+private:
+  Entry* find(uint32_t id) {
+    if (id < base_) {
+      return NULL;
+    }
+    size_t index = (id - base_) & INDEX_MASK;
+    if (index >= entries_.size() || entries_[index].id != id) {
+      return NULL;
+    }
+    return &entries_[index];
+  }
+
+  uint32_t base_;
+  size_t count_;
+  std::vector<Entry> entries_;
+  std::vector<size_t> free_;
+};
+
+}
+
+#endif
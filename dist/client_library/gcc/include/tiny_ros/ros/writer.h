@@ -0,0 +1,194 @@
+#ifndef TINYROS_WRITER_H_
+#define TINYROS_WRITER_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+#include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/time.h"
+#include "tiny_ros/ros/duration.h"
+
+namespace tinyros
+{
+/*
+ * Output of Msg::echo(Writer&). Everything is appended to one string,
+ * which keeps its capacity across clear(), and numbers are formatted in
+ * place instead of through a stream per field.
+ */
+class Writer
+{
+public:
+  /* how uint8[] arrays are written */
+  enum BytesMode { BYTES_LIST = 0, BYTES_BASE64 = 1 };
+
+  struct Options
+  {
+    Options() : max_array(0), bytes(BYTES_LIST) {}
+    uint32_t max_array;  // elements written per array, 0 writes them all
+    BytesMode bytes;
+  };
+
+  Writer() {}
+  Writer(const Options& options) : options_(options) {}
+
+  void setOptions(const Options& options) { options_ = options; }
+  const Options& options() const { return options_; }
+
+  const std::string& str() const { return out_; }
+  void clear() { out_.clear(); }
+
+  void raw(char c) { out_ += c; }
+  void raw(const char* s) { out_ += s; }
+
+  /* "name": */
+  void key(const char* name) {
+    out_ += '"';
+    out_ += name;
+    out_ += "\":";
+  }
+
+  void value(bool v) { out_ += v ? '1' : '0'; }
+  void value(char v) { integer(v); }
+  void value(int8_t v) { integer(v); }
+  void value(uint8_t v) { integer(v); }
+  void value(int16_t v) { integer(v); }
+  void value(uint16_t v) { integer(v); }
+  void value(int32_t v) { integer(v); }
+  void value(uint32_t v) { integer(v); }
+  void value(int64_t v) { integer(v); }
+  void value(uint64_t v) { integer(v); }
+  void value(float v) { real(v); }
+  void value(double v) { real(v); }
+
+  /* quoted, with quotes escaped */
+  void value(const std::string& v) {
+    out_ += '"';
+    size_t begin = 0;
+    size_t pos;
+    while ((pos = v.find('"', begin)) != std::string::npos) {
+      out_.append(v, begin, pos - begin);
+      out_ += "\\\"";
+      begin = pos + 1;
+    }
+    out_.append(v, begin, std::string::npos);
+    out_ += '"';
+  }
+
+  void value(const Time& v) {
+    out_ += "{\"sec\":";
+    integer(v.sec);
+    out_ += ",\"nsec\":";
+    integer(v.nsec);
+    out_ += '}';
+  }
+
+  void value(const Duration& v) {
+    out_ += "{\"sec\":";
+    integer(v.sec);
+    out_ += ",\"nsec\":";
+    integer(v.nsec);
+    out_ += '}';
+  }
+
+  void value(const Msg& v) { v.echo(*this); }
+
+  /* name:[a,b,...], arrays longer than max_array end with "...(n more)" */
+  template<typename T>
+  void array(const char* name, const T* data, uint32_t count) {
+    uint32_t n = begin(name, count);
+    for (uint32_t i = 0; i < n; i++) {
+      if (i > 0) out_ += ',';
+      value(data[i]);
+    }
+    end(count, n);
+  }
+
+  void array(const char* name, const std::vector<bool>& data) {
+    uint32_t count = (uint32_t)data.size();
+    uint32_t n = begin(name, count);
+    for (uint32_t i = 0; i < n; i++) {
+      if (i > 0) out_ += ',';
+      value((bool)data[i]);
+    }
+    end(count, n);
+  }
+
+  /* with BYTES_BASE64, name:{"size":count,"base64":"..."} */
+  void array(const char* name, const uint8_t* data, uint32_t count) {
+    if (options_.bytes != BYTES_BASE64) {
+      array<uint8_t>(name, data, count);
+      return;
+    }
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    uint32_t n = (options_.max_array > 0 && count > options_.max_array) ? options_.max_array : count;
+    out_ += name;
+    out_ += ":{\"size\":";
+    integer(count);
+    out_ += ",\"base64\":\"";
+    size_t pos = out_.size();
+    out_.resize(pos + (n + 2) / 3 * 4);
+    char* p = &out_[pos];
+    uint32_t i = 0;
+    for (; i + 2 < n; i += 3) {
+      uint32_t v = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+      *p++ = table[(v >> 18) & 0x3f];
+      *p++ = table[(v >> 12) & 0x3f];
+      *p++ = table[(v >> 6) & 0x3f];
+      *p++ = table[v & 0x3f];
+    }
+    if (i < n) {
+      uint32_t v = data[i] << 16;
+      if (i + 1 < n) v |= data[i + 1] << 8;
+      *p++ = table[(v >> 18) & 0x3f];
+      *p++ = table[(v >> 12) & 0x3f];
+      *p++ = (i + 1 < n) ? table[(v >> 6) & 0x3f] : '=';
+      *p++ = '=';
+    }
+    out_ += "\"}";
+  }
+
+private:
+  uint32_t begin(const char* name, uint32_t count) {
+    out_ += name;
+    out_ += ":[";
+    return (options_.max_array > 0 && count > options_.max_array) ? options_.max_array : count;
+  }
+
+  void end(uint32_t count, uint32_t written) {
+    if (written < count) {
+      out_ += written > 0 ? ",\"...(" : "\"...(";
+      integer(count - written);
+      out_ += " more)\"";
+    }
+    out_ += ']';
+  }
+
+  template<typename T>
+  void integer(T v) {
+    char buffer[24];
+    char* end = buffer + sizeof(buffer);
+    char* p = end;
+    bool negative = v < 0;
+    uint64_t u = negative ? 0 - (uint64_t)v : (uint64_t)v;
+    do {
+      *--p = (char)('0' + u % 10);
+      u /= 10;
+    } while (u != 0);
+    if (negative) *--p = '-';
+    out_.append(p, end - p);
+  }
+
+  /* same digits as an ostream with its default precision */
+  void real(double v) {
+    char buffer[32];
+    int n = snprintf(buffer, sizeof(buffer), "%g", v);
+    out_.append(buffer, n);
+  }
+
+  Options options_;
+  std::string out_;
+};
+
+}
+
+#endif
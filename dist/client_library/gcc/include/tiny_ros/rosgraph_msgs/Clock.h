@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 
 namespace tinyros
@@ -14,12 +16,16 @@ namespace tinyros
 namespace rosgraph_msgs
 {
 
+  class ClockView;
+
   class Clock : public tinyros::Msg
   {
     public:
       typedef tinyros::Time _clock_type;
       _clock_type clock;
 
+      static constexpr uint32_t kSerializedSize = 8;
+
     Clock():
       clock()
     {
@@ -27,58 +33,56 @@ namespace rosgraph_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->clock.sec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->clock.sec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->clock.sec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->clock.sec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->clock.sec);
-      *(outbuffer + offset + 0) = (this->clock.nsec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->clock.nsec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->clock.nsec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->clock.nsec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->clock.nsec);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->clock.sec, 1);
+      arrayToArr(outbuffer + 0 + 4, &this->clock.nsec, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->clock.sec =  ((uint32_t) (*(inbuffer + offset)));
-      this->clock.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->clock.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->clock.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->clock.sec);
-      this->clock.nsec =  ((uint32_t) (*(inbuffer + offset)));
-      this->clock.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->clock.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->clock.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->clock.nsec);
-      return offset;
+      arrToArray(&this->clock.sec, inbuffer + 0, 1);
+      arrToArray(&this->clock.nsec, inbuffer + 0 + 4, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->clock.sec);
-      length += sizeof(this->clock.nsec);
-      return length;
+      writer.raw('{');
+      writer.key("clock");
+      writer.value(this->clock);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_clock;
-      ss_clock << "\"clock\":{\"sec\":" << clock.sec;
-      ss_clock << ",\"nsec\":" << clock.nsec << "}";
-      string_echo += ss_clock.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "rosgraph_msgs/Clock"; }
     virtual std::string getMD5(){ return "d3bedbe03b904b8181e3fef4bbe0a73e"; }
+    typedef ClockView View;
+
+  };
+
+  /* Clock read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ClockView
+  {
+    public:
+    typedef Clock MsgType;
+
+    ClockView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 8; }
+
+    tinyros::Time clock() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 0); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
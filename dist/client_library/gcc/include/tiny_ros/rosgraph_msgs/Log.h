@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace rosgraph_msgs
 {
 
+  class LogView;
+
   class Log : public tinyros::Msg
   {
     public:
@@ -207,80 +211,99 @@ namespace rosgraph_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("level");
+      writer.value(this->level);
+      writer.raw(',');
+      writer.key("name");
+      writer.value(this->name);
+      writer.raw(',');
+      writer.key("msg");
+      writer.value(this->msg);
+      writer.raw(',');
+      writer.key("file");
+      writer.value(this->file);
+      writer.raw(',');
+      writer.key("function");
+      writer.value(this->function);
+      writer.raw(',');
+      writer.key("line");
+      writer.value(this->line);
+      writer.raw(',');
+      writer.array("topics", this->topics, this->topics_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_level; ss_level << "\"level\":" << (int16_t)level <<",";
-      string_echo += ss_level.str();
-      std::size_t name_pos = name.find("\"");
-      while(name_pos != std::string::npos){
-        name.replace(name_pos, 1,"\\\"");
-        name_pos = name.find("\"", name_pos+2);
-      }
-      string_echo += "\"name\":\"";
-      string_echo += name;
-      string_echo += "\",";
-      std::size_t msg_pos = msg.find("\"");
-      while(msg_pos != std::string::npos){
-        msg.replace(msg_pos, 1,"\\\"");
-        msg_pos = msg.find("\"", msg_pos+2);
-      }
-      string_echo += "\"msg\":\"";
-      string_echo += msg;
-      string_echo += "\",";
-      std::size_t file_pos = file.find("\"");
-      while(file_pos != std::string::npos){
-        file.replace(file_pos, 1,"\\\"");
-        file_pos = file.find("\"", file_pos+2);
-      }
-      string_echo += "\"file\":\"";
-      string_echo += file;
-      string_echo += "\",";
-      std::size_t function_pos = function.find("\"");
-      while(function_pos != std::string::npos){
-        function.replace(function_pos, 1,"\\\"");
-        function_pos = function.find("\"", function_pos+2);
-      }
-      string_echo += "\"function\":\"";
-      string_echo += function;
-      string_echo += "\",";
-      std::stringstream ss_line; ss_line << "\"line\":" << line <<",";
-      string_echo += ss_line.str();
-      string_echo += "topics:[";
-      for( uint32_t i = 0; i < topics_length; i++) {
-        if( i == (topics_length - 1)) {
-          std::stringstream ss_topicsi; ss_topicsi << "\"";
-          string_echo += ss_topicsi.str();
-          std::size_t topicsi_pos = topics[i].find("\"");
-          while(topicsi_pos != std::string::npos){
-            topics[i].replace(topicsi_pos, 1,"\\\"");
-            topicsi_pos = topics[i].find("\"", topicsi_pos+2);
-          }
-          string_echo += topics[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_topicsi; ss_topicsi << "\"";
-          string_echo += ss_topicsi.str();
-          std::size_t topicsi_pos = topics[i].find("\"");
-          while(topicsi_pos != std::string::npos){
-            topics[i].replace(topicsi_pos, 1,"\\\"");
-            topicsi_pos = topics[i].find("\"", topicsi_pos+2);
-          }
-          string_echo += topics[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "rosgraph_msgs/Log"; }
     virtual std::string getMD5(){ return "2de9daf47e984009074d74dbdd492d49"; }
+    typedef LogView View;
+
+  };
+
+  /* Log read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LogView
+  {
+    public:
+    typedef Log MsgType;
+
+    LogView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(8); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    int8_t level() const { return tinyros::viewRead<int8_t>(buffer_ + fieldOffset(1)); }
+    tinyros::StringView name() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+    tinyros::StringView msg() const { return tinyros::StringView(buffer_ + fieldOffset(3)); }
+    tinyros::StringView file() const { return tinyros::StringView(buffer_ + fieldOffset(4)); }
+    tinyros::StringView function() const { return tinyros::StringView(buffer_ + fieldOffset(5)); }
+    uint32_t line() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(6)); }
+    tinyros::ViewList<tinyros::StringView> topics() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(7);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 1; break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+          case 3: length = tinyros::StringView(p).serializedLength(); break;
+          case 4: length = tinyros::StringView(p).serializedLength(); break;
+          case 5: length = tinyros::StringView(p).serializedLength(); break;
+          case 6: length = 4; break;
+          case 7: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[9];
+    mutable uint32_t known_;
   };
 
 }
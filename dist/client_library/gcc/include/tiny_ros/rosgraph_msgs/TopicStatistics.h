@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 #include "tiny_ros/ros/duration.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace rosgraph_msgs
 {
 
+  class TopicStatisticsView;
+
   class TopicStatistics : public tinyros::Msg
   {
     public:
@@ -376,78 +380,126 @@ namespace rosgraph_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("topic");
+      writer.value(this->topic);
+      writer.raw(',');
+      writer.key("node_pub");
+      writer.value(this->node_pub);
+      writer.raw(',');
+      writer.key("node_sub");
+      writer.value(this->node_sub);
+      writer.raw(',');
+      writer.key("window_start");
+      writer.value(this->window_start);
+      writer.raw(',');
+      writer.key("window_stop");
+      writer.value(this->window_stop);
+      writer.raw(',');
+      writer.key("delivered_msgs");
+      writer.value(this->delivered_msgs);
+      writer.raw(',');
+      writer.key("dropped_msgs");
+      writer.value(this->dropped_msgs);
+      writer.raw(',');
+      writer.key("traffic");
+      writer.value(this->traffic);
+      writer.raw(',');
+      writer.key("period_mean");
+      writer.value(this->period_mean);
+      writer.raw(',');
+      writer.key("period_stddev");
+      writer.value(this->period_stddev);
+      writer.raw(',');
+      writer.key("period_max");
+      writer.value(this->period_max);
+      writer.raw(',');
+      writer.key("stamp_age_mean");
+      writer.value(this->stamp_age_mean);
+      writer.raw(',');
+      writer.key("stamp_age_stddev");
+      writer.value(this->stamp_age_stddev);
+      writer.raw(',');
+      writer.key("stamp_age_max");
+      writer.value(this->stamp_age_max);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t topic_pos = topic.find("\"");
-      while(topic_pos != std::string::npos){
-        topic.replace(topic_pos, 1,"\\\"");
-        topic_pos = topic.find("\"", topic_pos+2);
-      }
-      string_echo += "\"topic\":\"";
-      string_echo += topic;
-      string_echo += "\",";
-      std::size_t node_pub_pos = node_pub.find("\"");
-      while(node_pub_pos != std::string::npos){
-        node_pub.replace(node_pub_pos, 1,"\\\"");
-        node_pub_pos = node_pub.find("\"", node_pub_pos+2);
-      }
-      string_echo += "\"node_pub\":\"";
-      string_echo += node_pub;
-      string_echo += "\",";
-      std::size_t node_sub_pos = node_sub.find("\"");
-      while(node_sub_pos != std::string::npos){
-        node_sub.replace(node_sub_pos, 1,"\\\"");
-        node_sub_pos = node_sub.find("\"", node_sub_pos+2);
-      }
-      string_echo += "\"node_sub\":\"";
-      string_echo += node_sub;
-      string_echo += "\",";
-      std::stringstream ss_window_start;
-      ss_window_start << "\"window_start\":{\"sec\":" << window_start.sec;
-      ss_window_start << ",\"nsec\":" << window_start.nsec << "},";
-      string_echo += ss_window_start.str();
-      std::stringstream ss_window_stop;
-      ss_window_stop << "\"window_stop\":{\"sec\":" << window_stop.sec;
-      ss_window_stop << ",\"nsec\":" << window_stop.nsec << "},";
-      string_echo += ss_window_stop.str();
-      std::stringstream ss_delivered_msgs; ss_delivered_msgs << "\"delivered_msgs\":" << delivered_msgs <<",";
-      string_echo += ss_delivered_msgs.str();
-      std::stringstream ss_dropped_msgs; ss_dropped_msgs << "\"dropped_msgs\":" << dropped_msgs <<",";
-      string_echo += ss_dropped_msgs.str();
-      std::stringstream ss_traffic; ss_traffic << "\"traffic\":" << traffic <<",";
-      string_echo += ss_traffic.str();
-      std::stringstream ss_period_mean;
-      ss_period_mean << "\"period_mean\":{\"sec\":" << period_mean.sec;
-      ss_period_mean << ",\"nsec\":" << period_mean.nsec << "},";
-      string_echo += ss_period_mean.str();
-      std::stringstream ss_period_stddev;
-      ss_period_stddev << "\"period_stddev\":{\"sec\":" << period_stddev.sec;
-      ss_period_stddev << ",\"nsec\":" << period_stddev.nsec << "},";
-      string_echo += ss_period_stddev.str();
-      std::stringstream ss_period_max;
-      ss_period_max << "\"period_max\":{\"sec\":" << period_max.sec;
-      ss_period_max << ",\"nsec\":" << period_max.nsec << "},";
-      string_echo += ss_period_max.str();
-      std::stringstream ss_stamp_age_mean;
-      ss_stamp_age_mean << "\"stamp_age_mean\":{\"sec\":" << stamp_age_mean.sec;
-      ss_stamp_age_mean << ",\"nsec\":" << stamp_age_mean.nsec << "},";
-      string_echo += ss_stamp_age_mean.str();
-      std::stringstream ss_stamp_age_stddev;
-      ss_stamp_age_stddev << "\"stamp_age_stddev\":{\"sec\":" << stamp_age_stddev.sec;
-      ss_stamp_age_stddev << ",\"nsec\":" << stamp_age_stddev.nsec << "},";
-      string_echo += ss_stamp_age_stddev.str();
-      std::stringstream ss_stamp_age_max;
-      ss_stamp_age_max << "\"stamp_age_max\":{\"sec\":" << stamp_age_max.sec;
-      ss_stamp_age_max << ",\"nsec\":" << stamp_age_max.nsec << "}";
-      string_echo += ss_stamp_age_max.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "rosgraph_msgs/TopicStatistics"; }
     virtual std::string getMD5(){ return "8b30d3f22284a3bee7679b7194bd38a3"; }
+    typedef TopicStatisticsView View;
+
+  };
+
+  /* TopicStatistics read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TopicStatisticsView
+  {
+    public:
+    typedef TopicStatistics MsgType;
+
+    TopicStatisticsView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(14); }
+
+    tinyros::StringView topic() const { return tinyros::StringView(buffer_ + 0); }
+    tinyros::StringView node_pub() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+    tinyros::StringView node_sub() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+    tinyros::Time window_start() const { return tinyros::viewRead<tinyros::Time>(buffer_ + fieldOffset(3)); }
+    tinyros::Time window_stop() const { return tinyros::viewRead<tinyros::Time>(buffer_ + fieldOffset(4)); }
+    int32_t delivered_msgs() const { return tinyros::viewRead<int32_t>(buffer_ + fieldOffset(5)); }
+    int32_t dropped_msgs() const { return tinyros::viewRead<int32_t>(buffer_ + fieldOffset(6)); }
+    int32_t traffic() const { return tinyros::viewRead<int32_t>(buffer_ + fieldOffset(7)); }
+    tinyros::Duration period_mean() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(8)); }
+    tinyros::Duration period_stddev() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(9)); }
+    tinyros::Duration period_max() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(10)); }
+    tinyros::Duration stamp_age_mean() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(11)); }
+    tinyros::Duration stamp_age_stddev() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(12)); }
+    tinyros::Duration stamp_age_max() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(13)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+          case 3: length = 8; break;
+          case 4: length = 8; break;
+          case 5: length = 4; break;
+          case 6: length = 4; break;
+          case 7: length = 4; break;
+          case 8: length = 8; break;
+          case 9: length = 8; break;
+          case 10: length = 8; break;
+          case 11: length = 8; break;
+          case 12: length = 8; break;
+          case 13: length = 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[15];
+    mutable uint32_t known_;
   };
 
 }
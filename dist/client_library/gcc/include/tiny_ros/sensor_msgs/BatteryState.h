@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class BatteryStateView;
+
   class BatteryState : public tinyros::Msg
   {
     public:
@@ -169,18 +173,8 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->cell_voltage_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->cell_voltage_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->cell_voltage_length);
-      for( uint32_t i = 0; i < cell_voltage_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_cell_voltagei;
-        u_cell_voltagei.real = this->cell_voltage[i];
-        *(outbuffer + offset + 0) = (u_cell_voltagei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_cell_voltagei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_cell_voltagei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_cell_voltagei.base >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->cell_voltage[i]);
-      }
+      arrayToArr(outbuffer + offset, this->cell_voltage, cell_voltage_length);
+      offset += cell_voltage_length * sizeof(float);
       uint32_t length_location = this->location.size();
       varToArr(outbuffer + offset, length_location);
       offset += 4;
@@ -286,20 +280,8 @@ namespace sensor_msgs
       if(cell_voltage_lengthT > cell_voltage_length)
         this->cell_voltage = (float*)realloc(this->cell_voltage, cell_voltage_lengthT * sizeof(float));
       cell_voltage_length = cell_voltage_lengthT;
-      for( uint32_t i = 0; i < cell_voltage_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_st_cell_voltage;
-        u_st_cell_voltage.base = 0;
-        u_st_cell_voltage.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_cell_voltage.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_cell_voltage.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_cell_voltage.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_cell_voltage = u_st_cell_voltage.real;
-        offset += sizeof(this->st_cell_voltage);
-        memcpy( &(this->cell_voltage[i]), &(this->st_cell_voltage), sizeof(float));
-      }
+      arrToArray(this->cell_voltage, inbuffer + offset, cell_voltage_length);
+      offset += cell_voltage_length * sizeof(float);
       uint32_t length_location;
       arrToVar(length_location, (inbuffer + offset));
       offset += 4;
@@ -336,9 +318,7 @@ namespace sensor_msgs
       length += sizeof(this->power_supply_technology);
       length += sizeof(this->present);
       length += sizeof(this->cell_voltage_length);
-      for( uint32_t i = 0; i < cell_voltage_length; i++) {
-        length += sizeof(this->cell_voltage[i]);
-      }
+      length += cell_voltage_length * sizeof(float);
       uint32_t length_location = this->location.size();
       length += 4;
       length += length_location;
@@ -348,66 +328,129 @@ namespace sensor_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("voltage");
+      writer.value(this->voltage);
+      writer.raw(',');
+      writer.key("current");
+      writer.value(this->current);
+      writer.raw(',');
+      writer.key("charge");
+      writer.value(this->charge);
+      writer.raw(',');
+      writer.key("capacity");
+      writer.value(this->capacity);
+      writer.raw(',');
+      writer.key("design_capacity");
+      writer.value(this->design_capacity);
+      writer.raw(',');
+      writer.key("percentage");
+      writer.value(this->percentage);
+      writer.raw(',');
+      writer.key("power_supply_status");
+      writer.value(this->power_supply_status);
+      writer.raw(',');
+      writer.key("power_supply_health");
+      writer.value(this->power_supply_health);
+      writer.raw(',');
+      writer.key("power_supply_technology");
+      writer.value(this->power_supply_technology);
+      writer.raw(',');
+      writer.key("present");
+      writer.value(this->present);
+      writer.raw(',');
+      writer.array("cell_voltage", this->cell_voltage, this->cell_voltage_length);
+      writer.raw(',');
+      writer.key("location");
+      writer.value(this->location);
+      writer.raw(',');
+      writer.key("serial_number");
+      writer.value(this->serial_number);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_voltage; ss_voltage << "\"voltage\":" << voltage <<",";
-      string_echo += ss_voltage.str();
-      std::stringstream ss_current; ss_current << "\"current\":" << current <<",";
-      string_echo += ss_current.str();
-      std::stringstream ss_charge; ss_charge << "\"charge\":" << charge <<",";
-      string_echo += ss_charge.str();
-      std::stringstream ss_capacity; ss_capacity << "\"capacity\":" << capacity <<",";
-      string_echo += ss_capacity.str();
-      std::stringstream ss_design_capacity; ss_design_capacity << "\"design_capacity\":" << design_capacity <<",";
-      string_echo += ss_design_capacity.str();
-      std::stringstream ss_percentage; ss_percentage << "\"percentage\":" << percentage <<",";
-      string_echo += ss_percentage.str();
-      std::stringstream ss_power_supply_status; ss_power_supply_status << "\"power_supply_status\":" << (uint16_t)power_supply_status <<",";
-      string_echo += ss_power_supply_status.str();
-      std::stringstream ss_power_supply_health; ss_power_supply_health << "\"power_supply_health\":" << (uint16_t)power_supply_health <<",";
-      string_echo += ss_power_supply_health.str();
-      std::stringstream ss_power_supply_technology; ss_power_supply_technology << "\"power_supply_technology\":" << (uint16_t)power_supply_technology <<",";
-      string_echo += ss_power_supply_technology.str();
-      std::stringstream ss_present; ss_present << "\"present\":" << present <<",";
-      string_echo += ss_present.str();
-      string_echo += "cell_voltage:[";
-      for( uint32_t i = 0; i < cell_voltage_length; i++) {
-        if( i == (cell_voltage_length - 1)) {
-          std::stringstream ss_cell_voltagei; ss_cell_voltagei << cell_voltage[i] <<"";
-          string_echo += ss_cell_voltagei.str();
-        } else {
-          std::stringstream ss_cell_voltagei; ss_cell_voltagei << cell_voltage[i] <<",";
-          string_echo += ss_cell_voltagei.str();
-        }
-      }
-      string_echo += "],";
-      std::size_t location_pos = location.find("\"");
-      while(location_pos != std::string::npos){
-        location.replace(location_pos, 1,"\\\"");
-        location_pos = location.find("\"", location_pos+2);
-      }
-      string_echo += "\"location\":\"";
-      string_echo += location;
-      string_echo += "\",";
-      std::size_t serial_number_pos = serial_number.find("\"");
-      while(serial_number_pos != std::string::npos){
-        serial_number.replace(serial_number_pos, 1,"\\\"");
-        serial_number_pos = serial_number.find("\"", serial_number_pos+2);
-      }
-      string_echo += "\"serial_number\":\"";
-      string_echo += serial_number;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/BatteryState"; }
     virtual std::string getMD5(){ return "715c4769cacd76e4b679cc3ea4c347b4"; }
+    typedef BatteryStateView View;
+
+  };
+
+  /* BatteryState read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class BatteryStateView
+  {
+    public:
+    typedef BatteryState MsgType;
+
+    BatteryStateView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(14); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    float voltage() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(1)); }
+    float current() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(2)); }
+    float charge() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(3)); }
+    float capacity() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(4)); }
+    float design_capacity() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(5)); }
+    float percentage() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(6)); }
+    uint8_t power_supply_status() const { return tinyros::viewRead<uint8_t>(buffer_ + fieldOffset(7)); }
+    uint8_t power_supply_health() const { return tinyros::viewRead<uint8_t>(buffer_ + fieldOffset(8)); }
+    uint8_t power_supply_technology() const { return tinyros::viewRead<uint8_t>(buffer_ + fieldOffset(9)); }
+    bool present() const { return tinyros::viewRead<bool>(buffer_ + fieldOffset(10)); }
+    tinyros::Span<float> cell_voltage() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(11);
+      return tinyros::Span<float>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::StringView location() const { return tinyros::StringView(buffer_ + fieldOffset(12)); }
+    tinyros::StringView serial_number() const { return tinyros::StringView(buffer_ + fieldOffset(13)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+          case 3: length = 4; break;
+          case 4: length = 4; break;
+          case 5: length = 4; break;
+          case 6: length = 4; break;
+          case 7: length = 1; break;
+          case 8: length = 1; break;
+          case 9: length = 1; break;
+          case 10: length = 1; break;
+          case 11: length = 4 + tinyros::viewRead<uint32_t>(p) * 4; break;
+          case 12: length = tinyros::StringView(p).serializedLength(); break;
+          case 13: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[15];
+    mutable uint32_t known_;
   };
 
 }
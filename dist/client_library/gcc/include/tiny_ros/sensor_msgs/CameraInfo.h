@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/sensor_msgs/RegionOfInterest.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class CameraInfoView;
+
   class CameraInfo : public tinyros::Msg
   {
     public:
@@ -79,70 +83,14 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->D_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->D_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->D_length);
-      for( uint32_t i = 0; i < D_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_Di;
-        u_Di.real = this->D[i];
-        *(outbuffer + offset + 0) = (u_Di.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_Di.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_Di.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_Di.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_Di.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_Di.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_Di.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_Di.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->D[i]);
-      }
-      for( uint32_t i = 0; i < 9; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_Ki;
-        u_Ki.real = this->K[i];
-        *(outbuffer + offset + 0) = (u_Ki.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_Ki.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_Ki.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_Ki.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_Ki.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_Ki.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_Ki.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_Ki.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->K[i]);
-      }
-      for( uint32_t i = 0; i < 9; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_Ri;
-        u_Ri.real = this->R[i];
-        *(outbuffer + offset + 0) = (u_Ri.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_Ri.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_Ri.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_Ri.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_Ri.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_Ri.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_Ri.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_Ri.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->R[i]);
-      }
-      for( uint32_t i = 0; i < 12; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_Pi;
-        u_Pi.real = this->P[i];
-        *(outbuffer + offset + 0) = (u_Pi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_Pi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_Pi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_Pi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_Pi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_Pi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_Pi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_Pi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->P[i]);
-      }
+      arrayToArr(outbuffer + offset, this->D, D_length);
+      offset += D_length * sizeof(double);
+      arrayToArr(outbuffer + offset, this->K, 9);
+      offset += 9 * sizeof(double);
+      arrayToArr(outbuffer + offset, this->R, 9);
+      offset += 9 * sizeof(double);
+      arrayToArr(outbuffer + offset, this->P, 12);
+      offset += 12 * sizeof(double);
       *(outbuffer + offset + 0) = (this->binning_x >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->binning_x >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->binning_x >> (8 * 2)) & 0xFF;
@@ -188,75 +136,14 @@ namespace sensor_msgs
       if(D_lengthT > D_length)
         this->D = (double*)realloc(this->D, D_lengthT * sizeof(double));
       D_length = D_lengthT;
-      for( uint32_t i = 0; i < D_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_D;
-        u_st_D.base = 0;
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_D.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_D = u_st_D.real;
-        offset += sizeof(this->st_D);
-        memcpy( &(this->D[i]), &(this->st_D), sizeof(double));
-      }
-      for( uint32_t i = 0; i < 9; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_Ki;
-        u_Ki.base = 0;
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_Ki.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->K[i] = u_Ki.real;
-        offset += sizeof(this->K[i]);
-      }
-      for( uint32_t i = 0; i < 9; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_Ri;
-        u_Ri.base = 0;
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_Ri.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->R[i] = u_Ri.real;
-        offset += sizeof(this->R[i]);
-      }
-      for( uint32_t i = 0; i < 12; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_Pi;
-        u_Pi.base = 0;
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_Pi.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->P[i] = u_Pi.real;
-        offset += sizeof(this->P[i]);
-      }
+      arrToArray(this->D, inbuffer + offset, D_length);
+      offset += D_length * sizeof(double);
+      arrToArray(this->K, inbuffer + offset, 9);
+      offset += 9 * sizeof(double);
+      arrToArray(this->R, inbuffer + offset, 9);
+      offset += 9 * sizeof(double);
+      arrToArray(this->P, inbuffer + offset, 12);
+      offset += 12 * sizeof(double);
       this->binning_x =  ((uint32_t) (*(inbuffer + offset)));
       this->binning_x |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
       this->binning_x |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
@@ -281,100 +168,121 @@ namespace sensor_msgs
       length += 4;
       length += length_distortion_model;
       length += sizeof(this->D_length);
-      for( uint32_t i = 0; i < D_length; i++) {
-        length += sizeof(this->D[i]);
-      }
-      for( uint32_t i = 0; i < 9; i++) {
-        length += sizeof(this->K[i]);
-      }
-      for( uint32_t i = 0; i < 9; i++) {
-        length += sizeof(this->R[i]);
-      }
-      for( uint32_t i = 0; i < 12; i++) {
-        length += sizeof(this->P[i]);
-      }
+      length += D_length * sizeof(double);
+      length += 9 * sizeof(double);
+      length += 9 * sizeof(double);
+      length += 12 * sizeof(double);
       length += sizeof(this->binning_x);
       length += sizeof(this->binning_y);
       length += this->roi.serializedLength();
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("height");
+      writer.value(this->height);
+      writer.raw(',');
+      writer.key("width");
+      writer.value(this->width);
+      writer.raw(',');
+      writer.key("distortion_model");
+      writer.value(this->distortion_model);
+      writer.raw(',');
+      writer.array("D", this->D, this->D_length);
+      writer.raw(',');
+      writer.array("K", this->K, 9);
+      writer.raw(',');
+      writer.array("R", this->R, 9);
+      writer.raw(',');
+      writer.array("P", this->P, 12);
+      writer.raw(',');
+      writer.key("binning_x");
+      writer.value(this->binning_x);
+      writer.raw(',');
+      writer.key("binning_y");
+      writer.value(this->binning_y);
+      writer.raw(',');
+      writer.key("roi");
+      writer.value(this->roi);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_height; ss_height << "\"height\":" << height <<",";
-      string_echo += ss_height.str();
-      std::stringstream ss_width; ss_width << "\"width\":" << width <<",";
-      string_echo += ss_width.str();
-      std::size_t distortion_model_pos = distortion_model.find("\"");
-      while(distortion_model_pos != std::string::npos){
-        distortion_model.replace(distortion_model_pos, 1,"\\\"");
-        distortion_model_pos = distortion_model.find("\"", distortion_model_pos+2);
-      }
-      string_echo += "\"distortion_model\":\"";
-      string_echo += distortion_model;
-      string_echo += "\",";
-      string_echo += "D:[";
-      for( uint32_t i = 0; i < D_length; i++) {
-        if( i == (D_length - 1)) {
-          std::stringstream ss_Di; ss_Di << D[i] <<"";
-          string_echo += ss_Di.str();
-        } else {
-          std::stringstream ss_Di; ss_Di << D[i] <<",";
-          string_echo += ss_Di.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "K:[";
-      for( uint32_t i = 0; i < 9; i++) {
-        if( i == (9 - 1)) {
-          std::stringstream ss_Ki; ss_Ki << K[i] <<"";
-          string_echo += ss_Ki.str();
-        } else {
-          std::stringstream ss_Ki; ss_Ki << K[i] <<",";
-          string_echo += ss_Ki.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "R:[";
-      for( uint32_t i = 0; i < 9; i++) {
-        if( i == (9 - 1)) {
-          std::stringstream ss_Ri; ss_Ri << R[i] <<"";
-          string_echo += ss_Ri.str();
-        } else {
-          std::stringstream ss_Ri; ss_Ri << R[i] <<",";
-          string_echo += ss_Ri.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "P:[";
-      for( uint32_t i = 0; i < 12; i++) {
-        if( i == (12 - 1)) {
-          std::stringstream ss_Pi; ss_Pi << P[i] <<"";
-          string_echo += ss_Pi.str();
-        } else {
-          std::stringstream ss_Pi; ss_Pi << P[i] <<",";
-          string_echo += ss_Pi.str();
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_binning_x; ss_binning_x << "\"binning_x\":" << binning_x <<",";
-      string_echo += ss_binning_x.str();
-      std::stringstream ss_binning_y; ss_binning_y << "\"binning_y\":" << binning_y <<",";
-      string_echo += ss_binning_y.str();
-      string_echo += "\"roi\":";
-      string_echo += this->roi.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/CameraInfo"; }
     virtual std::string getMD5(){ return "57d2553deec0a7842f00837f40032798"; }
+    typedef CameraInfoView View;
+
+  };
+
+  /* CameraInfo read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class CameraInfoView
+  {
+    public:
+    typedef CameraInfo MsgType;
+
+    CameraInfoView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(11); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    uint32_t height() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(1)); }
+    uint32_t width() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(2)); }
+    tinyros::StringView distortion_model() const { return tinyros::StringView(buffer_ + fieldOffset(3)); }
+    tinyros::Span<double> D() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(4);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> K() const { return tinyros::Span<double>(buffer_ + fieldOffset(5), 9); }
+    tinyros::Span<double> R() const { return tinyros::Span<double>(buffer_ + fieldOffset(6), 9); }
+    tinyros::Span<double> P() const { return tinyros::Span<double>(buffer_ + fieldOffset(7), 12); }
+    uint32_t binning_x() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(8)); }
+    uint32_t binning_y() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(9)); }
+    tinyros::sensor_msgs::RegionOfInterestView roi() const { return tinyros::sensor_msgs::RegionOfInterestView(buffer_ + fieldOffset(10)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+          case 3: length = tinyros::StringView(p).serializedLength(); break;
+          case 4: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 5: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 6: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 7: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 8: length = 4; break;
+          case 9: length = 4; break;
+          case 10: length = tinyros::sensor_msgs::RegionOfInterestView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[12];
+    mutable uint32_t known_;
   };
 
 }
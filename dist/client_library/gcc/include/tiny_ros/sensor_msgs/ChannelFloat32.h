@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace sensor_msgs
 {
 
+  class ChannelFloat32View;
+
   class ChannelFloat32 : public tinyros::Msg
   {
     public:
@@ -42,18 +46,8 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->values_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->values_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->values_length);
-      for( uint32_t i = 0; i < values_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_valuesi;
-        u_valuesi.real = this->values[i];
-        *(outbuffer + offset + 0) = (u_valuesi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_valuesi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_valuesi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_valuesi.base >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->values[i]);
-      }
+      arrayToArr(outbuffer + offset, this->values, values_length);
+      offset += values_length * sizeof(float);
       return offset;
     }
 
@@ -77,20 +71,8 @@ namespace sensor_msgs
       if(values_lengthT > values_length)
         this->values = (float*)realloc(this->values, values_lengthT * sizeof(float));
       values_length = values_lengthT;
-      for( uint32_t i = 0; i < values_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_st_values;
-        u_st_values.base = 0;
-        u_st_values.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_values.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_values.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_values.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_values = u_st_values.real;
-        offset += sizeof(this->st_values);
-        memcpy( &(this->values[i]), &(this->st_values), sizeof(float));
-      }
+      arrToArray(this->values, inbuffer + offset, values_length);
+      offset += values_length * sizeof(float);
       return offset;
     }
 
@@ -101,41 +83,73 @@ namespace sensor_msgs
       length += 4;
       length += length_name;
       length += sizeof(this->values_length);
-      for( uint32_t i = 0; i < values_length; i++) {
-        length += sizeof(this->values[i]);
-      }
+      length += values_length * sizeof(float);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("name");
+      writer.value(this->name);
+      writer.raw(',');
+      writer.array("values", this->values, this->values_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t name_pos = name.find("\"");
-      while(name_pos != std::string::npos){
-        name.replace(name_pos, 1,"\\\"");
-        name_pos = name.find("\"", name_pos+2);
-      }
-      string_echo += "\"name\":\"";
-      string_echo += name;
-      string_echo += "\",";
-      string_echo += "values:[";
-      for( uint32_t i = 0; i < values_length; i++) {
-        if( i == (values_length - 1)) {
-          std::stringstream ss_valuesi; ss_valuesi << values[i] <<"";
-          string_echo += ss_valuesi.str();
-        } else {
-          std::stringstream ss_valuesi; ss_valuesi << values[i] <<",";
-          string_echo += ss_valuesi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/ChannelFloat32"; }
     virtual std::string getMD5(){ return "c4cf01c81334c609dca1afd3a227daff"; }
+    typedef ChannelFloat32View View;
+
+  };
+
+  /* ChannelFloat32 read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ChannelFloat32View
+  {
+    public:
+    typedef ChannelFloat32 MsgType;
+
+    ChannelFloat32View(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::StringView name() const { return tinyros::StringView(buffer_ + 0); }
+    tinyros::Span<float> values() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<float>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class CompressedImageView;
+
   class CompressedImage : public tinyros::Msg
   {
     public:
@@ -47,10 +51,8 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->data_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->data_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        *(outbuffer + offset + 0) = (this->data[i] >> (8 * 0)) & 0xFF;
-        offset += sizeof(this->data[i]);
-      }
+      arrayToArr(outbuffer + offset, this->data, data_length);
+      offset += data_length * sizeof(uint8_t);
       return offset;
     }
 
@@ -75,11 +77,8 @@ namespace sensor_msgs
       if(data_lengthT > data_length)
         this->data = (uint8_t*)realloc(this->data, data_lengthT * sizeof(uint8_t));
       data_length = data_lengthT;
-      for( uint32_t i = 0; i < data_length; i++) {
-        this->st_data =  ((uint8_t) (*(inbuffer + offset)));
-        offset += sizeof(this->st_data);
-        memcpy( &(this->data[i]), &(this->st_data), sizeof(uint8_t));
-      }
+      arrToArray(this->data, inbuffer + offset, data_length);
+      offset += data_length * sizeof(uint8_t);
       return offset;
     }
 
@@ -91,44 +90,78 @@ namespace sensor_msgs
       length += 4;
       length += length_format;
       length += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        length += sizeof(this->data[i]);
-      }
+      length += data_length * sizeof(uint8_t);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("format");
+      writer.value(this->format);
+      writer.raw(',');
+      writer.array("data", this->data, this->data_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::size_t format_pos = format.find("\"");
-      while(format_pos != std::string::npos){
-        format.replace(format_pos, 1,"\\\"");
-        format_pos = format.find("\"", format_pos+2);
-      }
-      string_echo += "\"format\":\"";
-      string_echo += format;
-      string_echo += "\",";
-      string_echo += "data:[";
-      for( uint32_t i = 0; i < data_length; i++) {
-        if( i == (data_length - 1)) {
-          std::stringstream ss_datai; ss_datai << (uint16_t)data[i] <<"";
-          string_echo += ss_datai.str();
-        } else {
-          std::stringstream ss_datai; ss_datai << (uint16_t)data[i] <<",";
-          string_echo += ss_datai.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/CompressedImage"; }
     virtual std::string getMD5(){ return "eed57d856457441995644e6294152301"; }
+    typedef CompressedImageView View;
+
+  };
+
+  /* CompressedImage read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class CompressedImageView
+  {
+    public:
+    typedef CompressedImage MsgType;
+
+    CompressedImageView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::StringView format() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+    tinyros::Span<uint8_t> data() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::Span<uint8_t>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 1; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class IlluminanceView;
+
   class Illuminance : public tinyros::Msg
   {
     public:
@@ -112,23 +116,71 @@ namespace sensor_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("illuminance");
+      writer.value(this->illuminance);
+      writer.raw(',');
+      writer.key("variance");
+      writer.value(this->variance);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_illuminance; ss_illuminance << "\"illuminance\":" << illuminance <<",";
-      string_echo += ss_illuminance.str();
-      std::stringstream ss_variance; ss_variance << "\"variance\":" << variance <<"";
-      string_echo += ss_variance.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/Illuminance"; }
     virtual std::string getMD5(){ return "08ab9e71fcfbed30d5e337886c3f07f2"; }
+    typedef IlluminanceView View;
+
+  };
+
+  /* Illuminance read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class IlluminanceView
+  {
+    public:
+    typedef Illuminance MsgType;
+
+    IlluminanceView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    double illuminance() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(1)); }
+    double variance() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 8; break;
+          case 2: length = 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
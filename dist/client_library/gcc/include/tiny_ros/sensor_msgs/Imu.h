@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Quaternion.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class ImuView;
+
   class Imu : public tinyros::Msg
   {
     public:
@@ -47,56 +51,14 @@ namespace sensor_msgs
       int offset = 0;
       offset += this->header.serialize(outbuffer + offset);
       offset += this->orientation.serialize(outbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_orientation_covariancei;
-        u_orientation_covariancei.real = this->orientation_covariance[i];
-        *(outbuffer + offset + 0) = (u_orientation_covariancei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_orientation_covariancei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_orientation_covariancei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_orientation_covariancei.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_orientation_covariancei.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_orientation_covariancei.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_orientation_covariancei.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_orientation_covariancei.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->orientation_covariance[i]);
-      }
+      arrayToArr(outbuffer + offset, this->orientation_covariance, 9);
+      offset += 9 * sizeof(double);
       offset += this->angular_velocity.serialize(outbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_angular_velocity_covariancei;
-        u_angular_velocity_covariancei.real = this->angular_velocity_covariance[i];
-        *(outbuffer + offset + 0) = (u_angular_velocity_covariancei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_angular_velocity_covariancei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_angular_velocity_covariancei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_angular_velocity_covariancei.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_angular_velocity_covariancei.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_angular_velocity_covariancei.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_angular_velocity_covariancei.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_angular_velocity_covariancei.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->angular_velocity_covariance[i]);
-      }
+      arrayToArr(outbuffer + offset, this->angular_velocity_covariance, 9);
+      offset += 9 * sizeof(double);
       offset += this->linear_acceleration.serialize(outbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_linear_acceleration_covariancei;
-        u_linear_acceleration_covariancei.real = this->linear_acceleration_covariance[i];
-        *(outbuffer + offset + 0) = (u_linear_acceleration_covariancei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_linear_acceleration_covariancei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_linear_acceleration_covariancei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_linear_acceleration_covariancei.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_linear_acceleration_covariancei.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_linear_acceleration_covariancei.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_linear_acceleration_covariancei.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_linear_acceleration_covariancei.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->linear_acceleration_covariance[i]);
-      }
+      arrayToArr(outbuffer + offset, this->linear_acceleration_covariance, 9);
+      offset += 9 * sizeof(double);
       return offset;
     }
 
@@ -105,59 +67,14 @@ namespace sensor_msgs
       int offset = 0;
       offset += this->header.deserialize(inbuffer + offset);
       offset += this->orientation.deserialize(inbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_orientation_covariancei;
-        u_orientation_covariancei.base = 0;
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_orientation_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->orientation_covariance[i] = u_orientation_covariancei.real;
-        offset += sizeof(this->orientation_covariance[i]);
-      }
+      arrToArray(this->orientation_covariance, inbuffer + offset, 9);
+      offset += 9 * sizeof(double);
       offset += this->angular_velocity.deserialize(inbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_angular_velocity_covariancei;
-        u_angular_velocity_covariancei.base = 0;
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_angular_velocity_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->angular_velocity_covariance[i] = u_angular_velocity_covariancei.real;
-        offset += sizeof(this->angular_velocity_covariance[i]);
-      }
+      arrToArray(this->angular_velocity_covariance, inbuffer + offset, 9);
+      offset += 9 * sizeof(double);
       offset += this->linear_acceleration.deserialize(inbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_linear_acceleration_covariancei;
-        u_linear_acceleration_covariancei.base = 0;
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_linear_acceleration_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->linear_acceleration_covariance[i] = u_linear_acceleration_covariancei.real;
-        offset += sizeof(this->linear_acceleration_covariance[i]);
-      }
+      arrToArray(this->linear_acceleration_covariance, inbuffer + offset, 9);
+      offset += 9 * sizeof(double);
       return offset;
     }
 
@@ -166,75 +83,96 @@ namespace sensor_msgs
       int length = 0;
       length += this->header.serializedLength();
       length += this->orientation.serializedLength();
-      for( uint32_t i = 0; i < 9; i++) {
-        length += sizeof(this->orientation_covariance[i]);
-      }
+      length += 9 * sizeof(double);
       length += this->angular_velocity.serializedLength();
-      for( uint32_t i = 0; i < 9; i++) {
-        length += sizeof(this->angular_velocity_covariance[i]);
-      }
+      length += 9 * sizeof(double);
       length += this->linear_acceleration.serializedLength();
-      for( uint32_t i = 0; i < 9; i++) {
-        length += sizeof(this->linear_acceleration_covariance[i]);
-      }
+      length += 9 * sizeof(double);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("orientation");
+      writer.value(this->orientation);
+      writer.raw(',');
+      writer.array("orientation_covariance", this->orientation_covariance, 9);
+      writer.raw(',');
+      writer.key("angular_velocity");
+      writer.value(this->angular_velocity);
+      writer.raw(',');
+      writer.array("angular_velocity_covariance", this->angular_velocity_covariance, 9);
+      writer.raw(',');
+      writer.key("linear_acceleration");
+      writer.value(this->linear_acceleration);
+      writer.raw(',');
+      writer.array("linear_acceleration_covariance", this->linear_acceleration_covariance, 9);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"orientation\":";
-      string_echo += this->orientation.echo();
-      string_echo += ",";
-      string_echo += "orientation_covariance:[";
-      for( uint32_t i = 0; i < 9; i++) {
-        if( i == (9 - 1)) {
-          std::stringstream ss_orientation_covariancei; ss_orientation_covariancei << orientation_covariance[i] <<"";
-          string_echo += ss_orientation_covariancei.str();
-        } else {
-          std::stringstream ss_orientation_covariancei; ss_orientation_covariancei << orientation_covariance[i] <<",";
-          string_echo += ss_orientation_covariancei.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "\"angular_velocity\":";
-      string_echo += this->angular_velocity.echo();
-      string_echo += ",";
-      string_echo += "angular_velocity_covariance:[";
-      for( uint32_t i = 0; i < 9; i++) {
-        if( i == (9 - 1)) {
-          std::stringstream ss_angular_velocity_covariancei; ss_angular_velocity_covariancei << angular_velocity_covariance[i] <<"";
-          string_echo += ss_angular_velocity_covariancei.str();
-        } else {
-          std::stringstream ss_angular_velocity_covariancei; ss_angular_velocity_covariancei << angular_velocity_covariance[i] <<",";
-          string_echo += ss_angular_velocity_covariancei.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "\"linear_acceleration\":";
-      string_echo += this->linear_acceleration.echo();
-      string_echo += ",";
-      string_echo += "linear_acceleration_covariance:[";
-      for( uint32_t i = 0; i < 9; i++) {
-        if( i == (9 - 1)) {
-          std::stringstream ss_linear_acceleration_covariancei; ss_linear_acceleration_covariancei << linear_acceleration_covariance[i] <<"";
-          string_echo += ss_linear_acceleration_covariancei.str();
-        } else {
-          std::stringstream ss_linear_acceleration_covariancei; ss_linear_acceleration_covariancei << linear_acceleration_covariance[i] <<",";
-          string_echo += ss_linear_acceleration_covariancei.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/Imu"; }
     virtual std::string getMD5(){ return "a42c1ab94665a5807834c0ea19a6d16a"; }
+    typedef ImuView View;
+
+  };
+
+  /* Imu read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ImuView
+  {
+    public:
+    typedef Imu MsgType;
+
+    ImuView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(7); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::geometry_msgs::QuaternionView orientation() const { return tinyros::geometry_msgs::QuaternionView(buffer_ + fieldOffset(1)); }
+    tinyros::Span<double> orientation_covariance() const { return tinyros::Span<double>(buffer_ + fieldOffset(2), 9); }
+    tinyros::geometry_msgs::Vector3View angular_velocity() const { return tinyros::geometry_msgs::Vector3View(buffer_ + fieldOffset(3)); }
+    tinyros::Span<double> angular_velocity_covariance() const { return tinyros::Span<double>(buffer_ + fieldOffset(4), 9); }
+    tinyros::geometry_msgs::Vector3View linear_acceleration() const { return tinyros::geometry_msgs::Vector3View(buffer_ + fieldOffset(5)); }
+    tinyros::Span<double> linear_acceleration_covariance() const { return tinyros::Span<double>(buffer_ + fieldOffset(6), 9); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::geometry_msgs::QuaternionView(p).serializedLength(); break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 3: length = tinyros::geometry_msgs::Vector3View(p).serializedLength(); break;
+          case 4: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 5: length = tinyros::geometry_msgs::Vector3View(p).serializedLength(); break;
+          case 6: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[8];
+    mutable uint32_t known_;
   };
 
 }
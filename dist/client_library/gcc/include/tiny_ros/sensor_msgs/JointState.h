@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class JointStateView;
+
   class JointState : public tinyros::Msg
   {
     public:
@@ -66,64 +70,22 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->position_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->position_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->position_length);
-      for( uint32_t i = 0; i < position_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_positioni;
-        u_positioni.real = this->position[i];
-        *(outbuffer + offset + 0) = (u_positioni.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_positioni.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_positioni.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_positioni.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_positioni.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_positioni.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_positioni.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_positioni.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->position[i]);
-      }
+      arrayToArr(outbuffer + offset, this->position, position_length);
+      offset += position_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->velocity_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->velocity_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->velocity_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->velocity_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->velocity_length);
-      for( uint32_t i = 0; i < velocity_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_velocityi;
-        u_velocityi.real = this->velocity[i];
-        *(outbuffer + offset + 0) = (u_velocityi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_velocityi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_velocityi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_velocityi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_velocityi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_velocityi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_velocityi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_velocityi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->velocity[i]);
-      }
+      arrayToArr(outbuffer + offset, this->velocity, velocity_length);
+      offset += velocity_length * sizeof(double);
       *(outbuffer + offset + 0) = (this->effort_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->effort_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->effort_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->effort_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->effort_length);
-      for( uint32_t i = 0; i < effort_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_efforti;
-        u_efforti.real = this->effort[i];
-        *(outbuffer + offset + 0) = (u_efforti.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_efforti.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_efforti.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_efforti.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_efforti.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_efforti.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_efforti.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_efforti.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->effort[i]);
-      }
+      arrayToArr(outbuffer + offset, this->effort, effort_length);
+      offset += effort_length * sizeof(double);
       return offset;
     }
 
@@ -159,24 +121,8 @@ namespace sensor_msgs
       if(position_lengthT > position_length)
         this->position = (double*)realloc(this->position, position_lengthT * sizeof(double));
       position_length = position_lengthT;
-      for( uint32_t i = 0; i < position_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_position;
-        u_st_position.base = 0;
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_position.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_position = u_st_position.real;
-        offset += sizeof(this->st_position);
-        memcpy( &(this->position[i]), &(this->st_position), sizeof(double));
-      }
+      arrToArray(this->position, inbuffer + offset, position_length);
+      offset += position_length * sizeof(double);
       uint32_t velocity_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       velocity_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       velocity_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -185,24 +131,8 @@ namespace sensor_msgs
       if(velocity_lengthT > velocity_length)
         this->velocity = (double*)realloc(this->velocity, velocity_lengthT * sizeof(double));
       velocity_length = velocity_lengthT;
-      for( uint32_t i = 0; i < velocity_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_velocity;
-        u_st_velocity.base = 0;
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_velocity.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_velocity = u_st_velocity.real;
-        offset += sizeof(this->st_velocity);
-        memcpy( &(this->velocity[i]), &(this->st_velocity), sizeof(double));
-      }
+      arrToArray(this->velocity, inbuffer + offset, velocity_length);
+      offset += velocity_length * sizeof(double);
       uint32_t effort_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       effort_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       effort_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -211,24 +141,8 @@ namespace sensor_msgs
       if(effort_lengthT > effort_length)
         this->effort = (double*)realloc(this->effort, effort_lengthT * sizeof(double));
       effort_length = effort_lengthT;
-      for( uint32_t i = 0; i < effort_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_effort;
-        u_st_effort.base = 0;
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_effort.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_effort = u_st_effort.real;
-        offset += sizeof(this->st_effort);
-        memcpy( &(this->effort[i]), &(this->st_effort), sizeof(double));
-      }
+      arrToArray(this->effort, inbuffer + offset, effort_length);
+      offset += effort_length * sizeof(double);
       return offset;
     }
 
@@ -243,91 +157,101 @@ namespace sensor_msgs
         length += length_namei;
       }
       length += sizeof(this->position_length);
-      for( uint32_t i = 0; i < position_length; i++) {
-        length += sizeof(this->position[i]);
-      }
+      length += position_length * sizeof(double);
       length += sizeof(this->velocity_length);
-      for( uint32_t i = 0; i < velocity_length; i++) {
-        length += sizeof(this->velocity[i]);
-      }
+      length += velocity_length * sizeof(double);
       length += sizeof(this->effort_length);
-      for( uint32_t i = 0; i < effort_length; i++) {
-        length += sizeof(this->effort[i]);
-      }
+      length += effort_length * sizeof(double);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("name", this->name, this->name_length);
+      writer.raw(',');
+      writer.array("position", this->position, this->position_length);
+      writer.raw(',');
+      writer.array("velocity", this->velocity, this->velocity_length);
+      writer.raw(',');
+      writer.array("effort", this->effort, this->effort_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "name:[";
-      for( uint32_t i = 0; i < name_length; i++) {
-        if( i == (name_length - 1)) {
-          std::stringstream ss_namei; ss_namei << "\"";
-          string_echo += ss_namei.str();
-          std::size_t namei_pos = name[i].find("\"");
-          while(namei_pos != std::string::npos){
-            name[i].replace(namei_pos, 1,"\\\"");
-            namei_pos = name[i].find("\"", namei_pos+2);
-          }
-          string_echo += name[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_namei; ss_namei << "\"";
-          string_echo += ss_namei.str();
-          std::size_t namei_pos = name[i].find("\"");
-          while(namei_pos != std::string::npos){
-            name[i].replace(namei_pos, 1,"\\\"");
-            namei_pos = name[i].find("\"", namei_pos+2);
-          }
-          string_echo += name[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "position:[";
-      for( uint32_t i = 0; i < position_length; i++) {
-        if( i == (position_length - 1)) {
-          std::stringstream ss_positioni; ss_positioni << position[i] <<"";
-          string_echo += ss_positioni.str();
-        } else {
-          std::stringstream ss_positioni; ss_positioni << position[i] <<",";
-          string_echo += ss_positioni.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "velocity:[";
-      for( uint32_t i = 0; i < velocity_length; i++) {
-        if( i == (velocity_length - 1)) {
-          std::stringstream ss_velocityi; ss_velocityi << velocity[i] <<"";
-          string_echo += ss_velocityi.str();
-        } else {
-          std::stringstream ss_velocityi; ss_velocityi << velocity[i] <<",";
-          string_echo += ss_velocityi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "effort:[";
-      for( uint32_t i = 0; i < effort_length; i++) {
-        if( i == (effort_length - 1)) {
-          std::stringstream ss_efforti; ss_efforti << effort[i] <<"";
-          string_echo += ss_efforti.str();
-        } else {
-          std::stringstream ss_efforti; ss_efforti << effort[i] <<",";
-          string_echo += ss_efforti.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/JointState"; }
     virtual std::string getMD5(){ return "6df7130a6d6a4c2f2037ce4a6e061fb9"; }
+    typedef JointStateView View;
+
+  };
+
+  /* JointState read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class JointStateView
+  {
+    public:
+    typedef JointState MsgType;
+
+    JointStateView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(5); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::ViewList<tinyros::StringView> name() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> position() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> velocity() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<double> effort() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(4);
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 3: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 4: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[6];
+    mutable uint32_t known_;
   };
 
 }
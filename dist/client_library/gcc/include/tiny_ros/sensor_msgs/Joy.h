@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class JoyView;
+
   class Joy : public tinyros::Msg
   {
     public:
@@ -44,35 +48,15 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->axes_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->axes_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->axes_length);
-      for( uint32_t i = 0; i < axes_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_axesi;
-        u_axesi.real = this->axes[i];
-        *(outbuffer + offset + 0) = (u_axesi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_axesi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_axesi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_axesi.base >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->axes[i]);
-      }
+      arrayToArr(outbuffer + offset, this->axes, axes_length);
+      offset += axes_length * sizeof(float);
       *(outbuffer + offset + 0) = (this->buttons_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->buttons_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->buttons_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->buttons_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->buttons_length);
-      for( uint32_t i = 0; i < buttons_length; i++) {
-        union {
-          int32_t real;
-          uint32_t base;
-        } u_buttonsi;
-        u_buttonsi.real = this->buttons[i];
-        *(outbuffer + offset + 0) = (u_buttonsi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_buttonsi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_buttonsi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_buttonsi.base >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->buttons[i]);
-      }
+      arrayToArr(outbuffer + offset, this->buttons, buttons_length);
+      offset += buttons_length * sizeof(int32_t);
       return offset;
     }
 
@@ -88,20 +72,8 @@ namespace sensor_msgs
       if(axes_lengthT > axes_length)
         this->axes = (float*)realloc(this->axes, axes_lengthT * sizeof(float));
       axes_length = axes_lengthT;
-      for( uint32_t i = 0; i < axes_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_st_axes;
-        u_st_axes.base = 0;
-        u_st_axes.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_axes.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_axes.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_axes.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_axes = u_st_axes.real;
-        offset += sizeof(this->st_axes);
-        memcpy( &(this->axes[i]), &(this->st_axes), sizeof(float));
-      }
+      arrToArray(this->axes, inbuffer + offset, axes_length);
+      offset += axes_length * sizeof(float);
       uint32_t buttons_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       buttons_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       buttons_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -110,20 +82,8 @@ namespace sensor_msgs
       if(buttons_lengthT > buttons_length)
         this->buttons = (int32_t*)realloc(this->buttons, buttons_lengthT * sizeof(int32_t));
       buttons_length = buttons_lengthT;
-      for( uint32_t i = 0; i < buttons_length; i++) {
-        union {
-          int32_t real;
-          uint32_t base;
-        } u_st_buttons;
-        u_st_buttons.base = 0;
-        u_st_buttons.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_buttons.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_buttons.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_buttons.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_buttons = u_st_buttons.real;
-        offset += sizeof(this->st_buttons);
-        memcpy( &(this->buttons[i]), &(this->st_buttons), sizeof(int32_t));
-      }
+      arrToArray(this->buttons, inbuffer + offset, buttons_length);
+      offset += buttons_length * sizeof(int32_t);
       return offset;
     }
 
@@ -132,51 +92,83 @@ namespace sensor_msgs
       int length = 0;
       length += this->header.serializedLength();
       length += sizeof(this->axes_length);
-      for( uint32_t i = 0; i < axes_length; i++) {
-        length += sizeof(this->axes[i]);
-      }
+      length += axes_length * sizeof(float);
       length += sizeof(this->buttons_length);
-      for( uint32_t i = 0; i < buttons_length; i++) {
-        length += sizeof(this->buttons[i]);
-      }
+      length += buttons_length * sizeof(int32_t);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("axes", this->axes, this->axes_length);
+      writer.raw(',');
+      writer.array("buttons", this->buttons, this->buttons_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "axes:[";
-      for( uint32_t i = 0; i < axes_length; i++) {
-        if( i == (axes_length - 1)) {
-          std::stringstream ss_axesi; ss_axesi << axes[i] <<"";
-          string_echo += ss_axesi.str();
-        } else {
-          std::stringstream ss_axesi; ss_axesi << axes[i] <<",";
-          string_echo += ss_axesi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "buttons:[";
-      for( uint32_t i = 0; i < buttons_length; i++) {
-        if( i == (buttons_length - 1)) {
-          std::stringstream ss_buttonsi; ss_buttonsi << buttons[i] <<"";
-          string_echo += ss_buttonsi.str();
-        } else {
-          std::stringstream ss_buttonsi; ss_buttonsi << buttons[i] <<",";
-          string_echo += ss_buttonsi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/Joy"; }
     virtual std::string getMD5(){ return "da3438323dbe92a4d6e4658e06bf8da1"; }
+    typedef JoyView View;
+
+  };
+
+  /* Joy read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class JoyView
+  {
+    public:
+    typedef Joy MsgType;
+
+    JoyView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::Span<float> axes() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<float>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<int32_t> buttons() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::Span<int32_t>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 4; break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
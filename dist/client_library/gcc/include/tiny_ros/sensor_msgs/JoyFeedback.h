@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace sensor_msgs
 {
 
+  class JoyFeedbackView;
+
   class JoyFeedback : public tinyros::Msg
   {
     public:
@@ -26,6 +30,8 @@ namespace sensor_msgs
       enum { TYPE_RUMBLE =  1 };
       enum { TYPE_BUZZER =  2 };
 
+      static constexpr uint32_t kSerializedSize = 6;
+
     JoyFeedback():
       type(0),
       id(0),
@@ -35,70 +41,66 @@ namespace sensor_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->type >> (8 * 0)) & 0xFF;
-      offset += sizeof(this->type);
-      *(outbuffer + offset + 0) = (this->id >> (8 * 0)) & 0xFF;
-      offset += sizeof(this->id);
-      union {
-        float real;
-        uint32_t base;
-      } u_intensity;
-      u_intensity.real = this->intensity;
-      *(outbuffer + offset + 0) = (u_intensity.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_intensity.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_intensity.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_intensity.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->intensity);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->type, 1);
+      arrayToArr(outbuffer + 1, &this->id, 1);
+      arrayToArr(outbuffer + 2, &this->intensity, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->type =  ((uint8_t) (*(inbuffer + offset)));
-      offset += sizeof(this->type);
-      this->id =  ((uint8_t) (*(inbuffer + offset)));
-      offset += sizeof(this->id);
-      union {
-        float real;
-        uint32_t base;
-      } u_intensity;
-      u_intensity.base = 0;
-      u_intensity.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_intensity.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_intensity.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_intensity.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->intensity = u_intensity.real;
-      offset += sizeof(this->intensity);
-      return offset;
+      arrToArray(&this->type, inbuffer + 0, 1);
+      arrToArray(&this->id, inbuffer + 1, 1);
+      arrToArray(&this->intensity, inbuffer + 2, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->type);
-      length += sizeof(this->id);
-      length += sizeof(this->intensity);
-      return length;
+      writer.raw('{');
+      writer.key("type");
+      writer.value(this->type);
+      writer.raw(',');
+      writer.key("id");
+      writer.value(this->id);
+      writer.raw(',');
+      writer.key("intensity");
+      writer.value(this->intensity);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_type; ss_type << "\"type\":" << (uint16_t)type <<",";
-      string_echo += ss_type.str();
-      std::stringstream ss_id; ss_id << "\"id\":" << (uint16_t)id <<",";
-      string_echo += ss_id.str();
-      std::stringstream ss_intensity; ss_intensity << "\"intensity\":" << intensity <<"";
-      string_echo += ss_intensity.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/JoyFeedback"; }
     virtual std::string getMD5(){ return "206b65e86c8b195f816ccbe40b3568a2"; }
+    typedef JoyFeedbackView View;
+
+  };
+
+  /* JoyFeedback read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class JoyFeedbackView
+  {
+    public:
+    typedef JoyFeedback MsgType;
+
+    JoyFeedbackView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 6; }
+
+    uint8_t type() const { return tinyros::viewRead<uint8_t>(buffer_ + 0); }
+    uint8_t id() const { return tinyros::viewRead<uint8_t>(buffer_ + 1); }
+    float intensity() const { return tinyros::viewRead<float>(buffer_ + 2); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace sensor_msgs
 {
 
+  class LaserEchoView;
+
   class LaserEcho : public tinyros::Msg
   {
     public:
@@ -34,18 +38,8 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->echoes_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->echoes_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->echoes_length);
-      for( uint32_t i = 0; i < echoes_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_echoesi;
-        u_echoesi.real = this->echoes[i];
-        *(outbuffer + offset + 0) = (u_echoesi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_echoesi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_echoesi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_echoesi.base >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->echoes[i]);
-      }
+      arrayToArr(outbuffer + offset, this->echoes, echoes_length);
+      offset += echoes_length * sizeof(float);
       return offset;
     }
 
@@ -60,20 +54,8 @@ namespace sensor_msgs
       if(echoes_lengthT > echoes_length)
         this->echoes = (float*)realloc(this->echoes, echoes_lengthT * sizeof(float));
       echoes_length = echoes_lengthT;
-      for( uint32_t i = 0; i < echoes_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_st_echoes;
-        u_st_echoes.base = 0;
-        u_st_echoes.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_echoes.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_echoes.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_echoes.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_echoes = u_st_echoes.real;
-        offset += sizeof(this->st_echoes);
-        memcpy( &(this->echoes[i]), &(this->st_echoes), sizeof(float));
-      }
+      arrToArray(this->echoes, inbuffer + offset, echoes_length);
+      offset += echoes_length * sizeof(float);
       return offset;
     }
 
@@ -81,33 +63,68 @@ namespace sensor_msgs
     {
       int length = 0;
       length += sizeof(this->echoes_length);
-      for( uint32_t i = 0; i < echoes_length; i++) {
-        length += sizeof(this->echoes[i]);
-      }
+      length += echoes_length * sizeof(float);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("echoes", this->echoes, this->echoes_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "echoes:[";
-      for( uint32_t i = 0; i < echoes_length; i++) {
-        if( i == (echoes_length - 1)) {
-          std::stringstream ss_echoesi; ss_echoesi << echoes[i] <<"";
-          string_echo += ss_echoesi.str();
-        } else {
-          std::stringstream ss_echoesi; ss_echoesi << echoes[i] <<",";
-          string_echo += ss_echoesi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/LaserEcho"; }
     virtual std::string getMD5(){ return "a8537b388573845b3240b44db5bc4905"; }
+    typedef LaserEchoView View;
+
+  };
+
+  /* LaserEcho read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LaserEchoView
+  {
+    public:
+    typedef LaserEcho MsgType;
+
+    LaserEchoView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(1); }
+
+    tinyros::Span<float> echoes() const
+    {
+      const unsigned char* p = buffer_ + 0;
+      return tinyros::Span<float>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = 4 + tinyros::viewRead<uint32_t>(p) * 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[2];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class LaserScanView;
+
   class LaserScan : public tinyros::Msg
   {
     public:
@@ -135,35 +139,15 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->ranges_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->ranges_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->ranges_length);
-      for( uint32_t i = 0; i < ranges_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_rangesi;
-        u_rangesi.real = this->ranges[i];
-        *(outbuffer + offset + 0) = (u_rangesi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_rangesi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_rangesi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_rangesi.base >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->ranges[i]);
-      }
+      arrayToArr(outbuffer + offset, this->ranges, ranges_length);
+      offset += ranges_length * sizeof(float);
       *(outbuffer + offset + 0) = (this->intensities_length >> (8 * 0)) & 0xFF;
       *(outbuffer + offset + 1) = (this->intensities_length >> (8 * 1)) & 0xFF;
       *(outbuffer + offset + 2) = (this->intensities_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->intensities_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->intensities_length);
-      for( uint32_t i = 0; i < intensities_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_intensitiesi;
-        u_intensitiesi.real = this->intensities[i];
-        *(outbuffer + offset + 0) = (u_intensitiesi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_intensitiesi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_intensitiesi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_intensitiesi.base >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->intensities[i]);
-      }
+      arrayToArr(outbuffer + offset, this->intensities, intensities_length);
+      offset += intensities_length * sizeof(float);
       return offset;
     }
 
@@ -256,20 +240,8 @@ namespace sensor_msgs
       if(ranges_lengthT > ranges_length)
         this->ranges = (float*)realloc(this->ranges, ranges_lengthT * sizeof(float));
       ranges_length = ranges_lengthT;
-      for( uint32_t i = 0; i < ranges_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_st_ranges;
-        u_st_ranges.base = 0;
-        u_st_ranges.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_ranges.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_ranges.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_ranges.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_ranges = u_st_ranges.real;
-        offset += sizeof(this->st_ranges);
-        memcpy( &(this->ranges[i]), &(this->st_ranges), sizeof(float));
-      }
+      arrToArray(this->ranges, inbuffer + offset, ranges_length);
+      offset += ranges_length * sizeof(float);
       uint32_t intensities_lengthT = ((uint32_t) (*(inbuffer + offset))); 
       intensities_lengthT |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1); 
       intensities_lengthT |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2); 
@@ -278,20 +250,8 @@ namespace sensor_msgs
       if(intensities_lengthT > intensities_length)
         this->intensities = (float*)realloc(this->intensities, intensities_lengthT * sizeof(float));
       intensities_length = intensities_lengthT;
-      for( uint32_t i = 0; i < intensities_length; i++) {
-        union {
-          float real;
-          uint32_t base;
-        } u_st_intensities;
-        u_st_intensities.base = 0;
-        u_st_intensities.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_intensities.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_intensities.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_intensities.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_intensities = u_st_intensities.real;
-        offset += sizeof(this->st_intensities);
-        memcpy( &(this->intensities[i]), &(this->st_intensities), sizeof(float));
-      }
+      arrToArray(this->intensities, inbuffer + offset, intensities_length);
+      offset += intensities_length * sizeof(float);
       return offset;
     }
 
@@ -307,65 +267,118 @@ namespace sensor_msgs
       length += sizeof(this->range_min);
       length += sizeof(this->range_max);
       length += sizeof(this->ranges_length);
-      for( uint32_t i = 0; i < ranges_length; i++) {
-        length += sizeof(this->ranges[i]);
-      }
+      length += ranges_length * sizeof(float);
       length += sizeof(this->intensities_length);
-      for( uint32_t i = 0; i < intensities_length; i++) {
-        length += sizeof(this->intensities[i]);
-      }
+      length += intensities_length * sizeof(float);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("angle_min");
+      writer.value(this->angle_min);
+      writer.raw(',');
+      writer.key("angle_max");
+      writer.value(this->angle_max);
+      writer.raw(',');
+      writer.key("angle_increment");
+      writer.value(this->angle_increment);
+      writer.raw(',');
+      writer.key("time_increment");
+      writer.value(this->time_increment);
+      writer.raw(',');
+      writer.key("scan_time");
+      writer.value(this->scan_time);
+      writer.raw(',');
+      writer.key("range_min");
+      writer.value(this->range_min);
+      writer.raw(',');
+      writer.key("range_max");
+      writer.value(this->range_max);
+      writer.raw(',');
+      writer.array("ranges", this->ranges, this->ranges_length);
+      writer.raw(',');
+      writer.array("intensities", this->intensities, this->intensities_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_angle_min; ss_angle_min << "\"angle_min\":" << angle_min <<",";
-      string_echo += ss_angle_min.str();
-      std::stringstream ss_angle_max; ss_angle_max << "\"angle_max\":" << angle_max <<",";
-      string_echo += ss_angle_max.str();
-      std::stringstream ss_angle_increment; ss_angle_increment << "\"angle_increment\":" << angle_increment <<",";
-      string_echo += ss_angle_increment.str();
-      std::stringstream ss_time_increment; ss_time_increment << "\"time_increment\":" << time_increment <<",";
-      string_echo += ss_time_increment.str();
-      std::stringstream ss_scan_time; ss_scan_time << "\"scan_time\":" << scan_time <<",";
-      string_echo += ss_scan_time.str();
-      std::stringstream ss_range_min; ss_range_min << "\"range_min\":" << range_min <<",";
-      string_echo += ss_range_min.str();
-      std::stringstream ss_range_max; ss_range_max << "\"range_max\":" << range_max <<",";
-      string_echo += ss_range_max.str();
-      string_echo += "ranges:[";
-      for( uint32_t i = 0; i < ranges_length; i++) {
-        if( i == (ranges_length - 1)) {
-          std::stringstream ss_rangesi; ss_rangesi << ranges[i] <<"";
-          string_echo += ss_rangesi.str();
-        } else {
-          std::stringstream ss_rangesi; ss_rangesi << ranges[i] <<",";
-          string_echo += ss_rangesi.str();
-        }
-      }
-      string_echo += "],";
-      string_echo += "intensities:[";
-      for( uint32_t i = 0; i < intensities_length; i++) {
-        if( i == (intensities_length - 1)) {
-          std::stringstream ss_intensitiesi; ss_intensitiesi << intensities[i] <<"";
-          string_echo += ss_intensitiesi.str();
-        } else {
-          std::stringstream ss_intensitiesi; ss_intensitiesi << intensities[i] <<",";
-          string_echo += ss_intensitiesi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/LaserScan"; }
     virtual std::string getMD5(){ return "9387943977c16b7fa134689acd87f1a2"; }
+    typedef LaserScanView View;
+
+  };
+
+  /* LaserScan read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LaserScanView
+  {
+    public:
+    typedef LaserScan MsgType;
+
+    LaserScanView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(10); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    float angle_min() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(1)); }
+    float angle_max() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(2)); }
+    float angle_increment() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(3)); }
+    float time_increment() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(4)); }
+    float scan_time() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(5)); }
+    float range_min() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(6)); }
+    float range_max() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(7)); }
+    tinyros::Span<float> ranges() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(8);
+      return tinyros::Span<float>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<float> intensities() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(9);
+      return tinyros::Span<float>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+          case 3: length = 4; break;
+          case 4: length = 4; break;
+          case 5: length = 4; break;
+          case 6: length = 4; break;
+          case 7: length = 4; break;
+          case 8: length = 4 + tinyros::viewRead<uint32_t>(p) * 4; break;
+          case 9: length = 4 + tinyros::viewRead<uint32_t>(p) * 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[11];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Vector3.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class MagneticFieldView;
+
   class MagneticField : public tinyros::Msg
   {
     public:
@@ -36,22 +40,8 @@ namespace sensor_msgs
       int offset = 0;
       offset += this->header.serialize(outbuffer + offset);
       offset += this->magnetic_field.serialize(outbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_magnetic_field_covariancei;
-        u_magnetic_field_covariancei.real = this->magnetic_field_covariance[i];
-        *(outbuffer + offset + 0) = (u_magnetic_field_covariancei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_magnetic_field_covariancei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_magnetic_field_covariancei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_magnetic_field_covariancei.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_magnetic_field_covariancei.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_magnetic_field_covariancei.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_magnetic_field_covariancei.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_magnetic_field_covariancei.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->magnetic_field_covariance[i]);
-      }
+      arrayToArr(outbuffer + offset, this->magnetic_field_covariance, 9);
+      offset += 9 * sizeof(double);
       return offset;
     }
 
@@ -60,23 +50,8 @@ namespace sensor_msgs
       int offset = 0;
       offset += this->header.deserialize(inbuffer + offset);
       offset += this->magnetic_field.deserialize(inbuffer + offset);
-      for( uint32_t i = 0; i < 9; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_magnetic_field_covariancei;
-        u_magnetic_field_covariancei.base = 0;
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_magnetic_field_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->magnetic_field_covariance[i] = u_magnetic_field_covariancei.real;
-        offset += sizeof(this->magnetic_field_covariance[i]);
-      }
+      arrToArray(this->magnetic_field_covariance, inbuffer + offset, 9);
+      offset += 9 * sizeof(double);
       return offset;
     }
 
@@ -85,39 +60,74 @@ namespace sensor_msgs
       int length = 0;
       length += this->header.serializedLength();
       length += this->magnetic_field.serializedLength();
-      for( uint32_t i = 0; i < 9; i++) {
-        length += sizeof(this->magnetic_field_covariance[i]);
-      }
+      length += 9 * sizeof(double);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("magnetic_field");
+      writer.value(this->magnetic_field);
+      writer.raw(',');
+      writer.array("magnetic_field_covariance", this->magnetic_field_covariance, 9);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"magnetic_field\":";
-      string_echo += this->magnetic_field.echo();
-      string_echo += ",";
-      string_echo += "magnetic_field_covariance:[";
-      for( uint32_t i = 0; i < 9; i++) {
-        if( i == (9 - 1)) {
-          std::stringstream ss_magnetic_field_covariancei; ss_magnetic_field_covariancei << magnetic_field_covariance[i] <<"";
-          string_echo += ss_magnetic_field_covariancei.str();
-        } else {
-          std::stringstream ss_magnetic_field_covariancei; ss_magnetic_field_covariancei << magnetic_field_covariance[i] <<",";
-          string_echo += ss_magnetic_field_covariancei.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/MagneticField"; }
     virtual std::string getMD5(){ return "f8e051d776de1349146122759c66db92"; }
+    typedef MagneticFieldView View;
+
+  };
+
+  /* MagneticField read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MagneticFieldView
+  {
+    public:
+    typedef MagneticField MsgType;
+
+    MagneticFieldView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::geometry_msgs::Vector3View magnetic_field() const { return tinyros::geometry_msgs::Vector3View(buffer_ + fieldOffset(1)); }
+    tinyros::Span<double> magnetic_field_covariance() const { return tinyros::Span<double>(buffer_ + fieldOffset(2), 9); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::geometry_msgs::Vector3View(p).serializedLength(); break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
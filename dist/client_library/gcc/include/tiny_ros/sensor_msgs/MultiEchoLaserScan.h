@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/sensor_msgs/LaserEcho.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class MultiEchoLaserScanView;
+
   class MultiEchoLaserScan : public tinyros::Msg
   {
     public:
@@ -280,55 +284,112 @@ namespace sensor_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("angle_min");
+      writer.value(this->angle_min);
+      writer.raw(',');
+      writer.key("angle_max");
+      writer.value(this->angle_max);
+      writer.raw(',');
+      writer.key("angle_increment");
+      writer.value(this->angle_increment);
+      writer.raw(',');
+      writer.key("time_increment");
+      writer.value(this->time_increment);
+      writer.raw(',');
+      writer.key("scan_time");
+      writer.value(this->scan_time);
+      writer.raw(',');
+      writer.key("range_min");
+      writer.value(this->range_min);
+      writer.raw(',');
+      writer.key("range_max");
+      writer.value(this->range_max);
+      writer.raw(',');
+      writer.array("ranges", this->ranges, this->ranges_length);
+      writer.raw(',');
+      writer.array("intensities", this->intensities, this->intensities_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_angle_min; ss_angle_min << "\"angle_min\":" << angle_min <<",";
-      string_echo += ss_angle_min.str();
-      std::stringstream ss_angle_max; ss_angle_max << "\"angle_max\":" << angle_max <<",";
-      string_echo += ss_angle_max.str();
-      std::stringstream ss_angle_increment; ss_angle_increment << "\"angle_increment\":" << angle_increment <<",";
-      string_echo += ss_angle_increment.str();
-      std::stringstream ss_time_increment; ss_time_increment << "\"time_increment\":" << time_increment <<",";
-      string_echo += ss_time_increment.str();
-      std::stringstream ss_scan_time; ss_scan_time << "\"scan_time\":" << scan_time <<",";
-      string_echo += ss_scan_time.str();
-      std::stringstream ss_range_min; ss_range_min << "\"range_min\":" << range_min <<",";
-      string_echo += ss_range_min.str();
-      std::stringstream ss_range_max; ss_range_max << "\"range_max\":" << range_max <<",";
-      string_echo += ss_range_max.str();
-      string_echo += "ranges:[";
-      for( uint32_t i = 0; i < ranges_length; i++) {
-        if( i == (ranges_length - 1)) {
-          string_echo += this->ranges[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->ranges[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "intensities:[";
-      for( uint32_t i = 0; i < intensities_length; i++) {
-        if( i == (intensities_length - 1)) {
-          string_echo += this->intensities[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->intensities[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/MultiEchoLaserScan"; }
     virtual std::string getMD5(){ return "92f3933b4fa486e3889b461437899bf5"; }
+    typedef MultiEchoLaserScanView View;
+
+  };
+
+  /* MultiEchoLaserScan read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MultiEchoLaserScanView
+  {
+    public:
+    typedef MultiEchoLaserScan MsgType;
+
+    MultiEchoLaserScanView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(10); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    float angle_min() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(1)); }
+    float angle_max() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(2)); }
+    float angle_increment() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(3)); }
+    float time_increment() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(4)); }
+    float scan_time() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(5)); }
+    float range_min() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(6)); }
+    float range_max() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(7)); }
+    tinyros::ViewList<tinyros::sensor_msgs::LaserEchoView> ranges() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(8);
+      return tinyros::ViewList<tinyros::sensor_msgs::LaserEchoView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::sensor_msgs::LaserEchoView> intensities() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(9);
+      return tinyros::ViewList<tinyros::sensor_msgs::LaserEchoView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+          case 3: length = 4; break;
+          case 4: length = 4; break;
+          case 5: length = 4; break;
+          case 6: length = 4; break;
+          case 7: length = 4; break;
+          case 8: length = 4 + tinyros::ViewList<tinyros::sensor_msgs::LaserEchoView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 9: length = 4 + tinyros::ViewList<tinyros::sensor_msgs::LaserEchoView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[11];
+    mutable uint32_t known_;
   };
 
 }
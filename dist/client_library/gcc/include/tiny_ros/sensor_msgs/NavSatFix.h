@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/sensor_msgs/NavSatStatus.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class NavSatFixView;
+
   class NavSatFix : public tinyros::Msg
   {
     public:
@@ -94,22 +98,8 @@ namespace sensor_msgs
       *(outbuffer + offset + 6) = (u_altitude.base >> (8 * 6)) & 0xFF;
       *(outbuffer + offset + 7) = (u_altitude.base >> (8 * 7)) & 0xFF;
       offset += sizeof(this->altitude);
-      for( uint32_t i = 0; i < 9; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_position_covariancei;
-        u_position_covariancei.real = this->position_covariance[i];
-        *(outbuffer + offset + 0) = (u_position_covariancei.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_position_covariancei.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_position_covariancei.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_position_covariancei.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_position_covariancei.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_position_covariancei.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_position_covariancei.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_position_covariancei.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->position_covariance[i]);
-      }
+      arrayToArr(outbuffer + offset, this->position_covariance, 9);
+      offset += 9 * sizeof(double);
       *(outbuffer + offset + 0) = (this->position_covariance_type >> (8 * 0)) & 0xFF;
       offset += sizeof(this->position_covariance_type);
       return offset;
@@ -165,23 +155,8 @@ namespace sensor_msgs
       u_altitude.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
       this->altitude = u_altitude.real;
       offset += sizeof(this->altitude);
-      for( uint32_t i = 0; i < 9; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_position_covariancei;
-        u_position_covariancei.base = 0;
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_position_covariancei.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->position_covariance[i] = u_position_covariancei.real;
-        offset += sizeof(this->position_covariance[i]);
-      }
+      arrToArray(this->position_covariance, inbuffer + offset, 9);
+      offset += 9 * sizeof(double);
       this->position_covariance_type =  ((uint8_t) (*(inbuffer + offset)));
       offset += sizeof(this->position_covariance_type);
       return offset;
@@ -195,48 +170,95 @@ namespace sensor_msgs
       length += sizeof(this->latitude);
       length += sizeof(this->longitude);
       length += sizeof(this->altitude);
-      for( uint32_t i = 0; i < 9; i++) {
-        length += sizeof(this->position_covariance[i]);
-      }
+      length += 9 * sizeof(double);
       length += sizeof(this->position_covariance_type);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("status");
+      writer.value(this->status);
+      writer.raw(',');
+      writer.key("latitude");
+      writer.value(this->latitude);
+      writer.raw(',');
+      writer.key("longitude");
+      writer.value(this->longitude);
+      writer.raw(',');
+      writer.key("altitude");
+      writer.value(this->altitude);
+      writer.raw(',');
+      writer.array("position_covariance", this->position_covariance, 9);
+      writer.raw(',');
+      writer.key("position_covariance_type");
+      writer.value(this->position_covariance_type);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"status\":";
-      string_echo += this->status.echo();
-      string_echo += ",";
-      std::stringstream ss_latitude; ss_latitude << "\"latitude\":" << latitude <<",";
-      string_echo += ss_latitude.str();
-      std::stringstream ss_longitude; ss_longitude << "\"longitude\":" << longitude <<",";
-      string_echo += ss_longitude.str();
-      std::stringstream ss_altitude; ss_altitude << "\"altitude\":" << altitude <<",";
-      string_echo += ss_altitude.str();
-      string_echo += "position_covariance:[";
-      for( uint32_t i = 0; i < 9; i++) {
-        if( i == (9 - 1)) {
-          std::stringstream ss_position_covariancei; ss_position_covariancei << position_covariance[i] <<"";
-          string_echo += ss_position_covariancei.str();
-        } else {
-          std::stringstream ss_position_covariancei; ss_position_covariancei << position_covariance[i] <<",";
-          string_echo += ss_position_covariancei.str();
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_position_covariance_type; ss_position_covariance_type << "\"position_covariance_type\":" << (uint16_t)position_covariance_type <<"";
-      string_echo += ss_position_covariance_type.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/NavSatFix"; }
     virtual std::string getMD5(){ return "adc27ca9d8634ed087021b82f3c43576"; }
+    typedef NavSatFixView View;
+
+  };
+
+  /* NavSatFix read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class NavSatFixView
+  {
+    public:
+    typedef NavSatFix MsgType;
+
+    NavSatFixView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(7); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::sensor_msgs::NavSatStatusView status() const { return tinyros::sensor_msgs::NavSatStatusView(buffer_ + fieldOffset(1)); }
+    double latitude() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(2)); }
+    double longitude() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(3)); }
+    double altitude() const { return tinyros::viewRead<double>(buffer_ + fieldOffset(4)); }
+    tinyros::Span<double> position_covariance() const { return tinyros::Span<double>(buffer_ + fieldOffset(5), 9); }
+    uint8_t position_covariance_type() const { return tinyros::viewRead<uint8_t>(buffer_ + fieldOffset(6)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::sensor_msgs::NavSatStatusView(p).serializedLength(); break;
+          case 2: length = 8; break;
+          case 3: length = 8; break;
+          case 4: length = 8; break;
+          case 5: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+          case 6: length = 1; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[8];
+    mutable uint32_t known_;
   };
 
 }
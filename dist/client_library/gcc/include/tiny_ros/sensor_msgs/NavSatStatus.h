@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace sensor_msgs
 {
 
+  class NavSatStatusView;
+
   class NavSatStatus : public tinyros::Msg
   {
     public:
@@ -29,6 +33,8 @@ namespace sensor_msgs
       enum { SERVICE_COMPASS =  4       };
       enum { SERVICE_GALILEO =  8 };
 
+      static constexpr uint32_t kSerializedSize = 3;
+
     NavSatStatus():
       status(0),
       service(0)
@@ -37,59 +43,60 @@ namespace sensor_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        int8_t real;
-        uint8_t base;
-      } u_status;
-      u_status.real = this->status;
-      *(outbuffer + offset + 0) = (u_status.base >> (8 * 0)) & 0xFF;
-      offset += sizeof(this->status);
-      *(outbuffer + offset + 0) = (this->service >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->service >> (8 * 1)) & 0xFF;
-      offset += sizeof(this->service);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->status, 1);
+      arrayToArr(outbuffer + 1, &this->service, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        int8_t real;
-        uint8_t base;
-      } u_status;
-      u_status.base = 0;
-      u_status.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      this->status = u_status.real;
-      offset += sizeof(this->status);
-      this->service =  ((uint16_t) (*(inbuffer + offset)));
-      this->service |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      offset += sizeof(this->service);
-      return offset;
+      arrToArray(&this->status, inbuffer + 0, 1);
+      arrToArray(&this->service, inbuffer + 1, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->status);
-      length += sizeof(this->service);
-      return length;
+      writer.raw('{');
+      writer.key("status");
+      writer.value(this->status);
+      writer.raw(',');
+      writer.key("service");
+      writer.value(this->service);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_status; ss_status << "\"status\":" << (int16_t)status <<",";
-      string_echo += ss_status.str();
-      std::stringstream ss_service; ss_service << "\"service\":" << service <<"";
-      string_echo += ss_service.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/NavSatStatus"; }
     virtual std::string getMD5(){ return "85ed59cf80532c1c15a2cf735d06279b"; }
+    typedef NavSatStatusView View;
+
+  };
+
+  /* NavSatStatus read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class NavSatStatusView
+  {
+    public:
+    typedef NavSatStatus MsgType;
+
+    NavSatStatusView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 3; }
+
+    int8_t status() const { return tinyros::viewRead<int8_t>(buffer_ + 0); }
+    uint16_t service() const { return tinyros::viewRead<uint16_t>(buffer_ + 1); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/geometry_msgs/Point32.h"
 #include "tiny_ros/sensor_msgs/ChannelFloat32.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class PointCloudView;
+
   class PointCloud : public tinyros::Msg
   {
     public:
@@ -106,41 +110,77 @@ namespace sensor_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("points", this->points, this->points_length);
+      writer.raw(',');
+      writer.array("channels", this->channels, this->channels_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "points:[";
-      for( uint32_t i = 0; i < points_length; i++) {
-        if( i == (points_length - 1)) {
-          string_echo += this->points[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->points[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "channels:[";
-      for( uint32_t i = 0; i < channels_length; i++) {
-        if( i == (channels_length - 1)) {
-          string_echo += this->channels[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->channels[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/PointCloud"; }
     virtual std::string getMD5(){ return "b01249148cae0106a561ab36cd1e48a8"; }
+    typedef PointCloudView View;
+
+  };
+
+  /* PointCloud read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PointCloudView
+  {
+    public:
+    typedef PointCloud MsgType;
+
+    PointCloudView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::Span<tinyros::geometry_msgs::Point32View> points() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<tinyros::geometry_msgs::Point32View>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::sensor_msgs::ChannelFloat32View> channels() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::ViewList<tinyros::sensor_msgs::ChannelFloat32View>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 12; break;
+          case 2: length = 4 + tinyros::ViewList<tinyros::sensor_msgs::ChannelFloat32View>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/sensor_msgs/PointField.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class PointCloud2View;
+
   class PointCloud2 : public tinyros::Msg
   {
     public:
@@ -98,10 +102,8 @@ namespace sensor_msgs
       *(outbuffer + offset + 2) = (this->data_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->data_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        *(outbuffer + offset + 0) = (this->data[i] >> (8 * 0)) & 0xFF;
-        offset += sizeof(this->data[i]);
-      }
+      arrayToArr(outbuffer + offset, this->data, data_length);
+      offset += data_length * sizeof(uint8_t);
       union {
         bool real;
         uint8_t base;
@@ -164,11 +166,8 @@ namespace sensor_msgs
       if(data_lengthT > data_length)
         this->data = (uint8_t*)realloc(this->data, data_lengthT * sizeof(uint8_t));
       data_length = data_lengthT;
-      for( uint32_t i = 0; i < data_length; i++) {
-        this->st_data =  ((uint8_t) (*(inbuffer + offset)));
-        offset += sizeof(this->st_data);
-        memcpy( &(this->data[i]), &(this->st_data), sizeof(uint8_t));
-      }
+      arrToArray(this->data, inbuffer + offset, data_length);
+      offset += data_length * sizeof(uint8_t);
       union {
         bool real;
         uint8_t base;
@@ -194,60 +193,112 @@ namespace sensor_msgs
       length += sizeof(this->point_step);
       length += sizeof(this->row_step);
       length += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        length += sizeof(this->data[i]);
-      }
+      length += data_length * sizeof(uint8_t);
       length += sizeof(this->is_dense);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("height");
+      writer.value(this->height);
+      writer.raw(',');
+      writer.key("width");
+      writer.value(this->width);
+      writer.raw(',');
+      writer.array("fields", this->fields, this->fields_length);
+      writer.raw(',');
+      writer.key("is_bigendian");
+      writer.value(this->is_bigendian);
+      writer.raw(',');
+      writer.key("point_step");
+      writer.value(this->point_step);
+      writer.raw(',');
+      writer.key("row_step");
+      writer.value(this->row_step);
+      writer.raw(',');
+      writer.array("data", this->data, this->data_length);
+      writer.raw(',');
+      writer.key("is_dense");
+      writer.value(this->is_dense);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_height; ss_height << "\"height\":" << height <<",";
-      string_echo += ss_height.str();
-      std::stringstream ss_width; ss_width << "\"width\":" << width <<",";
-      string_echo += ss_width.str();
-      string_echo += "fields:[";
-      for( uint32_t i = 0; i < fields_length; i++) {
-        if( i == (fields_length - 1)) {
-          string_echo += this->fields[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->fields[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_is_bigendian; ss_is_bigendian << "\"is_bigendian\":" << is_bigendian <<",";
-      string_echo += ss_is_bigendian.str();
-      std::stringstream ss_point_step; ss_point_step << "\"point_step\":" << point_step <<",";
-      string_echo += ss_point_step.str();
-      std::stringstream ss_row_step; ss_row_step << "\"row_step\":" << row_step <<",";
-      string_echo += ss_row_step.str();
-      string_echo += "data:[";
-      for( uint32_t i = 0; i < data_length; i++) {
-        if( i == (data_length - 1)) {
-          std::stringstream ss_datai; ss_datai << (uint16_t)data[i] <<"";
-          string_echo += ss_datai.str();
-        } else {
-          std::stringstream ss_datai; ss_datai << (uint16_t)data[i] <<",";
-          string_echo += ss_datai.str();
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_is_dense; ss_is_dense << "\"is_dense\":" << is_dense <<"";
-      string_echo += ss_is_dense.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/PointCloud2"; }
     virtual std::string getMD5(){ return "6aa926339b282463281af40546b3b3cf"; }
+    typedef PointCloud2View View;
+
+  };
+
+  /* PointCloud2 read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PointCloud2View
+  {
+    public:
+    typedef PointCloud2 MsgType;
+
+    PointCloud2View(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(9); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    uint32_t height() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(1)); }
+    uint32_t width() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(2)); }
+    tinyros::ViewList<tinyros::sensor_msgs::PointFieldView> fields() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::ViewList<tinyros::sensor_msgs::PointFieldView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    bool is_bigendian() const { return tinyros::viewRead<bool>(buffer_ + fieldOffset(4)); }
+    uint32_t point_step() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(5)); }
+    uint32_t row_step() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(6)); }
+    tinyros::Span<uint8_t> data() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(7);
+      return tinyros::Span<uint8_t>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    bool is_dense() const { return tinyros::viewRead<bool>(buffer_ + fieldOffset(8)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+          case 3: length = 4 + tinyros::ViewList<tinyros::sensor_msgs::PointFieldView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 4: length = 1; break;
+          case 5: length = 4; break;
+          case 6: length = 4; break;
+          case 7: length = 4 + tinyros::viewRead<uint32_t>(p) * 1; break;
+          case 8: length = 1; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[10];
+    mutable uint32_t known_;
   };
 
 }
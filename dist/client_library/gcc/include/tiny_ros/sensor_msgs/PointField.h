@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace sensor_msgs
 {
 
+  class PointFieldView;
+
   class PointField : public tinyros::Msg
   {
     public:
@@ -103,30 +107,76 @@ namespace sensor_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("name");
+      writer.value(this->name);
+      writer.raw(',');
+      writer.key("offset");
+      writer.value(this->offset);
+      writer.raw(',');
+      writer.key("datatype");
+      writer.value(this->datatype);
+      writer.raw(',');
+      writer.key("count");
+      writer.value(this->count);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t name_pos = name.find("\"");
-      while(name_pos != std::string::npos){
-        name.replace(name_pos, 1,"\\\"");
-        name_pos = name.find("\"", name_pos+2);
-      }
-      string_echo += "\"name\":\"";
-      string_echo += name;
-      string_echo += "\",";
-      std::stringstream ss_offset; ss_offset << "\"offset\":" << offset <<",";
-      string_echo += ss_offset.str();
-      std::stringstream ss_datatype; ss_datatype << "\"datatype\":" << (uint16_t)datatype <<",";
-      string_echo += ss_datatype.str();
-      std::stringstream ss_count; ss_count << "\"count\":" << count <<"";
-      string_echo += ss_count.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/PointField"; }
     virtual std::string getMD5(){ return "039974f05fdf0470d9dc865fd01dcc3e"; }
+    typedef PointFieldView View;
+
+  };
+
+  /* PointField read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PointFieldView
+  {
+    public:
+    typedef PointField MsgType;
+
+    PointFieldView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(4); }
+
+    tinyros::StringView name() const { return tinyros::StringView(buffer_ + 0); }
+    uint32_t offset() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(1)); }
+    uint8_t datatype() const { return tinyros::viewRead<uint8_t>(buffer_ + fieldOffset(2)); }
+    uint32_t count() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(3)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 1; break;
+          case 3: length = 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[5];
+    mutable uint32_t known_;
   };
 
 }
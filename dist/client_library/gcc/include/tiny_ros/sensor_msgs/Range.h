@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class RangeView;
+
   class Range : public tinyros::Msg
   {
     public:
@@ -156,29 +160,86 @@ namespace sensor_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("radiation_type");
+      writer.value(this->radiation_type);
+      writer.raw(',');
+      writer.key("field_of_view");
+      writer.value(this->field_of_view);
+      writer.raw(',');
+      writer.key("min_range");
+      writer.value(this->min_range);
+      writer.raw(',');
+      writer.key("max_range");
+      writer.value(this->max_range);
+      writer.raw(',');
+      writer.key("range");
+      writer.value(this->range);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_radiation_type; ss_radiation_type << "\"radiation_type\":" << (uint16_t)radiation_type <<",";
-      string_echo += ss_radiation_type.str();
-      std::stringstream ss_field_of_view; ss_field_of_view << "\"field_of_view\":" << field_of_view <<",";
-      string_echo += ss_field_of_view.str();
-      std::stringstream ss_min_range; ss_min_range << "\"min_range\":" << min_range <<",";
-      string_echo += ss_min_range.str();
-      std::stringstream ss_max_range; ss_max_range << "\"max_range\":" << max_range <<",";
-      string_echo += ss_max_range.str();
-      std::stringstream ss_range; ss_range << "\"range\":" << range <<"";
-      string_echo += ss_range.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/Range"; }
     virtual std::string getMD5(){ return "54d647e3a481f5b87ce39d1b97e84d53"; }
+    typedef RangeView View;
+
+  };
+
+  /* Range read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class RangeView
+  {
+    public:
+    typedef Range MsgType;
+
+    RangeView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(6); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    uint8_t radiation_type() const { return tinyros::viewRead<uint8_t>(buffer_ + fieldOffset(1)); }
+    float field_of_view() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(2)); }
+    float min_range() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(3)); }
+    float max_range() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(4)); }
+    float range() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(5)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 1; break;
+          case 2: length = 4; break;
+          case 3: length = 4; break;
+          case 4: length = 4; break;
+          case 5: length = 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[7];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace sensor_msgs
 {
 
+  class RegionOfInterestView;
+
   class RegionOfInterest : public tinyros::Msg
   {
     public:
@@ -27,6 +31,8 @@ namespace sensor_msgs
       typedef bool _do_rectify_type;
       _do_rectify_type do_rectify;
 
+      static constexpr uint32_t kSerializedSize = 17;
+
     RegionOfInterest():
       x_offset(0),
       y_offset(0),
@@ -38,102 +44,78 @@ namespace sensor_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->x_offset >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->x_offset >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->x_offset >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->x_offset >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->x_offset);
-      *(outbuffer + offset + 0) = (this->y_offset >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->y_offset >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->y_offset >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->y_offset >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->y_offset);
-      *(outbuffer + offset + 0) = (this->height >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->height >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->height >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->height >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->height);
-      *(outbuffer + offset + 0) = (this->width >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->width >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->width >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->width >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->width);
-      union {
-        bool real;
-        uint8_t base;
-      } u_do_rectify;
-      u_do_rectify.real = this->do_rectify;
-      *(outbuffer + offset + 0) = (u_do_rectify.base >> (8 * 0)) & 0xFF;
-      offset += sizeof(this->do_rectify);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->x_offset, 1);
+      arrayToArr(outbuffer + 4, &this->y_offset, 1);
+      arrayToArr(outbuffer + 8, &this->height, 1);
+      arrayToArr(outbuffer + 12, &this->width, 1);
+      arrayToArr(outbuffer + 16, &this->do_rectify, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->x_offset =  ((uint32_t) (*(inbuffer + offset)));
-      this->x_offset |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->x_offset |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->x_offset |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->x_offset);
-      this->y_offset =  ((uint32_t) (*(inbuffer + offset)));
-      this->y_offset |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->y_offset |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->y_offset |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->y_offset);
-      this->height =  ((uint32_t) (*(inbuffer + offset)));
-      this->height |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->height |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->height |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->height);
-      this->width =  ((uint32_t) (*(inbuffer + offset)));
-      this->width |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->width |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->width |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->width);
-      union {
-        bool real;
-        uint8_t base;
-      } u_do_rectify;
-      u_do_rectify.base = 0;
-      u_do_rectify.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      this->do_rectify = u_do_rectify.real;
-      offset += sizeof(this->do_rectify);
-      return offset;
+      arrToArray(&this->x_offset, inbuffer + 0, 1);
+      arrToArray(&this->y_offset, inbuffer + 4, 1);
+      arrToArray(&this->height, inbuffer + 8, 1);
+      arrToArray(&this->width, inbuffer + 12, 1);
+      arrToArray(&this->do_rectify, inbuffer + 16, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->x_offset);
-      length += sizeof(this->y_offset);
-      length += sizeof(this->height);
-      length += sizeof(this->width);
-      length += sizeof(this->do_rectify);
-      return length;
+      writer.raw('{');
+      writer.key("x_offset");
+      writer.value(this->x_offset);
+      writer.raw(',');
+      writer.key("y_offset");
+      writer.value(this->y_offset);
+      writer.raw(',');
+      writer.key("height");
+      writer.value(this->height);
+      writer.raw(',');
+      writer.key("width");
+      writer.value(this->width);
+      writer.raw(',');
+      writer.key("do_rectify");
+      writer.value(this->do_rectify);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_x_offset; ss_x_offset << "\"x_offset\":" << x_offset <<",";
-      string_echo += ss_x_offset.str();
-      std::stringstream ss_y_offset; ss_y_offset << "\"y_offset\":" << y_offset <<",";
-      string_echo += ss_y_offset.str();
-      std::stringstream ss_height; ss_height << "\"height\":" << height <<",";
-      string_echo += ss_height.str();
-      std::stringstream ss_width; ss_width << "\"width\":" << width <<",";
-      string_echo += ss_width.str();
-      std::stringstream ss_do_rectify; ss_do_rectify << "\"do_rectify\":" << do_rectify <<"";
-      string_echo += ss_do_rectify.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/RegionOfInterest"; }
     virtual std::string getMD5(){ return "8370dc286f915405c906299aef5bb442"; }
+    typedef RegionOfInterestView View;
+
+  };
+
+  /* RegionOfInterest read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class RegionOfInterestView
+  {
+    public:
+    typedef RegionOfInterest MsgType;
+
+    RegionOfInterestView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 17; }
+
+    uint32_t x_offset() const { return tinyros::viewRead<uint32_t>(buffer_ + 0); }
+    uint32_t y_offset() const { return tinyros::viewRead<uint32_t>(buffer_ + 4); }
+    uint32_t height() const { return tinyros::viewRead<uint32_t>(buffer_ + 8); }
+    uint32_t width() const { return tinyros::viewRead<uint32_t>(buffer_ + 12); }
+    bool do_rectify() const { return tinyros::viewRead<bool>(buffer_ + 16); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
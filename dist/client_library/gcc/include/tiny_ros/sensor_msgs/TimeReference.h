@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/ros/time.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace sensor_msgs
 {
 
+  class TimeReferenceView;
+
   class TimeReference : public tinyros::Msg
   {
     public:
@@ -92,31 +96,71 @@ namespace sensor_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("time_ref");
+      writer.value(this->time_ref);
+      writer.raw(',');
+      writer.key("source");
+      writer.value(this->source);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::stringstream ss_time_ref;
-      ss_time_ref << "\"time_ref\":{\"sec\":" << time_ref.sec;
-      ss_time_ref << ",\"nsec\":" << time_ref.nsec << "},";
-      string_echo += ss_time_ref.str();
-      std::size_t source_pos = source.find("\"");
-      while(source_pos != std::string::npos){
-        source.replace(source_pos, 1,"\\\"");
-        source_pos = source.find("\"", source_pos+2);
-      }
-      string_echo += "\"source\":\"";
-      string_echo += source;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "sensor_msgs/TimeReference"; }
     virtual std::string getMD5(){ return "8e1576e01de57cd0d55758112f0e84ec"; }
+    typedef TimeReferenceView View;
+
+  };
+
+  /* TimeReference read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TimeReferenceView
+  {
+    public:
+    typedef TimeReference MsgType;
+
+    TimeReferenceView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::Time time_ref() const { return tinyros::viewRead<tinyros::Time>(buffer_ + fieldOffset(1)); }
+    tinyros::StringView source() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 8; break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/shape_msgs/MeshTriangle.h"
 #include "tiny_ros/geometry_msgs/Point.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace shape_msgs
 {
 
+  class MeshView;
+
   class Mesh : public tinyros::Msg
   {
     public:
@@ -99,38 +103,72 @@ namespace shape_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("triangles", this->triangles, this->triangles_length);
+      writer.raw(',');
+      writer.array("vertices", this->vertices, this->vertices_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "triangles:[";
-      for( uint32_t i = 0; i < triangles_length; i++) {
-        if( i == (triangles_length - 1)) {
-          string_echo += this->triangles[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->triangles[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "vertices:[";
-      for( uint32_t i = 0; i < vertices_length; i++) {
-        if( i == (vertices_length - 1)) {
-          string_echo += this->vertices[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->vertices[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "shape_msgs/Mesh"; }
     virtual std::string getMD5(){ return "1579670b316f622b47d6700cd4f7e18d"; }
+    typedef MeshView View;
+
+  };
+
+  /* Mesh read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MeshView
+  {
+    public:
+    typedef Mesh MsgType;
+
+    MeshView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::Span<tinyros::shape_msgs::MeshTriangleView> triangles() const
+    {
+      const unsigned char* p = buffer_ + 0;
+      return tinyros::Span<tinyros::shape_msgs::MeshTriangleView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<tinyros::geometry_msgs::PointView> vertices() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<tinyros::geometry_msgs::PointView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = 4 + tinyros::viewRead<uint32_t>(p) * 12; break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 24; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
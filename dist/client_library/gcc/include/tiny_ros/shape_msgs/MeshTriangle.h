@@ -7,17 +7,23 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace shape_msgs
 {
 
+  class MeshTriangleView;
+
   class MeshTriangle : public tinyros::Msg
   {
     public:
       uint32_t vertex_indices[3];
 
+      static constexpr uint32_t kSerializedSize = 12;
+
     MeshTriangle():
       vertex_indices()
     {
@@ -25,60 +31,53 @@ namespace shape_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      for( uint32_t i = 0; i < 3; i++) {
-        *(outbuffer + offset + 0) = (this->vertex_indices[i] >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (this->vertex_indices[i] >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (this->vertex_indices[i] >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (this->vertex_indices[i] >> (8 * 3)) & 0xFF;
-        offset += sizeof(this->vertex_indices[i]);
-      }
-      return offset;
+      arrayToArr(outbuffer + 0, this->vertex_indices, 3);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      for( uint32_t i = 0; i < 3; i++){
-        this->vertex_indices[i] =  ((uint32_t) (*(inbuffer + offset)));
-        this->vertex_indices[i] |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        this->vertex_indices[i] |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        this->vertex_indices[i] |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        offset += sizeof(this->vertex_indices[i]);
-      }
-      return offset;
+      arrToArray(this->vertex_indices, inbuffer + 0, 3);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      for( uint32_t i = 0; i < 3; i++) {
-        length += sizeof(this->vertex_indices[i]);
-      }
-      return length;
+      writer.raw('{');
+      writer.array("vertex_indices", this->vertex_indices, 3);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "vertex_indices:[";
-      for( uint32_t i = 0; i < 3; i++) {
-        if( i == (3 - 1)) {
-          std::stringstream ss_vertex_indicesi; ss_vertex_indicesi << vertex_indices[i] <<"";
-          string_echo += ss_vertex_indicesi.str();
-        } else {
-          std::stringstream ss_vertex_indicesi; ss_vertex_indicesi << vertex_indices[i] <<",";
-          string_echo += ss_vertex_indicesi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "shape_msgs/MeshTriangle"; }
     virtual std::string getMD5(){ return "01020cfeb9ad7679dd18bbd7149962ba"; }
+    typedef MeshTriangleView View;
+
+  };
+
+  /* MeshTriangle read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MeshTriangleView
+  {
+    public:
+    typedef MeshTriangle MsgType;
+
+    MeshTriangleView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 12; }
+
+    tinyros::Span<uint32_t> vertex_indices() const { return tinyros::Span<uint32_t>(buffer_ + 0, 3); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
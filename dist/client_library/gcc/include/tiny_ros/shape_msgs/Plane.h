@@ -7,17 +7,23 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace shape_msgs
 {
 
+  class PlaneView;
+
   class Plane : public tinyros::Msg
   {
     public:
       double coef[4];
 
+      static constexpr uint32_t kSerializedSize = 32;
+
     Plane():
       coef()
     {
@@ -25,79 +31,53 @@ namespace shape_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      for( uint32_t i = 0; i < 4; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_coefi;
-        u_coefi.real = this->coef[i];
-        *(outbuffer + offset + 0) = (u_coefi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_coefi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_coefi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_coefi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_coefi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_coefi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_coefi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_coefi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->coef[i]);
-      }
-      return offset;
+      arrayToArr(outbuffer + 0, this->coef, 4);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      for( uint32_t i = 0; i < 4; i++){
-        union {
-          double real;
-          uint64_t base;
-        } u_coefi;
-        u_coefi.base = 0;
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_coefi.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->coef[i] = u_coefi.real;
-        offset += sizeof(this->coef[i]);
-      }
-      return offset;
+      arrToArray(this->coef, inbuffer + 0, 4);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      for( uint32_t i = 0; i < 4; i++) {
-        length += sizeof(this->coef[i]);
-      }
-      return length;
+      writer.raw('{');
+      writer.array("coef", this->coef, 4);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "coef:[";
-      for( uint32_t i = 0; i < 4; i++) {
-        if( i == (4 - 1)) {
-          std::stringstream ss_coefi; ss_coefi << coef[i] <<"";
-          string_echo += ss_coefi.str();
-        } else {
-          std::stringstream ss_coefi; ss_coefi << coef[i] <<",";
-          string_echo += ss_coefi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "shape_msgs/Plane"; }
     virtual std::string getMD5(){ return "770421286b7c90effe8aac9f1c37eac0"; }
+    typedef PlaneView View;
+
+  };
+
+  /* Plane read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class PlaneView
+  {
+    public:
+    typedef Plane MsgType;
+
+    PlaneView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 32; }
+
+    tinyros::Span<double> coef() const { return tinyros::Span<double>(buffer_ + 0, 4); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace shape_msgs
 {
 
+  class SolidPrimitiveView;
+
   class SolidPrimitive : public tinyros::Msg
   {
     public:
@@ -51,22 +55,8 @@ namespace shape_msgs
       *(outbuffer + offset + 2) = (this->dimensions_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->dimensions_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->dimensions_length);
-      for( uint32_t i = 0; i < dimensions_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_dimensionsi;
-        u_dimensionsi.real = this->dimensions[i];
-        *(outbuffer + offset + 0) = (u_dimensionsi.base >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (u_dimensionsi.base >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (u_dimensionsi.base >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (u_dimensionsi.base >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (u_dimensionsi.base >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (u_dimensionsi.base >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (u_dimensionsi.base >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (u_dimensionsi.base >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->dimensions[i]);
-      }
+      arrayToArr(outbuffer + offset, this->dimensions, dimensions_length);
+      offset += dimensions_length * sizeof(double);
       return offset;
     }
 
@@ -83,24 +73,8 @@ namespace shape_msgs
       if(dimensions_lengthT > dimensions_length)
         this->dimensions = (double*)realloc(this->dimensions, dimensions_lengthT * sizeof(double));
       dimensions_length = dimensions_lengthT;
-      for( uint32_t i = 0; i < dimensions_length; i++) {
-        union {
-          double real;
-          uint64_t base;
-        } u_st_dimensions;
-        u_st_dimensions.base = 0;
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        u_st_dimensions.base |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        this->st_dimensions = u_st_dimensions.real;
-        offset += sizeof(this->st_dimensions);
-        memcpy( &(this->dimensions[i]), &(this->st_dimensions), sizeof(double));
-      }
+      arrToArray(this->dimensions, inbuffer + offset, dimensions_length);
+      offset += dimensions_length * sizeof(double);
       return offset;
     }
 
@@ -109,35 +83,72 @@ namespace shape_msgs
       int length = 0;
       length += sizeof(this->type);
       length += sizeof(this->dimensions_length);
-      for( uint32_t i = 0; i < dimensions_length; i++) {
-        length += sizeof(this->dimensions[i]);
-      }
+      length += dimensions_length * sizeof(double);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("type");
+      writer.value(this->type);
+      writer.raw(',');
+      writer.array("dimensions", this->dimensions, this->dimensions_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_type; ss_type << "\"type\":" << (uint16_t)type <<",";
-      string_echo += ss_type.str();
-      string_echo += "dimensions:[";
-      for( uint32_t i = 0; i < dimensions_length; i++) {
-        if( i == (dimensions_length - 1)) {
-          std::stringstream ss_dimensionsi; ss_dimensionsi << dimensions[i] <<"";
-          string_echo += ss_dimensionsi.str();
-        } else {
-          std::stringstream ss_dimensionsi; ss_dimensionsi << dimensions[i] <<",";
-          string_echo += ss_dimensionsi.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "shape_msgs/SolidPrimitive"; }
     virtual std::string getMD5(){ return "f40805922065416be24909fd8fd751b5"; }
+    typedef SolidPrimitiveView View;
+
+  };
+
+  /* SolidPrimitive read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class SolidPrimitiveView
+  {
+    public:
+    typedef SolidPrimitive MsgType;
+
+    SolidPrimitiveView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(1)
+    {
+      offsets_[1] = 1;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    uint8_t type() const { return tinyros::viewRead<uint8_t>(buffer_ + 0); }
+    tinyros::Span<double> dimensions() const
+    {
+      const unsigned char* p = buffer_ + 1;
+      return tinyros::Span<double>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
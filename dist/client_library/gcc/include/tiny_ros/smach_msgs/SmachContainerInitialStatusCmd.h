@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace smach_msgs
 {
 
+  class SmachContainerInitialStatusCmdView;
+
   class SmachContainerInitialStatusCmd : public tinyros::Msg
   {
     public:
@@ -122,57 +126,74 @@ namespace smach_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("path");
+      writer.value(this->path);
+      writer.raw(',');
+      writer.array("initial_states", this->initial_states, this->initial_states_length);
+      writer.raw(',');
+      writer.key("local_data");
+      writer.value(this->local_data);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t path_pos = path.find("\"");
-      while(path_pos != std::string::npos){
-        path.replace(path_pos, 1,"\\\"");
-        path_pos = path.find("\"", path_pos+2);
-      }
-      string_echo += "\"path\":\"";
-      string_echo += path;
-      string_echo += "\",";
-      string_echo += "initial_states:[";
-      for( uint32_t i = 0; i < initial_states_length; i++) {
-        if( i == (initial_states_length - 1)) {
-          std::stringstream ss_initial_statesi; ss_initial_statesi << "\"";
-          string_echo += ss_initial_statesi.str();
-          std::size_t initial_statesi_pos = initial_states[i].find("\"");
-          while(initial_statesi_pos != std::string::npos){
-            initial_states[i].replace(initial_statesi_pos, 1,"\\\"");
-            initial_statesi_pos = initial_states[i].find("\"", initial_statesi_pos+2);
-          }
-          string_echo += initial_states[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_initial_statesi; ss_initial_statesi << "\"";
-          string_echo += ss_initial_statesi.str();
-          std::size_t initial_statesi_pos = initial_states[i].find("\"");
-          while(initial_statesi_pos != std::string::npos){
-            initial_states[i].replace(initial_statesi_pos, 1,"\\\"");
-            initial_statesi_pos = initial_states[i].find("\"", initial_statesi_pos+2);
-          }
-          string_echo += initial_states[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      std::size_t local_data_pos = local_data.find("\"");
-      while(local_data_pos != std::string::npos){
-        local_data.replace(local_data_pos, 1,"\\\"");
-        local_data_pos = local_data.find("\"", local_data_pos+2);
-      }
-      string_echo += "\"local_data\":\"";
-      string_echo += local_data;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "smach_msgs/SmachContainerInitialStatusCmd"; }
     virtual std::string getMD5(){ return "b7c8a2bbd4d7c89f80561645ea1f4f13"; }
+    typedef SmachContainerInitialStatusCmdView View;
+
+  };
+
+  /* SmachContainerInitialStatusCmd read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class SmachContainerInitialStatusCmdView
+  {
+    public:
+    typedef SmachContainerInitialStatusCmd MsgType;
+
+    SmachContainerInitialStatusCmdView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::StringView path() const { return tinyros::StringView(buffer_ + 0); }
+    tinyros::ViewList<tinyros::StringView> initial_states() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::StringView local_data() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace smach_msgs
 {
 
+  class SmachContainerStatusView;
+
   class SmachContainerStatus : public tinyros::Msg
   {
     public:
@@ -192,93 +196,92 @@ namespace smach_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("path");
+      writer.value(this->path);
+      writer.raw(',');
+      writer.array("initial_states", this->initial_states, this->initial_states_length);
+      writer.raw(',');
+      writer.array("active_states", this->active_states, this->active_states_length);
+      writer.raw(',');
+      writer.key("local_data");
+      writer.value(this->local_data);
+      writer.raw(',');
+      writer.key("info");
+      writer.value(this->info);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::size_t path_pos = path.find("\"");
-      while(path_pos != std::string::npos){
-        path.replace(path_pos, 1,"\\\"");
-        path_pos = path.find("\"", path_pos+2);
-      }
-      string_echo += "\"path\":\"";
-      string_echo += path;
-      string_echo += "\",";
-      string_echo += "initial_states:[";
-      for( uint32_t i = 0; i < initial_states_length; i++) {
-        if( i == (initial_states_length - 1)) {
-          std::stringstream ss_initial_statesi; ss_initial_statesi << "\"";
-          string_echo += ss_initial_statesi.str();
-          std::size_t initial_statesi_pos = initial_states[i].find("\"");
-          while(initial_statesi_pos != std::string::npos){
-            initial_states[i].replace(initial_statesi_pos, 1,"\\\"");
-            initial_statesi_pos = initial_states[i].find("\"", initial_statesi_pos+2);
-          }
-          string_echo += initial_states[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_initial_statesi; ss_initial_statesi << "\"";
-          string_echo += ss_initial_statesi.str();
-          std::size_t initial_statesi_pos = initial_states[i].find("\"");
-          while(initial_statesi_pos != std::string::npos){
-            initial_states[i].replace(initial_statesi_pos, 1,"\\\"");
-            initial_statesi_pos = initial_states[i].find("\"", initial_statesi_pos+2);
-          }
-          string_echo += initial_states[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "active_states:[";
-      for( uint32_t i = 0; i < active_states_length; i++) {
-        if( i == (active_states_length - 1)) {
-          std::stringstream ss_active_statesi; ss_active_statesi << "\"";
-          string_echo += ss_active_statesi.str();
-          std::size_t active_statesi_pos = active_states[i].find("\"");
-          while(active_statesi_pos != std::string::npos){
-            active_states[i].replace(active_statesi_pos, 1,"\\\"");
-            active_statesi_pos = active_states[i].find("\"", active_statesi_pos+2);
-          }
-          string_echo += active_states[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_active_statesi; ss_active_statesi << "\"";
-          string_echo += ss_active_statesi.str();
-          std::size_t active_statesi_pos = active_states[i].find("\"");
-          while(active_statesi_pos != std::string::npos){
-            active_states[i].replace(active_statesi_pos, 1,"\\\"");
-            active_statesi_pos = active_states[i].find("\"", active_statesi_pos+2);
-          }
-          string_echo += active_states[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      std::size_t local_data_pos = local_data.find("\"");
-      while(local_data_pos != std::string::npos){
-        local_data.replace(local_data_pos, 1,"\\\"");
-        local_data_pos = local_data.find("\"", local_data_pos+2);
-      }
-      string_echo += "\"local_data\":\"";
-      string_echo += local_data;
-      string_echo += "\",";
-      std::size_t info_pos = info.find("\"");
-      while(info_pos != std::string::npos){
-        info.replace(info_pos, 1,"\\\"");
-        info_pos = info.find("\"", info_pos+2);
-      }
-      string_echo += "\"info\":\"";
-      string_echo += info;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "smach_msgs/SmachContainerStatus"; }
     virtual std::string getMD5(){ return "3e74cf72da18311be27e7a5970ea6415"; }
+    typedef SmachContainerStatusView View;
+
+  };
+
+  /* SmachContainerStatus read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class SmachContainerStatusView
+  {
+    public:
+    typedef SmachContainerStatus MsgType;
+
+    SmachContainerStatusView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(6); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::StringView path() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+    tinyros::ViewList<tinyros::StringView> initial_states() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::StringView> active_states() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::StringView local_data() const { return tinyros::StringView(buffer_ + fieldOffset(4)); }
+    tinyros::StringView info() const { return tinyros::StringView(buffer_ + fieldOffset(5)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 3: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 4: length = tinyros::StringView(p).serializedLength(); break;
+          case 5: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[7];
+    mutable uint32_t known_;
   };
 
 }
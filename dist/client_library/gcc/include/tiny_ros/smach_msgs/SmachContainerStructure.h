@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace smach_msgs
 {
 
+  class SmachContainerStructureView;
+
   class SmachContainerStructure : public tinyros::Msg
   {
     public:
@@ -281,152 +285,106 @@ namespace smach_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("path");
+      writer.value(this->path);
+      writer.raw(',');
+      writer.array("children", this->children, this->children_length);
+      writer.raw(',');
+      writer.array("internal_outcomes", this->internal_outcomes, this->internal_outcomes_length);
+      writer.raw(',');
+      writer.array("outcomes_from", this->outcomes_from, this->outcomes_from_length);
+      writer.raw(',');
+      writer.array("outcomes_to", this->outcomes_to, this->outcomes_to_length);
+      writer.raw(',');
+      writer.array("container_outcomes", this->container_outcomes, this->container_outcomes_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      std::size_t path_pos = path.find("\"");
-      while(path_pos != std::string::npos){
-        path.replace(path_pos, 1,"\\\"");
-        path_pos = path.find("\"", path_pos+2);
-      }
-      string_echo += "\"path\":\"";
-      string_echo += path;
-      string_echo += "\",";
-      string_echo += "children:[";
-      for( uint32_t i = 0; i < children_length; i++) {
-        if( i == (children_length - 1)) {
-          std::stringstream ss_childreni; ss_childreni << "\"";
-          string_echo += ss_childreni.str();
-          std::size_t childreni_pos = children[i].find("\"");
-          while(childreni_pos != std::string::npos){
-            children[i].replace(childreni_pos, 1,"\\\"");
-            childreni_pos = children[i].find("\"", childreni_pos+2);
-          }
-          string_echo += children[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_childreni; ss_childreni << "\"";
-          string_echo += ss_childreni.str();
-          std::size_t childreni_pos = children[i].find("\"");
-          while(childreni_pos != std::string::npos){
-            children[i].replace(childreni_pos, 1,"\\\"");
-            childreni_pos = children[i].find("\"", childreni_pos+2);
-          }
-          string_echo += children[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "internal_outcomes:[";
-      for( uint32_t i = 0; i < internal_outcomes_length; i++) {
-        if( i == (internal_outcomes_length - 1)) {
-          std::stringstream ss_internal_outcomesi; ss_internal_outcomesi << "\"";
-          string_echo += ss_internal_outcomesi.str();
-          std::size_t internal_outcomesi_pos = internal_outcomes[i].find("\"");
-          while(internal_outcomesi_pos != std::string::npos){
-            internal_outcomes[i].replace(internal_outcomesi_pos, 1,"\\\"");
-            internal_outcomesi_pos = internal_outcomes[i].find("\"", internal_outcomesi_pos+2);
-          }
-          string_echo += internal_outcomes[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_internal_outcomesi; ss_internal_outcomesi << "\"";
-          string_echo += ss_internal_outcomesi.str();
-          std::size_t internal_outcomesi_pos = internal_outcomes[i].find("\"");
-          while(internal_outcomesi_pos != std::string::npos){
-            internal_outcomes[i].replace(internal_outcomesi_pos, 1,"\\\"");
-            internal_outcomesi_pos = internal_outcomes[i].find("\"", internal_outcomesi_pos+2);
-          }
-          string_echo += internal_outcomes[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "outcomes_from:[";
-      for( uint32_t i = 0; i < outcomes_from_length; i++) {
-        if( i == (outcomes_from_length - 1)) {
-          std::stringstream ss_outcomes_fromi; ss_outcomes_fromi << "\"";
-          string_echo += ss_outcomes_fromi.str();
-          std::size_t outcomes_fromi_pos = outcomes_from[i].find("\"");
-          while(outcomes_fromi_pos != std::string::npos){
-            outcomes_from[i].replace(outcomes_fromi_pos, 1,"\\\"");
-            outcomes_fromi_pos = outcomes_from[i].find("\"", outcomes_fromi_pos+2);
-          }
-          string_echo += outcomes_from[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_outcomes_fromi; ss_outcomes_fromi << "\"";
-          string_echo += ss_outcomes_fromi.str();
-          std::size_t outcomes_fromi_pos = outcomes_from[i].find("\"");
-          while(outcomes_fromi_pos != std::string::npos){
-            outcomes_from[i].replace(outcomes_fromi_pos, 1,"\\\"");
-            outcomes_fromi_pos = outcomes_from[i].find("\"", outcomes_fromi_pos+2);
-          }
-          string_echo += outcomes_from[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "outcomes_to:[";
-      for( uint32_t i = 0; i < outcomes_to_length; i++) {
-        if( i == (outcomes_to_length - 1)) {
-          std::stringstream ss_outcomes_toi; ss_outcomes_toi << "\"";
-          string_echo += ss_outcomes_toi.str();
-          std::size_t outcomes_toi_pos = outcomes_to[i].find("\"");
-          while(outcomes_toi_pos != std::string::npos){
-            outcomes_to[i].replace(outcomes_toi_pos, 1,"\\\"");
-            outcomes_toi_pos = outcomes_to[i].find("\"", outcomes_toi_pos+2);
-          }
-          string_echo += outcomes_to[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_outcomes_toi; ss_outcomes_toi << "\"";
-          string_echo += ss_outcomes_toi.str();
-          std::size_t outcomes_toi_pos = outcomes_to[i].find("\"");
-          while(outcomes_toi_pos != std::string::npos){
-            outcomes_to[i].replace(outcomes_toi_pos, 1,"\\\"");
-            outcomes_toi_pos = outcomes_to[i].find("\"", outcomes_toi_pos+2);
-          }
-          string_echo += outcomes_to[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "container_outcomes:[";
-      for( uint32_t i = 0; i < container_outcomes_length; i++) {
-        if( i == (container_outcomes_length - 1)) {
-          std::stringstream ss_container_outcomesi; ss_container_outcomesi << "\"";
-          string_echo += ss_container_outcomesi.str();
-          std::size_t container_outcomesi_pos = container_outcomes[i].find("\"");
-          while(container_outcomesi_pos != std::string::npos){
-            container_outcomes[i].replace(container_outcomesi_pos, 1,"\\\"");
-            container_outcomesi_pos = container_outcomes[i].find("\"", container_outcomesi_pos+2);
-          }
-          string_echo += container_outcomes[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_container_outcomesi; ss_container_outcomesi << "\"";
-          string_echo += ss_container_outcomesi.str();
-          std::size_t container_outcomesi_pos = container_outcomes[i].find("\"");
-          while(container_outcomesi_pos != std::string::npos){
-            container_outcomes[i].replace(container_outcomesi_pos, 1,"\\\"");
-            container_outcomesi_pos = container_outcomes[i].find("\"", container_outcomesi_pos+2);
-          }
-          string_echo += container_outcomes[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "smach_msgs/SmachContainerStructure"; }
     virtual std::string getMD5(){ return "0209663ab13753a56b6ac1d094d07fbe"; }
+    typedef SmachContainerStructureView View;
+
+  };
+
+  /* SmachContainerStructure read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class SmachContainerStructureView
+  {
+    public:
+    typedef SmachContainerStructure MsgType;
+
+    SmachContainerStructureView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(7); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::StringView path() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+    tinyros::ViewList<tinyros::StringView> children() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::StringView> internal_outcomes() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(3);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::StringView> outcomes_from() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(4);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::StringView> outcomes_to() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(5);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::StringView> container_outcomes() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(6);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 3: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 4: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 5: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 6: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[8];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/MultiArrayLayout.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace std_msgs
 {
 
+  class ByteMultiArrayView;
+
   class ByteMultiArray : public tinyros::Msg
   {
     public:
@@ -39,15 +43,8 @@ namespace std_msgs
       *(outbuffer + offset + 2) = (this->data_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->data_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        union {
-          int8_t real;
-          uint8_t base;
-        } u_datai;
-        u_datai.real = this->data[i];
-        *(outbuffer + offset + 0) = (u_datai.base >> (8 * 0)) & 0xFF;
-        offset += sizeof(this->data[i]);
-      }
+      arrayToArr(outbuffer + offset, this->data, data_length);
+      offset += data_length * sizeof(int8_t);
       return offset;
     }
 
@@ -63,17 +60,8 @@ namespace std_msgs
       if(data_lengthT > data_length)
         this->data = (int8_t*)realloc(this->data, data_lengthT * sizeof(int8_t));
       data_length = data_lengthT;
-      for( uint32_t i = 0; i < data_length; i++) {
-        union {
-          int8_t real;
-          uint8_t base;
-        } u_st_data;
-        u_st_data.base = 0;
-        u_st_data.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
-        this->st_data = u_st_data.real;
-        offset += sizeof(this->st_data);
-        memcpy( &(this->data[i]), &(this->st_data), sizeof(int8_t));
-      }
+      arrToArray(this->data, inbuffer + offset, data_length);
+      offset += data_length * sizeof(int8_t);
       return offset;
     }
 
@@ -82,36 +70,73 @@ namespace std_msgs
       int length = 0;
       length += this->layout.serializedLength();
       length += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        length += sizeof(this->data[i]);
-      }
+      length += data_length * sizeof(int8_t);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("layout");
+      writer.value(this->layout);
+      writer.raw(',');
+      writer.array("data", this->data, this->data_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"layout\":";
-      string_echo += this->layout.echo();
-      string_echo += ",";
-      string_echo += "data:[";
-      for( uint32_t i = 0; i < data_length; i++) {
-        if( i == (data_length - 1)) {
-          std::stringstream ss_datai; ss_datai <<(int16_t)data[i] <<"";
-          string_echo += ss_datai.str();
-        } else {
-          std::stringstream ss_datai; ss_datai <<(int16_t)data[i] <<",";
-          string_echo += ss_datai.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/ByteMultiArray"; }
     virtual std::string getMD5(){ return "87f5f1a1253d2ff75093b9a005c3a9a4"; }
+    typedef ByteMultiArrayView View;
+
+  };
+
+  /* ByteMultiArray read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ByteMultiArrayView
+  {
+    public:
+    typedef ByteMultiArray MsgType;
+
+    ByteMultiArrayView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::std_msgs::MultiArrayLayoutView layout() const { return tinyros::std_msgs::MultiArrayLayoutView(buffer_ + 0); }
+    tinyros::Span<int8_t> data() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<int8_t>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::MultiArrayLayoutView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 1; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,18 +7,24 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class CharView;
+
   class Char : public tinyros::Msg
   {
     public:
       typedef char _data_type;
       _data_type data;
 
+      static constexpr uint32_t kSerializedSize = 1;
+
     Char():
       data(0)
     {
@@ -26,50 +32,54 @@ namespace std_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        char real;
-        uint8_t base;
-      } u_data;
-      u_data.real = this->data;
-      *(outbuffer + offset + 0) = (u_data.base >> (8 * 0)) & 0xFF;
-      offset += sizeof(this->data);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->data, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        char real;
-        uint8_t base;
-      } u_data;
-      u_data.base = 0;
-      u_data.base |= ((uint8_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      this->data = u_data.real;
-      offset += sizeof(this->data);
-      return offset;
+      arrToArray(&this->data, inbuffer + 0, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->data);
-      return length;
+      writer.raw('{');
+      writer.key("data");
+      writer.value(this->data);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_data; ss_data << "\"data\":" << (int16_t)data <<"";
-      string_echo += ss_data.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/Char"; }
     virtual std::string getMD5(){ return "18741a80dcc02fcae20538073fcb0872"; }
+    typedef CharView View;
+
+  };
+
+  /* Char read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class CharView
+  {
+    public:
+    typedef Char MsgType;
+
+    CharView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 1; }
+
+    char data() const { return tinyros::viewRead<char>(buffer_ + 0); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class ColorRGBAView;
+
   class ColorRGBA : public tinyros::Msg
   {
     public:
@@ -25,6 +29,8 @@ namespace std_msgs
       typedef float _a_type;
       _a_type a;
 
+      static constexpr uint32_t kSerializedSize = 16;
+
     ColorRGBA():
       r(0),
       g(0),
@@ -35,128 +41,72 @@ namespace std_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        float real;
-        uint32_t base;
-      } u_r;
-      u_r.real = this->r;
-      *(outbuffer + offset + 0) = (u_r.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_r.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_r.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_r.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->r);
-      union {
-        float real;
-        uint32_t base;
-      } u_g;
-      u_g.real = this->g;
-      *(outbuffer + offset + 0) = (u_g.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_g.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_g.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_g.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->g);
-      union {
-        float real;
-        uint32_t base;
-      } u_b;
-      u_b.real = this->b;
-      *(outbuffer + offset + 0) = (u_b.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_b.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_b.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_b.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->b);
-      union {
-        float real;
-        uint32_t base;
-      } u_a;
-      u_a.real = this->a;
-      *(outbuffer + offset + 0) = (u_a.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_a.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_a.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_a.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->a);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->r, 1);
+      arrayToArr(outbuffer + 4, &this->g, 1);
+      arrayToArr(outbuffer + 8, &this->b, 1);
+      arrayToArr(outbuffer + 12, &this->a, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        float real;
-        uint32_t base;
-      } u_r;
-      u_r.base = 0;
-      u_r.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_r.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_r.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_r.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->r = u_r.real;
-      offset += sizeof(this->r);
-      union {
-        float real;
-        uint32_t base;
-      } u_g;
-      u_g.base = 0;
-      u_g.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_g.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_g.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_g.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->g = u_g.real;
-      offset += sizeof(this->g);
-      union {
-        float real;
-        uint32_t base;
-      } u_b;
-      u_b.base = 0;
-      u_b.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_b.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_b.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_b.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->b = u_b.real;
-      offset += sizeof(this->b);
-      union {
-        float real;
-        uint32_t base;
-      } u_a;
-      u_a.base = 0;
-      u_a.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_a.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_a.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_a.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->a = u_a.real;
-      offset += sizeof(this->a);
-      return offset;
+      arrToArray(&this->r, inbuffer + 0, 1);
+      arrToArray(&this->g, inbuffer + 4, 1);
+      arrToArray(&this->b, inbuffer + 8, 1);
+      arrToArray(&this->a, inbuffer + 12, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->r);
-      length += sizeof(this->g);
-      length += sizeof(this->b);
-      length += sizeof(this->a);
-      return length;
+      writer.raw('{');
+      writer.key("r");
+      writer.value(this->r);
+      writer.raw(',');
+      writer.key("g");
+      writer.value(this->g);
+      writer.raw(',');
+      writer.key("b");
+      writer.value(this->b);
+      writer.raw(',');
+      writer.key("a");
+      writer.value(this->a);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_r; ss_r << "\"r\":" << r <<",";
-      string_echo += ss_r.str();
-      std::stringstream ss_g; ss_g << "\"g\":" << g <<",";
-      string_echo += ss_g.str();
-      std::stringstream ss_b; ss_b << "\"b\":" << b <<",";
-      string_echo += ss_b.str();
-      std::stringstream ss_a; ss_a << "\"a\":" << a <<"";
-      string_echo += ss_a.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/ColorRGBA"; }
     virtual std::string getMD5(){ return "3c740aa311a337bfa4133c69405e0aed"; }
+    typedef ColorRGBAView View;
+
+  };
+
+  /* ColorRGBA read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class ColorRGBAView
+  {
+    public:
+    typedef ColorRGBA MsgType;
+
+    ColorRGBAView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 16; }
+
+    float r() const { return tinyros::viewRead<float>(buffer_ + 0); }
+    float g() const { return tinyros::viewRead<float>(buffer_ + 4); }
+    float b() const { return tinyros::viewRead<float>(buffer_ + 8); }
+    float a() const { return tinyros::viewRead<float>(buffer_ + 12); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
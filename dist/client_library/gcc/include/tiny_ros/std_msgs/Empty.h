@@ -7,48 +7,71 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class EmptyView;
+
   class Empty : public tinyros::Msg
   {
     public:
 
+      static constexpr uint32_t kSerializedSize = 0;
+
     Empty()
     {
     }
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      return offset;
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      return offset;
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      return length;
+      writer.raw('{');
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/Empty"; }
     virtual std::string getMD5(){ return "140bdcb7bbc50b4a936e90ff2350c8d3"; }
+    typedef EmptyView View;
+
+  };
+
+  /* Empty read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class EmptyView
+  {
+    public:
+    typedef Empty MsgType;
+
+    EmptyView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 0; }
+
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace std_msgs
 {
 
+  class HeaderView;
+
   class Header : public tinyros::Msg
   {
     public:
@@ -99,30 +103,69 @@ namespace std_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("seq");
+      writer.value(this->seq);
+      writer.raw(',');
+      writer.key("stamp");
+      writer.value(this->stamp);
+      writer.raw(',');
+      writer.key("frame_id");
+      writer.value(this->frame_id);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_seq; ss_seq << "\"seq\":" << seq <<",";
-      string_echo += ss_seq.str();
-      std::stringstream ss_stamp;
-      ss_stamp << "\"stamp\":{\"sec\":" << stamp.sec;
-      ss_stamp << ",\"nsec\":" << stamp.nsec << "},";
-      string_echo += ss_stamp.str();
-      std::size_t frame_id_pos = frame_id.find("\"");
-      while(frame_id_pos != std::string::npos){
-        frame_id.replace(frame_id_pos, 1,"\\\"");
-        frame_id_pos = frame_id.find("\"", frame_id_pos+2);
-      }
-      string_echo += "\"frame_id\":\"";
-      string_echo += frame_id;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/Header"; }
     virtual std::string getMD5(){ return "d33440e88be7b5b8255fc61ebbca06ad"; }
+    typedef HeaderView View;
+
+  };
+
+  /* Header read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class HeaderView
+  {
+    public:
+    typedef Header MsgType;
+
+    HeaderView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(2)
+    {
+      offsets_[2] = 12;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    uint32_t seq() const { return tinyros::viewRead<uint32_t>(buffer_ + 0); }
+    tinyros::Time stamp() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 4); }
+    tinyros::StringView frame_id() const { return tinyros::StringView(buffer_ + 12); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,18 +7,24 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class Int32View;
+
   class Int32 : public tinyros::Msg
   {
     public:
       typedef int32_t _data_type;
       _data_type data;
 
+      static constexpr uint32_t kSerializedSize = 4;
+
     Int32():
       data(0)
     {
@@ -26,56 +32,54 @@ namespace std_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      union {
-        int32_t real;
-        uint32_t base;
-      } u_data;
-      u_data.real = this->data;
-      *(outbuffer + offset + 0) = (u_data.base >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (u_data.base >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (u_data.base >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (u_data.base >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->data);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->data, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      union {
-        int32_t real;
-        uint32_t base;
-      } u_data;
-      u_data.base = 0;
-      u_data.base |= ((uint32_t) (*(inbuffer + offset + 0))) << (8 * 0);
-      u_data.base |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      u_data.base |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      u_data.base |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      this->data = u_data.real;
-      offset += sizeof(this->data);
-      return offset;
+      arrToArray(&this->data, inbuffer + 0, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->data);
-      return length;
+      writer.raw('{');
+      writer.key("data");
+      writer.value(this->data);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_data; ss_data << "\"data\":" << data <<"";
-      string_echo += ss_data.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/Int32"; }
     virtual std::string getMD5(){ return "8e99256d77b8f00635db2852db07fc9f"; }
+    typedef Int32View View;
+
+  };
+
+  /* Int32 read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class Int32View
+  {
+    public:
+    typedef Int32 MsgType;
+
+    Int32View(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 4; }
+
+    int32_t data() const { return tinyros::viewRead<int32_t>(buffer_ + 0); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class MultiArrayDimensionView;
+
   class MultiArrayDimension : public tinyros::Msg
   {
     public:
@@ -87,28 +91,71 @@ namespace std_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("label");
+      writer.value(this->label);
+      writer.raw(',');
+      writer.key("size");
+      writer.value(this->size);
+      writer.raw(',');
+      writer.key("stride");
+      writer.value(this->stride);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t label_pos = label.find("\"");
-      while(label_pos != std::string::npos){
-        label.replace(label_pos, 1,"\\\"");
-        label_pos = label.find("\"", label_pos+2);
-      }
-      string_echo += "\"label\":\"";
-      string_echo += label;
-      string_echo += "\",";
-      std::stringstream ss_size; ss_size << "\"size\":" << size <<",";
-      string_echo += ss_size.str();
-      std::stringstream ss_stride; ss_stride << "\"stride\":" << stride <<"";
-      string_echo += ss_stride.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/MultiArrayDimension"; }
     virtual std::string getMD5(){ return "c2aacf83d49c7aa4a8504bd32158e990"; }
+    typedef MultiArrayDimensionView View;
+
+  };
+
+  /* MultiArrayDimension read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MultiArrayDimensionView
+  {
+    public:
+    typedef MultiArrayDimension MsgType;
+
+    MultiArrayDimensionView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::StringView label() const { return tinyros::StringView(buffer_ + 0); }
+    uint32_t size() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(1)); }
+    uint32_t stride() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = 4; break;
+          case 2: length = 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
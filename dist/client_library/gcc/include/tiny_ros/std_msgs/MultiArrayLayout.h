@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/MultiArrayDimension.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace std_msgs
 {
 
+  class MultiArrayLayoutView;
+
   class MultiArrayLayout : public tinyros::Msg
   {
     public:
@@ -83,29 +87,69 @@ namespace std_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("dim", this->dim, this->dim_length);
+      writer.raw(',');
+      writer.key("data_offset");
+      writer.value(this->data_offset);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "dim:[";
-      for( uint32_t i = 0; i < dim_length; i++) {
-        if( i == (dim_length - 1)) {
-          string_echo += this->dim[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->dim[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_data_offset; ss_data_offset << "\"data_offset\":" << data_offset <<"";
-      string_echo += ss_data_offset.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/MultiArrayLayout"; }
     virtual std::string getMD5(){ return "f40f0b5b285a93ca167c98c1012a989a"; }
+    typedef MultiArrayLayoutView View;
+
+  };
+
+  /* MultiArrayLayout read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MultiArrayLayoutView
+  {
+    public:
+    typedef MultiArrayLayout MsgType;
+
+    MultiArrayLayoutView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::ViewList<tinyros::std_msgs::MultiArrayDimensionView> dim() const
+    {
+      const unsigned char* p = buffer_ + 0;
+      return tinyros::ViewList<tinyros::std_msgs::MultiArrayDimensionView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    uint32_t data_offset() const { return tinyros::viewRead<uint32_t>(buffer_ + fieldOffset(1)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = 4 + tinyros::ViewList<tinyros::std_msgs::MultiArrayDimensionView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 1: length = 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class StringView;
+
   class String : public tinyros::Msg
   {
     public:
@@ -59,24 +63,61 @@ namespace std_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("data");
+      writer.value(this->data);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t data_pos = data.find("\"");
-      while(data_pos != std::string::npos){
-        data.replace(data_pos, 1,"\\\"");
-        data_pos = data.find("\"", data_pos+2);
-      }
-      string_echo += "\"data\":\"";
-      string_echo += data;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/String"; }
     virtual std::string getMD5(){ return "44b822292b4a9ed05e241aa225458f97"; }
+    typedef StringView View;
+
+  };
+
+  /* String read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class StringView
+  {
+    public:
+    typedef String MsgType;
+
+    StringView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(1); }
+
+    tinyros::StringView data() const { return tinyros::StringView(buffer_ + 0); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[2];
+    mutable uint32_t known_;
   };
 
 }
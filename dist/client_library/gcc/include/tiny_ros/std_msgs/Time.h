@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 
 namespace tinyros
@@ -14,12 +16,16 @@ namespace tinyros
 namespace std_msgs
 {
 
+  class TimeView;
+
   class Time : public tinyros::Msg
   {
     public:
       typedef tinyros::Time _data_type;
       _data_type data;
 
+      static constexpr uint32_t kSerializedSize = 8;
+
     Time():
       data()
     {
@@ -27,58 +33,56 @@ namespace std_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->data.sec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->data.sec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->data.sec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->data.sec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->data.sec);
-      *(outbuffer + offset + 0) = (this->data.nsec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->data.nsec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->data.nsec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->data.nsec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->data.nsec);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->data.sec, 1);
+      arrayToArr(outbuffer + 0 + 4, &this->data.nsec, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->data.sec =  ((uint32_t) (*(inbuffer + offset)));
-      this->data.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->data.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->data.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->data.sec);
-      this->data.nsec =  ((uint32_t) (*(inbuffer + offset)));
-      this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->data.nsec);
-      return offset;
+      arrToArray(&this->data.sec, inbuffer + 0, 1);
+      arrToArray(&this->data.nsec, inbuffer + 0 + 4, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->data.sec);
-      length += sizeof(this->data.nsec);
-      return length;
+      writer.raw('{');
+      writer.key("data");
+      writer.value(this->data);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_data;
-      ss_data << "\"data\":{\"sec\":" << data.sec;
-      ss_data << ",\"nsec\":" << data.nsec << "}";
-      string_echo += ss_data.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/Time"; }
     virtual std::string getMD5(){ return "64602ed67393e1e61260ab68d6fa2045"; }
+    typedef TimeView View;
+
+  };
+
+  /* Time read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TimeView
+  {
+    public:
+    typedef Time MsgType;
+
+    TimeView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 8; }
+
+    tinyros::Time data() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 0); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
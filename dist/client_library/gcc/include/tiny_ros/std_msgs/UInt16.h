@@ -7,18 +7,24 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class UInt16View;
+
   class UInt16 : public tinyros::Msg
   {
     public:
       typedef uint16_t _data_type;
       _data_type data;
 
+      static constexpr uint32_t kSerializedSize = 2;
+
     UInt16():
       data(0)
     {
@@ -26,41 +32,54 @@ namespace std_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->data >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->data >> (8 * 1)) & 0xFF;
-      offset += sizeof(this->data);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->data, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->data =  ((uint16_t) (*(inbuffer + offset)));
-      this->data |= ((uint16_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      offset += sizeof(this->data);
-      return offset;
+      arrToArray(&this->data, inbuffer + 0, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->data);
-      return length;
+      writer.raw('{');
+      writer.key("data");
+      writer.value(this->data);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_data; ss_data << "\"data\":" << data <<"";
-      string_echo += ss_data.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/UInt16"; }
     virtual std::string getMD5(){ return "a4caad902eedb84b728d8369c50ffc39"; }
+    typedef UInt16View View;
+
+  };
+
+  /* UInt16 read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class UInt16View
+  {
+    public:
+    typedef UInt16 MsgType;
+
+    UInt16View(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 2; }
+
+    uint16_t data() const { return tinyros::viewRead<uint16_t>(buffer_ + 0); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
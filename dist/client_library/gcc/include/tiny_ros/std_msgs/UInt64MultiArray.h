@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/MultiArrayLayout.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace std_msgs
 {
 
+  class UInt64MultiArrayView;
+
   class UInt64MultiArray : public tinyros::Msg
   {
     public:
@@ -39,17 +43,8 @@ namespace std_msgs
       *(outbuffer + offset + 2) = (this->data_length >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->data_length >> (8 * 3)) & 0xFF;
       offset += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        *(outbuffer + offset + 0) = (this->data[i] >> (8 * 0)) & 0xFF;
-        *(outbuffer + offset + 1) = (this->data[i] >> (8 * 1)) & 0xFF;
-        *(outbuffer + offset + 2) = (this->data[i] >> (8 * 2)) & 0xFF;
-        *(outbuffer + offset + 3) = (this->data[i] >> (8 * 3)) & 0xFF;
-        *(outbuffer + offset + 4) = (this->data[i] >> (8 * 4)) & 0xFF;
-        *(outbuffer + offset + 5) = (this->data[i] >> (8 * 5)) & 0xFF;
-        *(outbuffer + offset + 6) = (this->data[i] >> (8 * 6)) & 0xFF;
-        *(outbuffer + offset + 7) = (this->data[i] >> (8 * 7)) & 0xFF;
-        offset += sizeof(this->data[i]);
-      }
+      arrayToArr(outbuffer + offset, this->data, data_length);
+      offset += data_length * sizeof(uint64_t);
       return offset;
     }
 
@@ -65,18 +60,8 @@ namespace std_msgs
       if(data_lengthT > data_length)
         this->data = (uint64_t*)realloc(this->data, data_lengthT * sizeof(uint64_t));
       data_length = data_lengthT;
-      for( uint32_t i = 0; i < data_length; i++) {
-        this->st_data =  ((uint64_t) (*(inbuffer + offset)));
-        this->st_data |= ((uint64_t) (*(inbuffer + offset + 1))) << (8 * 1);
-        this->st_data |= ((uint64_t) (*(inbuffer + offset + 2))) << (8 * 2);
-        this->st_data |= ((uint64_t) (*(inbuffer + offset + 3))) << (8 * 3);
-        this->st_data |= ((uint64_t) (*(inbuffer + offset + 4))) << (8 * 4);
-        this->st_data |= ((uint64_t) (*(inbuffer + offset + 5))) << (8 * 5);
-        this->st_data |= ((uint64_t) (*(inbuffer + offset + 6))) << (8 * 6);
-        this->st_data |= ((uint64_t) (*(inbuffer + offset + 7))) << (8 * 7);
-        offset += sizeof(this->st_data);
-        memcpy( &(this->data[i]), &(this->st_data), sizeof(uint64_t));
-      }
+      arrToArray(this->data, inbuffer + offset, data_length);
+      offset += data_length * sizeof(uint64_t);
       return offset;
     }
 
@@ -85,36 +70,73 @@ namespace std_msgs
       int length = 0;
       length += this->layout.serializedLength();
       length += sizeof(this->data_length);
-      for( uint32_t i = 0; i < data_length; i++) {
-        length += sizeof(this->data[i]);
-      }
+      length += data_length * sizeof(uint64_t);
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("layout");
+      writer.value(this->layout);
+      writer.raw(',');
+      writer.array("data", this->data, this->data_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"layout\":";
-      string_echo += this->layout.echo();
-      string_echo += ",";
-      string_echo += "data:[";
-      for( uint32_t i = 0; i < data_length; i++) {
-        if( i == (data_length - 1)) {
-          std::stringstream ss_datai; ss_datai << data[i] <<"";
-          string_echo += ss_datai.str();
-        } else {
-          std::stringstream ss_datai; ss_datai << data[i] <<",";
-          string_echo += ss_datai.str();
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/UInt64MultiArray"; }
     virtual std::string getMD5(){ return "a0fe08f13f702ecfc59c58150f66678a"; }
+    typedef UInt64MultiArrayView View;
+
+  };
+
+  /* UInt64MultiArray read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class UInt64MultiArrayView
+  {
+    public:
+    typedef UInt64MultiArray MsgType;
+
+    UInt64MultiArrayView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::std_msgs::MultiArrayLayoutView layout() const { return tinyros::std_msgs::MultiArrayLayoutView(buffer_ + 0); }
+    tinyros::Span<uint64_t> data() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<uint64_t>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::MultiArrayLayoutView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
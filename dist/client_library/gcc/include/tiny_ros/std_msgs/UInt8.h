@@ -7,18 +7,24 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace std_msgs
 {
 
+  class UInt8View;
+
   class UInt8 : public tinyros::Msg
   {
     public:
       typedef uint8_t _data_type;
       _data_type data;
 
+      static constexpr uint32_t kSerializedSize = 1;
+
     UInt8():
       data(0)
     {
@@ -26,39 +32,54 @@ namespace std_msgs
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->data >> (8 * 0)) & 0xFF;
-      offset += sizeof(this->data);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->data, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->data =  ((uint8_t) (*(inbuffer + offset)));
-      offset += sizeof(this->data);
-      return offset;
+      arrToArray(&this->data, inbuffer + 0, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->data);
-      return length;
+      writer.raw('{');
+      writer.key("data");
+      writer.value(this->data);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_data; ss_data << "\"data\":" << (uint16_t)data <<"";
-      string_echo += ss_data.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "std_msgs/UInt8"; }
     virtual std::string getMD5(){ return "6f90555707d539e508484b884b2acc65"; }
+    typedef UInt8View View;
+
+  };
+
+  /* UInt8 read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class UInt8View
+  {
+    public:
+    typedef UInt8 MsgType;
+
+    UInt8View(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 1; }
+
+    uint8_t data() const { return tinyros::viewRead<uint8_t>(buffer_ + 0); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
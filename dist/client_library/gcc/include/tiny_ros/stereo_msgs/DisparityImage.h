@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/sensor_msgs/Image.h"
 #include "tiny_ros/sensor_msgs/RegionOfInterest.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace stereo_msgs
 {
 
+  class DisparityImageView;
+
   class DisparityImage : public tinyros::Msg
   {
     public:
@@ -185,35 +189,96 @@ namespace stereo_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("image");
+      writer.value(this->image);
+      writer.raw(',');
+      writer.key("f");
+      writer.value(this->f);
+      writer.raw(',');
+      writer.key("T");
+      writer.value(this->T);
+      writer.raw(',');
+      writer.key("valid_window");
+      writer.value(this->valid_window);
+      writer.raw(',');
+      writer.key("min_disparity");
+      writer.value(this->min_disparity);
+      writer.raw(',');
+      writer.key("max_disparity");
+      writer.value(this->max_disparity);
+      writer.raw(',');
+      writer.key("delta_d");
+      writer.value(this->delta_d);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"image\":";
-      string_echo += this->image.echo();
-      string_echo += ",";
-      std::stringstream ss_f; ss_f << "\"f\":" << f <<",";
-      string_echo += ss_f.str();
-      std::stringstream ss_T; ss_T << "\"T\":" << T <<",";
-      string_echo += ss_T.str();
-      string_echo += "\"valid_window\":";
-      string_echo += this->valid_window.echo();
-      string_echo += ",";
-      std::stringstream ss_min_disparity; ss_min_disparity << "\"min_disparity\":" << min_disparity <<",";
-      string_echo += ss_min_disparity.str();
-      std::stringstream ss_max_disparity; ss_max_disparity << "\"max_disparity\":" << max_disparity <<",";
-      string_echo += ss_max_disparity.str();
-      std::stringstream ss_delta_d; ss_delta_d << "\"delta_d\":" << delta_d <<"";
-      string_echo += ss_delta_d.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "stereo_msgs/DisparityImage"; }
     virtual std::string getMD5(){ return "03545cef8df8d20bea21fdbbf9482b4b"; }
+    typedef DisparityImageView View;
+
+  };
+
+  /* DisparityImage read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class DisparityImageView
+  {
+    public:
+    typedef DisparityImage MsgType;
+
+    DisparityImageView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(8); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::sensor_msgs::ImageView image() const { return tinyros::sensor_msgs::ImageView(buffer_ + fieldOffset(1)); }
+    float f() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(2)); }
+    float T() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(3)); }
+    tinyros::sensor_msgs::RegionOfInterestView valid_window() const { return tinyros::sensor_msgs::RegionOfInterestView(buffer_ + fieldOffset(4)); }
+    float min_disparity() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(5)); }
+    float max_disparity() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(6)); }
+    float delta_d() const { return tinyros::viewRead<float>(buffer_ + fieldOffset(7)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::sensor_msgs::ImageView(p).serializedLength(); break;
+          case 2: length = 4; break;
+          case 3: length = 4; break;
+          case 4: length = tinyros::sensor_msgs::RegionOfInterestView(p).serializedLength(); break;
+          case 5: length = 4; break;
+          case 6: length = 4; break;
+          case 7: length = 4; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[9];
+    mutable uint32_t known_;
   };
 
 }
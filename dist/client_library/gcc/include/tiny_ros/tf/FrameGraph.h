@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -55,11 +57,17 @@ static const char FRAMEGRAPH[] = "tf/FrameGraph";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return FRAMEGRAPH; }
@@ -130,19 +138,19 @@ static const char FRAMEGRAPH[] = "tf/FrameGraph";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("dot_graph");
+      writer.value(this->dot_graph);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t dot_graph_pos = dot_graph.find("\"");
-      while(dot_graph_pos != std::string::npos){
-        dot_graph.replace(dot_graph_pos, 1,"\\\"");
-        dot_graph_pos = dot_graph.find("\"", dot_graph_pos+2);
-      }
-      string_echo += "\"dot_graph\":\"";
-      string_echo += dot_graph;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return FRAMEGRAPH; }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/TransformStamped.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace tf
 {
 
+  class tfMessageView;
+
   class tfMessage : public tinyros::Msg
   {
     public:
@@ -69,27 +73,64 @@ namespace tf
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("transforms", this->transforms, this->transforms_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "transforms:[";
-      for( uint32_t i = 0; i < transforms_length; i++) {
-        if( i == (transforms_length - 1)) {
-          string_echo += this->transforms[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->transforms[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tf/tfMessage"; }
     virtual std::string getMD5(){ return "0401e4f6583aa665321e471e02ec671b"; }
+    typedef tfMessageView View;
+
+  };
+
+  /* tfMessage read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class tfMessageView
+  {
+    public:
+    typedef tfMessage MsgType;
+
+    tfMessageView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(1); }
+
+    tinyros::ViewList<tinyros::geometry_msgs::TransformStampedView> transforms() const
+    {
+      const unsigned char* p = buffer_ + 0;
+      return tinyros::ViewList<tinyros::geometry_msgs::TransformStampedView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = 4 + tinyros::ViewList<tinyros::geometry_msgs::TransformStampedView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[2];
+    mutable uint32_t known_;
   };
 
 }
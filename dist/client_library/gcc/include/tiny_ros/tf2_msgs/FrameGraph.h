@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -55,11 +57,17 @@ static const char FRAMEGRAPH[] = "tf2_msgs/FrameGraph";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return FRAMEGRAPH; }
@@ -130,19 +138,19 @@ static const char FRAMEGRAPH[] = "tf2_msgs/FrameGraph";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("frame_yaml");
+      writer.value(this->frame_yaml);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t frame_yaml_pos = frame_yaml.find("\"");
-      while(frame_yaml_pos != std::string::npos){
-        frame_yaml.replace(frame_yaml_pos, 1,"\\\"");
-        frame_yaml_pos = frame_yaml.find("\"", frame_yaml_pos+2);
-      }
-      string_echo += "\"frame_yaml\":\"";
-      string_echo += frame_yaml;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return FRAMEGRAPH; }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/tf2_msgs/LookupTransformActionGoal.h"
 #include "tiny_ros/tf2_msgs/LookupTransformActionResult.h"
 #include "tiny_ros/tf2_msgs/LookupTransformActionFeedback.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace tf2_msgs
 {
 
+  class LookupTransformActionView;
+
   class LookupTransformAction : public tinyros::Msg
   {
     public:
@@ -60,25 +64,71 @@ namespace tf2_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("action_goal");
+      writer.value(this->action_goal);
+      writer.raw(',');
+      writer.key("action_result");
+      writer.value(this->action_result);
+      writer.raw(',');
+      writer.key("action_feedback");
+      writer.value(this->action_feedback);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"action_goal\":";
-      string_echo += this->action_goal.echo();
-      string_echo += ",";
-      string_echo += "\"action_result\":";
-      string_echo += this->action_result.echo();
-      string_echo += ",";
-      string_echo += "\"action_feedback\":";
-      string_echo += this->action_feedback.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tf2_msgs/LookupTransformAction"; }
     virtual std::string getMD5(){ return "49655e848adf6c64870a8eb763b94484"; }
+    typedef LookupTransformActionView View;
+
+  };
+
+  /* LookupTransformAction read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LookupTransformActionView
+  {
+    public:
+    typedef LookupTransformAction MsgType;
+
+    LookupTransformActionView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::tf2_msgs::LookupTransformActionGoalView action_goal() const { return tinyros::tf2_msgs::LookupTransformActionGoalView(buffer_ + 0); }
+    tinyros::tf2_msgs::LookupTransformActionResultView action_result() const { return tinyros::tf2_msgs::LookupTransformActionResultView(buffer_ + fieldOffset(1)); }
+    tinyros::tf2_msgs::LookupTransformActionFeedbackView action_feedback() const { return tinyros::tf2_msgs::LookupTransformActionFeedbackView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::tf2_msgs::LookupTransformActionGoalView(p).serializedLength(); break;
+          case 1: length = tinyros::tf2_msgs::LookupTransformActionResultView(p).serializedLength(); break;
+          case 2: length = tinyros::tf2_msgs::LookupTransformActionFeedbackView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/actionlib_msgs/GoalStatus.h"
 #include "tiny_ros/tf2_msgs/LookupTransformFeedback.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace tf2_msgs
 {
 
+  class LookupTransformActionFeedbackView;
+
   class LookupTransformActionFeedback : public tinyros::Msg
   {
     public:
@@ -60,25 +64,71 @@ namespace tf2_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.key("status");
+      writer.value(this->status);
+      writer.raw(',');
+      writer.key("feedback");
+      writer.value(this->feedback);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "\"status\":";
-      string_echo += this->status.echo();
-      string_echo += ",";
-      string_echo += "\"feedback\":";
-      string_echo += this->feedback.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tf2_msgs/LookupTransformActionFeedback"; }
     virtual std::string getMD5(){ return "f432c3fa33a3ac9586ace248b606de3a"; }
+    typedef LookupTransformActionFeedbackView View;
+
+  };
+
+  /* LookupTransformActionFeedback read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LookupTransformActionFeedbackView
+  {
+    public:
+    typedef LookupTransformActionFeedback MsgType;
+
+    LookupTransformActionFeedbackView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::actionlib_msgs::GoalStatusView status() const { return tinyros::actionlib_msgs::GoalStatusView(buffer_ + fieldOffset(1)); }
+    tinyros::tf2_msgs::LookupTransformFeedbackView feedback() const { return tinyros::tf2_msgs::LookupTransformFeedbackView(buffer_ + fieldOffset(2)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = tinyros::actionlib_msgs::GoalStatusView(p).serializedLength(); break;
+          case 2: length = tinyros::tf2_msgs::LookupTransformFeedbackView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 #include "tiny_ros/ros/duration.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace tf2_msgs
 {
 
+  class LookupTransformGoalView;
+
   class LookupTransformGoal : public tinyros::Msg
   {
     public:
@@ -195,54 +199,91 @@ namespace tf2_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("target_frame");
+      writer.value(this->target_frame);
+      writer.raw(',');
+      writer.key("source_frame");
+      writer.value(this->source_frame);
+      writer.raw(',');
+      writer.key("source_time");
+      writer.value(this->source_time);
+      writer.raw(',');
+      writer.key("timeout");
+      writer.value(this->timeout);
+      writer.raw(',');
+      writer.key("target_time");
+      writer.value(this->target_time);
+      writer.raw(',');
+      writer.key("fixed_frame");
+      writer.value(this->fixed_frame);
+      writer.raw(',');
+      writer.key("advanced");
+      writer.value(this->advanced);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t target_frame_pos = target_frame.find("\"");
-      while(target_frame_pos != std::string::npos){
-        target_frame.replace(target_frame_pos, 1,"\\\"");
-        target_frame_pos = target_frame.find("\"", target_frame_pos+2);
-      }
-      string_echo += "\"target_frame\":\"";
-      string_echo += target_frame;
-      string_echo += "\",";
-      std::size_t source_frame_pos = source_frame.find("\"");
-      while(source_frame_pos != std::string::npos){
-        source_frame.replace(source_frame_pos, 1,"\\\"");
-        source_frame_pos = source_frame.find("\"", source_frame_pos+2);
-      }
-      string_echo += "\"source_frame\":\"";
-      string_echo += source_frame;
-      string_echo += "\",";
-      std::stringstream ss_source_time;
-      ss_source_time << "\"source_time\":{\"sec\":" << source_time.sec;
-      ss_source_time << ",\"nsec\":" << source_time.nsec << "},";
-      string_echo += ss_source_time.str();
-      std::stringstream ss_timeout;
-      ss_timeout << "\"timeout\":{\"sec\":" << timeout.sec;
-      ss_timeout << ",\"nsec\":" << timeout.nsec << "},";
-      string_echo += ss_timeout.str();
-      std::stringstream ss_target_time;
-      ss_target_time << "\"target_time\":{\"sec\":" << target_time.sec;
-      ss_target_time << ",\"nsec\":" << target_time.nsec << "},";
-      string_echo += ss_target_time.str();
-      std::size_t fixed_frame_pos = fixed_frame.find("\"");
-      while(fixed_frame_pos != std::string::npos){
-        fixed_frame.replace(fixed_frame_pos, 1,"\\\"");
-        fixed_frame_pos = fixed_frame.find("\"", fixed_frame_pos+2);
-      }
-      string_echo += "\"fixed_frame\":\"";
-      string_echo += fixed_frame;
-      string_echo += "\",";
-      std::stringstream ss_advanced; ss_advanced << "\"advanced\":" << advanced <<"";
-      string_echo += ss_advanced.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tf2_msgs/LookupTransformGoal"; }
     virtual std::string getMD5(){ return "677c84a912b788ccaaea5fbc38570182"; }
+    typedef LookupTransformGoalView View;
+
+  };
+
+  /* LookupTransformGoal read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LookupTransformGoalView
+  {
+    public:
+    typedef LookupTransformGoal MsgType;
+
+    LookupTransformGoalView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(7); }
+
+    tinyros::StringView target_frame() const { return tinyros::StringView(buffer_ + 0); }
+    tinyros::StringView source_frame() const { return tinyros::StringView(buffer_ + fieldOffset(1)); }
+    tinyros::Time source_time() const { return tinyros::viewRead<tinyros::Time>(buffer_ + fieldOffset(2)); }
+    tinyros::Duration timeout() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(3)); }
+    tinyros::Time target_time() const { return tinyros::viewRead<tinyros::Time>(buffer_ + fieldOffset(4)); }
+    tinyros::StringView fixed_frame() const { return tinyros::StringView(buffer_ + fieldOffset(5)); }
+    bool advanced() const { return tinyros::viewRead<bool>(buffer_ + fieldOffset(6)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = 8; break;
+          case 3: length = 8; break;
+          case 4: length = 8; break;
+          case 5: length = tinyros::StringView(p).serializedLength(); break;
+          case 6: length = 1; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[8];
+    mutable uint32_t known_;
   };
 
 }
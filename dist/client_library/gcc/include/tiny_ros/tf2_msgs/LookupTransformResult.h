@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/TransformStamped.h"
 #include "tiny_ros/tf2_msgs/TF2Error.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace tf2_msgs
 {
 
+  class LookupTransformResultView;
+
   class LookupTransformResult : public tinyros::Msg
   {
     public:
@@ -53,22 +57,66 @@ namespace tf2_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("transform");
+      writer.value(this->transform);
+      writer.raw(',');
+      writer.key("error");
+      writer.value(this->error);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"transform\":";
-      string_echo += this->transform.echo();
-      string_echo += ",";
-      string_echo += "\"error\":";
-      string_echo += this->error.echo();
-      string_echo += "";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tf2_msgs/LookupTransformResult"; }
     virtual std::string getMD5(){ return "7be4fc6719f512bc94491db1ccda6aee"; }
+    typedef LookupTransformResultView View;
+
+  };
+
+  /* LookupTransformResult read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LookupTransformResultView
+  {
+    public:
+    typedef LookupTransformResult MsgType;
+
+    LookupTransformResultView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    tinyros::geometry_msgs::TransformStampedView transform() const { return tinyros::geometry_msgs::TransformStampedView(buffer_ + 0); }
+    tinyros::tf2_msgs::TF2ErrorView error() const { return tinyros::tf2_msgs::TF2ErrorView(buffer_ + fieldOffset(1)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::geometry_msgs::TransformStampedView(p).serializedLength(); break;
+          case 1: length = tinyros::tf2_msgs::TF2ErrorView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
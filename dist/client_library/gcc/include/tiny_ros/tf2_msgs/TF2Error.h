@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace tf2_msgs
 {
 
+  class TF2ErrorView;
+
   class TF2Error : public tinyros::Msg
   {
     public:
@@ -74,26 +78,65 @@ namespace tf2_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("error");
+      writer.value(this->error);
+      writer.raw(',');
+      writer.key("error_string");
+      writer.value(this->error_string);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_error; ss_error << "\"error\":" << (uint16_t)error <<",";
-      string_echo += ss_error.str();
-      std::size_t error_string_pos = error_string.find("\"");
-      while(error_string_pos != std::string::npos){
-        error_string.replace(error_string_pos, 1,"\\\"");
-        error_string_pos = error_string.find("\"", error_string_pos+2);
-      }
-      string_echo += "\"error_string\":\"";
-      string_echo += error_string;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tf2_msgs/TF2Error"; }
     virtual std::string getMD5(){ return "ed32adf5a372962d977aea0e5630d1d6"; }
+    typedef TF2ErrorView View;
+
+  };
+
+  /* TF2Error read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TF2ErrorView
+  {
+    public:
+    typedef TF2Error MsgType;
+
+    TF2ErrorView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(1)
+    {
+      offsets_[1] = 1;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    uint8_t error() const { return tinyros::viewRead<uint8_t>(buffer_ + 0); }
+    tinyros::StringView error_string() const { return tinyros::StringView(buffer_ + 1); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
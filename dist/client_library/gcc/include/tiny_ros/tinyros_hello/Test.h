@@ -6,6 +6,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
@@ -75,19 +77,19 @@ static const char TEST[] = "tinyros_hello/Test";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("input");
+      writer.value(this->input);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t input_pos = input.find("\"");
-      while(input_pos != std::string::npos){
-        input.replace(input_pos, 1,"\\\"");
-        input_pos = input.find("\"", input_pos+2);
-      }
-      string_echo += "\"input\":\"";
-      string_echo += input;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return TEST; }
@@ -158,19 +160,19 @@ static const char TEST[] = "tinyros_hello/Test";
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("output");
+      writer.value(this->output);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t output_pos = output.find("\"");
-      while(output_pos != std::string::npos){
-        output.replace(output_pos, 1,"\\\"");
-        output_pos = output.find("\"", output_pos+2);
-      }
-      string_echo += "\"output\":\"";
-      string_echo += output;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return TEST; }
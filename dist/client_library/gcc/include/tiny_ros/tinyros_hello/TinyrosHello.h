@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace tinyros_hello
 {
 
+  class TinyrosHelloView;
+
   class TinyrosHello : public tinyros::Msg
   {
     public:
@@ -59,24 +63,61 @@ namespace tinyros_hello
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("hello");
+      writer.value(this->hello);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::size_t hello_pos = hello.find("\"");
-      while(hello_pos != std::string::npos){
-        hello.replace(hello_pos, 1,"\\\"");
-        hello_pos = hello.find("\"", hello_pos+2);
-      }
-      string_echo += "\"hello\":\"";
-      string_echo += hello;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tinyros_hello/TinyrosHello"; }
     virtual std::string getMD5(){ return "0c68e66a217802ad0c9f648b7a69d090"; }
+    typedef TinyrosHelloView View;
+
+  };
+
+  /* TinyrosHello read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TinyrosHelloView
+  {
+    public:
+    typedef TinyrosHello MsgType;
+
+    TinyrosHelloView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(1); }
+
+    tinyros::StringView hello() const { return tinyros::StringView(buffer_ + 0); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[2];
+    mutable uint32_t known_;
   };
 
 }
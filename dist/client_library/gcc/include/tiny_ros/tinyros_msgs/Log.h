@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace tinyros_msgs
 {
 
+  class LogView;
+
   class Log : public tinyros::Msg
   {
     public:
@@ -72,26 +76,65 @@ namespace tinyros_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("level");
+      writer.value(this->level);
+      writer.raw(',');
+      writer.key("msg");
+      writer.value(this->msg);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_level; ss_level << "\"level\":" << (uint16_t)level <<",";
-      string_echo += ss_level.str();
-      std::size_t msg_pos = msg.find("\"");
-      while(msg_pos != std::string::npos){
-        msg.replace(msg_pos, 1,"\\\"");
-        msg_pos = msg.find("\"", msg_pos+2);
-      }
-      string_echo += "\"msg\":\"";
-      string_echo += msg;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tinyros_msgs/Log"; }
     virtual std::string getMD5(){ return "0bd74339b4d77cb15766d831a3d15eeb"; }
+    typedef LogView View;
+
+  };
+
+  /* Log read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class LogView
+  {
+    public:
+    typedef Log MsgType;
+
+    LogView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(1)
+    {
+      offsets_[1] = 1;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(2); }
+
+    uint8_t level() const { return tinyros::viewRead<uint8_t>(buffer_ + 0); }
+    tinyros::StringView msg() const { return tinyros::StringView(buffer_ + 1); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[3];
+    mutable uint32_t known_;
   };
 
 }
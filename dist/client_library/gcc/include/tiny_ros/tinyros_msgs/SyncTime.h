@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/ros/time.h"
 
 namespace tinyros
@@ -14,6 +16,8 @@ namespace tinyros
 namespace tinyros_msgs
 {
 
+  class SyncTimeView;
+
   class SyncTime : public tinyros::Msg
   {
     public:
@@ -21,80 +25,95 @@ namespace tinyros_msgs
       _tick_type tick;
       typedef tinyros::Time _data_type;
       _data_type data;
+      typedef tinyros::Time _request_type;
+      _request_type request;
+      typedef tinyros::Time _receive_type;
+      _receive_type receive;
+
+      static constexpr uint32_t kSerializedSize = 28;
 
     SyncTime():
       tick(0),
-      data()
+      data(),
+      request(),
+      receive()
     {
     }
 
     virtual int serialize(unsigned char *outbuffer) const
     {
-      int offset = 0;
-      *(outbuffer + offset + 0) = (this->tick >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->tick >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->tick >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->tick >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->tick);
-      *(outbuffer + offset + 0) = (this->data.sec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->data.sec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->data.sec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->data.sec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->data.sec);
-      *(outbuffer + offset + 0) = (this->data.nsec >> (8 * 0)) & 0xFF;
-      *(outbuffer + offset + 1) = (this->data.nsec >> (8 * 1)) & 0xFF;
-      *(outbuffer + offset + 2) = (this->data.nsec >> (8 * 2)) & 0xFF;
-      *(outbuffer + offset + 3) = (this->data.nsec >> (8 * 3)) & 0xFF;
-      offset += sizeof(this->data.nsec);
-      return offset;
+      arrayToArr(outbuffer + 0, &this->tick, 1);
+      arrayToArr(outbuffer + 4, &this->data.sec, 1);
+      arrayToArr(outbuffer + 4 + 4, &this->data.nsec, 1);
+      arrayToArr(outbuffer + 12, &this->request.sec, 1);
+      arrayToArr(outbuffer + 12 + 4, &this->request.nsec, 1);
+      arrayToArr(outbuffer + 20, &this->receive.sec, 1);
+      arrayToArr(outbuffer + 20 + 4, &this->receive.nsec, 1);
+      return kSerializedSize;
     }
 
     virtual int deserialize(unsigned char *inbuffer)
     {
-      int offset = 0;
-      this->tick =  ((uint32_t) (*(inbuffer + offset)));
-      this->tick |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->tick |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->tick |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->tick);
-      this->data.sec =  ((uint32_t) (*(inbuffer + offset)));
-      this->data.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->data.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->data.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->data.sec);
-      this->data.nsec =  ((uint32_t) (*(inbuffer + offset)));
-      this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
-      this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
-      this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
-      offset += sizeof(this->data.nsec);
-      return offset;
+      arrToArray(&this->tick, inbuffer + 0, 1);
+      arrToArray(&this->data.sec, inbuffer + 4, 1);
+      arrToArray(&this->data.nsec, inbuffer + 4 + 4, 1);
+      arrToArray(&this->request.sec, inbuffer + 12, 1);
+      arrToArray(&this->request.nsec, inbuffer + 12 + 4, 1);
+      arrToArray(&this->receive.sec, inbuffer + 20, 1);
+      arrToArray(&this->receive.nsec, inbuffer + 20 + 4, 1);
+      return kSerializedSize;
     }
 
-    virtual int serializedLength() const
+    virtual int serializedLength() const { return kSerializedSize; }
+
+    virtual void echo(tinyros::Writer& writer) const
     {
-      int length = 0;
-      length += sizeof(this->tick);
-      length += sizeof(this->data.sec);
-      length += sizeof(this->data.nsec);
-      return length;
+      writer.raw('{');
+      writer.key("tick");
+      writer.value(this->tick);
+      writer.raw(',');
+      writer.key("data");
+      writer.value(this->data);
+      writer.raw(',');
+      writer.key("request");
+      writer.value(this->request);
+      writer.raw(',');
+      writer.key("receive");
+      writer.value(this->receive);
+      writer.raw('}');
     }
 
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_tick; ss_tick << "\"tick\":" << tick <<",";
-      string_echo += ss_tick.str();
-      std::stringstream ss_data;
-      ss_data << "\"data\":{\"sec\":" << data.sec;
-      ss_data << ",\"nsec\":" << data.nsec << "}";
-      string_echo += ss_data.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tinyros_msgs/SyncTime"; }
-    virtual std::string getMD5(){ return "45bf702585c65b1bb762993bdbb1de6f"; }
+    virtual std::string getMD5(){ return "849829d40822c909f761d27e58c6bec5"; }
+    typedef SyncTimeView View;
+
+  };
+
+  /* SyncTime read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class SyncTimeView
+  {
+    public:
+    typedef SyncTime MsgType;
+
+    SyncTimeView(const unsigned char* buffer = NULL) : buffer_(buffer) {}
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return 28; }
+
+    uint32_t tick() const { return tinyros::viewRead<uint32_t>(buffer_ + 0); }
+    tinyros::Time data() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 4); }
+    tinyros::Time request() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 12); }
+    tinyros::Time receive() const { return tinyros::viewRead<tinyros::Time>(buffer_ + 20); }
 
+    private:
+    const unsigned char* buffer_;
   };
 
 }
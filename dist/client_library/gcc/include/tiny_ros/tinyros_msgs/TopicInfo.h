@@ -7,12 +7,16 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 
 namespace tinyros
 {
 namespace tinyros_msgs
 {
 
+  class TopicInfoView;
+
   class TopicInfo : public tinyros::Msg
   {
     public:
@@ -40,6 +44,10 @@ namespace tinyros_msgs
       enum { ID_TIME = 9 };
       enum { ID_NEGOTIATED = 10 };
       enum { ID_SESSION_ID = 11 };
+      enum { ID_UNREGISTER = 12 };
+      enum { ID_RECORD = 13 };
+      enum { ID_LOG_LEVEL = 14 };
+      enum { ID_LOG_SESSION_ID = 15 };
 
     TopicInfo():
       topic_id(0),
@@ -187,54 +195,90 @@ namespace tinyros_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("topic_id");
+      writer.value(this->topic_id);
+      writer.raw(',');
+      writer.key("topic_name");
+      writer.value(this->topic_name);
+      writer.raw(',');
+      writer.key("message_type");
+      writer.value(this->message_type);
+      writer.raw(',');
+      writer.key("md5sum");
+      writer.value(this->md5sum);
+      writer.raw(',');
+      writer.key("buffer_size");
+      writer.value(this->buffer_size);
+      writer.raw(',');
+      writer.key("negotiated");
+      writer.value(this->negotiated);
+      writer.raw(',');
+      writer.key("node");
+      writer.value(this->node);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      std::stringstream ss_topic_id; ss_topic_id << "\"topic_id\":" << topic_id <<",";
-      string_echo += ss_topic_id.str();
-      std::size_t topic_name_pos = topic_name.find("\"");
-      while(topic_name_pos != std::string::npos){
-        topic_name.replace(topic_name_pos, 1,"\\\"");
-        topic_name_pos = topic_name.find("\"", topic_name_pos+2);
-      }
-      string_echo += "\"topic_name\":\"";
-      string_echo += topic_name;
-      string_echo += "\",";
-      std::size_t message_type_pos = message_type.find("\"");
-      while(message_type_pos != std::string::npos){
-        message_type.replace(message_type_pos, 1,"\\\"");
-        message_type_pos = message_type.find("\"", message_type_pos+2);
-      }
-      string_echo += "\"message_type\":\"";
-      string_echo += message_type;
-      string_echo += "\",";
-      std::size_t md5sum_pos = md5sum.find("\"");
-      while(md5sum_pos != std::string::npos){
-        md5sum.replace(md5sum_pos, 1,"\\\"");
-        md5sum_pos = md5sum.find("\"", md5sum_pos+2);
-      }
-      string_echo += "\"md5sum\":\"";
-      string_echo += md5sum;
-      string_echo += "\",";
-      std::stringstream ss_buffer_size; ss_buffer_size << "\"buffer_size\":" << buffer_size <<",";
-      string_echo += ss_buffer_size.str();
-      std::stringstream ss_negotiated; ss_negotiated << "\"negotiated\":" << negotiated <<",";
-      string_echo += ss_negotiated.str();
-      std::size_t node_pos = node.find("\"");
-      while(node_pos != std::string::npos){
-        node.replace(node_pos, 1,"\\\"");
-        node_pos = node.find("\"", node_pos+2);
-      }
-      string_echo += "\"node\":\"";
-      string_echo += node;
-      string_echo += "\"";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "tinyros_msgs/TopicInfo"; }
-    virtual std::string getMD5(){ return "76d40676946fcde66f228def7575451a"; }
+    virtual std::string getMD5(){ return "82d849772aaa15cd9875bf868f0a1720"; }
+    typedef TopicInfoView View;
+
+  };
+
+  /* TopicInfo read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class TopicInfoView
+  {
+    public:
+    typedef TopicInfo MsgType;
+
+    TopicInfoView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(1)
+    {
+      offsets_[1] = 4;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(7); }
+
+    uint32_t topic_id() const { return tinyros::viewRead<uint32_t>(buffer_ + 0); }
+    tinyros::StringView topic_name() const { return tinyros::StringView(buffer_ + 4); }
+    tinyros::StringView message_type() const { return tinyros::StringView(buffer_ + fieldOffset(2)); }
+    tinyros::StringView md5sum() const { return tinyros::StringView(buffer_ + fieldOffset(3)); }
+    int32_t buffer_size() const { return tinyros::viewRead<int32_t>(buffer_ + fieldOffset(4)); }
+    bool negotiated() const { return tinyros::viewRead<bool>(buffer_ + fieldOffset(5)); }
+    tinyros::StringView node() const { return tinyros::StringView(buffer_ + fieldOffset(6)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 1: length = tinyros::StringView(p).serializedLength(); break;
+          case 2: length = tinyros::StringView(p).serializedLength(); break;
+          case 3: length = tinyros::StringView(p).serializedLength(); break;
+          case 4: length = 4; break;
+          case 5: length = 1; break;
+          case 6: length = tinyros::StringView(p).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[8];
+    mutable uint32_t known_;
   };
 
 }
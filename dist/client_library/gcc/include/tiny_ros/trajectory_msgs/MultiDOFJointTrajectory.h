@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/std_msgs/Header.h"
 #include "tiny_ros/trajectory_msgs/MultiDOFJointTrajectoryPoint.h"
 
@@ -15,6 +17,8 @@ namespace tinyros
 namespace trajectory_msgs
 {
 
+  class MultiDOFJointTrajectoryView;
+
   class MultiDOFJointTrajectory : public tinyros::Msg
   {
     public:
@@ -119,55 +123,77 @@ namespace trajectory_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.key("header");
+      writer.value(this->header);
+      writer.raw(',');
+      writer.array("joint_names", this->joint_names, this->joint_names_length);
+      writer.raw(',');
+      writer.array("points", this->points, this->points_length);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "\"header\":";
-      string_echo += this->header.echo();
-      string_echo += ",";
-      string_echo += "joint_names:[";
-      for( uint32_t i = 0; i < joint_names_length; i++) {
-        if( i == (joint_names_length - 1)) {
-          std::stringstream ss_joint_namesi; ss_joint_namesi << "\"";
-          string_echo += ss_joint_namesi.str();
-          std::size_t joint_namesi_pos = joint_names[i].find("\"");
-          while(joint_namesi_pos != std::string::npos){
-            joint_names[i].replace(joint_namesi_pos, 1,"\\\"");
-            joint_namesi_pos = joint_names[i].find("\"", joint_namesi_pos+2);
-          }
-          string_echo += joint_names[i];
-          string_echo += "\"";
-        } else {
-          std::stringstream ss_joint_namesi; ss_joint_namesi << "\"";
-          string_echo += ss_joint_namesi.str();
-          std::size_t joint_namesi_pos = joint_names[i].find("\"");
-          while(joint_namesi_pos != std::string::npos){
-            joint_names[i].replace(joint_namesi_pos, 1,"\\\"");
-            joint_namesi_pos = joint_names[i].find("\"", joint_namesi_pos+2);
-          }
-          string_echo += joint_names[i];
-          string_echo += "\",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "points:[";
-      for( uint32_t i = 0; i < points_length; i++) {
-        if( i == (points_length - 1)) {
-          string_echo += this->points[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->points[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "]";
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "trajectory_msgs/MultiDOFJointTrajectory"; }
     virtual std::string getMD5(){ return "19f97d4cdcae9d0ef55126c1495f6c91"; }
+    typedef MultiDOFJointTrajectoryView View;
+
+  };
+
+  /* MultiDOFJointTrajectory read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MultiDOFJointTrajectoryView
+  {
+    public:
+    typedef MultiDOFJointTrajectory MsgType;
+
+    MultiDOFJointTrajectoryView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(3); }
+
+    tinyros::std_msgs::HeaderView header() const { return tinyros::std_msgs::HeaderView(buffer_ + 0); }
+    tinyros::ViewList<tinyros::StringView> joint_names() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::ViewList<tinyros::trajectory_msgs::MultiDOFJointTrajectoryPointView> points() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::ViewList<tinyros::trajectory_msgs::MultiDOFJointTrajectoryPointView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = tinyros::std_msgs::HeaderView(p).serializedLength(); break;
+          case 1: length = 4 + tinyros::ViewList<tinyros::StringView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+          case 2: length = 4 + tinyros::ViewList<tinyros::trajectory_msgs::MultiDOFJointTrajectoryPointView>(p + 4, tinyros::viewRead<uint32_t>(p)).serializedLength(); break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[4];
+    mutable uint32_t known_;
   };
 
 }
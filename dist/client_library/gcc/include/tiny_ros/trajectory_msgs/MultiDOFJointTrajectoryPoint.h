@@ -7,6 +7,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include "tiny_ros/ros/msg.h"
+#include "tiny_ros/ros/msg_view.h"
+#include "tiny_ros/ros/writer.h"
 #include "tiny_ros/geometry_msgs/Transform.h"
 #include "tiny_ros/geometry_msgs/Twist.h"
 #include "tiny_ros/ros/duration.h"
@@ -16,6 +18,8 @@ namespace tinyros
 namespace trajectory_msgs
 {
 
+  class MultiDOFJointTrajectoryPointView;
+
   class MultiDOFJointTrajectoryPoint : public tinyros::Msg
   {
     public:
@@ -154,53 +158,85 @@ namespace trajectory_msgs
       return length;
     }
 
+    virtual void echo(tinyros::Writer& writer) const
+    {
+      writer.raw('{');
+      writer.array("transforms", this->transforms, this->transforms_length);
+      writer.raw(',');
+      writer.array("velocities", this->velocities, this->velocities_length);
+      writer.raw(',');
+      writer.array("accelerations", this->accelerations, this->accelerations_length);
+      writer.raw(',');
+      writer.key("time_from_start");
+      writer.value(this->time_from_start);
+      writer.raw('}');
+    }
+
     virtual std::string echo()
     {
-      std::string string_echo = "{";
-      string_echo += "transforms:[";
-      for( uint32_t i = 0; i < transforms_length; i++) {
-        if( i == (transforms_length - 1)) {
-          string_echo += this->transforms[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->transforms[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "velocities:[";
-      for( uint32_t i = 0; i < velocities_length; i++) {
-        if( i == (velocities_length - 1)) {
-          string_echo += this->velocities[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->velocities[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      string_echo += "accelerations:[";
-      for( uint32_t i = 0; i < accelerations_length; i++) {
-        if( i == (accelerations_length - 1)) {
-          string_echo += this->accelerations[i].echo();
-          string_echo += "";
-        } else {
-          string_echo += this->accelerations[i].echo();
-          string_echo += ",";
-        }
-      }
-      string_echo += "],";
-      std::stringstream ss_time_from_start;
-      ss_time_from_start << "\"time_from_start\":{\"sec\":" << time_from_start.sec;
-      ss_time_from_start << ",\"nsec\":" << time_from_start.nsec << "}";
-      string_echo += ss_time_from_start.str();
-      string_echo += "}";
-      return string_echo;
+      tinyros::Writer writer;
+      echo(writer);
+      return writer.str();
     }
 
     virtual std::string getType(){ return "trajectory_msgs/MultiDOFJointTrajectoryPoint"; }
     virtual std::string getMD5(){ return "f8b4a74b416279b5c5d565029308ff08"; }
+    typedef MultiDOFJointTrajectoryPointView View;
+
+  };
+
+  /* MultiDOFJointTrajectoryPoint read in place from a received buffer, see tiny_ros/ros/msg_view.h */
+  class MultiDOFJointTrajectoryPointView
+  {
+    public:
+    typedef MultiDOFJointTrajectoryPoint MsgType;
+
+    MultiDOFJointTrajectoryPointView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(0)
+    {
+      offsets_[0] = 0;
+    }
+
+    const unsigned char* buffer() const { return buffer_; }
+    uint32_t serializedLength() const { return fieldOffset(4); }
+
+    tinyros::Span<tinyros::geometry_msgs::TransformView> transforms() const
+    {
+      const unsigned char* p = buffer_ + 0;
+      return tinyros::Span<tinyros::geometry_msgs::TransformView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<tinyros::geometry_msgs::TwistView> velocities() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(1);
+      return tinyros::Span<tinyros::geometry_msgs::TwistView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Span<tinyros::geometry_msgs::TwistView> accelerations() const
+    {
+      const unsigned char* p = buffer_ + fieldOffset(2);
+      return tinyros::Span<tinyros::geometry_msgs::TwistView>(p + 4, tinyros::viewRead<uint32_t>(p));
+    }
+    tinyros::Duration time_from_start() const { return tinyros::viewRead<tinyros::Duration>(buffer_ + fieldOffset(3)); }
+
+    private:
+    uint32_t fieldOffset(uint32_t field) const
+    {
+      while (known_ < field) {
+        const unsigned char* p = buffer_ + offsets_[known_];
+        uint32_t length = 0;
+        switch (known_) {
+          case 0: length = 4 + tinyros::viewRead<uint32_t>(p) * 56; break;
+          case 1: length = 4 + tinyros::viewRead<uint32_t>(p) * 48; break;
+          case 2: length = 4 + tinyros::viewRead<uint32_t>(p) * 48; break;
+          case 3: length = 8; break;
+        }
+        offsets_[known_ + 1] = offsets_[known_] + length;
+        known_++;
+      }
+      return offsets_[field];
+    }
 
+    const unsigned char* buffer_;
+    mutable uint32_t offsets_[5];
+    mutable uint32_t known_;
   };
 
 }
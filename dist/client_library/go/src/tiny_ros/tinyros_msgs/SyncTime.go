@@ -9,18 +9,24 @@ import (
 type SyncTime struct {
     Go_tick uint32 `json:"tick"`
     Go_data *rostime.Time `json:"data"`
+    Go_request *rostime.Time `json:"request"`
+    Go_receive *rostime.Time `json:"receive"`
 }
 
 func NewSyncTime() (*SyncTime) {
     newSyncTime := new(SyncTime)
     newSyncTime.Go_tick = 0
     newSyncTime.Go_data = rostime.NewTime()
+    newSyncTime.Go_request = rostime.NewTime()
+    newSyncTime.Go_receive = rostime.NewTime()
     return newSyncTime
 }
 
 func (self *SyncTime) Go_initialize() {
     self.Go_tick = 0
     self.Go_data = rostime.NewTime()
+    self.Go_request = rostime.NewTime()
+    self.Go_receive = rostime.NewTime()
 }
 
 func (self *SyncTime) Go_serialize(buff []byte) (int) {
@@ -40,6 +46,26 @@ func (self *SyncTime) Go_serialize(buff []byte) (int) {
     buff[offset + 2] = byte((self.Go_data.Go_nsec >> (8 * 2)) & 0xFF)
     buff[offset + 3] = byte((self.Go_data.Go_nsec >> (8 * 3)) & 0xFF)
     offset += 4
+    buff[offset + 0] = byte((self.Go_request.Go_sec >> (8 * 0)) & 0xFF)
+    buff[offset + 1] = byte((self.Go_request.Go_sec >> (8 * 1)) & 0xFF)
+    buff[offset + 2] = byte((self.Go_request.Go_sec >> (8 * 2)) & 0xFF)
+    buff[offset + 3] = byte((self.Go_request.Go_sec >> (8 * 3)) & 0xFF)
+    offset += 4
+    buff[offset + 0] = byte((self.Go_request.Go_nsec >> (8 * 0)) & 0xFF)
+    buff[offset + 1] = byte((self.Go_request.Go_nsec >> (8 * 1)) & 0xFF)
+    buff[offset + 2] = byte((self.Go_request.Go_nsec >> (8 * 2)) & 0xFF)
+    buff[offset + 3] = byte((self.Go_request.Go_nsec >> (8 * 3)) & 0xFF)
+    offset += 4
+    buff[offset + 0] = byte((self.Go_receive.Go_sec >> (8 * 0)) & 0xFF)
+    buff[offset + 1] = byte((self.Go_receive.Go_sec >> (8 * 1)) & 0xFF)
+    buff[offset + 2] = byte((self.Go_receive.Go_sec >> (8 * 2)) & 0xFF)
+    buff[offset + 3] = byte((self.Go_receive.Go_sec >> (8 * 3)) & 0xFF)
+    offset += 4
+    buff[offset + 0] = byte((self.Go_receive.Go_nsec >> (8 * 0)) & 0xFF)
+    buff[offset + 1] = byte((self.Go_receive.Go_nsec >> (8 * 1)) & 0xFF)
+    buff[offset + 2] = byte((self.Go_receive.Go_nsec >> (8 * 2)) & 0xFF)
+    buff[offset + 3] = byte((self.Go_receive.Go_nsec >> (8 * 3)) & 0xFF)
+    offset += 4
     return offset
 }
 
@@ -60,6 +86,26 @@ func (self *SyncTime) Go_deserialize(buff []byte) (int) {
     self.Go_data.Go_nsec |= uint32(buff[offset + 2] & 0xFF) << (8 * 2)
     self.Go_data.Go_nsec |= uint32(buff[offset + 3] & 0xFF) << (8 * 3)
     offset += 4
+    self.Go_request.Go_sec = uint32(buff[offset + 0] & 0xFF) << (8 * 0)
+    self.Go_request.Go_sec |= uint32(buff[offset + 1] & 0xFF) << (8 * 1)
+    self.Go_request.Go_sec |= uint32(buff[offset + 2] & 0xFF) << (8 * 2)
+    self.Go_request.Go_sec |= uint32(buff[offset + 3] & 0xFF) << (8 * 3)
+    offset += 4
+    self.Go_request.Go_nsec = uint32(buff[offset + 0] & 0xFF) << (8 * 0)
+    self.Go_request.Go_nsec |= uint32(buff[offset + 1] & 0xFF) << (8 * 1)
+    self.Go_request.Go_nsec |= uint32(buff[offset + 2] & 0xFF) << (8 * 2)
+    self.Go_request.Go_nsec |= uint32(buff[offset + 3] & 0xFF) << (8 * 3)
+    offset += 4
+    self.Go_receive.Go_sec = uint32(buff[offset + 0] & 0xFF) << (8 * 0)
+    self.Go_receive.Go_sec |= uint32(buff[offset + 1] & 0xFF) << (8 * 1)
+    self.Go_receive.Go_sec |= uint32(buff[offset + 2] & 0xFF) << (8 * 2)
+    self.Go_receive.Go_sec |= uint32(buff[offset + 3] & 0xFF) << (8 * 3)
+    offset += 4
+    self.Go_receive.Go_nsec = uint32(buff[offset + 0] & 0xFF) << (8 * 0)
+    self.Go_receive.Go_nsec |= uint32(buff[offset + 1] & 0xFF) << (8 * 1)
+    self.Go_receive.Go_nsec |= uint32(buff[offset + 2] & 0xFF) << (8 * 2)
+    self.Go_receive.Go_nsec |= uint32(buff[offset + 3] & 0xFF) << (8 * 3)
+    offset += 4
     return offset
 }
 
@@ -68,6 +114,10 @@ func (self *SyncTime) Go_serializedLength() (int) {
     length += 4
     length += 4
     length += 4
+    length += 4
+    length += 4
+    length += 4
+    length += 4
     return length
 }
 
@@ -77,7 +127,7 @@ func (self *SyncTime) Go_echo() (string) {
 }
 
 func (self *SyncTime) Go_getType() (string) { return "tinyros_msgs/SyncTime" }
-func (self *SyncTime) Go_getMD5() (string) { return "45bf702585c65b1bb762993bdbb1de6f" }
+func (self *SyncTime) Go_getMD5() (string) { return "849829d40822c909f761d27e58c6bec5" }
 func (self *SyncTime) Go_getID() (uint32) { return 0 }
 func (self *SyncTime) Go_setID(id uint32) { }
 
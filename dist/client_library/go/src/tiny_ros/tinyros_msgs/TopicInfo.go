@@ -14,6 +14,10 @@ func Go_ID_LOG() (uint32) { return 8 }
 func Go_ID_TIME() (uint32) { return 9 }
 func Go_ID_NEGOTIATED() (uint32) { return 10 }
 func Go_ID_SESSION_ID() (uint32) { return 11 }
+func Go_ID_UNREGISTER() (uint32) { return 12 }
+func Go_ID_RECORD() (uint32) { return 13 }
+func Go_ID_LOG_LEVEL() (uint32) { return 14 }
+func Go_ID_LOG_SESSION_ID() (uint32) { return 15 }
 
 type TopicInfo struct {
     Go_topic_id uint32 `json:"topic_id"`
@@ -175,7 +179,7 @@ func (self *TopicInfo) Go_echo() (string) {
 }
 
 func (self *TopicInfo) Go_getType() (string) { return "tinyros_msgs/TopicInfo" }
-func (self *TopicInfo) Go_getMD5() (string) { return "76d40676946fcde66f228def7575451a" }
+func (self *TopicInfo) Go_getMD5() (string) { return "82d849772aaa15cd9875bf868f0a1720" }
 func (self *TopicInfo) Go_getID() (uint32) { return 0 }
 func (self *TopicInfo) Go_setID(id uint32) { }
 
@@ -5,10 +5,14 @@ import java.lang.*;
 public class SyncTime implements com.roslib.ros.Msg {
     public long tick;
     public com.roslib.ros.Time data;
+    public com.roslib.ros.Time request;
+    public com.roslib.ros.Time receive;
 
     public SyncTime() {
         this.tick = 0;
         this.data = new com.roslib.ros.Time();
+        this.request = new com.roslib.ros.Time();
+        this.receive = new com.roslib.ros.Time();
     }
 
     public int serialize(byte[] outbuffer, int start) {
@@ -28,6 +32,26 @@ public class SyncTime implements com.roslib.ros.Msg {
         outbuffer[offset + 2] = (byte)((this.data.nsec >> (8 * 2)) & 0xFF);
         outbuffer[offset + 3] = (byte)((this.data.nsec >> (8 * 3)) & 0xFF);
         offset += 4;
+        outbuffer[offset + 0] = (byte)((this.request.sec >> (8 * 0)) & 0xFF);
+        outbuffer[offset + 1] = (byte)((this.request.sec >> (8 * 1)) & 0xFF);
+        outbuffer[offset + 2] = (byte)((this.request.sec >> (8 * 2)) & 0xFF);
+        outbuffer[offset + 3] = (byte)((this.request.sec >> (8 * 3)) & 0xFF);
+        offset += 4;
+        outbuffer[offset + 0] = (byte)((this.request.nsec >> (8 * 0)) & 0xFF);
+        outbuffer[offset + 1] = (byte)((this.request.nsec >> (8 * 1)) & 0xFF);
+        outbuffer[offset + 2] = (byte)((this.request.nsec >> (8 * 2)) & 0xFF);
+        outbuffer[offset + 3] = (byte)((this.request.nsec >> (8 * 3)) & 0xFF);
+        offset += 4;
+        outbuffer[offset + 0] = (byte)((this.receive.sec >> (8 * 0)) & 0xFF);
+        outbuffer[offset + 1] = (byte)((this.receive.sec >> (8 * 1)) & 0xFF);
+        outbuffer[offset + 2] = (byte)((this.receive.sec >> (8 * 2)) & 0xFF);
+        outbuffer[offset + 3] = (byte)((this.receive.sec >> (8 * 3)) & 0xFF);
+        offset += 4;
+        outbuffer[offset + 0] = (byte)((this.receive.nsec >> (8 * 0)) & 0xFF);
+        outbuffer[offset + 1] = (byte)((this.receive.nsec >> (8 * 1)) & 0xFF);
+        outbuffer[offset + 2] = (byte)((this.receive.nsec >> (8 * 2)) & 0xFF);
+        outbuffer[offset + 3] = (byte)((this.receive.nsec >> (8 * 3)) & 0xFF);
+        offset += 4;
         return offset;
     }
 
@@ -48,6 +72,26 @@ public class SyncTime implements com.roslib.ros.Msg {
         this.data.nsec |= (long)((inbuffer[offset + 2] & 0xFF) << (8 * 2));
         this.data.nsec |= (long)((inbuffer[offset + 3] & 0xFF) << (8 * 3));
         offset += 4;
+        this.request.sec   = (long)((inbuffer[offset + 0] & 0xFF) << (8 * 0));
+        this.request.sec |= (long)((inbuffer[offset + 1] & 0xFF) << (8 * 1));
+        this.request.sec |= (long)((inbuffer[offset + 2] & 0xFF) << (8 * 2));
+        this.request.sec |= (long)((inbuffer[offset + 3] & 0xFF) << (8 * 3));
+        offset += 4;
+        this.request.nsec   = (long)((inbuffer[offset + 0] & 0xFF) << (8 * 0));
+        this.request.nsec |= (long)((inbuffer[offset + 1] & 0xFF) << (8 * 1));
+        this.request.nsec |= (long)((inbuffer[offset + 2] & 0xFF) << (8 * 2));
+        this.request.nsec |= (long)((inbuffer[offset + 3] & 0xFF) << (8 * 3));
+        offset += 4;
+        this.receive.sec   = (long)((inbuffer[offset + 0] & 0xFF) << (8 * 0));
+        this.receive.sec |= (long)((inbuffer[offset + 1] & 0xFF) << (8 * 1));
+        this.receive.sec |= (long)((inbuffer[offset + 2] & 0xFF) << (8 * 2));
+        this.receive.sec |= (long)((inbuffer[offset + 3] & 0xFF) << (8 * 3));
+        offset += 4;
+        this.receive.nsec   = (long)((inbuffer[offset + 0] & 0xFF) << (8 * 0));
+        this.receive.nsec |= (long)((inbuffer[offset + 1] & 0xFF) << (8 * 1));
+        this.receive.nsec |= (long)((inbuffer[offset + 2] & 0xFF) << (8 * 2));
+        this.receive.nsec |= (long)((inbuffer[offset + 3] & 0xFF) << (8 * 3));
+        offset += 4;
         return offset;
     }
 
@@ -56,12 +100,16 @@ public class SyncTime implements com.roslib.ros.Msg {
         length += 4;
         length += 4;
         length += 4;
+        length += 4;
+        length += 4;
+        length += 4;
+        length += 4;
         return length;
     }
 
     public java.lang.String echo() { return ""; }
     public java.lang.String getType(){ return "tinyros_msgs/SyncTime"; }
-    public java.lang.String getMD5(){ return "45bf702585c65b1bb762993bdbb1de6f"; }
+    public java.lang.String getMD5(){ return "849829d40822c909f761d27e58c6bec5"; }
     public long getID() { return 0; }
     public void setID(long id) { }
 }
@@ -20,6 +20,10 @@ public class TopicInfo implements com.roslib.ros.Msg {
     public static final long ID_TIME = (long)(9);
     public static final long ID_NEGOTIATED = (long)(10);
     public static final long ID_SESSION_ID = (long)(11);
+    public static final long ID_UNREGISTER = (long)(12);
+    public static final long ID_RECORD = (long)(13);
+    public static final long ID_LOG_LEVEL = (long)(14);
+    public static final long ID_LOG_SESSION_ID = (long)(15);
 
     public TopicInfo() {
         this.topic_id = 0;
@@ -171,7 +175,7 @@ public class TopicInfo implements com.roslib.ros.Msg {
 
     public java.lang.String echo() { return ""; }
     public java.lang.String getType(){ return "tinyros_msgs/TopicInfo"; }
-    public java.lang.String getMD5(){ return "76d40676946fcde66f228def7575451a"; }
+    public java.lang.String getMD5(){ return "82d849772aaa15cd9875bf868f0a1720"; }
     public long getID() { return 0; }
     public void setID(long id) { }
 }
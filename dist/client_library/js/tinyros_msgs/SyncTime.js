@@ -6,6 +6,8 @@ document.write("<script language=javascript src='"+_ROOT_PATH_+"/tinyros/Time.js
 function SyncTime() {
     this.tick = 0;
     this.data = tinyros.Time();
+    this.request = tinyros.Time();
+    this.receive = tinyros.Time();
 };
 
 SyncTime.prototype.serialize = function(buff, idx) {
@@ -25,6 +27,26 @@ SyncTime.prototype.serialize = function(buff, idx) {
     buff[offset + 2] = ((+this.data.nsec) >> (8 * 2)) & 0xFF;
     buff[offset + 3] = ((+this.data.nsec) >> (8 * 3)) & 0xFF;
     offset += 4;
+    buff[offset + 0] = ((+this.request.sec) >> (8 * 0)) & 0xFF;
+    buff[offset + 1] = ((+this.request.sec) >> (8 * 1)) & 0xFF;
+    buff[offset + 2] = ((+this.request.sec) >> (8 * 2)) & 0xFF;
+    buff[offset + 3] = ((+this.request.sec) >> (8 * 3)) & 0xFF;
+    offset += 4;
+    buff[offset + 0] = ((+this.request.nsec) >> (8 * 0)) & 0xFF;
+    buff[offset + 1] = ((+this.request.nsec) >> (8 * 1)) & 0xFF;
+    buff[offset + 2] = ((+this.request.nsec) >> (8 * 2)) & 0xFF;
+    buff[offset + 3] = ((+this.request.nsec) >> (8 * 3)) & 0xFF;
+    offset += 4;
+    buff[offset + 0] = ((+this.receive.sec) >> (8 * 0)) & 0xFF;
+    buff[offset + 1] = ((+this.receive.sec) >> (8 * 1)) & 0xFF;
+    buff[offset + 2] = ((+this.receive.sec) >> (8 * 2)) & 0xFF;
+    buff[offset + 3] = ((+this.receive.sec) >> (8 * 3)) & 0xFF;
+    offset += 4;
+    buff[offset + 0] = ((+this.receive.nsec) >> (8 * 0)) & 0xFF;
+    buff[offset + 1] = ((+this.receive.nsec) >> (8 * 1)) & 0xFF;
+    buff[offset + 2] = ((+this.receive.nsec) >> (8 * 2)) & 0xFF;
+    buff[offset + 3] = ((+this.receive.nsec) >> (8 * 3)) & 0xFF;
+    offset += 4;
     return offset;
 };
 
@@ -45,6 +67,26 @@ SyncTime.prototype.deserialize = function(buff, idx) {
     this.data.nsec |= +((buff[offset + 2] & 0xFF) << (8 * 2));
     this.data.nsec |= +((buff[offset + 3] & 0xFF) << (8 * 3));
     offset += 4;
+    this.request.sec = +((buff[offset + 0] & 0xFF) << (8 * 0));
+    this.request.sec |= +((buff[offset + 1] & 0xFF) << (8 * 1));
+    this.request.sec |= +((buff[offset + 2] & 0xFF) << (8 * 2));
+    this.request.sec |= +((buff[offset + 3] & 0xFF) << (8 * 3));
+    offset += 4;
+    this.request.nsec = +((buff[offset + 0] & 0xFF) << (8 * 0));
+    this.request.nsec |= +((buff[offset + 1] & 0xFF) << (8 * 1));
+    this.request.nsec |= +((buff[offset + 2] & 0xFF) << (8 * 2));
+    this.request.nsec |= +((buff[offset + 3] & 0xFF) << (8 * 3));
+    offset += 4;
+    this.receive.sec = +((buff[offset + 0] & 0xFF) << (8 * 0));
+    this.receive.sec |= +((buff[offset + 1] & 0xFF) << (8 * 1));
+    this.receive.sec |= +((buff[offset + 2] & 0xFF) << (8 * 2));
+    this.receive.sec |= +((buff[offset + 3] & 0xFF) << (8 * 3));
+    offset += 4;
+    this.receive.nsec = +((buff[offset + 0] & 0xFF) << (8 * 0));
+    this.receive.nsec |= +((buff[offset + 1] & 0xFF) << (8 * 1));
+    this.receive.nsec |= +((buff[offset + 2] & 0xFF) << (8 * 2));
+    this.receive.nsec |= +((buff[offset + 3] & 0xFF) << (8 * 3));
+    offset += 4;
     return offset;
 };
 
@@ -53,6 +95,10 @@ SyncTime.prototype.serializedLength = function() {
     length += 4
     length += 4
     length += 4
+    length += 4
+    length += 4
+    length += 4
+    length += 4
     return length;
 };
 
@@ -60,7 +106,7 @@ SyncTime.prototype.echo = function() { return ""; };
 
 SyncTime.prototype.getType = function() { return "tinyros_msgs/SyncTime"; };
 
-SyncTime.prototype.getMD5 = function() { return "45bf702585c65b1bb762993bdbb1de6f"; };
+SyncTime.prototype.getMD5 = function() { return "849829d40822c909f761d27e58c6bec5"; };
 
 SyncTime.prototype.getID = function() { return 0; };
 
@@ -20,6 +20,10 @@ function TopicInfo() {
     this.ID_TIME = 9;
     this.ID_NEGOTIATED = 10;
     this.ID_SESSION_ID = 11;
+    this.ID_UNREGISTER = 12;
+    this.ID_RECORD = 13;
+    this.ID_LOG_LEVEL = 14;
+    this.ID_LOG_SESSION_ID = 15;
     // }ENUM
 };
 
@@ -161,7 +165,7 @@ TopicInfo.prototype.echo = function() { return ""; };
 
 TopicInfo.prototype.getType = function() { return "tinyros_msgs/TopicInfo"; };
 
-TopicInfo.prototype.getMD5 = function() { return "76d40676946fcde66f228def7575451a"; };
+TopicInfo.prototype.getMD5 = function() { return "82d849772aaa15cd9875bf868f0a1720"; };
 
 TopicInfo.prototype.getID = function() { return 0; };
 
@@ -6,13 +6,15 @@ import tinyros_msgs.msg
 import tinyros
 
 class SyncTime(tinyros.Message):
-    __slots__ = ['tick','data']
-    _slot_types = ['uint32','tinyros.Time']
+    __slots__ = ['tick','data','request','receive']
+    _slot_types = ['uint32','tinyros.Time','tinyros.Time','tinyros.Time']
 
     def __init__(self):
         super(SyncTime, self).__init__()
         self.tick = 0
         self.data = tinyros.Time()
+        self.request = tinyros.Time()
+        self.receive = tinyros.Time()
 
     def serialize(self, buff):
         offset = 0
@@ -31,6 +33,26 @@ class SyncTime(tinyros.Message):
             offset += 4
         except struct.error as ex:
             print('Unable to serialize messages: %s'%str(ex))
+        try:
+            buff.write(_struct_I.pack(self.request.sec))
+            offset += 4
+        except struct.error as ex:
+            print('Unable to serialize messages: %s'%str(ex))
+        try:
+            buff.write(_struct_I.pack(self.request.nsec))
+            offset += 4
+        except struct.error as ex:
+            print('Unable to serialize messages: %s'%str(ex))
+        try:
+            buff.write(_struct_I.pack(self.receive.sec))
+            offset += 4
+        except struct.error as ex:
+            print('Unable to serialize messages: %s'%str(ex))
+        try:
+            buff.write(_struct_I.pack(self.receive.nsec))
+            offset += 4
+        except struct.error as ex:
+            print('Unable to serialize messages: %s'%str(ex))
         return offset
 
     def deserialize(self, buff):
@@ -50,6 +72,26 @@ class SyncTime(tinyros.Message):
             offset += 4
         except struct.error as ex:
             print('Unable to deserialize messages: %s'%str(ex))
+        try:
+            (self.request.sec,) = _struct_I.unpack(buff[offset:(offset + 4)])
+            offset += 4
+        except struct.error as ex:
+            print('Unable to deserialize messages: %s'%str(ex))
+        try:
+            (self.request.nsec,) = _struct_I.unpack(buff[offset:(offset + 4)])
+            offset += 4
+        except struct.error as ex:
+            print('Unable to deserialize messages: %s'%str(ex))
+        try:
+            (self.receive.sec,) = _struct_I.unpack(buff[offset:(offset + 4)])
+            offset += 4
+        except struct.error as ex:
+            print('Unable to deserialize messages: %s'%str(ex))
+        try:
+            (self.receive.nsec,) = _struct_I.unpack(buff[offset:(offset + 4)])
+            offset += 4
+        except struct.error as ex:
+            print('Unable to deserialize messages: %s'%str(ex))
         return offset
 
     def serializedLength(self):
@@ -57,6 +99,10 @@ class SyncTime(tinyros.Message):
         length += 4
         length += 4
         length += 4
+        length += 4
+        length += 4
+        length += 4
+        length += 4
         return length
 
     def echo(self):
@@ -65,6 +111,12 @@ class SyncTime(tinyros.Message):
         string_echo += ', '
         string_echo += '"data.sec": %s, '%data.sec
         string_echo += '"data.nsec": %s'%data.nsec
+        string_echo += ', '
+        string_echo += '"request.sec": %s, '%request.sec
+        string_echo += '"request.nsec": %s'%request.nsec
+        string_echo += ', '
+        string_echo += '"receive.sec": %s, '%receive.sec
+        string_echo += '"receive.nsec": %s'%receive.nsec
         string_echo += ''
         string_echo += '}'
         return string_echo
@@ -73,7 +125,7 @@ class SyncTime(tinyros.Message):
         return "tinyros_msgs/SyncTime"
 
     def getMD5(self):
-        return "45bf702585c65b1bb762993bdbb1de6f"
+        return "849829d40822c909f761d27e58c6bec5"
 
 _struct_I = struct.Struct('<I')
 
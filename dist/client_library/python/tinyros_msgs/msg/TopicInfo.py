@@ -18,6 +18,10 @@ class TopicInfo(tinyros.Message):
     ID_TIME = 9
     ID_NEGOTIATED = 10
     ID_SESSION_ID = 11
+    ID_UNREGISTER = 12
+    ID_RECORD = 13
+    ID_LOG_LEVEL = 14
+    ID_LOG_SESSION_ID = 15
 
     def __init__(self):
         super(TopicInfo, self).__init__()
@@ -226,7 +230,7 @@ class TopicInfo(tinyros.Message):
         return "tinyros_msgs/TopicInfo"
 
     def getMD5(self):
-        return "76d40676946fcde66f228def7575451a"
+        return "82d849772aaa15cd9875bf868f0a1720"
 
 _struct_I = struct.Struct('<I')
 
@@ -19,10 +19,16 @@ namespace tinyros_msgs
       _tick_type tick;
       typedef tinyros::Time _data_type;
       _data_type data;
+      typedef tinyros::Time _request_type;
+      _request_type request;
+      typedef tinyros::Time _receive_type;
+      _receive_type receive;
 
     SyncTime():
       tick(0),
-      data()
+      data(),
+      request(),
+      receive()
     {
     }
 
@@ -44,6 +50,26 @@ namespace tinyros_msgs
       *(outbuffer + offset + 2) = (this->data.nsec >> (8 * 2)) & 0xFF;
       *(outbuffer + offset + 3) = (this->data.nsec >> (8 * 3)) & 0xFF;
       offset += sizeof(this->data.nsec);
+      *(outbuffer + offset + 0) = (this->request.sec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->request.sec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->request.sec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->request.sec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->request.sec);
+      *(outbuffer + offset + 0) = (this->request.nsec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->request.nsec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->request.nsec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->request.nsec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->request.nsec);
+      *(outbuffer + offset + 0) = (this->receive.sec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->receive.sec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->receive.sec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->receive.sec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->receive.sec);
+      *(outbuffer + offset + 0) = (this->receive.nsec >> (8 * 0)) & 0xFF;
+      *(outbuffer + offset + 1) = (this->receive.nsec >> (8 * 1)) & 0xFF;
+      *(outbuffer + offset + 2) = (this->receive.nsec >> (8 * 2)) & 0xFF;
+      *(outbuffer + offset + 3) = (this->receive.nsec >> (8 * 3)) & 0xFF;
+      offset += sizeof(this->receive.nsec);
       return offset;
     }
 
@@ -65,6 +91,26 @@ namespace tinyros_msgs
       this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
       this->data.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
       offset += sizeof(this->data.nsec);
+      this->request.sec =  ((uint32_t) (*(inbuffer + offset)));
+      this->request.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->request.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->request.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->request.sec);
+      this->request.nsec =  ((uint32_t) (*(inbuffer + offset)));
+      this->request.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->request.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->request.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->request.nsec);
+      this->receive.sec =  ((uint32_t) (*(inbuffer + offset)));
+      this->receive.sec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->receive.sec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->receive.sec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->receive.sec);
+      this->receive.nsec =  ((uint32_t) (*(inbuffer + offset)));
+      this->receive.nsec |= ((uint32_t) (*(inbuffer + offset + 1))) << (8 * 1);
+      this->receive.nsec |= ((uint32_t) (*(inbuffer + offset + 2))) << (8 * 2);
+      this->receive.nsec |= ((uint32_t) (*(inbuffer + offset + 3))) << (8 * 3);
+      offset += sizeof(this->receive.nsec);
       return offset;
     }
 
@@ -74,11 +120,15 @@ namespace tinyros_msgs
       length += sizeof(this->tick);
       length += sizeof(this->data.sec);
       length += sizeof(this->data.nsec);
+      length += sizeof(this->request.sec);
+      length += sizeof(this->request.nsec);
+      length += sizeof(this->receive.sec);
+      length += sizeof(this->receive.nsec);
       return length;
     }
 
     virtual tinyros::string getType(){ return "tinyros_msgs/SyncTime"; }
-    virtual tinyros::string getMD5(){ return "45bf702585c65b1bb762993bdbb1de6f"; }
+    virtual tinyros::string getMD5(){ return "849829d40822c909f761d27e58c6bec5"; }
 
   };
 
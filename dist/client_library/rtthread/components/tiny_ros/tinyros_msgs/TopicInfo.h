@@ -38,6 +38,10 @@ namespace tinyros_msgs
       enum { ID_TIME = 9 };
       enum { ID_NEGOTIATED = 10 };
       enum { ID_SESSION_ID = 11 };
+      enum { ID_UNREGISTER = 12 };
+      enum { ID_RECORD = 13 };
+      enum { ID_LOG_LEVEL = 14 };
+      enum { ID_LOG_SESSION_ID = 15 };
 
     TopicInfo():
       topic_id(0),
@@ -186,7 +190,7 @@ namespace tinyros_msgs
     }
 
     virtual tinyros::string getType(){ return "tinyros_msgs/TopicInfo"; }
-    virtual tinyros::string getMD5(){ return "76d40676946fcde66f228def7575451a"; }
+    virtual tinyros::string getMD5(){ return "82d849772aaa15cd9875bf868f0a1720"; }
 
   };
 
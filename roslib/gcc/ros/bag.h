@@ -0,0 +1,736 @@
+#ifndef TINYROS_BAG_H_
+#define TINYROS_BAG_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <algorithm>
+#ifndef WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#ifdef TINYROS_WITH_ZLIB
+#include <zlib.h>
+#endif
+#include "tiny_ros/ros/time.h"
+
+/*
+ * Bag files: messages as they were received, serialized, in chunks.
+ *
+ *   header      "#TINYROSBAG V1.0" and the index position (uint64), 0 until
+ *               the bag is closed
+ *   records     op, length of the body, body
+ *   CONNECTION  id, topic, type, md5; written before the first chunk that
+ *               has a message of it
+ *   CHUNK       compression, size of the messages, message count, then the
+ *               messages, compressed as a whole: connection, sec, nsec,
+ *               size, serialized message
+ *   INDEX       connection count, the CONNECTION bodies, chunk count, the
+ *               position of each CHUNK record, entry count, then an entry
+ *               per message sorted by time: sec, nsec, connection, chunk,
+ *               offset of the message in the chunk
+ *
+ * Integers are little endian uint32 unless noted, strings are a length and
+ * the characters. A bag that was not closed has no index; it is read by
+ * walking its records instead, up to the last complete one.
+ */
+namespace tinyros
+{
+class BagFormat
+{
+public:
+  enum { OP_CONNECTION = 1, OP_CHUNK = 2, OP_INDEX = 3 };
+  enum Compression { COMPRESSION_NONE = 0, COMPRESSION_ZLIB = 1 };
+  enum { HEADER_SIZE = 24, RECORD_HEADER_SIZE = 8, CHUNK_HEADER_SIZE = 12,
+         MESSAGE_HEADER_SIZE = 16, ENTRY_SIZE = 20 };
+
+  static const char* magic() { return "#TINYROSBAG V1.0"; }
+
+  static void put32(std::string& out, uint32_t v) {
+    char b[4] = { (char)(v & 0xff), (char)((v >> 8) & 0xff), (char)((v >> 16) & 0xff), (char)((v >> 24) & 0xff) };
+    out.append(b, 4);
+  }
+
+  static void put64(std::string& out, uint64_t v) {
+    put32(out, (uint32_t)(v & 0xffffffff));
+    put32(out, (uint32_t)(v >> 32));
+  }
+
+  static void putString(std::string& out, const std::string& s) {
+    put32(out, (uint32_t)s.size());
+    out += s;
+  }
+
+  static uint32_t get32(const uint8_t* p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+  }
+
+  static uint64_t get64(const uint8_t* p) {
+    return (uint64_t)get32(p) | ((uint64_t)get32(p + 4) << 32);
+  }
+
+  /* a string at p, no further than end; false if it does not fit */
+  static bool getString(const uint8_t*& p, const uint8_t* end, std::string& s) {
+    if (end - p < 4 || (uint32_t)(end - p - 4) < get32(p)) {
+      return false;
+    }
+    uint32_t size = get32(p);
+    s.assign((const char*)p + 4, size);
+    p += 4 + size;
+    return true;
+  }
+
+  static bool before(uint32_t sec, uint32_t nsec, uint32_t other_sec, uint32_t other_nsec) {
+    return sec < other_sec || (sec == other_sec && nsec < other_nsec);
+  }
+};
+
+/*
+ * Writes a bag. write() only appends to the current chunk; full chunks
+ * are compressed and written by a thread of the writer, so callers do not
+ * wait on the disk. Once more than max_pending bytes wait for it, messages
+ * are dropped and counted rather than queued. Thread safe.
+ */
+class BagWriter
+{
+public:
+  enum { DEFAULT_CHUNK_SIZE = 768 * 1024, DEFAULT_MAX_PENDING = 256 * 1024 * 1024 };
+
+  BagWriter() : file_(NULL), compression_(BagFormat::COMPRESSION_NONE), chunk_size_(DEFAULT_CHUNK_SIZE),
+    max_pending_(DEFAULT_MAX_PENDING), pending_(0), chunks_(0), messages_(0), dropped_(0), failed_(false), stop_(false), chunk_count_(0) {}
+  ~BagWriter() { close(); }
+
+  /* chunks fall back to uncompressed if zlib was not built in */
+  bool open(const std::string& path, BagFormat::Compression compression = BagFormat::COMPRESSION_NONE,
+    uint32_t chunk_size = DEFAULT_CHUNK_SIZE, uint64_t max_pending = DEFAULT_MAX_PENDING) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (file_ != NULL) {
+      return false;
+    }
+    file_ = fopen(path.c_str(), "wb");
+    if (file_ == NULL) {
+      return false;
+    }
+    file_buffer_.resize(4 * 1024 * 1024);
+    setvbuf(file_, &file_buffer_[0], _IOFBF, file_buffer_.size());
+#ifdef TINYROS_WITH_ZLIB
+    compression_ = compression;
+#else
+    compression_ = BagFormat::COMPRESSION_NONE;
+#endif
+    chunk_size_ = chunk_size > 0 ? chunk_size : (uint32_t)DEFAULT_CHUNK_SIZE;
+    max_pending_ = max_pending;
+    pending_ = 0;
+    chunks_ = 0;
+    messages_ = 0;
+    dropped_ = 0;
+    failed_ = false;
+    stop_ = false;
+    connection_ids_.clear();
+    connections_.clear();
+    index_.clear();
+    chunk_.clear();
+    chunk_count_ = 0;
+    chunk_connections_.clear();
+    positions_.clear();
+    std::string header(BagFormat::magic());
+    BagFormat::put64(header, 0);
+    if (fwrite(header.data(), 1, header.size(), file_) != header.size()) {
+      failed_ = true;
+    }
+    thread_ = std::thread(&BagWriter::run, this);
+    return true;
+  }
+
+  bool isOpen() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return file_ != NULL;
+  }
+
+  /* false if the message was dropped */
+  bool write(const std::string& topic, const std::string& type, const std::string& md5,
+    const Time& time, const uint8_t* data, uint32_t size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (file_ == NULL || stop_) {
+      return false;
+    }
+    if (pending_ + chunk_.size() > max_pending_) {
+      dropped_++;
+      return false;
+    }
+    uint32_t connection;
+    std::map<std::string, uint32_t>::iterator it = connection_ids_.find(topic);
+    if (it == connection_ids_.end()) {
+      connection = (uint32_t)connection_ids_.size();
+      connection_ids_[topic] = connection;
+      std::string body;
+      BagFormat::put32(body, connection);
+      BagFormat::putString(body, topic);
+      BagFormat::putString(body, type);
+      BagFormat::putString(body, md5);
+      connections_.push_back(body);
+      BagFormat::put32(chunk_connections_, BagFormat::OP_CONNECTION);
+      BagFormat::put32(chunk_connections_, (uint32_t)body.size());
+      chunk_connections_ += body;
+    } else {
+      connection = it->second;
+    }
+    Entry entry = { time.sec, time.nsec, connection, chunks_, (uint32_t)chunk_.size() };
+    index_.push_back(entry);
+    BagFormat::put32(chunk_, connection);
+    BagFormat::put32(chunk_, time.sec);
+    BagFormat::put32(chunk_, time.nsec);
+    BagFormat::put32(chunk_, size);
+    chunk_.append((const char*)data, size);
+    chunk_count_++;
+    messages_++;
+    if (chunk_.size() >= chunk_size_) {
+      flushChunk();
+    }
+    return true;
+  }
+
+  /* writes what is left and the index */
+  void close() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (file_ == NULL || stop_) {
+      return;
+    }
+    if (chunk_count_ > 0) {
+      flushChunk();
+    }
+    stop_ = true;
+    cond_.notify_all();
+    lock.unlock();
+    thread_.join();
+    lock.lock();
+
+    std::stable_sort(index_.begin(), index_.end(), entryBefore);
+    std::string body;
+    BagFormat::put32(body, (uint32_t)connections_.size());
+    for (size_t i = 0; i < connections_.size(); i++) {
+      body += connections_[i];
+    }
+    BagFormat::put32(body, (uint32_t)positions_.size());
+    for (size_t i = 0; i < positions_.size(); i++) {
+      BagFormat::put64(body, positions_[i]);
+    }
+    BagFormat::put32(body, (uint32_t)index_.size());
+    body.reserve(body.size() + index_.size() * BagFormat::ENTRY_SIZE);
+    for (size_t i = 0; i < index_.size(); i++) {
+      BagFormat::put32(body, index_[i].sec);
+      BagFormat::put32(body, index_[i].nsec);
+      BagFormat::put32(body, index_[i].connection);
+      BagFormat::put32(body, index_[i].chunk);
+      BagFormat::put32(body, index_[i].offset);
+    }
+    uint64_t position = (uint64_t)ftell(file_);
+    writeRecord(BagFormat::OP_INDEX, body);
+    std::string position_bytes;
+    BagFormat::put64(position_bytes, position);
+    if (fseek(file_, BagFormat::HEADER_SIZE - 8, SEEK_SET) != 0
+      || fwrite(position_bytes.data(), 1, 8, file_) != 8) {
+      failed_ = true;
+    }
+    if (fclose(file_) != 0) {
+      failed_ = true;
+    }
+    file_ = NULL;
+    index_.clear();
+  }
+
+  uint64_t getMessages() { std::unique_lock<std::mutex> lock(mutex_); return messages_; }
+  uint64_t getDropped() { std::unique_lock<std::mutex> lock(mutex_); return dropped_; }
+  /* true once a write to the file failed, such as on a full disk */
+  bool failed() { std::unique_lock<std::mutex> lock(mutex_); return failed_; }
+
+private:
+  struct Entry
+  {
+    uint32_t sec;
+    uint32_t nsec;
+    uint32_t connection;
+    uint32_t chunk;
+    uint32_t offset;
+  };
+
+  struct Chunk
+  {
+    std::string connections;  // CONNECTION records to write first
+    std::string messages;
+    uint32_t count;
+  };
+
+  static bool entryBefore(const Entry& a, const Entry& b) {
+    return BagFormat::before(a.sec, a.nsec, b.sec, b.nsec);
+  }
+
+  /* hands the current chunk to the thread, mutex_ held */
+  void flushChunk() {
+    chunks_queue_.push_back(Chunk());
+    Chunk& chunk = chunks_queue_.back();
+    chunk.connections.swap(chunk_connections_);
+    chunk.messages.swap(chunk_);
+    chunk.count = chunk_count_;
+    pending_ += chunk.messages.size();
+    chunk_.reserve(chunk_size_ + chunk_size_ / 8);
+    chunk_count_ = 0;
+    chunks_++;
+    cond_.notify_all();
+  }
+
+  void run() {
+    std::string record;
+    std::string compressed;
+    for (;;) {
+      Chunk chunk;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (chunks_queue_.empty() && !stop_) {
+          cond_.wait(lock);
+        }
+        if (chunks_queue_.empty()) {
+          return;
+        }
+        chunk.connections.swap(chunks_queue_.front().connections);
+        chunk.messages.swap(chunks_queue_.front().messages);
+        chunk.count = chunks_queue_.front().count;
+        chunks_queue_.pop_front();
+      }
+
+      uint32_t compression = BagFormat::COMPRESSION_NONE;
+      const std::string* data = &chunk.messages;
+#ifdef TINYROS_WITH_ZLIB
+      if (compression_ == BagFormat::COMPRESSION_ZLIB) {
+        uLongf size = compressBound((uLong)chunk.messages.size());
+        compressed.resize(size);
+        if (compress2((Bytef*)&compressed[0], &size, (const Bytef*)chunk.messages.data(),
+          (uLong)chunk.messages.size(), Z_BEST_SPEED) == Z_OK) {
+          compressed.resize(size);
+          compression = BagFormat::COMPRESSION_ZLIB;
+          data = &compressed;
+        }
+      }
+#endif
+      record.clear();
+      BagFormat::put32(record, BagFormat::OP_CHUNK);
+      BagFormat::put32(record, BagFormat::CHUNK_HEADER_SIZE + (uint32_t)data->size());
+      BagFormat::put32(record, compression);
+      BagFormat::put32(record, (uint32_t)chunk.messages.size());
+      BagFormat::put32(record, chunk.count);
+
+      bool ok = fwrite(chunk.connections.data(), 1, chunk.connections.size(), file_) == chunk.connections.size();
+      uint64_t position = (uint64_t)ftell(file_);
+      ok = ok && fwrite(record.data(), 1, record.size(), file_) == record.size();
+      ok = ok && fwrite(data->data(), 1, data->size(), file_) == data->size();
+      ok = ok && fflush(file_) == 0;  // a bag cut short keeps its complete chunks
+
+      std::unique_lock<std::mutex> lock(mutex_);
+      positions_.push_back(position);
+      pending_ -= chunk.messages.size();
+      if (!ok) {
+        failed_ = true;
+      }
+    }
+  }
+
+  /* mutex_ held, the thread is done */
+  void writeRecord(uint32_t op, const std::string& body) {
+    std::string header;
+    BagFormat::put32(header, op);
+    BagFormat::put32(header, (uint32_t)body.size());
+    if (fwrite(header.data(), 1, header.size(), file_) != header.size()
+      || fwrite(body.data(), 1, body.size(), file_) != body.size()) {
+      failed_ = true;
+    }
+  }
+
+  FILE* file_;
+  std::vector<char> file_buffer_;
+  BagFormat::Compression compression_;
+  uint32_t chunk_size_;
+  uint64_t max_pending_;
+  uint64_t pending_;  // bytes of chunks waiting for the thread
+  uint32_t chunks_;
+  uint64_t messages_;
+  uint64_t dropped_;
+  bool failed_;
+  bool stop_;
+
+  std::map<std::string, uint32_t> connection_ids_;
+  std::vector<std::string> connections_;  // CONNECTION bodies by id
+  std::vector<Entry> index_;
+  std::string chunk_;
+  uint32_t chunk_count_;
+  std::string chunk_connections_;
+  std::deque<Chunk> chunks_queue_;
+  std::vector<uint64_t> positions_;  // of the CHUNK records, by chunk
+
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+};
+
+/*
+ * Reads a bag through a read only mapping of the file. Messages are found
+ * through the index, by position in time order or by seek(), which is a
+ * binary search. Messages of uncompressed chunks are read in place;
+ * compressed chunks are inflated once into a buffer that holds the most
+ * recently read chunk. Not thread safe.
+ */
+class BagReader
+{
+public:
+  struct Connection
+  {
+    uint32_t id;
+    std::string topic;
+    std::string type;
+    std::string md5;
+  };
+
+  struct Message
+  {
+    const Connection* connection;
+    Time time;
+    const uint8_t* data;  // valid until the next read() or close()
+    uint32_t size;
+  };
+
+  BagReader() : map_(NULL), size_(0), entries_(NULL), count_(0), indexed_(false), cached_(-1) {}
+  ~BagReader() { close(); }
+
+  bool open(const std::string& path) {
+    close();
+#ifdef WIN32
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+      return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    contents_.resize(length > 0 ? length : 1);
+    size_ = length > 0 && fread(&contents_[0], 1, length, file) == (size_t)length ? (size_t)length : 0;
+    fclose(file);
+    map_ = (const uint8_t*)&contents_[0];
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < BagFormat::HEADER_SIZE) {
+      ::close(fd);
+      return false;
+    }
+    void* map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+      return false;
+    }
+    map_ = (const uint8_t*)map;
+    size_ = (size_t)st.st_size;
+#endif
+    if (size_ < BagFormat::HEADER_SIZE || memcmp(map_, BagFormat::magic(), BagFormat::HEADER_SIZE - 8) != 0) {
+      close();
+      return false;
+    }
+    uint64_t index = BagFormat::get64(map_ + BagFormat::HEADER_SIZE - 8);
+    indexed_ = index != 0 && readIndex(index);
+    if (!indexed_ && !rebuildIndex()) {
+      close();
+      return false;
+    }
+    return true;
+  }
+
+  void close() {
+    if (map_ != NULL) {
+#ifdef WIN32
+      contents_.clear();
+#else
+      munmap((void*)map_, size_);
+#endif
+    }
+    map_ = NULL;
+    size_ = 0;
+    entries_ = NULL;
+    count_ = 0;
+    indexed_ = false;
+    connections_.clear();
+    positions_.clear();
+    rebuilt_.clear();
+    cached_ = -1;
+    chunk_.clear();
+  }
+
+  bool isOpen() const { return map_ != NULL; }
+  /* false if the bag was not closed and its messages were found by walking it */
+  bool indexed() const { return indexed_; }
+
+  const std::vector<Connection>& getConnections() const { return connections_; }
+  size_t getChunks() const { return positions_.size(); }
+  /* messages, in time order */
+  size_t size() const { return count_; }
+
+  Time getTime(size_t i) const {
+    const uint8_t* entry = entries_ + i * BagFormat::ENTRY_SIZE;
+    Time time;
+    time.sec = BagFormat::get32(entry);
+    time.nsec = BagFormat::get32(entry + 4);
+    return time;
+  }
+
+  const Connection* getConnection(size_t i) const {
+    uint32_t id = BagFormat::get32(entries_ + i * BagFormat::ENTRY_SIZE + 8);
+    return id < connections_.size() ? &connections_[id] : NULL;
+  }
+
+  /* position of the first message at or after time, size() if none */
+  size_t seek(const Time& time) const {
+    size_t lo = 0;
+    size_t hi = count_;
+    while (lo < hi) {
+      size_t mid = lo + (hi - lo) / 2;
+      const uint8_t* entry = entries_ + mid * BagFormat::ENTRY_SIZE;
+      if (BagFormat::before(BagFormat::get32(entry), BagFormat::get32(entry + 4), time.sec, time.nsec)) {
+        lo = mid + 1;
+      } else {
+        hi = mid;
+      }
+    }
+    return lo;
+  }
+
+  bool read(size_t i, Message& msg) {
+    if (i >= count_) {
+      return false;
+    }
+    const uint8_t* entry = entries_ + i * BagFormat::ENTRY_SIZE;
+    uint32_t chunk = BagFormat::get32(entry + 12);
+    uint32_t offset = BagFormat::get32(entry + 16);
+    const uint8_t* data;
+    uint32_t size;
+    if (!chunkData(chunk, data, size) || offset > size || size - offset < BagFormat::MESSAGE_HEADER_SIZE) {
+      return false;
+    }
+    const uint8_t* p = data + offset;
+    uint32_t connection = BagFormat::get32(p);
+    uint32_t length = BagFormat::get32(p + 12);
+    if (connection >= connections_.size() || size - offset - BagFormat::MESSAGE_HEADER_SIZE < length) {
+      return false;
+    }
+    msg.connection = &connections_[connection];
+    msg.time.sec = BagFormat::get32(p + 4);
+    msg.time.nsec = BagFormat::get32(p + 8);
+    msg.data = p + BagFormat::MESSAGE_HEADER_SIZE;
+    msg.size = length;
+    return true;
+  }
+
+private:
+  bool readIndex(uint64_t position) {
+    if (position > size_ || size_ - position < BagFormat::RECORD_HEADER_SIZE
+      || BagFormat::get32(map_ + position) != BagFormat::OP_INDEX) {
+      return false;
+    }
+    uint32_t length = BagFormat::get32(map_ + position + 4);
+    const uint8_t* p = map_ + position + BagFormat::RECORD_HEADER_SIZE;
+    if ((size_t)(map_ + size_ - p) < length) {
+      return false;
+    }
+    const uint8_t* end = p + length;
+    if (end - p < 4) {
+      return false;
+    }
+    uint32_t connections = BagFormat::get32(p);
+    p += 4;
+    for (uint32_t i = 0; i < connections; i++) {
+      if (!readConnection(p, end)) {
+        return false;
+      }
+    }
+    if (end - p < 4) {
+      return false;
+    }
+    uint32_t chunks = BagFormat::get32(p);
+    p += 4;
+    if ((uint64_t)(end - p) < (uint64_t)chunks * 8 + 4) {
+      return false;
+    }
+    for (uint32_t i = 0; i < chunks; i++, p += 8) {
+      positions_.push_back(BagFormat::get64(p));
+    }
+    count_ = BagFormat::get32(p);
+    p += 4;
+    if ((uint64_t)(end - p) < (uint64_t)count_ * BagFormat::ENTRY_SIZE) {
+      return false;
+    }
+    entries_ = p;
+    return true;
+  }
+
+  /* a CONNECTION body at p */
+  bool readConnection(const uint8_t*& p, const uint8_t* end) {
+    Connection connection;
+    if (end - p < 4) {
+      return false;
+    }
+    connection.id = BagFormat::get32(p);
+    p += 4;
+    if (!BagFormat::getString(p, end, connection.topic) || !BagFormat::getString(p, end, connection.type)
+      || !BagFormat::getString(p, end, connection.md5)) {
+      return false;
+    }
+    if (connection.id >= connections_.size()) {
+      connections_.resize(connection.id + 1);
+    }
+    connections_[connection.id] = connection;
+    return true;
+  }
+
+  /* walks the records of a bag without index, up to the last complete one */
+  bool rebuildIndex() {
+    connections_.clear();
+    positions_.clear();
+    rebuilt_.clear();
+    size_t position = BagFormat::HEADER_SIZE;
+    while (size_ - position >= BagFormat::RECORD_HEADER_SIZE) {
+      uint32_t op = BagFormat::get32(map_ + position);
+      uint32_t length = BagFormat::get32(map_ + position + 4);
+      const uint8_t* p = map_ + position + BagFormat::RECORD_HEADER_SIZE;
+      if ((size_t)(map_ + size_ - p) < length) {
+        break;
+      }
+      if (op == BagFormat::OP_CONNECTION) {
+        if (!readConnection(p, p + length)) {
+          break;
+        }
+      } else if (op == BagFormat::OP_CHUNK) {
+        uint32_t chunk = (uint32_t)positions_.size();
+        positions_.push_back(position);
+        const uint8_t* data;
+        uint32_t size;
+        if (!chunkData(chunk, data, size)) {
+          positions_.pop_back();
+          break;
+        }
+        uint32_t offset = 0;
+        while (size - offset >= BagFormat::MESSAGE_HEADER_SIZE) {
+          const uint8_t* message = data + offset;
+          uint32_t message_size = BagFormat::get32(message + 12);
+          if (size - offset - BagFormat::MESSAGE_HEADER_SIZE < message_size) {
+            break;
+          }
+          rebuilt_.append((const char*)message + 4, 8);
+          rebuilt_.append((const char*)message, 4);
+          BagFormat::put32(rebuilt_, chunk);
+          BagFormat::put32(rebuilt_, offset);
+          offset += BagFormat::MESSAGE_HEADER_SIZE + message_size;
+        }
+      } else if (op == BagFormat::OP_INDEX) {
+        break;
+      }
+      position += BagFormat::RECORD_HEADER_SIZE + length;
+    }
+
+    // the entries in time order, as the index has them
+    count_ = rebuilt_.size() / BagFormat::ENTRY_SIZE;
+    std::vector<size_t> order(count_);
+    for (size_t i = 0; i < count_; i++) {
+      order[i] = i;
+    }
+    const uint8_t* entries = (const uint8_t*)rebuilt_.data();
+    std::stable_sort(order.begin(), order.end(), EntryBefore(entries));
+    std::string sorted;
+    sorted.reserve(rebuilt_.size());
+    for (size_t i = 0; i < count_; i++) {
+      sorted.append(rebuilt_, order[i] * BagFormat::ENTRY_SIZE, BagFormat::ENTRY_SIZE);
+    }
+    rebuilt_.swap(sorted);
+    entries_ = (const uint8_t*)rebuilt_.data();
+    cached_ = -1;
+    return true;
+  }
+
+  struct EntryBefore
+  {
+    EntryBefore(const uint8_t* entries) : entries_(entries) {}
+    bool operator()(size_t a, size_t b) const {
+      const uint8_t* x = entries_ + a * BagFormat::ENTRY_SIZE;
+      const uint8_t* y = entries_ + b * BagFormat::ENTRY_SIZE;
+      return BagFormat::before(BagFormat::get32(x), BagFormat::get32(x + 4), BagFormat::get32(y), BagFormat::get32(y + 4));
+    }
+    const uint8_t* entries_;
+  };
+
+  /* the messages of a chunk, inflated if it is compressed */
+  bool chunkData(uint32_t chunk, const uint8_t*& data, uint32_t& size) {
+    if (chunk >= positions_.size()) {
+      return false;
+    }
+    uint64_t position = positions_[chunk];
+    if (position > size_ || size_ - position < BagFormat::RECORD_HEADER_SIZE + BagFormat::CHUNK_HEADER_SIZE
+      || BagFormat::get32(map_ + position) != BagFormat::OP_CHUNK) {
+      return false;
+    }
+    const uint8_t* record = map_ + position;
+    uint32_t length = BagFormat::get32(record + 4);
+    if (length < BagFormat::CHUNK_HEADER_SIZE || size_ - position - BagFormat::RECORD_HEADER_SIZE < length) {
+      return false;
+    }
+    uint32_t compression = BagFormat::get32(record + 8);
+    uint32_t raw_size = BagFormat::get32(record + 12);
+    const uint8_t* body = record + BagFormat::RECORD_HEADER_SIZE + BagFormat::CHUNK_HEADER_SIZE;
+    uint32_t body_size = length - BagFormat::CHUNK_HEADER_SIZE;
+    if (compression == BagFormat::COMPRESSION_NONE) {
+      data = body;
+      size = body_size < raw_size ? body_size : raw_size;
+      return true;
+    }
+#ifdef TINYROS_WITH_ZLIB
+    if (compression == BagFormat::COMPRESSION_ZLIB) {
+      if (cached_ != (int64_t)chunk) {
+        chunk_.resize(raw_size > 0 ? raw_size : 1);
+        uLongf inflated = raw_size;
+        if (uncompress((Bytef*)&chunk_[0], &inflated, body, body_size) != Z_OK || inflated != raw_size) {
+          cached_ = -1;
+          return false;
+        }
+        cached_ = chunk;
+      }
+      data = (const uint8_t*)&chunk_[0];
+      size = raw_size;
+      return true;
+    }
+#endif
+    return false;
+  }
+
+  const uint8_t* map_;
+  size_t size_;
+#ifdef WIN32
+  std::vector<char> contents_;
+#endif
+  const uint8_t* entries_;  // ENTRY_SIZE each, in the mapping or in rebuilt_
+  size_t count_;
+  bool indexed_;
+  std::vector<Connection> connections_;
+  std::vector<uint64_t> positions_;
+  std::string rebuilt_;
+  int64_t cached_;  // chunk held in chunk_
+  std::vector<uint8_t> chunk_;
+};
+
+}
+
+#endif
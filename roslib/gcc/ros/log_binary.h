@@ -0,0 +1,431 @@
+#ifndef TINYROS_LOG_BINARY_H_
+#define TINYROS_LOG_BINARY_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace tinyros
+{
+/* lowest level anyone listens to, see NodeHandle::getLogLevel(); in log.cpp */
+int logLevel();
+
+/*
+ * A call site of tinyros_blog_*. It is constant initialized, and its
+ * address is the id records refer to the format string by.
+ */
+struct LogSite
+{
+  constexpr LogSite(int level, const char* format) : level(level), format(format) {}
+  int level;
+  const char* format;  // a literal, never copied
+};
+
+/*
+ * The tinyros_blog_* records of one thread: the site and the raw
+ * arguments, which the log thread of NodeHandle formats later. Single
+ * producer, the thread, and single consumer, the log thread. A record is
+ * a header (size, length of the arguments, site) followed by the
+ * arguments, each a tag and its value; C strings are copied, as they may
+ * be gone by then.
+ */
+class LogBuffer
+{
+public:
+  enum { CAPACITY = 64 * 1024 };  // a power of two
+  enum { HEADER = 16 };
+  enum Tag { TAG_INT = 'i', TAG_UINT = 'u', TAG_DOUBLE = 'd', TAG_STRING = 's', TAG_POINTER = 'p' };
+
+  LogBuffer() : alive_(true), head_(0), tail_(0), dropped_(0) {}
+
+  template<typename... Args>
+  bool write(const LogSite* site, const Args&... args) {
+    uint32_t length = argsSize(args...);
+    uint32_t size = (HEADER + length + 7) & ~7u;
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t offset = tail & (CAPACITY - 1);
+    size_t pad = offset + size > CAPACITY ? CAPACITY - offset : 0;
+    if (tail + pad + size - head_.load(std::memory_order_acquire) > CAPACITY) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+    if (pad > 0) {
+      // the record does not fit before the end, the reader skips to the start
+      uint32_t padding = 0;
+      memcpy(buffer_ + offset, &padding, 4);
+      offset = 0;
+    }
+    uint8_t* p = buffer_ + offset;
+    memcpy(p, &size, 4);
+    memcpy(p + 4, &length, 4);
+    memcpy(p + 8, &site, sizeof(site));
+    p += HEADER;
+    putArgs(p, args...);
+    tail_.store(tail + pad + size, std::memory_order_release);
+    return true;
+  }
+
+  /* the oldest record, false if there is none; consumer only */
+  bool front(const LogSite*& site, const uint8_t*& args, const uint8_t*& end) {
+    while (true) {
+      size_t head = head_.load(std::memory_order_relaxed);
+      if (head == tail_.load(std::memory_order_acquire)) {
+        return false;
+      }
+      const uint8_t* p = buffer_ + (head & (CAPACITY - 1));
+      uint32_t size;
+      memcpy(&size, p, 4);
+      if (size == 0) {
+        head_.store(head + (CAPACITY - (head & (CAPACITY - 1))), std::memory_order_release);
+        continue;
+      }
+      uint32_t length;
+      memcpy(&length, p + 4, 4);
+      memcpy(&site, p + 8, sizeof(site));
+      args = p + HEADER;
+      end = args + length;  // not p + size, the padding holds no arguments
+      return true;
+    }
+  }
+
+  void pop() {
+    size_t head = head_.load(std::memory_order_relaxed);
+    uint32_t size;
+    memcpy(&size, buffer_ + (head & (CAPACITY - 1)), 4);
+    head_.store(head + size, std::memory_order_release);
+  }
+
+  bool empty() {
+    return head_.load(std::memory_order_relaxed) == tail_.load(std::memory_order_acquire);
+  }
+
+  uint64_t getDropped() { return dropped_.load(std::memory_order_relaxed); }
+
+  std::atomic<bool> alive_;  // false once its thread is gone
+
+private:
+  static uint32_t argsSize() { return 0; }
+  template<typename T, typename... Rest>
+  static uint32_t argsSize(const T& arg, const Rest&... rest) {
+    return argSize(arg) + argsSize(rest...);
+  }
+
+  static void putArgs(uint8_t*&) {}
+  template<typename T, typename... Rest>
+  static void putArgs(uint8_t*& p, const T& arg, const Rest&... rest) {
+    putArg(p, arg);
+    putArgs(p, rest...);
+  }
+
+  static uint32_t argSize(const char* s) { return 5 + (uint32_t)strlen(s ? s : "(null)"); }
+  static uint32_t argSize(char* s) { return argSize((const char*)s); }
+  template<typename T>
+  static uint32_t argSize(const T&) { return 9; }
+
+  static void putValue(uint8_t*& p, char tag, const void* value) {
+    *p++ = (uint8_t)tag;
+    memcpy(p, value, 8);
+    p += 8;
+  }
+
+  static void putArg(uint8_t*& p, const char* s) {
+    s = s ? s : "(null)";
+    uint32_t length = (uint32_t)strlen(s);
+    *p++ = TAG_STRING;
+    memcpy(p, &length, 4);
+    memcpy(p + 4, s, length);
+    p += 4 + length;
+  }
+  static void putArg(uint8_t*& p, char* s) { putArg(p, (const char*)s); }
+
+  template<typename T>
+  static void putArg(uint8_t*& p, const T& arg) {
+    putNumber(p, arg, std::integral_constant<int,
+      std::is_floating_point<T>::value ? 2 : (std::is_pointer<T>::value ? 3 :
+      (std::is_signed<T>::value || std::is_enum<T>::value ? 0 : 1))>());
+  }
+
+  template<typename T>
+  static void putNumber(uint8_t*& p, const T& arg, std::integral_constant<int, 0>) {
+    int64_t value = (int64_t)arg;
+    putValue(p, TAG_INT, &value);
+  }
+  template<typename T>
+  static void putNumber(uint8_t*& p, const T& arg, std::integral_constant<int, 1>) {
+    uint64_t value = (uint64_t)arg;
+    putValue(p, TAG_UINT, &value);
+  }
+  template<typename T>
+  static void putNumber(uint8_t*& p, const T& arg, std::integral_constant<int, 2>) {
+    double value = (double)arg;
+    putValue(p, TAG_DOUBLE, &value);
+  }
+  template<typename T>
+  static void putNumber(uint8_t*& p, const T& arg, std::integral_constant<int, 3>) {
+    uint64_t value = (uint64_t)(uintptr_t)arg;
+    putValue(p, TAG_POINTER, &value);
+  }
+
+  uint8_t buffer_[CAPACITY];
+  std::atomic<size_t> head_;
+  std::atomic<size_t> tail_;
+  std::atomic<uint64_t> dropped_;
+};
+
+/*
+ * The LogBuffer of every thread that used tinyros_blog_*. A thread gets
+ * its own on first use; it is dropped once the thread is gone and the
+ * log thread read it empty.
+ */
+class BinaryLog
+{
+public:
+  static LogBuffer* local() {
+    static thread_local Holder holder;
+    return holder.buffer_.get();
+  }
+
+  /*
+   * Log thread: formats the oldest records into text and hands them to
+   * put(level, text, length) until it returns false or none are left.
+   */
+  template<typename F>
+  static void drain(F put) {
+    std::vector<std::shared_ptr<LogBuffer> > buffers;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      buffers = buffers_;
+    }
+    char text[TEXT_SIZE];
+    for (size_t i = 0; i < buffers.size(); i++) {
+      const LogSite* site;
+      const uint8_t* args;
+      const uint8_t* end;
+      bool alive = buffers[i]->alive_.load();
+      while (buffers[i]->front(site, args, end)) {
+        uint32_t length = format(site->format, args, end, text, sizeof(text));
+        if (!put(site->level, text, length)) {
+          return;
+        }
+        buffers[i]->pop();
+      }
+      if (!alive) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        gone_dropped_ += buffers[i]->getDropped();
+        for (size_t j = 0; j < buffers_.size(); j++) {
+          if (buffers_[j] == buffers[i]) {
+            buffers_.erase(buffers_.begin() + j);
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  /* records to format, or buffers of gone threads to drop */
+  static bool pending() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (size_t i = 0; i < buffers_.size(); i++) {
+      if (!buffers_[i]->empty() || !buffers_[i]->alive_) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /* records dropped because the buffer of their thread was full */
+  static uint64_t getDropped() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t dropped = gone_dropped_;
+    for (size_t i = 0; i < buffers_.size(); i++) {
+      dropped += buffers_[i]->getDropped();
+    }
+    return dropped;
+  }
+
+  /* printf of format with recorded arguments, returns the length written */
+  static uint32_t format(const char* format, const uint8_t* args, const uint8_t* end, char* out, size_t size) {
+    size_t n = 0;
+    const char* f = format;
+    while (*f && n + 1 < size) {
+      if (*f != '%') {
+        out[n++] = *f++;
+        continue;
+      }
+      if (f[1] == '%') {
+        out[n++] = '%';
+        f += 2;
+        continue;
+      }
+      // %[flags][width][.precision][length]conversion, length is replaced;
+      // each flag once, width and precision 11 chars at most: 33 bytes
+      char spec[64];
+      size_t s = 0;
+      const char* start = f++;
+      spec[s++] = '%';
+      for (; *f && strchr("-+ #0", *f); f++) {
+        if (!memchr(spec + 1, *f, s - 1)) spec[s++] = *f;
+      }
+      for (int part = 0; part < 2; part++) {
+        if (part == 1) {
+          if (*f != '.') break;
+          spec[s++] = *f++;
+        }
+        if (*f == '*') {
+          f++;
+          int value = (int)nextInt(args, end);
+          if (part == 1 && value < 0) {
+            s--;  // a negative precision is taken as if it were omitted
+          } else {
+            s += snprintf(spec + s, 12, "%d", value);
+          }
+        } else {
+          // past leading zeros, more digits overflow an int in printf too
+          for (size_t digits = 0; *f >= '0' && *f <= '9'; f++) {
+            if (*f == '0' && spec[s - 1] == '.') continue;
+            if (digits++ < 10) spec[s++] = *f;
+          }
+        }
+      }
+      const char* modifier = f;
+      while (*f && strchr("hljztLq", *f)) f++;
+      int bits = lengthBits(modifier, f);
+      char conversion = *f;
+      if (conversion == '\0' || args >= end) {
+        // not a conversion, or more conversions than arguments
+        size_t length = (conversion ? f + 1 : f) - start;
+        length = length < size - 1 - n ? length : size - 1 - n;
+        memcpy(out + n, start, length);
+        n += length;
+        f = conversion ? f + 1 : f;
+        continue;
+      }
+      f++;
+      int written = 0;
+      if (strchr("di", conversion)) {
+        spec[s++] = 'l'; spec[s++] = 'l'; spec[s++] = conversion; spec[s] = '\0';
+        written = snprintf(out + n, size - n, spec, (long long)toSigned(nextInt(args, end), bits));
+      } else if (strchr("ouxX", conversion)) {
+        spec[s++] = 'l'; spec[s++] = 'l'; spec[s++] = conversion; spec[s] = '\0';
+        written = snprintf(out + n, size - n, spec, (unsigned long long)toUnsigned(nextInt(args, end), bits));
+      } else if (strchr("eEfFgGaA", conversion)) {
+        spec[s++] = conversion; spec[s] = '\0';
+        written = snprintf(out + n, size - n, spec, nextDouble(args, end));
+      } else if (conversion == 'c') {
+        spec[s++] = conversion; spec[s] = '\0';
+        written = snprintf(out + n, size - n, spec, (int)nextInt(args, end));
+      } else if (conversion == 's') {
+        std::string text = nextString(args, end);
+        spec[s++] = conversion; spec[s] = '\0';
+        written = snprintf(out + n, size - n, spec, text.c_str());
+      } else if (conversion == 'p') {
+        spec[s++] = conversion; spec[s] = '\0';
+        written = snprintf(out + n, size - n, spec, (void*)(uintptr_t)nextInt(args, end));
+      } else {
+        nextInt(args, end);
+      }
+      if (written > 0) {
+        n += (size_t)written < size - n ? (size_t)written : size - 1 - n;
+      }
+    }
+    out[n] = '\0';
+    return (uint32_t)n;
+  }
+
+private:
+  enum { TEXT_SIZE = 4096 };
+
+  struct Holder
+  {
+    Holder() : buffer_(new LogBuffer()) {
+      std::unique_lock<std::mutex> lock(mutex_);
+      buffers_.push_back(buffer_);
+    }
+    ~Holder() { buffer_->alive_ = false; }
+    std::shared_ptr<LogBuffer> buffer_;
+  };
+
+  /* bits of the integer a length modifier names, as printf converts to them */
+  static int lengthBits(const char* modifier, const char* end) {
+    if (modifier == end) return 32;
+    if (*modifier == 'h') return end - modifier > 1 ? 8 : 16;
+    if (*modifier == 'l' && end - modifier == 1) return (int)sizeof(long) * 8;
+    if (*modifier == 'z' || *modifier == 't') return (int)sizeof(size_t) * 8;
+    return 64;
+  }
+
+  static int64_t toSigned(int64_t value, int bits) {
+    return bits == 8 ? (signed char)value : (bits == 16 ? (short)value : (bits == 32 ? (int32_t)value : value));
+  }
+
+  static uint64_t toUnsigned(int64_t value, int bits) {
+    return bits == 8 ? (unsigned char)value : (bits == 16 ? (unsigned short)value : (bits == 32 ? (uint32_t)value : (uint64_t)value));
+  }
+
+  /* the next argument as a number, whatever it was recorded as */
+  static int64_t nextInt(const uint8_t*& args, const uint8_t* end) {
+    if (args >= end) {
+      return 0;
+    }
+    char tag = (char)*args;
+    if (tag == LogBuffer::TAG_STRING) {
+      nextString(args, end);
+      return 0;
+    }
+    int64_t value = 0;
+    double real = 0;
+    if (tag == LogBuffer::TAG_DOUBLE) {
+      memcpy(&real, args + 1, 8);
+      value = (int64_t)real;
+    } else {
+      memcpy(&value, args + 1, 8);
+    }
+    args += 9;
+    return value;
+  }
+
+  static double nextDouble(const uint8_t*& args, const uint8_t* end) {
+    if (args >= end || (char)*args != LogBuffer::TAG_DOUBLE) {
+      return (double)nextInt(args, end);
+    }
+    double value;
+    memcpy(&value, args + 1, 8);
+    args += 9;
+    return value;
+  }
+
+  static std::string nextString(const uint8_t*& args, const uint8_t* end) {
+    if (args >= end || (char)*args != LogBuffer::TAG_STRING) {
+      nextInt(args, end);
+      return "(?)";
+    }
+    uint32_t length;
+    memcpy(&length, args + 1, 4);
+    std::string text((const char*)args + 5, length);
+    args += 5 + length;
+    return text;
+  }
+
+  static std::mutex mutex_;
+  static std::vector<std::shared_ptr<LogBuffer> > buffers_;
+  static uint64_t gone_dropped_;  // of buffers already removed
+};
+
+/* the hot path of tinyros_blog_*: a level check and a copy of the arguments */
+template<typename... Args>
+inline void logBinary(const LogSite& site, const Args&... args)
+{
+  if (site.level < logLevel()) {
+    return;
+  }
+  BinaryLog::local()->write(&site, args...);
+}
+
+}
+
+#endif
@@ -0,0 +1,125 @@
+#ifndef TINYROS_LOG_RING_H_
+#define TINYROS_LOG_RING_H_
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+namespace tinyros
+{
+/*
+ * Log records on their way to tinyrosdds. Any thread pushes without
+ * locking, allocating or a system call (bounded multi-producer queue,
+ * Vyukov, with a sequence number per slot); when the ring is full the
+ * record is dropped and counted instead, so logging never waits. Only
+ * the log thread of NodeHandle reads, through front() and pop(). A
+ * record longer than a slot takes as many consecutive ones as it needs.
+ */
+class LogRing
+{
+public:
+  // CAPACITY is a power of two; longer messages are cut at MAX_LENGTH
+  enum { CAPACITY = 512, SLOT_SIZE = 496, MAX_LENGTH = 4096 };
+
+  struct Record
+  {
+    uint8_t level;
+    uint32_t length;
+    const char* text;
+  };
+
+  LogRing() : head_(0), tail_(0), dropped_(0) {
+    for (size_t i = 0; i < CAPACITY; i++) {
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  bool push(uint8_t level, const char* text, uint32_t length) {
+    if (length > (uint32_t)MAX_LENGTH) {
+      length = MAX_LENGTH;
+    }
+    /* the slots are freed in order, so the last one free means all are */
+    size_t count = slots(length);
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot* last = &slots_[(pos + count - 1) & (CAPACITY - 1)];
+      size_t sequence = last->sequence.load(std::memory_order_acquire);
+      intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + count - 1);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + count, std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+    /* the first slot is published last, front() then finds the rest written */
+    for (size_t i = count; i-- > 0; ) {
+      Slot* slot = &slots_[(pos + i) & (CAPACITY - 1)];
+      uint32_t offset = (uint32_t)i * SLOT_SIZE;
+      uint32_t part = length - offset < (uint32_t)SLOT_SIZE ? length - offset : (uint32_t)SLOT_SIZE;
+      slot->level = level;
+      slot->length = length;
+      memcpy(slot->text, text + offset, part);
+      slot->sequence.store(pos + i + 1, std::memory_order_release);
+    }
+    return true;
+  }
+
+  /* the oldest record, NULL if there is none; valid until pop() */
+  const Record* front() {
+    Slot* slot = &slots_[head_ & (CAPACITY - 1)];
+    if (slot->sequence.load(std::memory_order_acquire) != head_ + 1) {
+      return NULL;
+    }
+    front_.level = slot->level;
+    front_.length = slot->length;
+    front_.text = slot->text;
+    if (slot->length > (uint32_t)SLOT_SIZE) {
+      for (size_t i = 0, count = slots(slot->length); i < count; i++) {
+        uint32_t offset = (uint32_t)i * SLOT_SIZE;
+        uint32_t part = slot->length - offset < (uint32_t)SLOT_SIZE ? slot->length - offset : (uint32_t)SLOT_SIZE;
+        memcpy(joined_ + offset, slots_[(head_ + i) & (CAPACITY - 1)].text, part);
+      }
+      front_.text = joined_;
+    }
+    return &front_;
+  }
+
+  void pop() {
+    size_t count = slots(slots_[head_ & (CAPACITY - 1)].length);
+    for (size_t i = 0; i < count; i++) {
+      slots_[(head_ + i) & (CAPACITY - 1)].sequence.store(head_ + i + CAPACITY, std::memory_order_release);
+    }
+    head_ += count;
+  }
+
+  /* records dropped because the ring was full */
+  uint64_t getDropped() { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    uint8_t level;
+    uint32_t length;  // of the whole record, in every slot of it
+    char text[SLOT_SIZE];
+  };
+
+  static size_t slots(uint32_t length) {
+    return length > (uint32_t)SLOT_SIZE ? (length + SLOT_SIZE - 1) / SLOT_SIZE : 1;
+  }
+
+  Slot slots_[CAPACITY];
+  size_t head_;  // log thread only
+  Record front_;  // log thread only
+  char joined_[MAX_LENGTH];  // log thread only, a record of several slots
+  std::atomic<size_t> tail_;
+  std::atomic<uint64_t> dropped_;
+};
+
+}
+
+#endif
@@ -4,6 +4,7 @@
 #include "tiny_ros/tinyros_msgs/TopicInfo.h"
 #include "tiny_ros/ros/node_handle_base.h"
 #include "tiny_ros/ros/log.h"
+#include "tiny_ros/ros/msg_view.h"
 
 namespace tinyros
 {
@@ -17,12 +18,25 @@ public:
     msg_(msg),
     nh_(NULL),
     negotiated_(false),
+    frame_size_(0),
     endpoint_(endpoint) { }
 
-  int publish(const Msg * msg, bool islog = false)
+  /* Publishers of fixed size messages get their frames pooled when advertised */
+  template<typename MsgT>
+  Publisher(std::string topic_name, MsgT * msg, int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_PUBLISHER) :
+    topic_(topic_name),
+    msg_(msg),
+    nh_(NULL),
+    negotiated_(false),
+    frame_size_(frameSize<MsgT>(typename is_fixed_size<MsgT>::type())),
+    endpoint_(endpoint) { }
+
+  /* Fixed size messages take NodeHandleBase_::publishFixed */
+  template<typename MsgT>
+  int publish(const MsgT * msg, bool islog = false)
   {
     if (nh_ != NULL) {
-      return nh_->publish(id_, msg, islog);
+      return publish(msg, islog, typename is_fixed_size<MsgT>::type());
     } else {
       tinyros_log_error("%s topic_name: %s, nh is NULL, please advertise.", __FUNCTION__, topic_.c_str());
       return -1;
@@ -48,10 +62,95 @@ public:
   // negotiated_ is set by NodeHandle when we negotiateTopics
   bool negotiated_;
 
+  // serialized size of the message when it is constant, else 0
+  int frame_size_;
+
+  // what NodeHandle negotiates the topic with, kept to renegotiate it without allocating
+  tinyros::tinyros_msgs::TopicInfo topic_info_;
+
 private:
+  template<typename MsgT>
+  int publish(const MsgT * msg, bool islog, std::true_type)
+  {
+    return nh_->publishFixed(id_, msg, islog);
+  }
+
+  int publish(const Msg * msg, bool islog, std::false_type)
+  {
+    return nh_->publish(id_, msg, islog);
+  }
+
+  template<typename MsgT>
+  static int frameSize(std::true_type) { return MsgT::kSerializedSize; }
+  template<typename MsgT>
+  static int frameSize(std::false_type) { return 0; }
+
   int endpoint_;
 };
 
+/* Serialized bytes sent as they are, under the type and md5 given */
+class RawMessage : public Msg
+{
+public:
+  RawMessage(const uint8_t* data = NULL, uint32_t length = 0, std::string type = "", std::string md5 = "") :
+    data_(data),
+    length_(length),
+    type_(type),
+    md5_(md5) {}
+
+  virtual int serialize(unsigned char* outbuffer) const
+  {
+    if (length_ > 0) {
+      memcpy(outbuffer, data_, length_);
+    }
+    return length_;
+  }
+  virtual int deserialize(unsigned char*) { return 0; }
+  virtual int serializedLength() const { return length_; }
+  virtual void echo(Writer&) const {}
+  virtual std::string echo() { return ""; }
+  virtual std::string getType() { return type_; }
+  virtual std::string getMD5() { return md5_; }
+
+private:
+  const uint8_t* data_;
+  uint32_t length_;
+  std::string type_;
+  std::string md5_;
+};
+
+/*
+ * Publisher of any message type: forwards payloads that are already
+ * serialized, such as those of a RawSubscriber or a bag, without decoding
+ * them into a message first.
+ */
+class RawPublisher : public Publisher
+{
+public:
+  RawPublisher(std::string topic_name, std::string type, std::string md5,
+      int endpoint = tinyros::tinyros_msgs::TopicInfo::ID_PUBLISHER) :
+    Publisher(topic_name, (Msg*)&type_msg_, endpoint),
+    type_msg_(NULL, 0, type, md5) { }
+
+  int publish(const uint8_t* data, uint32_t length, bool islog = false)
+  {
+    if (nh_ == NULL) {
+      tinyros_log_error("%s topic_name: %s, nh is NULL, please advertise.", __FUNCTION__, topic_.c_str());
+      return -1;
+    }
+    RawMessage msg(data, length);
+    return nh_->publish(id_, &msg, islog);
+  }
+
+  int publish(const Span<uint8_t>& payload, bool islog = false)
+  {
+    return publish(payload.data(), payload.size(), islog);
+  }
+
+private:
+  RawMessage type_msg_;  // type and md5 to negotiate with
+};
+
 }
 
 #endif
@@ -0,0 +1,254 @@
+#ifndef TINYROS_SEND_QUEUE_H_
+#define TINYROS_SEND_QUEUE_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <condition_variable>
+#include "tiny_ros/ros/trace.h"
+#include "tiny_ros/ros/buffer_pool.h"
+
+namespace tinyros
+{
+/* A serialized frame on its way from a publisher to the writer thread */
+class SendFrame
+{
+public:
+  std::atomic<SendFrame*> next_;
+  uint8_t* buffer_;
+  int capacity_;
+  int size_class_;
+  int length_;
+  bool islog_;
+  bool time_sync_; // an ID_TIME frame, its send time is stamped when written
+  int64_t enqueue_ns_;
+
+  SendFrame(int capacity, int size_class)
+    : next_(NULL)
+    , buffer_(NULL)
+    , capacity_(capacity)
+    , size_class_(size_class)
+    , length_(0)
+    , islog_(false)
+    , time_sync_(false)
+    , enqueue_ns_(0) {
+    if (capacity_ > 0) {
+      buffer_ = (uint8_t*)malloc(capacity_);
+    }
+  }
+
+  ~SendFrame() {
+    if (buffer_) free(buffer_);
+  }
+};
+
+typedef BufferPool<SendFrame> SendFramePool;
+
+/*
+ * Intrusive multi-producer single-consumer queue (Vyukov). push is a
+ * single atomic exchange; only the writer thread pops. When the queue
+ * holds capacity frames, publishers either wait for room (POLICY_BLOCK)
+ * or the frame is dropped and counted (POLICY_DROP).
+ */
+class SendQueue
+{
+public:
+  enum Policy { POLICY_BLOCK = 0, POLICY_DROP = 1 };
+
+  SendQueue(int capacity = 1024, Policy policy = POLICY_BLOCK)
+    : head_(&stub_)
+    , tail_(&stub_)
+    , stub_(0, -1)
+    , size_(0)
+    , capacity_(capacity)
+    , policy_(policy)
+    , started_(true)
+    , consumer_waiting_(false)
+    , producers_waiting_(0)
+    , enqueued_(0)
+    , dropped_(0)
+    , written_(0)
+    , failed_(0) {
+  }
+
+  static int64_t now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  }
+
+  void setPolicy(Policy policy) { policy_ = policy; }
+  Policy getPolicy() { return policy_; }
+  void setCapacity(int capacity) { capacity_ = capacity > 0 ? capacity : 1; }
+  int getCapacity() { return capacity_; }
+  int size() { return size_.load(); }
+
+  /* false if the frame was not queued, the caller still owns it */
+  bool push(SendFrame* frame) {
+    while (started_) {
+      if (size_.fetch_add(1) < capacity_) {
+        frame->enqueue_ns_ = now();
+        link(frame);
+        enqueued_++;
+        if (consumer_waiting_.load()) {
+          std::unique_lock<std::mutex> lock(mutex_);
+          consumer_cond_.notify_one();
+        }
+        return true;
+      }
+      size_.fetch_sub(1);
+      if (policy_ == POLICY_DROP) {
+        dropped_++;
+        return false;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      producers_waiting_++;
+      while (started_ && size_.load() >= capacity_) {
+        producer_cond_.wait_for(lock, std::chrono::milliseconds(100));
+      }
+      producers_waiting_--;
+    }
+    return false;
+  }
+
+  /* writer thread only, NULL on timeout or shutdown with an empty queue */
+  SendFrame* pop(int timeout_ms) {
+    std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while (true) {
+      SendFrame* frame = unlink();
+      if (frame) {
+        size_.fetch_sub(1);
+        if (producers_waiting_ > 0) {
+          std::unique_lock<std::mutex> lock(mutex_);
+          producer_cond_.notify_all();
+        }
+        return frame;
+      }
+      if (size_.load() > 0) {
+        /* a producer reserved a slot and is linking its frame */
+        std::this_thread::yield();
+        continue;
+      }
+      if (!started_) {
+        return NULL;
+      }
+      std::unique_lock<std::mutex> lock(mutex_);
+      consumer_waiting_.store(true);
+      if (size_.load() == 0 && started_) {
+        if (consumer_cond_.wait_until(lock, deadline) == std::cv_status::timeout) {
+          consumer_waiting_.store(false);
+          return NULL;
+        }
+      }
+      consumer_waiting_.store(false);
+    }
+  }
+
+  void shutdown() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    started_ = false;
+    consumer_cond_.notify_all();
+    producer_cond_.notify_all();
+  }
+
+  bool started() { return started_; }
+
+  /* serialize + enqueue time of a publish call */
+  void recordPublish(int64_t start_ns) {
+    publish_latency_.record((now() - start_ns) / 1000);
+  }
+
+  /* enqueue -> socket write time of a frame */
+  void recordWrite(SendFrame* frame, bool ok) {
+    if (ok) {
+      written_++;
+      queue_latency_.record((now() - frame->enqueue_ns_) / 1000);
+    } else {
+      failed_++;
+    }
+  }
+
+  uint64_t getDropped() { return dropped_.load(); }
+
+  std::string report() {
+    char buffer[256];
+    snprintf(buffer, sizeof(buffer), "enqueued: %llu, written: %llu, failed: %llu, dropped: %llu, queued: %d\n",
+      (unsigned long long)enqueued_.load(), (unsigned long long)written_.load(),
+      (unsigned long long)failed_.load(), (unsigned long long)dropped_.load(), size_.load());
+    return std::string(buffer)
+      + "  publish: " + publish_latency_.summary() + "\n"
+      + "  send queue: " + queue_latency_.summary() + "\n";
+  }
+
+  void resetStats() {
+    enqueued_ = 0;
+    dropped_ = 0;
+    written_ = 0;
+    failed_ = 0;
+    publish_latency_.reset();
+    queue_latency_.reset();
+  }
+
+private:
+  void link(SendFrame* frame) {
+    frame->next_.store(NULL, std::memory_order_relaxed);
+    SendFrame* prev = head_.exchange(frame, std::memory_order_acq_rel);
+    prev->next_.store(frame, std::memory_order_release);
+  }
+
+  SendFrame* unlink() {
+    SendFrame* tail = tail_;
+    SendFrame* next = tail->next_.load(std::memory_order_acquire);
+    if (tail == &stub_) {
+      if (next == NULL) {
+        return NULL;
+      }
+      tail_ = next;
+      tail = next;
+      next = next->next_.load(std::memory_order_acquire);
+    }
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    if (tail != head_.load(std::memory_order_acquire)) {
+      return NULL;
+    }
+    link(&stub_);
+    next = tail->next_.load(std::memory_order_acquire);
+    if (next) {
+      tail_ = next;
+      return tail;
+    }
+    return NULL;
+  }
+
+  std::atomic<SendFrame*> head_;
+  SendFrame* tail_;
+  SendFrame stub_;
+  std::atomic<int> size_;
+  int capacity_;
+  Policy policy_;
+  std::atomic<bool> started_;
+
+  std::mutex mutex_;
+  std::condition_variable consumer_cond_;
+  std::condition_variable producer_cond_;
+  std::atomic<bool> consumer_waiting_;
+  std::atomic<int> producers_waiting_;
+
+  std::atomic<uint64_t> enqueued_;
+  std::atomic<uint64_t> dropped_;
+  std::atomic<uint64_t> written_;
+  std::atomic<uint64_t> failed_;
+  LatencyHistogram publish_latency_;
+  LatencyHistogram queue_latency_;
+};
+
+}
+
+#endif
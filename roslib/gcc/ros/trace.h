@@ -0,0 +1,242 @@
+#ifndef TINYROS_TRACE_H_
+#define TINYROS_TRACE_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <map>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <string>
+#include "tiny_ros/ros/time.h"
+
+namespace tinyros
+{
+/*
+ * Trace trailer appended to the payload of a traced message:
+ *
+ *   uint32 body_length   payload length without the trailer
+ *   uint64 publish       stamped by NodeHandle::publish
+ *   uint64 dds_recv      stamped by tinyrosdds when the frame is read
+ *   uint64 dds_enqueue   stamped by tinyrosdds in Session::write_message_stream
+ *   uint64 dds_dequeue   stamped by tinyrosdds in Session::write_completion_cb
+ *   uint32 magic
+ *
+ * All stamps are nanoseconds of the dds synchronized clock. Message
+ * deserializers read their fields by offset, so subscribers that know
+ * nothing about tracing simply ignore the trailer.
+ */
+const uint32_t TRACE_MAGIC = 0x45435254; // "TRCE"
+const int TRACE_SIZE = 40; // bytes
+
+enum TraceHop {
+  TRACE_PUBLISH = 0,
+  TRACE_DDS_RECV = 1,
+  TRACE_DDS_ENQUEUE = 2,
+  TRACE_DDS_DEQUEUE = 3,
+  TRACE_SUB_RECV = 4,
+  TRACE_SPIN_START = 5,
+  TRACE_SPIN_END = 6,
+  TRACE_STAMPS = 7
+};
+
+class Trace
+{
+public:
+  static uint64_t toNSec(const Time& t) {
+    return (uint64_t)t.sec * 1000000000ull + (uint64_t)t.nsec;
+  }
+
+  /* dds synchronized clock of the client library */
+  static uint64_t stamp() {
+    return toNSec(Time::dds());
+  }
+
+  static void putStamp(uint8_t* trailer, int hop, uint64_t ns) {
+    uint8_t* p = trailer + 4 + hop * 8;
+    for (int i = 0; i < 8; i++) {
+      p[i] = (uint8_t)((ns >> (8 * i)) & 0xFF);
+    }
+  }
+
+  static uint64_t getStamp(const uint8_t* trailer, int hop) {
+    const uint8_t* p = trailer + 4 + hop * 8;
+    uint64_t ns = 0;
+    for (int i = 0; i < 8; i++) {
+      ns |= ((uint64_t)p[i]) << (8 * i);
+    }
+    return ns;
+  }
+
+  /* Write a trailer behind a serialized body, returns TRACE_SIZE */
+  static int append(uint8_t* body, uint32_t body_length, uint64_t publish_ns) {
+    uint8_t* trailer = body + body_length;
+    memset(trailer, 0, TRACE_SIZE);
+    for (int i = 0; i < 4; i++) {
+      trailer[i] = (uint8_t)((body_length >> (8 * i)) & 0xFF);
+      trailer[36 + i] = (uint8_t)((TRACE_MAGIC >> (8 * i)) & 0xFF);
+    }
+    putStamp(trailer, TRACE_PUBLISH, publish_ns);
+    return TRACE_SIZE;
+  }
+
+  /* Locate the trailer of a payload, NULL if the message is not traced */
+  static const uint8_t* find(const uint8_t* payload, uint32_t length) {
+    if (payload == NULL || length < (uint32_t)TRACE_SIZE) {
+      return NULL;
+    }
+    const uint8_t* trailer = payload + length - TRACE_SIZE;
+    uint32_t body_length = 0, magic = 0;
+    for (int i = 0; i < 4; i++) {
+      body_length |= ((uint32_t)trailer[i]) << (8 * i);
+      magic |= ((uint32_t)trailer[36 + i]) << (8 * i);
+    }
+    if (magic != TRACE_MAGIC || body_length != length - TRACE_SIZE) {
+      return NULL;
+    }
+    return trailer;
+  }
+};
+
+/* log2 bucketed latency histogram in microseconds, safe to record from any thread */
+class LatencyHistogram
+{
+public:
+  enum { BUCKETS = 32 };
+
+  LatencyHistogram() { reset(); }
+
+  void reset() {
+    count_ = 0;
+    sum_ = 0;
+    min_ = INT64_MAX;
+    max_ = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+      buckets_[b] = 0;
+    }
+  }
+
+  void record(int64_t us) {
+    if (us < 0) us = 0;
+    int b = 0;
+    while (b < BUCKETS - 1 && ((int64_t)1 << b) <= us) b++;
+    int64_t v = min_.load(std::memory_order_relaxed);
+    while (us < v && !min_.compare_exchange_weak(v, us, std::memory_order_relaxed)) {}
+    v = max_.load(std::memory_order_relaxed);
+    while (us > v && !max_.compare_exchange_weak(v, us, std::memory_order_relaxed)) {}
+    sum_.fetch_add(us, std::memory_order_relaxed);
+    buckets_[b].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  uint64_t count() {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  /* upper bound of the bucket holding the given percentile (0-100) */
+  int64_t percentile(double p) {
+    uint64_t count = 0, buckets[BUCKETS];
+    for (int b = 0; b < BUCKETS; b++) {
+      buckets[b] = buckets_[b].load(std::memory_order_relaxed);
+      count += buckets[b];
+    }
+    int64_t max = max_.load(std::memory_order_relaxed);
+    if (count == 0) return 0;
+    uint64_t rank = (uint64_t)((p / 100.0) * count);
+    if (rank >= count) rank = count - 1;
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+      seen += buckets[b];
+      if (seen > rank) {
+        int64_t upper = (b == 0) ? 0 : ((int64_t)1 << b) - 1;
+        return upper < max ? upper : max;
+      }
+    }
+    return max;
+  }
+
+  std::string summary() {
+    uint64_t count = count_.load(std::memory_order_relaxed);
+    char buffer[256];
+    if (count == 0) {
+      snprintf(buffer, sizeof(buffer), "count: 0");
+    } else {
+      snprintf(buffer, sizeof(buffer), "count: %llu, mean: %.3f(ms), min: %.3f(ms), max: %.3f(ms), p50: %.3f(ms), p99: %.3f(ms)",
+        (unsigned long long)count, (double)sum_.load() / count / 1000.0, min_.load() / 1000.0, max_.load() / 1000.0,
+        percentile(50) / 1000.0, percentile(99) / 1000.0);
+    }
+    return std::string(buffer);
+  }
+
+private:
+  std::atomic<uint64_t> count_;
+  std::atomic<int64_t> sum_;
+  std::atomic<int64_t> min_;
+  std::atomic<int64_t> max_;
+  std::atomic<uint64_t> buckets_[BUCKETS];
+};
+
+/* Aggregated per-hop latencies of one topic */
+class TraceStats
+{
+public:
+  enum Segment {
+    SEG_PUB_TO_DDS = 0,   // publish -> dds recv
+    SEG_DDS_QUEUE = 1,    // dds enqueue -> dds dequeue
+    SEG_DDS_TO_SUB = 2,   // dds dequeue -> subscriber recv
+    SEG_SUB_QUEUE = 3,    // subscriber recv -> spin_task start
+    SEG_CALLBACK = 4,     // spin_task start -> spin_task end
+    SEG_END_TO_END = 5,   // publish -> spin_task end
+    SEGMENTS = 6
+  };
+
+  static const char* name(int segment) {
+    static const char* names[SEGMENTS] = {
+      "publish->dds", "dds queue", "dds->subscriber", "subscriber queue", "callback", "end-to-end"
+    };
+    return names[segment];
+  }
+
+  void record(int segment, uint64_t from_ns, uint64_t to_ns) {
+    if (from_ns == 0 || to_ns == 0) return;
+    histograms_[segment].record(((int64_t)to_ns - (int64_t)from_ns) / 1000);
+  }
+
+  /* stamps indexed by TraceHop */
+  void record(const uint64_t* stamps) {
+    record(SEG_PUB_TO_DDS, stamps[TRACE_PUBLISH], stamps[TRACE_DDS_RECV]);
+    record(SEG_DDS_QUEUE, stamps[TRACE_DDS_ENQUEUE], stamps[TRACE_DDS_DEQUEUE]);
+    record(SEG_DDS_TO_SUB, stamps[TRACE_DDS_DEQUEUE], stamps[TRACE_SUB_RECV]);
+    record(SEG_SUB_QUEUE, stamps[TRACE_SUB_RECV], stamps[TRACE_SPIN_START]);
+    record(SEG_CALLBACK, stamps[TRACE_SPIN_START], stamps[TRACE_SPIN_END]);
+    record(SEG_END_TO_END, stamps[TRACE_PUBLISH], stamps[TRACE_SPIN_END]);
+  }
+
+  LatencyHistogram& histogram(int segment) {
+    return histograms_[segment];
+  }
+
+  std::string report() {
+    std::string out;
+    for (int i = 0; i < SEGMENTS; i++) {
+      if (histograms_[i].count() > 0) {
+        out += std::string("  ") + name(i) + ": " + histograms_[i].summary() + "\n";
+      }
+    }
+    return out;
+  }
+
+  void reset() {
+    for (int i = 0; i < SEGMENTS; i++) {
+      histograms_[i].reset();
+    }
+  }
+
+private:
+  LatencyHistogram histograms_[SEGMENTS];
+};
+typedef std::shared_ptr<TraceStats> TraceStatsPtr;
+
+}
+
+#endif
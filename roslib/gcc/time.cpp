@@ -5,18 +5,22 @@
   #include <windows.h>
   #include <sys/timeb.h>
 #else
-  #include <sys/time.h>
+  #include <time.h>
 #endif
 
 namespace tinyros
 {
 std::mutex Time::mutex_;
 
-int64_t Time::time_start_ = 0;
+std::atomic<uint32_t> Time::dds_seq_(0);
+
+std::atomic<int64_t> Time::time_start_(0);
 
 int64_t Time::time_last_ = 0;
 
-int64_t Time::time_dds_ = 0;
+std::atomic<int64_t> Time::time_dds_(0);
+
+std::atomic<int64_t> Time::time_drift_(0);
 
 void normalizeSecNSec(uint32_t& sec, uint32_t& nsec)
 {
@@ -67,34 +71,70 @@ Time& Time::operator -=(const Duration &rhs)
   return *this;
 }
 
+static int64_t timeToNSec(const Time& time)
+{
+  return (int64_t)time.sec * 1000000000LL + (int64_t)time.nsec;
+}
+
+static Time nsecToTime(int64_t ns)
+{
+  return Time((uint32_t)(ns / 1000000000LL), (uint32_t)(ns % 1000000000LL));
+}
+
+void Time::setDDS(const Time& dds, const Time& start, int64_t drift)
+{
+  uint32_t seq = Time::dds_seq_.load(std::memory_order_relaxed);
+  Time::dds_seq_.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Time::time_dds_.store(timeToNSec(dds), std::memory_order_relaxed);
+  Time::time_start_.store(timeToNSec(start), std::memory_order_relaxed);
+  Time::time_drift_.store(drift, std::memory_order_relaxed);
+  Time::dds_seq_.store(seq + 2, std::memory_order_release);
+}
+
 Time Time::dds() {
-  std::unique_lock<std::mutex> lock(Time::mutex_);
-  Time time = Time::now();
-  int64_t offset = (int64_t)(time.toMSec());
-  offset = offset > Time::time_start_ && Time::time_start_ > 0 ? offset - Time::time_start_ : 0;
-  time.sec = (uint32_t)(offset / 1000);
-  time.nsec = (uint32_t)((offset % 1000) * 1000000);
-  time.sec += (uint32_t)(Time::time_dds_ / 1000);
-  time.nsec += (uint32_t)((Time::time_dds_ % 1000) * 1000000);
-  normalizeSecNSec(time.sec, time.nsec);
-  return time;
+  int64_t start, dds, drift;
+  uint32_t seq;
+  do {
+    seq = Time::dds_seq_.load(std::memory_order_acquire);
+    start = Time::time_start_.load(std::memory_order_relaxed);
+    dds = Time::time_dds_.load(std::memory_order_relaxed);
+    drift = Time::time_drift_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+  } while ((seq & 1) || seq != Time::dds_seq_.load(std::memory_order_relaxed));
+  int64_t offset = timeToNSec(Time::monotonic()) - start;
+  offset = offset > 0 && start > 0 ? offset : 0;
+  return nsecToTime(dds + offset + (int64_t)((double)offset * (double)drift * 1e-9));
+}
+
+Time Time::monotonic()
+{
+#ifndef WIN32
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return Time((uint32_t)now.tv_sec, (uint32_t)now.tv_nsec);
+#else
+  static LARGE_INTEGER cpu_freq = { 0 };
+  if (cpu_freq.QuadPart == 0) {
+    QueryPerformanceFrequency(&cpu_freq);
+  }
+  LARGE_INTEGER now;
+  QueryPerformanceCounter(&now);
+  int64_t sec = now.QuadPart / cpu_freq.QuadPart;
+  int64_t nsec = (now.QuadPart % cpu_freq.QuadPart) * 1000000000LL / cpu_freq.QuadPart;
+  return Time((uint32_t)sec, (uint32_t)nsec);
+#endif
 }
 
 Time Time::now()
 {
   Time time;
 #ifndef WIN32
-#if HAS_CLOCK_GETTIME
+    // vDSO, no system call
     timespec start;
     clock_gettime(CLOCK_REALTIME, &start);
     time.sec  = start.tv_sec;
     time.nsec = start.tv_nsec;
-#else
-    struct timeval timeofday;
-    gettimeofday(&timeofday,NULL);
-    time.sec  = timeofday.tv_sec;
-    time.nsec = timeofday.tv_usec * 1000;
-#endif
 #else
     static LARGE_INTEGER cpu_freq, init_cpu_time;
     static uint32_t start_sec = 0;
@@ -3,7 +3,10 @@
 from __future__ import print_function
 
 __usage__ = """
-python make_library.py <output_path>
+python make_library_gcc.py <build_path> <output_path> <source_path> [--arrays=pointer|vector]
+
+  --arrays=vector  generate std::vector / std::array fields instead of
+                   raw pointer + _length arrays
 """
 import traceback
 
@@ -125,28 +128,32 @@ class PrimitiveDataType:
     def serializedLength(self, f, header):
         f.write('%s      length += sizeof(this->%s);\n' % (header, self.name))
 
-    def echo(self, f, header, trailer):
-        if self.name.find('[') > 0:
-            cn = self.name.replace("[","").replace("]","").split(".")[-1]
-            if self.type == 'int8_t':
-                f.write('%s      std::stringstream ss_%s; ss_%s <<(int16_t)%s <<"%s";\n' % (header, cn, cn, self.name, trailer))
-            elif self.type == 'uint8_t':
-                f.write('%s      std::stringstream ss_%s; ss_%s << (uint16_t)%s <<"%s";\n' % (header, cn, cn, self.name, trailer))
-            elif self.type == 'char':
-                f.write('%s      std::stringstream ss_%s; ss_%s << (int16_t)%s <<"%s";\n' % (header, cn, cn, self.name, trailer))
-            else:
-                f.write('%s      std::stringstream ss_%s; ss_%s << %s <<"%s";\n' % (header, cn, cn, self.name, trailer))
-            f.write('%s      string_echo += ss_%s.str();\n' % (header, cn))
-        else:
-            if self.type == 'int8_t':
-                f.write('%s      std::stringstream ss_%s; ss_%s << "\\"%s\\":" << (int16_t)%s <<"%s";\n' % (header, self.name, self.name, self.name, self.name, trailer))
-            elif self.type == 'uint8_t':
-                f.write('%s      std::stringstream ss_%s; ss_%s << "\\"%s\\":" << (uint16_t)%s <<"%s";\n' % (header, self.name, self.name, self.name, self.name, trailer))
-            elif self.type == 'char':
-                f.write('%s      std::stringstream ss_%s; ss_%s << "\\"%s\\":" << (int16_t)%s <<"%s";\n' % (header, self.name, self.name, self.name, self.name, trailer))
-            else:
-                f.write('%s      std::stringstream ss_%s; ss_%s << "\\"%s\\":" << %s <<"%s";\n' % (header, self.name, self.name, self.name, self.name, trailer))
-            f.write('%s      string_echo += ss_%s.str();\n' % (header, self.name)) 
+    def echo(self, f):
+        f.write('      writer.key("%s");\n' % self.name)
+        f.write('      writer.value(this->%s);\n' % self.name)
+
+    # serialized size when it is constant, else None
+    def wire_size(self):
+        return self.bytes
+
+    # codecs of fixed size messages, the field is at a constant offset
+    def fixed_serialize(self, f, offset):
+        f.write('      arrayToArr(outbuffer + %s, &this->%s, 1);\n' % (offset, self.name))
+
+    def fixed_deserialize(self, f, offset):
+        f.write('      arrToArray(&this->%s, inbuffer + %s, 1);\n' % (self.name, offset))
+
+    # views: accessor type, accessor expression for the field at p,
+    # serialized length at p
+
+    def view_type(self):
+        return self.type
+
+    def view_get(self, p):
+        return 'tinyros::viewRead<%s>(%s)' % (self.type, p)
+
+    def view_skip(self, p):
+        return '%d' % self.wire_size()
 
 class MessageDataType(PrimitiveDataType):
     """ For when our data type is another message. """
@@ -163,14 +170,25 @@ class MessageDataType(PrimitiveDataType):
     def serializedLength(self, f, header):
         f.write('%s      length += this->%s.serializedLength();\n' % (header, self.name))
 
-    def echo(self, f, header, trailer):
-        if self.name.find('[') > 0:
-            f.write('%s      string_echo += this->%s.echo();\n' % (header, self.name))
-            f.write('%s      string_echo += "%s";\n' % (header, trailer))
-        else:
-            f.write('%s      string_echo += "\\"%s\\":";\n' % (header, self.name))
-            f.write('%s      string_echo += this->%s.echo();\n' % (header, self.name))
-            f.write('%s      string_echo += "%s";\n' % (header, trailer))
+    def wire_size(self):
+        if self.type not in MESSAGES:
+            return None
+        return MESSAGES[self.type].wire_size()
+
+    def fixed_serialize(self, f, offset):
+        f.write('      this->%s.serialize(outbuffer + %s);\n' % (self.name, offset))
+
+    def fixed_deserialize(self, f, offset):
+        f.write('      this->%s.deserialize(inbuffer + %s);\n' % (self.name, offset))
+
+    def view_type(self):
+        return self.type + 'View'
+
+    def view_get(self, p):
+        return '%s(%s)' % (self.view_type(), p)
+
+    def view_skip(self, p):
+        return '%s(%s).serializedLength()' % (self.view_type(), p)
 
 class StringDataType(PrimitiveDataType):
     def make_initializer(self, f, trailer):
@@ -205,27 +223,17 @@ class StringDataType(PrimitiveDataType):
         f.write('%s      length += 4;\n' % header)
         f.write('%s      length += length_%s;\n' % (header, cn))
 
-    def echo(self, f, header, trailer):
-        if self.name.find('[') > 0:
-            cn = self.name.replace("[","").replace("]","").split(".")[-1]
-            f.write('%s      std::stringstream ss_%s; ss_%s << "\\"";\n' % (header, cn, cn))
-            f.write('%s      string_echo += ss_%s.str();\n' % (header, cn))
-            f.write('%s      std::size_t %s_pos = %s.find("\\"");\n' % (header, cn, self.name))
-            f.write('%s      while(%s_pos != std::string::npos){\n' % (header, cn))
-            f.write('%s        %s.replace(%s_pos, 1,"\\\\\\"");\n' % (header, self.name, cn))
-            f.write('%s        %s_pos = %s.find("\\"", %s_pos+2);\n' % (header, cn, self.name, cn))
-            f.write('%s      }\n' % header)
-            f.write('%s      string_echo += %s;\n' % (header, self.name))
-            f.write('%s      string_echo += "\\"%s";\n' % (header, trailer))
-        else:
-            f.write('%s      std::size_t %s_pos = %s.find("\\"");\n' % (header, self.name, self.name))
-            f.write('%s      while(%s_pos != std::string::npos){\n' % (header, self.name))
-            f.write('%s        %s.replace(%s_pos, 1,"\\\\\\"");\n' % (header, self.name, self.name))
-            f.write('%s        %s_pos = %s.find("\\"", %s_pos+2);\n' % (header, self.name, self.name, self.name))
-            f.write('%s      }\n' % header)
-            f.write('%s      string_echo += "\\"%s\\":\\"";\n' % (header, self.name))
-            f.write('%s      string_echo += %s;\n' % (header, self.name))
-            f.write('%s      string_echo += "\\"%s";\n' % (header, trailer))
+    def wire_size(self):
+        return None
+
+    def view_type(self):
+        return 'tinyros::StringView'
+
+    def view_get(self, p):
+        return 'tinyros::StringView(%s)' % p
+
+    def view_skip(self, p):
+        return 'tinyros::StringView(%s).serializedLength()' % p
 
 class TimeDataType(PrimitiveDataType):
 
@@ -253,18 +261,16 @@ class TimeDataType(PrimitiveDataType):
         self.sec.serializedLength(f, header)
         self.nsec.serializedLength(f, header)
 
-    def echo(self, f, header, trailer):
-        if self.name.find('[') > 0:
-            cn = self.name.replace("[","").replace("]","").split(".")[-1]
-            f.write('%s      std::stringstream ss_%s; ss_%s << "{";\n' % (header, cn, cn))
-            f.write('%s      ss_%s << "\\"sec\\":" << %s.sec;\n' % (header, cn, self.name))
-            f.write('%s      ss_%s << ",\\"nsec\\":" << %s.nsec << "}%s";\n' % (header, cn, self.name, trailer))
-            f.write('%s      string_echo += ss_%s.str();\n' % (header, cn))
-        else:
-            f.write('%s      std::stringstream ss_%s;\n' % (header, self.name))
-            f.write('%s      ss_%s << "\\"%s\\":{\\"sec\\":" << %s.sec;\n' % (header, self.name, self.name, self.name))
-            f.write('%s      ss_%s << ",\\"nsec\\":" << %s.nsec << "}%s";\n' % (header, self.name, self.name, trailer))
-            f.write('%s      string_echo += ss_%s.str();\n' % (header, self.name))
+    def wire_size(self):
+        return 8
+
+    def fixed_serialize(self, f, offset):
+        f.write('      arrayToArr(outbuffer + %s, &this->%s.sec, 1);\n' % (offset, self.name))
+        f.write('      arrayToArr(outbuffer + %s + 4, &this->%s.nsec, 1);\n' % (offset, self.name))
+
+    def fixed_deserialize(self, f, offset):
+        f.write('      arrToArray(&this->%s.sec, inbuffer + %s, 1);\n' % (self.name, offset))
+        f.write('      arrToArray(&this->%s.nsec, inbuffer + %s + 4, 1);\n' % (self.name, offset))
 
 class ArrayDataType(PrimitiveDataType):
 
@@ -290,8 +296,13 @@ class ArrayDataType(PrimitiveDataType):
         else:
             f.write('      %s %s[%d];\n' % (self.type, self.name, self.size))
 
+    def bulk(self):
+        # numeric elements are copied as a block, bool is normalized one by one
+        return self.cls is PrimitiveDataType and self.type != 'bool'
+
     def serialize(self, f, header):
         c = self.cls(self.name+"[i]", self.type, self.bytes)
+        count = '%s_length' % self.name if self.size == None else '%d' % self.size
         if self.size == None:
             # serialize length
             f.write('%s      *(outbuffer + offset + 0) = (this->%s_length >> (8 * 0)) & 0xFF;\n' % (header, self.name))
@@ -299,11 +310,11 @@ class ArrayDataType(PrimitiveDataType):
             f.write('%s      *(outbuffer + offset + 2) = (this->%s_length >> (8 * 2)) & 0xFF;\n' % (header, self.name))
             f.write('%s      *(outbuffer + offset + 3) = (this->%s_length >> (8 * 3)) & 0xFF;\n' % (header, self.name))
             f.write('%s      offset += sizeof(this->%s_length);\n' % (header, self.name))
-            f.write('%s      for( uint32_t i = 0; i < %s_length; i++) {\n' % (header, self.name))
-            c.serialize(f, header + "  ")
-            f.write('%s      }\n' % header)
+        if self.bulk():
+            f.write('%s      arrayToArr(outbuffer + offset, this->%s, %s);\n' % (header, self.name, count))
+            f.write('%s      offset += %s * sizeof(%s);\n' % (header, count, self.type))
         else:
-            f.write('%s      for( uint32_t i = 0; i < %d; i++) {\n' % (header, self.size) )
+            f.write('%s      for( uint32_t i = 0; i < %s; i++) {\n' % (header, count))
             c.serialize(f, header + "  ")
             f.write('%s      }\n' % header)
 
@@ -319,10 +330,17 @@ class ArrayDataType(PrimitiveDataType):
             f.write('%s      if(%s_lengthT > %s_length)\n' % (header, self.name, self.name))
             f.write('%s        this->%s = (%s*)realloc(this->%s, %s_lengthT * sizeof(%s));\n' % (header, self.name, self.type, self.name, self.name, self.type))
             f.write('%s      %s_length = %s_lengthT;\n' % (header, self.name, self.name))
+            if self.bulk():
+                f.write('%s      arrToArray(this->%s, inbuffer + offset, %s_length);\n' % (header, self.name, self.name))
+                f.write('%s      offset += %s_length * sizeof(%s);\n' % (header, self.name, self.type))
+                return
             f.write('%s      for( uint32_t i = 0; i < %s_length; i++) {\n' % (header, self.name))
             c.deserialize(f, header + "  ")
             f.write('%s        memcpy( &(this->%s[i]), &(this->st_%s), sizeof(%s));\n' % (header, self.name, self.name, self.type))
             f.write('%s      }\n' % header)
+        elif self.bulk():
+            f.write('%s      arrToArray(this->%s, inbuffer + offset, %d);\n' % (header, self.name, self.size))
+            f.write('%s      offset += %d * sizeof(%s);\n' % (header, self.size, self.type))
         else:
             c = self.cls(self.name+"[i]", self.type, self.bytes)
             f.write('%s      for( uint32_t i = 0; i < %d; i++){\n' % (header, self.size) )
@@ -331,6 +349,13 @@ class ArrayDataType(PrimitiveDataType):
 
     def serializedLength(self, f, header):
         c = self.cls(self.name+"[i]", self.type, self.bytes)
+        if self.bulk():
+            if self.size == None:
+                f.write('%s      length += sizeof(this->%s_length);\n' % (header, self.name))
+                f.write('%s      length += %s_length * sizeof(%s);\n' % (header, self.name, self.type))
+            else:
+                f.write('%s      length += %d * sizeof(%s);\n' % (header, self.size, self.type))
+            return
         if self.size == None:
             # serialize length
             f.write('%s      length += sizeof(this->%s_length);\n' % (header, self.name))
@@ -342,28 +367,141 @@ class ArrayDataType(PrimitiveDataType):
             c.serializedLength(f, header + "  ")
             f.write('%s      }\n' % header)
 
-    def echo(self, f, header, trailer):
+    def echo(self, f):
+        count = 'this->%s_length' % self.name if self.size == None else '%d' % self.size
+        f.write('      writer.array("%s", %s, %s);\n' % (self.name, self.pointer(), count))
+
+    def wire_element(self):
+        return self.cls(self.name, self.type, self.bytes)
+
+    def pointer(self):
+        return 'this->%s' % self.name
+
+    def fixed_serialize(self, f, offset):
+        if self.bulk():
+            f.write('      arrayToArr(outbuffer + %s, %s, %d);\n' % (offset, self.pointer(), self.size))
+            return
+        c = self.cls(self.name+"[i]", self.type, self.bytes)
+        f.write('      for( uint32_t i = 0; i < %d; i++) {\n' % self.size)
+        c.fixed_serialize(f, '%s + i * %d' % (offset, c.wire_size()))
+        f.write('      }\n')
+
+    def fixed_deserialize(self, f, offset):
+        if self.bulk():
+            f.write('      arrToArray(%s, inbuffer + %s, %d);\n' % (self.pointer(), offset, self.size))
+            return
         c = self.cls(self.name+"[i]", self.type, self.bytes)
+        f.write('      for( uint32_t i = 0; i < %d; i++) {\n' % self.size)
+        c.fixed_deserialize(f, '%s + i * %d' % (offset, c.wire_size()))
+        f.write('      }\n')
+
+    def wire_size(self):
+        size = self.wire_element().wire_size()
+        if size == None or self.size == None:
+            return None
+        return size * self.size
+
+    def view_type(self):
+        # fixed size elements are indexed directly, the others are walked
+        c = self.wire_element()
+        if c.wire_size() != None:
+            return 'tinyros::Span<%s>' % c.view_type()
+        return 'tinyros::ViewList<%s>' % c.view_type()
+
+    def view_get(self, p):
         if self.size == None:
-            f.write('%s      string_echo += "%s:[";\n' % (header, self.name))
-            f.write('%s      for( uint32_t i = 0; i < %s_length; i++) {\n' % (header, self.name))
-            f.write('%s        if( i == (%s_length - 1)) {\n' % (header, self.name))
-            c.echo(f, header + "    ", "")
-            f.write('%s        } else {\n' % header)
-            c.echo(f, header + "    ", ",")
-            f.write('%s        }\n' % header)
+            return '%s(%s + 4, tinyros::viewRead<uint32_t>(%s))' % (self.view_type(), p, p)
+        return '%s(%s, %d)' % (self.view_type(), p, self.size)
+
+    def view_skip(self, p):
+        size = self.wire_element().wire_size()
+        if size != None:
+            return '4 + tinyros::viewRead<uint32_t>(%s) * %d' % (p, size)
+        if self.size == None:
+            return '4 + %s.serializedLength()' % self.view_get(p)
+        return '%s.serializedLength()' % self.view_get(p)
+
+class VectorArrayDataType(ArrayDataType):
+    """ Arrays as std::vector (variable) or std::array (fixed size). """
+
+    def make_initializer(self, f, trailer):
+        f.write('      %s()%s\n' % (self.name, trailer))
+
+    def make_declaration(self, f):
+        f.write('      typedef %s _%s_type;\n' % (self.type, self.name))
+        if self.size == None:
+            f.write('      std::vector<_%s_type> %s;\n' % (self.name, self.name))
+        else:
+            f.write('      std::array<_%s_type, %d> %s;\n' % (self.name, self.size, self.name))
+
+    def count(self):
+        return 'this->%s.size()' % self.name if self.size == None else '%d' % self.size
+
+    def pointer(self):
+        return 'this->%s.data()' % self.name
+
+    def echo(self, f):
+        if self.size == None and self.type == 'bool':
+            # std::vector<bool> has no data()
+            f.write('      writer.array("%s", this->%s);\n' % (self.name, self.name))
+        else:
+            f.write('      writer.array("%s", %s, (uint32_t)%s);\n' % (self.name, self.pointer(), self.count()))
+
+    def serialize(self, f, header):
+        c = self.cls(self.name+"[i]", self.type, self.bytes)
+        if self.size == None:
+            f.write('%s      uint32_t %s_length = this->%s.size();\n' % (header, self.name, self.name))
+            f.write('%s      varToArr(outbuffer + offset, %s_length);\n' % (header, self.name))
+            f.write('%s      offset += sizeof(%s_length);\n' % (header, self.name))
+        if self.bulk():
+            f.write('%s      arrayToArr(outbuffer + offset, this->%s.data(), %s);\n' % (header, self.name, self.count()))
+            f.write('%s      offset += %s * sizeof(%s);\n' % (header, self.count(), self.type))
+        elif self.type == 'bool':
+            # std::vector<bool> hands out proxies, write one byte per element
+            f.write('%s      for( uint32_t i = 0; i < %s; i++) {\n' % (header, self.count()))
+            f.write('%s        *(outbuffer + offset++) = this->%s[i] ? 1 : 0;\n' % (header, self.name))
             f.write('%s      }\n' % header)
-            f.write('%s      string_echo += "]%s";\n' % (header, trailer))
         else:
-            f.write('%s      string_echo += "%s:[";\n' % (header, self.name))
-            f.write('%s      for( uint32_t i = 0; i < %d; i++) {\n' % (header, self.size) )
-            f.write('%s        if( i == (%d - 1)) {\n' % (header, self.size))
-            c.echo(f, header + "    ", "")
-            f.write('%s        } else {\n' % header)
-            c.echo(f, header + "    ", ",")
-            f.write('%s        }\n' % header)
+            f.write('%s      for( uint32_t i = 0; i < %s; i++) {\n' % (header, self.count()))
+            c.serialize(f, header + "  ")
+            f.write('%s      }\n' % header)
+
+    def deserialize(self, f, header):
+        c = self.cls(self.name+"[i]", self.type, self.bytes)
+        if self.size == None:
+            # resize keeps the capacity, and the elements, of earlier messages
+            f.write('%s      uint32_t %s_length;\n' % (header, self.name))
+            f.write('%s      arrToVar(%s_length, (inbuffer + offset));\n' % (header, self.name))
+            f.write('%s      offset += sizeof(%s_length);\n' % (header, self.name))
+            f.write('%s      this->%s.resize(%s_length);\n' % (header, self.name, self.name))
+        if self.bulk():
+            f.write('%s      arrToArray(this->%s.data(), inbuffer + offset, %s);\n' % (header, self.name, self.count()))
+            f.write('%s      offset += %s * sizeof(%s);\n' % (header, self.count(), self.type))
+        elif self.type == 'bool':
+            f.write('%s      for( uint32_t i = 0; i < %s; i++) {\n' % (header, self.count()))
+            f.write('%s        this->%s[i] = *(inbuffer + offset++) != 0;\n' % (header, self.name))
+            f.write('%s      }\n' % header)
+        else:
+            f.write('%s      for( uint32_t i = 0; i < %s; i++) {\n' % (header, self.count()))
+            c.deserialize(f, header + "  ")
             f.write('%s      }\n' % header)
-            f.write('%s      string_echo += "]%s";\n' % (header, trailer))
+
+    def serializedLength(self, f, header):
+        c = self.cls(self.name+"[i]", self.type, self.bytes)
+        if self.size == None:
+            f.write('%s      length += sizeof(uint32_t);\n' % header)
+        if self.bulk() or self.type == 'bool':
+            f.write('%s      length += %s * sizeof(%s);\n' % (header, self.count(), self.type))
+        else:
+            f.write('%s      for( uint32_t i = 0; i < %s; i++) {\n' % (header, self.count()))
+            c.serializedLength(f, header + "  ")
+            f.write('%s      }\n' % header)
+
+# pointer: T* x + x_length, vector: std::vector<T> x / std::array<T, N> x
+ARRAYS = 'pointer'
+
+# every message of every package by C++ type, to size nested messages
+MESSAGES = dict()
 
 ROS_TO_EMBEDDED_TYPES = {
     'bool'    :   ('bool',              1, PrimitiveDataType, []),
@@ -456,7 +594,9 @@ class Message:
                 cls = MessageDataType
                 code_type = "tinyros::" + type_package + "::" + type_name
                 size = 0
-            if type_array:
+            if type_array and ARRAYS == 'vector':
+                self.data.append( VectorArrayDataType(name, code_type, size, cls, type_array_size ) )
+            elif type_array:
                 self.data.append( ArrayDataType(name, code_type, size, cls, type_array_size ) )
             else:
                 self.data.append( cls(name, code_type, size) )
@@ -479,6 +619,45 @@ class Message:
     def _write_setID(self, f):
         f.write('')
 
+    def wire_size(self):
+        # a sum of constant field sizes, or None when any field varies
+        size = 0
+        for d in self.data:
+            if d.wire_size() == None:
+                return None
+            size += d.wire_size()
+        return size
+
+    def _write_fixed_size(self, f):
+        if self.wire_size() != None:
+            f.write('      static constexpr uint32_t kSerializedSize = %d;\n\n' % self.wire_size())
+
+    def _write_fixed_serializer(self, f):
+        f.write('    virtual int serialize(unsigned char *outbuffer) const\n')
+        f.write('    {\n')
+        offset = 0
+        for d in self.data:
+            d.fixed_serialize(f, '%d' % offset)
+            offset += d.wire_size()
+        f.write('      return kSerializedSize;\n')
+        f.write('    }\n')
+        f.write('\n')
+
+    def _write_fixed_deserializer(self, f):
+        f.write('    virtual int deserialize(unsigned char *inbuffer)\n')
+        f.write('    {\n')
+        offset = 0
+        for d in self.data:
+            d.fixed_deserialize(f, '%d' % offset)
+            offset += d.wire_size()
+        f.write('      return kSerializedSize;\n')
+        f.write('    }\n')
+        f.write('\n')
+
+    def _write_fixed_serializedLength(self, f):
+        f.write('    virtual int serializedLength() const { return kSerializedSize; }\n')
+        f.write('\n')
+
     def _write_serializer(self, f):
                 # serializer
         f.write('    virtual int serialize(unsigned char *outbuffer) const\n')
@@ -515,15 +694,21 @@ class Message:
         f.write('\n')
 
     def _write_echo(self, f):
+        f.write('    virtual void echo(tinyros::Writer& writer) const\n')
+        f.write('    {\n')
+        f.write('      writer.raw(\'{\');\n')
+        for i in range(len(self.data)):
+            if i > 0:
+                f.write('      writer.raw(\',\');\n')
+            self.data[i].echo(f)
+        f.write('      writer.raw(\'}\');\n')
+        f.write('    }\n')
+        f.write('\n')
         f.write('    virtual std::string echo()\n')
         f.write('    {\n')
-        f.write('      std::string string_echo = "{";\n');
-        if self.data:
-            for d in self.data[:-1]:
-                d.echo(f, "", ",")
-            self.data[-1].echo(f, "", "")
-        f.write('      string_echo += "}";\n');
-        f.write('      return string_echo;\n');
+        f.write('      tinyros::Writer writer;\n')
+        f.write('      echo(writer);\n')
+        f.write('      return writer.str();\n')
         f.write('    }\n')
         f.write('\n')
 
@@ -533,7 +718,12 @@ class Message:
         f.write('#include <stdio.h>\n')
         f.write('#include <string.h>\n')
         f.write('#include <stdlib.h>\n')
+        if ARRAYS == 'vector':
+            f.write('#include <vector>\n')
+            f.write('#include <array>\n')
         f.write('#include "tiny_ros/ros/msg.h"\n')
+        f.write('#include "tiny_ros/ros/msg_view.h"\n')
+        f.write('#include "tiny_ros/ros/writer.h"\n')
 
     def _write_msg_includes(self,f):
         for i in self.includes:
@@ -568,16 +758,101 @@ class Message:
         self._write_id(f)
         f.write('    public:\n')
         self._write_data(f)
+        self._write_fixed_size(f)
         self._write_constructor(f)
-        self._write_serializer(f)
-        self._write_deserializer(f)
-        self._write_serializedLength(f)
+        if self.wire_size() != None:
+            # constant offsets, no length to compute
+            self._write_fixed_serializer(f)
+            self._write_fixed_deserializer(f)
+            self._write_fixed_serializedLength(f)
+        else:
+            self._write_serializer(f)
+            self._write_deserializer(f)
+            self._write_serializedLength(f)
         self._write_echo(f)
         self._write_getType(f)
         self._write_getMD5(f)
         self._write_getID(f)
         self._write_setID(f)
+        self._write_view_typedef(f)
+        f.write('\n')
+        f.write('  };\n')
+
+    def _write_view_typedef(self, f):
+        f.write('    typedef %sView View;\n' % self.name)
+
+    def _write_view(self, f):
+        # fields up to the first variable size one are at fixed offsets,
+        # the offsets of the others are found on first use and cached
+        offsets = []
+        offset = 0
+        for d in self.data:
+            offsets.append(offset)
+            if offset != None and d.wire_size() != None:
+                offset += d.wire_size()
+            else:
+                offset = None
+        variable = [i for i in range(len(self.data)) if self.data[i].wire_size() == None]
+        dynamic = len(variable) > 0
+        first = variable[0] if dynamic else len(self.data)
+
+        def at(i):
+            if offsets[i] != None:
+                return 'buffer_ + %d' % offsets[i]
+            return 'buffer_ + fieldOffset(%d)' % i
+
+        f.write('  /* %s read in place from a received buffer, see tiny_ros/ros/msg_view.h */\n' % self.name)
+        f.write('  class %sView\n' % self.name)
+        f.write('  {\n')
+        f.write('    public:\n')
+        f.write('    typedef %s MsgType;\n\n' % self.name)
+        if dynamic:
+            f.write('    %sView(const unsigned char* buffer = NULL) : buffer_(buffer), known_(%d)\n' % (self.name, first))
+            f.write('    {\n')
+            f.write('      offsets_[%d] = %d;\n' % (first, offsets[first]))
+            f.write('    }\n\n')
+        else:
+            f.write('    %sView(const unsigned char* buffer = NULL) : buffer_(buffer) {}\n\n' % self.name)
+        f.write('    const unsigned char* buffer() const { return buffer_; }\n')
+        if dynamic:
+            f.write('    uint32_t serializedLength() const { return fieldOffset(%d); }\n' % len(self.data))
+        else:
+            f.write('    uint32_t serializedLength() const { return %d; }\n' % offset)
         f.write('\n')
+        for i in range(len(self.data)):
+            d = self.data[i]
+            if d.view_get('@').count('@') > 1:
+                f.write('    %s %s() const\n' % (d.view_type(), d.name))
+                f.write('    {\n')
+                f.write('      const unsigned char* p = %s;\n' % at(i))
+                f.write('      return %s;\n' % d.view_get('p'))
+                f.write('    }\n')
+            else:
+                f.write('    %s %s() const { return %s; }\n' % (d.view_type(), d.name, d.view_get(at(i))))
+        if dynamic:
+            f.write('\n')
+            f.write('    private:\n')
+            f.write('    uint32_t fieldOffset(uint32_t field) const\n')
+            f.write('    {\n')
+            f.write('      while (known_ < field) {\n')
+            f.write('        const unsigned char* p = buffer_ + offsets_[known_];\n')
+            f.write('        uint32_t length = 0;\n')
+            f.write('        switch (known_) {\n')
+            for i in range(first, len(self.data)):
+                f.write('          case %d: length = %s; break;\n' % (i, self.data[i].view_skip('p')))
+            f.write('        }\n')
+            f.write('        offsets_[known_ + 1] = offsets_[known_] + length;\n')
+            f.write('        known_++;\n')
+            f.write('      }\n')
+            f.write('      return offsets_[field];\n')
+            f.write('    }\n\n')
+            f.write('    const unsigned char* buffer_;\n')
+            f.write('    mutable uint32_t offsets_[%d];\n' % (len(self.data) + 1))
+            f.write('    mutable uint32_t known_;\n')
+        else:
+            f.write('\n')
+            f.write('    private:\n')
+            f.write('    const unsigned char* buffer_;\n')
         f.write('  };\n')
 
     def make_header(self, f):
@@ -592,8 +867,11 @@ class Message:
         f.write('namespace %s\n' % self.package)
         f.write('{\n')
         f.write('\n')
+        f.write('  class %sView;\n\n' % self.name)
         self._write_impl(f)
         f.write('\n')
+        self._write_view(f)
+        f.write('\n')
         f.write('}\n')
         f.write('}\n')
 
@@ -686,6 +964,13 @@ class Service:
         self.req._write_setID = _write_setID
         self.resp._write_setID = _write_setID
 
+        # requests and responses carry the call id, they have no views and
+        # no fixed size codecs
+        self.req._write_view_typedef = lambda out: None
+        self.resp._write_view_typedef = lambda out: None
+        self.req.wire_size = lambda: None
+        self.resp.wire_size = lambda: None
+
         def write_type(out, name):
             out.write('    virtual std::string getType(){ return %s; }\n'%(name))
         _write_getType = lambda out: write_type(out, self.name.upper())
@@ -773,6 +1058,17 @@ def MakeLibrary(pkg_dir, package, output_path, build_dir):
         msg.make_header(header)
         header.close()
 
+def messages_register(msgs):
+    # parse every message first, sizes of nested messages are needed
+    # before their own package is generated
+    for d in sorted(os.listdir(msgs)):
+        if not os.path.exists(msgs + "/" + d + "/msg"):
+            continue
+        for f in os.listdir(msgs + "/" + d + "/msg"):
+            if f.endswith(".msg"):
+                definition = open(msgs + "/" + d + "/msg/" + f).readlines()
+                MESSAGES["tinyros::" + d + "::" + f[0:-4]] = Message(f[0:-4], d, definition)
+
 def messages_generate(path, build, msgs):
     # gimme messages
     failed = []
@@ -794,66 +1090,74 @@ def messages_generate(path, build, msgs):
         raise Exception("Failed to generate libraries for: " + str(failed))
     print('\n')
 
+def ReplaceIfChanged(part, target):
+    # keep the old file, and its timestamp, when nothing changed
+    if os.path.exists(target):
+        if hashlib_md5sum_definition(open(target).readlines()) == hashlib_md5sum_definition(open(part).readlines()):
+            os.remove(part)
+            return
+    shutil.move(part, target)
+
 def MakeSubscribers(messages, output_path):
-    # generate for each message
-    for msg in messages:
-        if not os.path.exists(output_path):
-            os.makedirs(output_path)
-        f = open(output_path + "/rostopic_subscribers.cpp.part", "w")
-        f.write('#ifndef _TINYROS_ROSTOPIC_SUBSCRIBERS_h\n')
-        f.write('#define _TINYROS_ROSTOPIC_SUBSCRIBERS_h\n')
-        f.write('\n')
-        f.write('#include "tiny_ros/ros.h"\n')
-        for i in messages:
-            f.write('#include "tiny_ros/%s.h"\n' % i)
+    if not os.path.exists(output_path):
+        os.makedirs(output_path)
+
+    # one translation unit per package, so that only the packages that
+    # changed are compiled again
+    packages = dict()
+    for s in messages:
+        packages.setdefault(s[0:s.find('/')], []).append(s[s.find('/')+1:])
+    generated = ["rostopic_subscribers.cpp"]
+    for pkg in sorted(packages.keys()):
+        target = "rostopic_subscribers_%s.cpp" % pkg
+        generated.append(target)
+        f = open(output_path + "/" + target + ".part", "w")
+        f.write('#include "echo_subscriber.h"\n')
+        for name in sorted(packages[pkg]):
+            f.write('#include "tiny_ros/%s/%s.h"\n' % (pkg, name))
         f.write('\n')
         f.write('namespace tinyros\n')
         f.write('{\n')
-        f.write('template<typename MsgT>\n')
-        f.write('class EchoSubscriber: public tinyros::Subscriber_\n')
+        f.write('void rostopic_register_%s(EchoSubscriberRegistry& registry)\n' % pkg)
         f.write('{\n')
-        f.write('public:\n')
-        f.write('  MsgT msg;\n')
-        f.write('  virtual void callback(unsigned char* data)\n')
-        f.write('  {\n')
-        f.write('    MsgT tmsg;\n')
-        f.write('    tmsg.deserialize(data);\n')
-        f.write('    spdlog::get("logger")->info("{0}[{1}]->>{2}", topic_, getMsgType(), tmsg.echo());\n')
-        f.write('  }\n')
-        f.write('  virtual std::string getMsgType()\n')
-        f.write('  {\n')
-        f.write('    return this->msg.getType();\n')
-        f.write('  }\n')
-        f.write('  virtual std::string getMsgMD5()\n')
-        f.write('  {\n')
-        f.write('    return this->msg.getMD5();\n')
-        f.write('  }\n')
-        f.write('  virtual int getEndpointType()\n')
-        f.write('  {\n')
-        f.write('    return tinyros_msgs::TopicInfo::ID_SUBSCRIBER;\n')
-        f.write('  }\n')
-        f.write('};\n\n')
-        f.write('static std::map<std::string, tinyros::Subscriber_*> rostopic_subscribers = {\n')
-        for s in messages:
-	        pkg = s[0:s.find('/')]
-	        name = s[s.find('/')+1:]
-	        f.write('    {"%s", new EchoSubscriber<tinyros::%s::%s>()},\n' % (s, pkg, name))
-        f.write('};\n\n')
+        for name in sorted(packages[pkg]):
+            f.write('  registry["%s/%s"] = &createEchoSubscriber<tinyros::%s::%s>;\n' % (pkg, name, pkg, name))
+        f.write('}\n')
         f.write('}\n')
-        f.write('#endif\n\n')
         f.close()
+        ReplaceIfChanged(output_path + "/" + target + ".part", output_path + "/" + target)
+
+    # the registry only holds the factories, and is filled on first use
+    f = open(output_path + "/rostopic_subscribers.cpp.part", "w")
+    f.write('#include "echo_subscriber.h"\n')
+    f.write('\n')
+    f.write('namespace tinyros\n')
+    f.write('{\n')
+    for pkg in sorted(packages.keys()):
+        f.write('void rostopic_register_%s(EchoSubscriberRegistry& registry);\n' % pkg)
+    f.write('\n')
+    f.write('static EchoSubscriberRegistry rostopic_make_registry()\n')
+    f.write('{\n')
+    f.write('  EchoSubscriberRegistry registry;\n')
+    for pkg in sorted(packages.keys()):
+        f.write('  rostopic_register_%s(registry);\n' % pkg)
+    f.write('  return registry;\n')
+    f.write('}\n')
+    f.write('\n')
+    f.write('Subscriber_* rostopic_create_subscriber(const std::string& type)\n')
+    f.write('{\n')
+    f.write('  static const EchoSubscriberRegistry registry = rostopic_make_registry();\n')
+    f.write('  EchoSubscriberRegistry::const_iterator it = registry.find(type);\n')
+    f.write('  return it != registry.end() ? it->second() : NULL;\n')
+    f.write('}\n')
+    f.write('}\n')
+    f.close()
+    ReplaceIfChanged(output_path + "/rostopic_subscribers.cpp.part", output_path + "/rostopic_subscribers.cpp")
 
-        if not os.path.exists(output_path + "/rostopic_subscribers.cpp"):
-            shutil.move(output_path + "/rostopic_subscribers.cpp.part", output_path + "/rostopic_subscribers.cpp")
-        else:
-            tmp_file_definition = open(output_path + "/rostopic_subscribers.cpp").readlines()
-            file_definition = open(output_path + "/rostopic_subscribers.cpp.part").readlines()
-            tmp_file_md5 = hashlib_md5sum_definition(tmp_file_definition)
-            file_md5 = hashlib_md5sum_definition(file_definition)
-            if file_md5 != tmp_file_md5:
-                shutil.move(output_path + "/rostopic_subscribers.cpp.part", output_path + "/rostopic_subscribers.cpp")
-            else:
-                os.remove(output_path + "/rostopic_subscribers.cpp.part")
+    # packages that are gone
+    for f in os.listdir(output_path):
+        if f.startswith("rostopic_subscribers") and f.endswith(".cpp") and f not in generated:
+            os.remove(output_path + "/" + f)
         
 def subscribers_generate(path, msgs):
     # gimme messages
@@ -890,7 +1194,13 @@ def roslib_copy_roslib_files(path):
              'ros.h',
              'ros/duration.h',
              'ros/msg.h',
+             'ros/msg_view.h',
+             'ros/writer.h',
+             'ros/bag.h',
              'ros/log.h',
+             'ros/log_ring.h',
+             'ros/log_binary.h',
+             'ros/clock_sync.h',
              'ros/node_handle_base.h',
              'ros/node_handle_udp.h',
              'ros/node_handle.h',
@@ -899,6 +1209,11 @@ def roslib_copy_roslib_files(path):
              'ros/service_server.h',
              'ros/service_client.h',
              'ros/threadpool.h',
+             'ros/trace.h',
+             'ros/send_queue.h',
+             'ros/buffer_pool.h',
+             'ros/executor.h',
+             'ros/topic_registry.h',
              'ros/hardware.h',
              'ros/hardware_udp.h',
              'ros/hardware_tcp.h',
@@ -971,6 +1286,15 @@ def roslib_copy_examples_files(path):
     f.write('ENDIF()\n\n')
     f.close()
 
+# Options
+for arg in sys.argv[1:]:
+    if arg.startswith('--arrays='):
+        ARRAYS = arg[len('--arrays='):]
+        if ARRAYS not in ('pointer', 'vector'):
+            print(__usage__)
+            exit(1)
+        sys.argv.remove(arg)
+
 # Enforce correct inputs
 if (len(sys.argv) < 3):
     print(__usage__)
@@ -984,8 +1308,20 @@ print("\nExporting to %s" % path)
 
 roslib_copy_roslib_files(path+"/include/tiny_ros/")
 roslib_copy_examples_files(path+"/src/")
-messages_generate(path+"/include/tiny_ros/", sys.argv[1] + "/build/CMake/gcc_msgs", sys.argv[3] + "/msgs")
+# the cache of definitions already exported is only good for the array
+# mode it was exported in, drop it to regenerate everything on a change
+cache = sys.argv[1] + "/build/CMake/gcc_msgs"
+cache_arrays = cache + "/.arrays"
+if os.path.exists(cache):
+    if not os.path.exists(cache_arrays) or open(cache_arrays).read().strip() != ARRAYS:
+        shutil.rmtree(cache)
+
+messages_register(sys.argv[3] + "/msgs")
+messages_generate(path+"/include/tiny_ros/", cache, sys.argv[3] + "/msgs")
 subscribers_generate(path+"/include/tiny_ros/", sys.argv[3] + "/msgs")
-if os.path.exists(sys.argv[1] + "/build/CMake/gcc_msgs"):
-    shutil.rmtree(sys.argv[1] + "/build/CMake/gcc_msgs")
-shutil.copytree(sys.argv[3] + "/msgs", sys.argv[1] + "/build/CMake/gcc_msgs")
+if os.path.exists(cache):
+    shutil.rmtree(cache)
+shutil.copytree(sys.argv[3] + "/msgs", cache)
+f = open(cache_arrays, 'w')
+f.write(ARRAYS + '\n')
+f.close()
@@ -0,0 +1,196 @@
+/*
+ * Steady state publish and spin must not touch the heap: receive buffers
+ * come from SpinObjectPool, frames from SendFramePool and messages from
+ * the MessagePool of the subscriber, and answering the negotiation and
+ * time exchanges of tinyrosdds, once a second, reuses what the first one
+ * allocated. Counts every malloc, calloc and realloc the test and the
+ * client library make, linked with -Wl,--wrap (operator new comes down to
+ * malloc here), while LaserScans go from a publisher through tinyrosdds
+ * back to a subscriber of the same node, WINDOW of them at a time, so the
+ * pools have a depth to settle at. Calls from inside libstdc++ and libc go
+ * past the wrappers. Warming up and counting both take two exchanges at
+ * least.
+ *
+ *   allocation_test [path of tinyrosdds, started for the test]
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <type_traits>
+#include "tiny_ros/ros.h"
+#include "tiny_ros/sensor_msgs/LaserScan.h"
+
+static std::atomic<bool> counting(false);
+static std::atomic<long> allocations(0);
+
+extern "C" {
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* p, size_t size);
+void __real_free(void* p);
+
+void* __wrap_malloc(size_t size) {
+  if (counting) allocations++;
+  return __real_malloc(size);
+}
+void* __wrap_calloc(size_t count, size_t size) {
+  if (counting) allocations++;
+  return __real_calloc(count, size);
+}
+/* generated deserialize() grows pointer mode arrays with realloc */
+void* __wrap_realloc(void* p, size_t size) {
+  if (counting) allocations++;
+  return __real_realloc(p, size);
+}
+void __wrap_free(void* p) {
+  __real_free(p);
+}
+}
+
+/* out of line, GCC would otherwise pair the free it sees with operator new */
+__attribute__((noinline)) static void* allocate(size_t size) {
+  return malloc(size ? size : 1);
+}
+__attribute__((noinline)) static void release(void* p) {
+  free(p);
+}
+
+void* operator new(size_t size) {
+  void* p = allocate(size);
+  if (p == NULL) throw std::bad_alloc();
+  return p;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void operator delete(void* p) noexcept { release(p); }
+void operator delete[](void* p) noexcept { release(p); }
+
+/*
+ * The generator makes arrays T* x with x_length, or std::vector<T> x with
+ * --arrays=vector (make GCC_ARRAYS=vector); only one of each pair compiles.
+ */
+typedef std::is_pointer<decltype(tinyros::sensor_msgs::LaserScan::ranges)>::type PointerArrays;
+
+template<typename M>
+static void resizeRanges(M& scan, uint32_t length, std::true_type) {
+  scan.ranges_length = length;
+  scan.ranges = new float[length];
+}
+template<typename M>
+static void resizeRanges(M& scan, uint32_t length, std::false_type) {
+  scan.ranges.resize(length);
+}
+
+template<typename M>
+static uint32_t rangesLength(const M& scan, std::true_type) { return scan.ranges_length; }
+template<typename M>
+static uint32_t rangesLength(const M& scan, std::false_type) { return scan.ranges.size(); }
+
+enum { WARMUP = 2000, ROUNDS = 10, MESSAGES = 1000, EXCHANGES_MS = 2500, RANGES = 720, WINDOW = 8 };
+
+static std::atomic<long> received(0);
+static pid_t broker = -1;
+
+static void messageCb(const tinyros::sensor_msgs::LaserScan& scan) {
+  if (rangesLength(scan, PointerArrays()) == RANGES) received++;
+}
+
+static bool before(std::chrono::steady_clock::time_point start, int ms) {
+  return std::chrono::steady_clock::now() - start < std::chrono::milliseconds(ms);
+}
+
+static void finish(int code) {
+  if (broker > 0) {
+    kill(broker, SIGKILL);
+    waitpid(broker, NULL, 0);
+  }
+  fflush(stdout);
+  _exit(code);
+}
+
+/* publish count scans, at most WINDOW on the way, false when one got lost */
+static bool roundTrip(tinyros::Publisher& pub, tinyros::sensor_msgs::LaserScan& scan, long count) {
+  long target = received + count;
+  for (long sent = 0; sent < count; sent++) {
+    long done = target - count + sent - WINDOW;
+    for (int i = 0; i < 5000 && received < done; i++) {
+      usleep(100);
+    }
+    if (received < done) {
+      return false;
+    }
+    pub.publish(&scan);
+  }
+  for (int i = 0; i < 5000 && received < target; i++) {
+    usleep(100);
+  }
+  return received >= target;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc >= 2) {
+    broker = fork();
+    if (broker == 0) {
+      execl(argv[1], argv[1], "-l", "warn", (char*)NULL);
+      _exit(127);
+    }
+    sleep(1);
+  }
+
+  tinyros::init("allocation_test", "127.0.0.1");
+  tinyros::sensor_msgs::LaserScan scan;
+  resizeRanges(scan, RANGES, PointerArrays());
+  for (int i = 0; i < RANGES; i++) scan.ranges[i] = i * 0.01f;
+  tinyros::Publisher pub("allocation_test_scan", &scan);
+  tinyros::Subscriber<tinyros::sensor_msgs::LaserScan> sub("allocation_test_scan", messageCb);
+  tinyros::nh()->advertise(pub);
+  tinyros::nh()->subscribe(sub);
+  // a frame is released after its write returns, when the scan may be back already
+  tinyros::nh()->reserveFrames(scan.serializedLength(), 2 * WINDOW);
+
+  // wait for tinyrosdds to route the topic
+  for (int tries = 0; !roundTrip(pub, scan, 1); tries++) {
+    if (tries == 10) {
+      printf("FAIL: no messages came back from tinyrosdds\n");
+      finish(1);
+    }
+  }
+
+  // fill the pools
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  long warmup = 0;
+  while (warmup < WARMUP || before(start, EXCHANGES_MS)) {
+    if (!roundTrip(pub, scan, MESSAGES)) {
+      printf("FAIL: messages got lost while warming up\n");
+      finish(1);
+    }
+    warmup += MESSAGES;
+  }
+
+  counting = true;
+  int rounds = 0, failed = 0;
+  start = std::chrono::steady_clock::now();
+  for (int round = 0; round < ROUNDS || before(start, EXCHANGES_MS); round++) {
+    allocations = 0;
+    bool complete = roundTrip(pub, scan, MESSAGES);
+    long count = allocations;
+    printf("round %d: %d messages, %s, %ld allocations\n", round, MESSAGES, complete ? "all received" : "incomplete", count);
+    if (!complete || count != 0) {
+      failed++;
+    }
+    rounds++;
+  }
+  if (failed > 0) {
+    printf("FAIL: %d of %d rounds of %d messages allocated or lost messages\n", failed, rounds, MESSAGES);
+    finish(1);
+  }
+  printf("PASS\n");
+  finish(0);
+  return 1;
+}
@@ -0,0 +1,219 @@
+/*
+ * Bags written by BagWriter and read back by BagReader: messages of two
+ * topics, not in time order, across many chunks, with and without zlib,
+ * must come back in time order with their connection, time and bytes,
+ * and seek() must find the first message at or after any time. A writer
+ * killed before close() leaves a bag without index; its complete chunks
+ * must be found by walking it, also when the file ends inside a chunk.
+ *
+ *   bag_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <string>
+#include <vector>
+#include "tiny_ros/ros/bag.h"
+
+enum { MESSAGES = 3000, CHUNK_SIZE = 16 * 1024, KILLED_PAYLOAD = 240, KILLED_PER_CHUNK = 16, KILLED_CHUNKS = 10 };
+
+static const char* TOPICS[] = { "/bag_test/scan", "/bag_test/odom" };
+static const char* TYPES[] = { "sensor_msgs/LaserScan", "nav_msgs/Odometry" };
+static const char* MD5S[] = { "90c7ef2dc6895d81024acba2ac42f369", "cd5e73d190d741a2f92e81eda573aca7" };
+
+static int failed = 0;
+
+static void check(bool ok, const char* what, size_t i) {
+  if (!ok && failed++ < 10) {
+    printf("  %s, message %zu\n", what, i);
+  }
+}
+
+/* times out of order within each second, so the index has to sort them */
+static tinyros::Time timeOf(uint32_t i) {
+  tinyros::Time time;
+  time.sec = 100 + i / 1000;
+  time.nsec = (i * 7919) % 1000 * 1000000;
+  return time;
+}
+
+static void payloadOf(uint32_t i, uint32_t size, std::vector<uint8_t>& payload) {
+  payload.resize(size);
+  for (uint32_t j = 0; j < size; j++) {
+    payload[j] = (uint8_t)(i * 31 + j);
+  }
+  memcpy(&payload[0], &i, 4);
+}
+
+static uint32_t sizeOf(uint32_t i) {
+  return 4 + (i * 37) % 600;
+}
+
+static bool writeBag(const std::string& path, tinyros::BagFormat::Compression compression) {
+  tinyros::BagWriter writer;
+  if (!writer.open(path, compression, CHUNK_SIZE)) {
+    return false;
+  }
+  std::vector<uint8_t> payload;
+  for (uint32_t i = 0; i < MESSAGES; i++) {
+    payloadOf(i, sizeOf(i), payload);
+    writer.write(TOPICS[i % 2], TYPES[i % 2], MD5S[i % 2], timeOf(i), &payload[0], (uint32_t)payload.size());
+  }
+  writer.close();
+  return writer.getMessages() == MESSAGES && writer.getDropped() == 0 && !writer.failed();
+}
+
+/* every message once, in time order, as it was written */
+static void checkMessages(tinyros::BagReader& reader, size_t count, uint32_t (*size)(uint32_t)) {
+  check(reader.size() == count, "message count differs", reader.size());
+  std::vector<bool> seen(count, false);
+  std::vector<uint8_t> payload;
+  tinyros::Time last;
+  for (size_t n = 0; n < reader.size(); n++) {
+    tinyros::BagReader::Message msg;
+    if (!reader.read(n, msg) || msg.size < 4) {
+      check(false, "cannot read", n);
+      continue;
+    }
+    uint32_t i;
+    memcpy(&i, msg.data, 4);
+    if (i >= count || seen[i]) {
+      check(false, "unknown or repeated message", n);
+      continue;
+    }
+    seen[i] = true;
+    tinyros::Time time = timeOf(i);
+    check(msg.time.sec == time.sec && msg.time.nsec == time.nsec, "time differs", n);
+    check(!tinyros::BagFormat::before(msg.time.sec, msg.time.nsec, last.sec, last.nsec), "out of time order", n);
+    last = msg.time;
+    check(msg.connection != NULL && msg.connection->topic == TOPICS[i % 2]
+      && msg.connection->type == TYPES[i % 2] && msg.connection->md5 == MD5S[i % 2], "connection differs", n);
+    payloadOf(i, size(i), payload);
+    check(msg.size == payload.size() && memcmp(msg.data, &payload[0], msg.size) == 0, "bytes differ", n);
+  }
+}
+
+/* seek() against counting the messages before time */
+static void checkSeek(tinyros::BagReader& reader) {
+  tinyros::Time probes[] = { tinyros::Time(0, 0), tinyros::Time(100, 0), timeOf(1), timeOf(1234),
+    tinyros::Time(101, 500000000), tinyros::Time(101, 500000001), timeOf(MESSAGES - 1), tinyros::Time(1000, 0) };
+  for (size_t p = 0; p < sizeof(probes) / sizeof(probes[0]); p++) {
+    size_t before = 0;
+    for (uint32_t i = 0; i < MESSAGES; i++) {
+      tinyros::Time time = timeOf(i);
+      if (tinyros::BagFormat::before(time.sec, time.nsec, probes[p].sec, probes[p].nsec)) {
+        before++;
+      }
+    }
+    check(reader.seek(probes[p]) == before, "seek misses the first message at or after the time", p);
+  }
+}
+
+static void roundTrip(const char* name, const std::string& path, tinyros::BagFormat::Compression compression) {
+  printf("%s\n", name);
+  if (!writeBag(path, compression)) {
+    check(false, "writing failed", 0);
+    return;
+  }
+  tinyros::BagReader reader;
+  if (!reader.open(path)) {
+    check(false, "cannot open", 0);
+    return;
+  }
+  check(reader.indexed(), "a closed bag has no index", 0);
+  check(reader.getChunks() > 10, "the messages did not take several chunks", reader.getChunks());
+  check(reader.getConnections().size() == 2, "connection count differs", reader.getConnections().size());
+  checkMessages(reader, MESSAGES, sizeOf);
+  checkSeek(reader);
+  reader.close();
+  unlink(path.c_str());
+}
+
+static uint32_t killedSizeOf(uint32_t) {
+  // all of one size, KILLED_PER_CHUNK of them fill a chunk of the killed writer
+  return KILLED_PAYLOAD;
+}
+
+static void killedWriter(const std::string& path) {
+  printf("writer killed before close()\n");
+  int ready[2];
+  if (pipe(ready) != 0) {
+    check(false, "pipe failed", 0);
+    return;
+  }
+  uint32_t chunk_size = KILLED_PER_CHUNK * (tinyros::BagFormat::MESSAGE_HEADER_SIZE + KILLED_PAYLOAD);
+  pid_t writer = fork();
+  if (writer == 0) {
+    tinyros::BagWriter* bag = new tinyros::BagWriter();
+    bag->open(path, tinyros::BagFormat::COMPRESSION_NONE, chunk_size);
+    std::vector<uint8_t> payload;
+    for (uint32_t i = 0; i < KILLED_CHUNKS * KILLED_PER_CHUNK + KILLED_PER_CHUNK / 2; i++) {
+      payloadOf(i, KILLED_PAYLOAD, payload);
+      bag->write(TOPICS[i % 2], TYPES[i % 2], MD5S[i % 2], timeOf(i), &payload[0], KILLED_PAYLOAD);
+    }
+    sleep(1);  // the thread of the writer gets the full chunks to the disk
+    if (write(ready[1], "k", 1) != 1) {
+      _exit(1);
+    }
+    pause();
+    _exit(0);
+  }
+  char c;
+  bool child_ready = read(ready[0], &c, 1) == 1;
+  kill(writer, SIGKILL);
+  waitpid(writer, NULL, 0);
+  close(ready[0]);
+  close(ready[1]);
+  if (!child_ready) {
+    check(false, "the writer did not get ready", 0);
+    return;
+  }
+
+  tinyros::BagReader reader;
+  if (!reader.open(path)) {
+    check(false, "cannot open", 0);
+    return;
+  }
+  check(!reader.indexed(), "a bag that was not closed has an index", 0);
+  check(reader.getChunks() == KILLED_CHUNKS, "chunk count differs", reader.getChunks());
+  checkMessages(reader, KILLED_CHUNKS * KILLED_PER_CHUNK, killedSizeOf);
+  reader.close();
+
+  // cut inside the last chunk: only the chunks before it are found
+  printf("bag cut inside its last chunk\n");
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0 || truncate(path.c_str(), st.st_size - 100) != 0) {
+    check(false, "cannot cut the bag", 0);
+    return;
+  }
+  if (!reader.open(path)) {
+    check(false, "cannot open", 0);
+    return;
+  }
+  check(reader.getChunks() == KILLED_CHUNKS - 1, "chunk count differs", reader.getChunks());
+  checkMessages(reader, (KILLED_CHUNKS - 1) * KILLED_PER_CHUNK, killedSizeOf);
+  reader.close();
+  unlink(path.c_str());
+}
+
+int main() {
+  char cwd[1024];
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    return 1;
+  }
+  std::string dir(cwd);
+  roundTrip("uncompressed chunks", dir + "/bag_test.bag", tinyros::BagFormat::COMPRESSION_NONE);
+#ifdef TINYROS_WITH_ZLIB
+  roundTrip("zlib chunks", dir + "/bag_test_zlib.bag", tinyros::BagFormat::COMPRESSION_ZLIB);
+#endif
+  killedWriter(dir + "/bag_test_killed.bag");
+  if (failed > 0) {
+    printf("FAIL: %d checks failed\n", failed);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
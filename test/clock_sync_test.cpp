@@ -0,0 +1,169 @@
+/*
+ * ClockSync on synthetic exchanges with a dds clock OFFSET ahead of the
+ * monotonic clock that runs a known drift faster. An exchange takes
+ * forward ms to tinyrosdds and back ms to return, so its offset is off
+ * by (forward - back) / 2. Out of the last FILTER exchanges the one with
+ * the least delay must set Time::dds(), the drift must be found within
+ * 0.5 ppm and clamped at MAX_DRIFT, and quality() must report the rtt,
+ * jitter and error of the chosen sample. Answers that cannot be right
+ * must not count.
+ *
+ *   clock_sync_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "tiny_ros/ros/clock_sync.h"
+
+static const int64_t MS = 1000000LL, S = 1000000000LL;
+static const int64_t OFFSET = 1234 * S + 567 * MS;
+static const int64_t PROCESS = MS / 10;  // tinyrosdds between t1 and t2
+
+static int failed = 0;
+
+static void check(bool ok, const char* what) {
+  if (!ok) {
+    printf("  FAIL: %s\n", what);
+    failed++;
+  }
+}
+
+static bool near(double value, double expected, double tolerance) {
+  return fabs(value - expected) <= tolerance;
+}
+
+static int64_t toNSec(const tinyros::Time& t) {
+  return (int64_t)t.sec * S + (int64_t)t.nsec;
+}
+
+static tinyros::Time fromNSec(int64_t ns) {
+  return tinyros::Time((uint32_t)(ns / S), (uint32_t)(ns % S));
+}
+
+/* a dds clock OFFSET ahead at start that runs drift faster */
+struct Link
+{
+  int64_t start;
+  double drift;
+  int64_t t3;  // of the last exchange
+
+  int64_t dds(int64_t mono) const {
+    return mono + OFFSET + (int64_t)llround(drift * (double)(mono - start));
+  }
+
+  /* a request sent at m0 of the monotonic clock, the offset it measures */
+  int64_t exchange(tinyros::ClockSync& sync, int64_t m0, int64_t forward, int64_t back, bool* updated = NULL) {
+    int64_t t1 = dds(m0 + forward), t2 = t1 + PROCESS;
+    t3 = m0 + forward + PROCESS + back;
+    bool ok = sync.update(fromNSec(m0), fromNSec(t1), fromNSec(t2), fromNSec(t3));
+    if (updated != NULL) {
+      *updated = ok;
+    }
+    return ((t1 - m0) + (t2 - t3)) / 2;
+  }
+};
+
+static int64_t ddsOffset() {
+  return tinyros::Time::time_dds_.load() - tinyros::Time::time_start_.load();
+}
+
+/* the delay in ms of each exchange, forward and back */
+static const int64_t DELAYS[][2] = {
+  {4, 4}, {6, 2}, {3, 9}, {2, 1}, {5, 5}, {7, 3}, {2, 6}, {8, 8}, {5, 5}, {5, 5}, {5, 5}, {5, 5}
+};
+
+static void filter() {
+  printf("least delay of the last %d exchanges\n", (int)tinyros::ClockSync::FILTER);
+  tinyros::ClockSync sync;
+  Link link;
+  link.drift = 0;
+  link.start = toNSec(tinyros::Time::monotonic()) - 20 * S;
+  int64_t offsets[12];
+  for (int i = 0; i < 12; i++) {
+    check(i >= tinyros::ClockSync::FILTER || sync.warmingUp(), "not warming up before the filter is full");
+    offsets[i] = link.exchange(sync, link.start + i * S, DELAYS[i][0] * MS, DELAYS[i][1] * MS);
+    int64_t truth = OFFSET + (DELAYS[i][0] - DELAYS[i][1]) * MS / 2;
+    check(offsets[i] == truth, "an exchange measures other than half its asymmetry off");
+
+    if (i == tinyros::ClockSync::FILTER - 1) {
+      check(!sync.warmingUp(), "warming up with the filter full");
+      // {2, 1} of the first eight, 0.5 ms off by its asymmetry
+      tinyros::SyncQuality quality = sync.quality();
+      check(ddsOffset() == OFFSET + MS / 2, "dds does not follow the exchange of the least delay");
+      check(tinyros::Time::time_start_.load() == link.start + 3 * S + 3 * MS + PROCESS, "dds starts elsewhere than at t3 of that exchange");
+      check(near(quality.rtt, 3, 1e-9), "rtt is not the delay of that exchange");
+      double sum = 0;
+      for (int j = 0; j <= i; j++) {
+        double d = (double)(offsets[j] - offsets[3]) * 1e-6;
+        sum += d * d;
+      }
+      check(near(quality.jitter, sqrt(sum / (i + 1)), 1e-9), "jitter is not the spread of the offsets around it");
+      check(near(quality.error, quality.rtt / 2 + quality.jitter, 1e-9), "error is not rtt / 2 + jitter");
+      check(quality.synced && quality.samples == 8, "not synced after 8 exchanges");
+      check(quality.drift == 0, "drift before the picks span MIN_DRIFT_SPAN");
+      double age = (toNSec(tinyros::Time::monotonic()) - link.t3) * 1e-9;
+      check(quality.age >= 0 && near(quality.age, age, 0.1), "age is not the time since the last exchange");
+    }
+    if (i == 10) {
+      check(ddsOffset() == OFFSET + MS / 2, "the exchange of the least delay left before 8 others came");
+    }
+  }
+  // it left with the twelfth, {2, 6} is the least of the last eight
+  check(ddsOffset() == OFFSET - 2 * MS, "dds does not follow the least delay once the best left the filter");
+  check(near(sync.quality().rtt, 8, 1e-9), "rtt is not the delay of the least of the last eight");
+}
+
+static void drift(double ppm, double expected) {
+  printf("drift of %g ppm\n", ppm);
+  tinyros::ClockSync sync;
+  Link link;
+  link.drift = ppm * 1e-6;
+  link.start = toNSec(tinyros::Time::monotonic()) - 200 * S;
+  for (int i = 0; i < 200; i++) {
+    // asymmetric throughout, which shifts every offset alike but not the slope
+    link.exchange(sync, link.start + i * S, 3 * MS, 1 * MS);
+  }
+  tinyros::SyncQuality quality = sync.quality();
+  check(near(quality.drift, expected, 0.5), "drift not found");
+  check(near((double)tinyros::Time::time_drift_.load(), expected * 1000, 500), "dds does not run at that drift");
+  if (expected == ppm) {
+    check(quality.jitter < 0.001, "drift counted as jitter");
+  } else {
+    check(near(quality.drift, expected, 1e-9), "drift not clamped at MAX_DRIFT");
+  }
+}
+
+static void rejected() {
+  printf("answers that cannot be right\n");
+  tinyros::ClockSync sync;
+  Link link;
+  link.drift = 0;
+  link.start = toNSec(tinyros::Time::monotonic()) - 10 * S;
+  bool updated = false;
+  link.exchange(sync, link.start, 1 * MS, 1 * MS, &updated);
+  check(updated, "a good exchange is refused");
+  int64_t offset = ddsOffset();
+
+  link.exchange(sync, link.start + S, 600 * MS, 500 * MS, &updated);
+  check(!updated, "an answer slower than MAX_DELAY taken");
+  int64_t m0 = link.start + 2 * S;
+  check(!sync.update(fromNSec(m0), fromNSec(link.dds(m0)), fromNSec(link.dds(m0)), fromNSec(m0 - MS)), "an answer before its request taken");
+  check(!sync.update(fromNSec(m0), fromNSec(link.dds(m0)), fromNSec(link.dds(m0) + 10 * MS), fromNSec(m0 + MS)), "a negative delay taken");
+  check(!sync.update(tinyros::Time(), fromNSec(link.dds(m0)), fromNSec(link.dds(m0)), fromNSec(m0 + MS)), "an answer without t0 taken");
+  check(sync.quality().samples == 1 && ddsOffset() == offset, "a refused answer counted");
+}
+
+int main() {
+  filter();
+  drift(100, 100);
+  drift(-37.5, -37.5);
+  drift(2000, tinyros::ClockSync::MAX_DRIFT);
+  drift(-2000, -tinyros::ClockSync::MAX_DRIFT);
+  rejected();
+  if (failed > 0) {
+    printf("FAIL: %d checks failed\n", failed);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
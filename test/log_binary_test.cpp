@@ -0,0 +1,181 @@
+/*
+ * tinyros_blog_* records: BinaryLog::format() of the arguments a
+ * LogBuffer recorded must print what snprintf prints of them, over a
+ * table of formats and argument types, and keep a conversion it has no
+ * argument for as it is. A LogBuffer filled and drained in steps wraps
+ * around many times, sometimes with records that end exactly at the end
+ * of the buffer and sometimes with the padding marker in front of it;
+ * every record must come back once, in order, with its arguments, and a
+ * record that does not fit must be dropped and counted.
+ *
+ *   log_binary_test
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <string>
+#include <vector>
+#include "tiny_ros/ros/log_binary.h"
+
+static int failed = 0;
+
+static tinyros::LogBuffer* buffer = new tinyros::LogBuffer();
+
+/* a record of format with args, formatted as the log thread does */
+template<typename... Args>
+static std::string formatted(const char* format, const Args&... args) {
+  tinyros::LogSite site(0, format);
+  const tinyros::LogSite* front;
+  const uint8_t* begin;
+  const uint8_t* end;
+  char text[256];
+  if (!buffer->write(&site, args...) || !buffer->front(front, begin, end) || front != &site) {
+    return "(not recorded)";
+  }
+  uint32_t length = tinyros::BinaryLog::format(front->format, begin, end, text, sizeof(text));
+  buffer->pop();
+  return std::string(text, length);
+}
+
+static void compare(const char* format, const std::string& got, const char* want) {
+  if (got != want) {
+    printf("  FAIL: \"%s\" formats to \"%s\", expected \"%s\"\n", format, got.c_str(), want);
+    failed++;
+  }
+}
+
+template<typename... Args>
+static void expect(const char* format, const Args&... args) {
+  char want[256];
+  snprintf(want, sizeof(want), format, args...);
+  compare(format, formatted(format, args...), want);
+}
+
+template<typename... Args>
+static void expectText(const char* format, const char* want, const Args&... args) {
+  compare(format, formatted(format, args...), want);
+}
+
+static void formats() {
+  printf("format() against snprintf\n");
+  expect("%*.*f|", 10, 3, 3.14159);
+  expect("%*.*f|", -10, 2, 2.5);
+  expect("%.*f|%.*e", -1, 2.5, 0, 7.5);
+  expect("%-08lld|%08lld", -42LL, -42LL);
+  expect("%08.3e|%+.2f|% f|%#.0f", -1234.5, 1.005, 2.0, 3.0);
+  expect("%g %G %a %10.3g", 1e-5, 1e20, 1.5, 123456.0);
+  expect("%zu %zd %zx", (size_t)123456789012ULL, (ssize_t)-5, (size_t)0xfff);
+  expect("%p|%20p|%-20p|", (void*)0x1234abcd, (const void*)&failed, (int*)&failed);
+  expect("%p", (void*)NULL);
+  expect("%c%c|%5c|%-3c|", 'a', 'Z', 'x', (unsigned char)'y');
+  expect("%d %i %d", INT_MIN, INT_MAX, (short)-7);
+  expect("%u %x %X %o %#x %#o", 4000000000u, 0xdeadbeefu, 0xabcdefu, 0777u, 255u, 8u);
+  expect("%x %u %d", -1, -2, 4000000000u);
+  expect("%hd %hhd %hu %hhu %hx", 70000, 300, 70000, 300, -1);
+  expect("%ld %lu %lx", LONG_MIN, ULONG_MAX, -1L);
+  expect("%lld %llu %llx %jd %ju", LLONG_MIN, ULLONG_MAX, -1LL, (intmax_t)-5, (uintmax_t)5);
+  expect("%+d|% d|%+5d|%-+5d|%05d", 5, 5, -5, 5, -5);
+  expect("%10.4s|%-10s|%.0s|%s", "abcdefgh", "left", "gone", std::string("kept").c_str());
+  char text[] = "mutable";
+  expect("%s %s", text, (const char*)text);
+  expect("%-----5d|%+-+-+-+-+-+-+-+-+-+-+-+-+-08d|", 5, 7);
+  expect("%000000000000000000000000000000000000000000000012.0000000000000000000000000000000000000003f|", 1.0);
+  expect("%0-+ #*.*f|", -20, 3, -1.5);
+  expect("%-+ #0-+ #0*.*lld|", -1000000, INT_MIN, 42LL);
+  expectText("%s|%8s|%-8s|", "(null)|  (null)|(null)  |", (const char*)NULL, (const char*)NULL, (char*)NULL);
+  expectText("%d and %s and %f", "7 and %s and %f", 7);
+  expectText("%*.*f", "%*.*f", 10);
+  expectText("100%% %d%%", "100% 5%", 5);
+  expectText("%s", "(?)", 5);
+  expectText("no arguments %", "no arguments %");
+}
+
+/* the record of seq: a number, a string of its own length, and a double */
+static uint32_t lengthOf(uint32_t seq) {
+  return (seq * 53) % 700;
+}
+
+static std::string textOf(uint32_t seq) {
+  return std::string(lengthOf(seq), (char)('a' + seq % 26));
+}
+
+static const tinyros::LogSite RECORD(0, "%u %s %.1f");
+
+static void wrap() {
+  printf("LogBuffer wrapping around\n");
+  tinyros::LogBuffer* ring = new tinyros::LogBuffer();
+  const uint8_t* base = NULL;
+  const uint8_t* last_end = NULL;
+  uint32_t written = 0, read = 0, padded = 0, exact = 0;
+  bool full = false;
+  char text[1024], want[1024];
+  while (read < 20000) {
+    // write until full every other round, else a few, then read half of it back
+    uint32_t burst = full ? 7 : 1000;
+    for (uint32_t i = 0; i < burst && written < 20000; i++) {
+      std::string s = textOf(written);
+      if (!ring->write(&RECORD, written, s.c_str(), written * 0.5)) {
+        full = true;
+        break;
+      }
+      written++;
+    }
+    full = !full;
+    uint32_t target = read + (written - read + 1) / 2;
+    while (read < target) {
+      const tinyros::LogSite* site;
+      const uint8_t* args;
+      const uint8_t* end;
+      if (!ring->front(site, args, end)) {
+        printf("  FAIL: record %u is missing\n", read);
+        failed++;
+        return;
+      }
+      const uint8_t* record = args - tinyros::LogBuffer::HEADER;
+      if (base == NULL) {
+        base = record;  // the first record starts the buffer
+      } else if (record == base && last_end != base + tinyros::LogBuffer::CAPACITY) {
+        padded++;
+      } else if (record == base) {
+        exact++;
+      }
+      last_end = record + ((tinyros::LogBuffer::HEADER + (end - args) + 7) & ~7);
+      uint32_t length = tinyros::BinaryLog::format(site->format, args, end, text, sizeof(text));
+      snprintf(want, sizeof(want), RECORD.format, read, textOf(read).c_str(), read * 0.5);
+      if (site != &RECORD || std::string(text, length) != want) {
+        if (failed++ < 10) {
+          printf("  FAIL: record %u reads \"%.40s\"\n", read, text);
+        }
+      }
+      ring->pop();
+      read++;
+    }
+  }
+  if (!ring->empty()) {
+    printf("  FAIL: records left after all were read\n");
+    failed++;
+  }
+  if (ring->getDropped() == 0) {
+    printf("  FAIL: no record found the buffer full\n");
+    failed++;
+  }
+  if (padded == 0 || exact == 0) {
+    printf("  FAIL: %u wraps behind the padding marker, %u at the end of the buffer\n", padded, exact);
+    failed++;
+  }
+  printf("%u records, %u dropped, %u wraps behind the padding marker, %u at the end\n",
+    read, (unsigned)ring->getDropped(), padded, exact);
+  delete ring;
+}
+
+int main() {
+  formats();
+  wrap();
+  if (failed > 0) {
+    printf("FAIL: %d checks failed\n", failed);
+    return 1;
+  }
+  printf("PASS\n");
+  return 0;
+}
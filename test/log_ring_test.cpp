@@ -0,0 +1,122 @@
+/*
+ * LogRing under concurrent producers: PRODUCERS threads push RECORDS
+ * records each, of lengths that fit one slot, fill it exactly, take
+ * several and wrap around the end of the ring, and some past MAX_LENGTH.
+ * A producer whose record finds the ring full pushes it again, so the
+ * consumer must see every record of every producer, in the order that
+ * producer pushed them, with its level and bytes intact and records past
+ * MAX_LENGTH cut there.
+ *
+ *   log_ring_test
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "tiny_ros/ros/log_ring.h"
+
+enum { PRODUCERS = 4, RECORDS = 20000 };
+
+static const uint32_t LENGTHS[] = {
+  8, 100, tinyros::LogRing::SLOT_SIZE - 1, tinyros::LogRing::SLOT_SIZE,
+  tinyros::LogRing::SLOT_SIZE + 1, 2 * tinyros::LogRing::SLOT_SIZE, 1500,
+  tinyros::LogRing::MAX_LENGTH, tinyros::LogRing::MAX_LENGTH + 904
+};
+
+static uint32_t lengthOf(uint32_t seq) {
+  return LENGTHS[seq % (sizeof(LENGTHS) / sizeof(LENGTHS[0]))];
+}
+
+static uint8_t levelOf(uint32_t producer, uint32_t seq) {
+  return (uint8_t)((producer + seq) % 5);
+}
+
+static char byteAt(uint32_t producer, uint32_t seq, uint32_t i) {
+  return (char)('a' + (producer * 7 + seq * 13 + i) % 26);
+}
+
+/* the producer and the sequence number lead the text, the pattern follows */
+static void fill(std::vector<char>& text, uint32_t producer, uint32_t seq) {
+  text.resize(lengthOf(seq));
+  for (uint32_t i = 0; i < text.size(); i++) {
+    text[i] = byteAt(producer, seq, i);
+  }
+  memcpy(&text[0], &producer, 4);
+  memcpy(&text[4], &seq, 4);
+}
+
+static void produce(tinyros::LogRing* ring, uint32_t producer) {
+  std::vector<char> text;
+  for (uint32_t seq = 0; seq < RECORDS; seq++) {
+    fill(text, producer, seq);
+    while (!ring->push(levelOf(producer, seq), &text[0], (uint32_t)text.size())) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+int main() {
+  static tinyros::LogRing ring;
+  std::vector<std::thread> producers;
+  for (uint32_t p = 0; p < PRODUCERS; p++) {
+    producers.push_back(std::thread(produce, &ring, p));
+  }
+
+  uint32_t next[PRODUCERS] = {0};
+  long received = 0, failed = 0;
+  std::vector<char> expected;
+  std::chrono::steady_clock::time_point progress = std::chrono::steady_clock::now();
+  while (received < (long)PRODUCERS * RECORDS) {
+    const tinyros::LogRing::Record* record = ring.front();
+    if (record == NULL) {
+      if (std::chrono::steady_clock::now() - progress > std::chrono::seconds(5)) {
+        // the producers may wait for slots that are never freed, do not join them
+        printf("FAIL: no record for 5 s after %ld of %ld\n", received, (long)PRODUCERS * RECORDS);
+        fflush(stdout);
+        _exit(1);
+      }
+      std::this_thread::yield();
+      continue;
+    }
+    progress = std::chrono::steady_clock::now();
+    uint32_t producer = 0, seq = 0;
+    if (record->length >= 8) {
+      memcpy(&producer, record->text, 4);
+      memcpy(&seq, record->text + 4, 4);
+    }
+    if (record->length < 8 || producer >= PRODUCERS || seq != next[producer]) {
+      if (failed++ < 10) {
+        printf("record %ld: producer %u, seq %u, length %u out of order\n", received, producer, seq, record->length);
+      }
+    } else {
+      fill(expected, producer, seq);
+      uint32_t length = expected.size() > (size_t)tinyros::LogRing::MAX_LENGTH ? (uint32_t)tinyros::LogRing::MAX_LENGTH : (uint32_t)expected.size();
+      if (record->length != length || record->level != levelOf(producer, seq) || memcmp(record->text, &expected[0], length) != 0) {
+        if (failed++ < 10) {
+          printf("record %ld: producer %u, seq %u, length %u of %u, level %u, bytes differ\n",
+            received, producer, seq, record->length, length, record->level);
+        }
+      }
+      next[producer] = seq + 1;
+    }
+    ring.pop();
+    received++;
+  }
+
+  for (size_t p = 0; p < producers.size(); p++) {
+    producers[p].join();
+  }
+  if (ring.front() != NULL) {
+    printf("FAIL: records left in the ring after all were taken\n");
+    return 1;
+  }
+  if (failed > 0) {
+    printf("FAIL: %ld of %ld records out of order or damaged\n", failed, received);
+    return 1;
+  }
+  printf("PASS: %ld records, %llu pushes found the ring full\n", received, (unsigned long long)ring.getDropped());
+  return 0;
+}
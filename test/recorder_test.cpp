@@ -0,0 +1,137 @@
+/*
+ * The recorder of tinyrosdds on a topic that a subscriber of any type
+ * created before any publisher: the recording starts while the topic has
+ * no type yet, then a publisher of std_msgs/String comes and publishes
+ * MESSAGES messages. The bag must hold all of them under a connection
+ * with the type and md5 of the publisher, or tinyrostopic play could not
+ * advertise the topic.
+ *
+ *   recorder_test <path of tinyrosdds, started for the test>
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <atomic>
+#include <string>
+#include "tiny_ros/ros.h"
+#include "tiny_ros/ros/bag.h"
+#include "tiny_ros/std_msgs/String.h"
+
+enum { MESSAGES = 100 };
+
+static const char* TOPIC = "/recorder_test_topic";
+
+static std::atomic<long> received(0);
+static pid_t broker = -1;
+
+static void finish(int code) {
+  if (broker > 0) {
+    kill(broker, SIGKILL);
+    waitpid(broker, NULL, 0);
+  }
+  fflush(stdout);
+  _exit(code);
+}
+
+static bool waitFor(long count) {
+  for (int i = 0; i < 5000 && received < count; i++) {
+    usleep(1000);
+  }
+  return received >= count;
+}
+
+int main(int argc, char* argv[]) {
+  if (argc < 2) {
+    printf("usage: recorder_test <path of tinyrosdds>\n");
+    return 1;
+  }
+  char cwd[1024];
+  if (getcwd(cwd, sizeof(cwd)) == NULL) {
+    return 1;
+  }
+  std::string bag = std::string(cwd) + "/recorder_test.bag";
+  unlink(bag.c_str());
+
+  broker = fork();
+  if (broker == 0) {
+    execl(argv[1], argv[1], "-l", "warn", (char*)NULL);
+    _exit(127);
+  }
+  sleep(1);
+
+  tinyros::init("recorder_test", "127.0.0.1");
+
+  // the topic comes into being without a type
+  tinyros::RawSubscriber sub(TOPIC, [](const tinyros::Span<uint8_t>&) { received++; });
+  tinyros::nh()->subscribe(sub);
+  for (int i = 0; i < 50 && !sub.negotiated(); i++) {
+    usleep(100 * 1000);
+  }
+
+  std::string reply = tinyros::nh()->record("start " + bag + " " + TOPIC);
+  printf("%s\n", reply.c_str());
+  if (reply.compare(0, 7, "started") != 0) {
+    printf("FAIL: the recorder did not start\n");
+    finish(1);
+  }
+
+  tinyros::std_msgs::String msg;
+  tinyros::Publisher pub(TOPIC, &msg);
+  tinyros::nh()->advertise(pub);
+  // messages are only routed once tinyrosdds knows the publisher
+  for (int tries = 0; received == 0; tries++) {
+    if (tries == 50) {
+      printf("FAIL: no messages came back from tinyrosdds\n");
+      finish(1);
+    }
+    msg.data = "warmup";
+    pub.publish(&msg);
+    usleep(100 * 1000);
+  }
+  long before = received;
+  for (int i = 0; i < MESSAGES; i++) {
+    msg.data = "message " + std::to_string(i);
+    pub.publish(&msg);
+  }
+  if (!waitFor(before + MESSAGES)) {
+    printf("FAIL: messages got lost on the way through tinyrosdds\n");
+    finish(1);
+  }
+
+  reply = tinyros::nh()->record("stop");
+  printf("%s\n", reply.c_str());
+
+  tinyros::BagReader reader;
+  if (!reader.open(bag)) {
+    printf("FAIL: cannot open %s\n", bag.c_str());
+    finish(1);
+  }
+  int failed = 0;
+  const std::vector<tinyros::BagReader::Connection>& connections = reader.getConnections();
+  for (size_t i = 0; i < connections.size(); i++) {
+    printf("connection %s: type [%s], md5 [%s]\n", connections[i].topic.c_str(),
+      connections[i].type.c_str(), connections[i].md5.c_str());
+    if (connections[i].type != msg.getType() || connections[i].md5 != msg.getMD5()) {
+      failed++;
+    }
+  }
+  if (connections.size() != 1) {
+    printf("FAIL: %zu connections in the bag, expected 1\n", connections.size());
+    failed++;
+  }
+  if (reader.size() != (size_t)received) {
+    printf("FAIL: %zu messages in the bag, %ld went through the topic\n", reader.size(), (long)received);
+    failed++;
+  }
+  reader.close();
+  unlink(bag.c_str());
+  if (failed > 0) {
+    printf("FAIL: the bag does not hold the topic with its type\n");
+    finish(1);
+  }
+  printf("PASS\n");
+  finish(0);
+  return 1;
+}
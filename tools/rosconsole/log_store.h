@@ -0,0 +1,452 @@
+#ifndef TINYROS_LOG_STORE_H_
+#define TINYROS_LOG_STORE_H_
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "tiny_ros/ros/time.h"
+
+/*
+ * Log segments of tinyrosconsole -b: tinyros_msgs/Log records as they
+ * arrived, serialized, in preallocated files that are written through
+ * mmap and rotated when full.
+ *
+ *   header   "#TINYROSLOG V1.0", the end of the records (uint64), updated
+ *            on every flush, the index entry count, then the sparse time
+ *            index: sec, nsec, offset (uint64) of a record every
+ *            indexInterval() bytes, the first record included
+ *   records  from DATA_OFFSET on: size of the Log, sec, nsec, the
+ *            serialized Log (level, length of msg, msg)
+ *
+ * Integers are little endian uint32 unless noted. The preallocated rest
+ * is zeros, a size of 0 ends the records; a segment that was closed is
+ * truncated to its end. Segments are <dir>/tinyros_apps.<seq>.tlog.
+ */
+namespace tinyros
+{
+class LogStoreFormat
+{
+public:
+  enum { HEADER_SIZE = 32, ENTRY_SIZE = 16, DATA_OFFSET = 8192, RECORD_HEADER_SIZE = 12 };
+  enum { MAX_ENTRIES = (DATA_OFFSET - HEADER_SIZE) / ENTRY_SIZE };
+
+  static const char* magic() { return "#TINYROSLOG V1.0"; }
+  static const char* prefix() { return "tinyros_apps."; }
+  static const char* suffix() { return ".tlog"; }
+
+  static bool before(const Time& a, const Time& b) {
+    return a.sec < b.sec || (a.sec == b.sec && a.nsec < b.nsec);
+  }
+
+  static uint32_t indexInterval(uint64_t segment_size) {
+    uint64_t interval = (segment_size - DATA_OFFSET) / MAX_ENTRIES;
+    return interval > 4096 ? (uint32_t)interval : 4096;
+  }
+
+  static std::string segmentPath(const std::string& dir, uint32_t seq) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s%06u%s", prefix(), seq, suffix());
+    return dir + "/" + name;
+  }
+
+  /* the segments in dir by seq, oldest first */
+  static std::vector<std::pair<uint32_t, std::string> > segments(const std::string& dir) {
+    std::vector<std::pair<uint32_t, std::string> > found;
+    DIR* d = opendir(dir.c_str());
+    if (d == NULL) {
+      return found;
+    }
+    struct dirent* entry;
+    size_t prefix_length = strlen(prefix()), suffix_length = strlen(suffix());
+    while ((entry = readdir(d)) != NULL) {
+      std::string name = entry->d_name;
+      if (name.size() > prefix_length + suffix_length && name.compare(0, prefix_length, prefix()) == 0
+          && name.compare(name.size() - suffix_length, suffix_length, suffix()) == 0) {
+        found.push_back(std::make_pair((uint32_t)strtoul(name.c_str() + prefix_length, NULL, 10), dir + "/" + name));
+      }
+    }
+    closedir(d);
+    std::sort(found.begin(), found.end());
+    return found;
+  }
+
+  static void put32(uint8_t* out, uint32_t v) {
+    out[0] = v & 0xff; out[1] = (v >> 8) & 0xff; out[2] = (v >> 16) & 0xff; out[3] = (v >> 24) & 0xff;
+  }
+  static void put64(uint8_t* out, uint64_t v) {
+    put32(out, (uint32_t)v);
+    put32(out + 4, (uint32_t)(v >> 32));
+  }
+  static uint32_t get32(const uint8_t* in) {
+    return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+  }
+  static uint64_t get64(const uint8_t* in) {
+    return (uint64_t)get32(in) | ((uint64_t)get32(in + 4) << 32);
+  }
+};
+
+/*
+ * Appends records to the current segment with a memcpy; a thread of its
+ * own publishes the end and msyncs every FLUSH_INTERVAL ms. A full
+ * segment is closed and the next one opened, the oldest beyond the
+ * segment count are removed.
+ */
+class LogStoreWriter
+{
+public:
+  enum { FLUSH_INTERVAL = 1000 };
+
+  LogStoreWriter() : segment_size_(0), segment_files_(0), seq_(0), fd_(-1), map_(NULL), end_(0), flushed_(0),
+    entries_(0), next_index_(0), records_(0), dropped_(0), stop_(false) {}
+  ~LogStoreWriter() { close(); }
+
+  bool open(const std::string& dir, uint64_t segment_size, uint32_t segment_files) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (map_ != NULL) {
+      return false;
+    }
+    dir_ = dir;
+    segment_size_ = segment_size > (uint64_t)LogStoreFormat::DATA_OFFSET * 2 ? segment_size : LogStoreFormat::DATA_OFFSET * 2;
+    segment_files_ = segment_files > 0 ? segment_files : 1;
+    std::vector<std::pair<uint32_t, std::string> > existing = LogStoreFormat::segments(dir_);
+    seq_ = existing.empty() ? 0 : existing.back().first + 1;
+    if (!openSegment()) {
+      return false;
+    }
+    stop_ = false;
+    thread_ = std::thread(&LogStoreWriter::run, this);
+    return true;
+  }
+
+  /* log is a serialized tinyros_msgs/Log; false if it was dropped */
+  bool write(const Time& time, const uint8_t* log, uint32_t size) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    uint64_t length = LogStoreFormat::RECORD_HEADER_SIZE + (uint64_t)size;
+    if (map_ != NULL && end_ + length > segment_size_ && end_ > LogStoreFormat::DATA_OFFSET) {
+      closeSegment();
+      openSegment();
+    }
+    if (map_ == NULL || size == 0 || end_ + length > segment_size_) {
+      dropped_++;
+      return false;
+    }
+    if (end_ >= next_index_ && entries_ < (uint32_t)LogStoreFormat::MAX_ENTRIES) {
+      uint8_t* entry = map_ + LogStoreFormat::HEADER_SIZE + entries_ * LogStoreFormat::ENTRY_SIZE;
+      LogStoreFormat::put32(entry, time.sec);
+      LogStoreFormat::put32(entry + 4, time.nsec);
+      LogStoreFormat::put64(entry + 8, end_);
+      entries_++;
+      next_index_ = end_ + LogStoreFormat::indexInterval(segment_size_);
+    }
+    uint8_t* out = map_ + end_;
+    LogStoreFormat::put32(out, size);
+    LogStoreFormat::put32(out + 4, time.sec);
+    LogStoreFormat::put32(out + 8, time.nsec);
+    memcpy(out + LogStoreFormat::RECORD_HEADER_SIZE, log, size);
+    end_ += length;
+    records_++;
+    return true;
+  }
+
+  void close() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cond_.notify_all();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    closeSegment();
+  }
+
+  uint64_t getRecords() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return records_;
+  }
+
+  /* records dropped because no segment could be opened */
+  uint64_t getDropped() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return dropped_;
+  }
+
+private:
+  /* with mutex_ held */
+  bool openSegment() {
+    std::string path = LogStoreFormat::segmentPath(dir_, seq_++);
+    fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd_ < 0) {
+      return false;
+    }
+#ifdef __linux__
+    bool allocated = posix_fallocate(fd_, 0, (off_t)segment_size_) == 0;
+#else
+    bool allocated = ftruncate(fd_, (off_t)segment_size_) == 0;
+#endif
+    void* map = allocated ? mmap(NULL, (size_t)segment_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0) : MAP_FAILED;
+    if (map == MAP_FAILED) {
+      ::close(fd_);
+      fd_ = -1;
+      unlink(path.c_str());
+      return false;
+    }
+    map_ = (uint8_t*)map;
+    memcpy(map_, LogStoreFormat::magic(), 16);
+    end_ = LogStoreFormat::DATA_OFFSET;
+    flushed_ = end_;
+    entries_ = 0;
+    next_index_ = end_;
+    publishEnd();
+    removeOldSegments();
+    return true;
+  }
+
+  /* with mutex_ held */
+  void closeSegment() {
+    if (map_ == NULL) {
+      return;
+    }
+    publishEnd();
+    msync(map_, (size_t)segment_size_, MS_SYNC);
+    munmap(map_, (size_t)segment_size_);
+    map_ = NULL;
+    if (ftruncate(fd_, (off_t)end_) != 0) {
+      // the zeros after end_ are read as the end as well
+    }
+    ::close(fd_);
+    fd_ = -1;
+  }
+
+  void publishEnd() {
+    LogStoreFormat::put64(map_ + 16, end_);
+    LogStoreFormat::put32(map_ + 24, entries_);
+  }
+
+  void removeOldSegments() {
+    std::vector<std::pair<uint32_t, std::string> > existing = LogStoreFormat::segments(dir_);
+    for (size_t i = 0; i + segment_files_ < existing.size(); i++) {
+      unlink(existing[i].second.c_str());
+    }
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+      cond_.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL));
+      if (map_ != NULL && end_ != flushed_) {
+        publishEnd();
+        // the header and the pages written since the last flush
+        size_t page = (size_t)sysconf(_SC_PAGESIZE);
+        size_t from = (size_t)(flushed_ < end_ ? flushed_ : (uint64_t)LogStoreFormat::DATA_OFFSET) / page * page;
+        msync(map_, LogStoreFormat::DATA_OFFSET, MS_ASYNC);
+        msync(map_ + from, (size_t)end_ - from, MS_ASYNC);
+        flushed_ = end_;
+      }
+    }
+  }
+
+  std::string dir_;
+  uint64_t segment_size_;
+  uint32_t segment_files_;
+  uint32_t seq_;
+  int fd_;
+  uint8_t* map_;
+  uint64_t end_;
+  uint64_t flushed_;
+  uint32_t entries_;
+  uint64_t next_index_;
+  uint64_t records_;
+  uint64_t dropped_;
+  bool stop_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+};
+
+/*
+ * Reads segments back in order. seek() skips whole segments by their
+ * first entry and then to the last index entry not after the time, so
+ * only the records of one index interval are walked to get there.
+ */
+class LogStoreReader
+{
+public:
+  struct Record
+  {
+    Time time;
+    uint8_t level;
+    const char* msg;  // valid until the next read()
+    uint32_t length;
+  };
+
+  LogStoreReader() : current_(0), map_(NULL), size_(0), pos_(0), seeking_(false) {}
+  ~LogStoreReader() { unmap(); }
+
+  /* a directory of segments or a single segment */
+  bool open(const std::string& path) {
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+      return false;
+    }
+    paths_.clear();
+    if (S_ISDIR(st.st_mode)) {
+      std::vector<std::pair<uint32_t, std::string> > found = LogStoreFormat::segments(path);
+      for (size_t i = 0; i < found.size(); i++) {
+        paths_.push_back(found[i].second);
+      }
+    } else {
+      paths_.push_back(path);
+    }
+    current_ = 0;
+    return mapCurrent();
+  }
+
+  /* the next read() returns the first record at or after time */
+  void seek(const Time& time) {
+    // the last segment that starts at or before time
+    size_t first = 0;
+    for (size_t i = 1; i < paths_.size(); i++) {
+      Time start;
+      if (!firstTime(paths_[i], start)) {
+        continue;
+      }
+      if (LogStoreFormat::before(time, start)) {
+        break;
+      }
+      first = i;
+    }
+    current_ = first;
+    if (!mapCurrent()) {
+      return;
+    }
+    uint32_t entries = LogStoreFormat::get32(map_ + 24);
+    for (uint32_t i = 0; i < entries && i < (uint32_t)LogStoreFormat::MAX_ENTRIES; i++) {
+      const uint8_t* entry = map_ + LogStoreFormat::HEADER_SIZE + i * LogStoreFormat::ENTRY_SIZE;
+      Time at(LogStoreFormat::get32(entry), LogStoreFormat::get32(entry + 4));
+      if (LogStoreFormat::before(time, at)) {
+        break;
+      }
+      uint64_t offset = LogStoreFormat::get64(entry + 8);
+      if (offset >= (uint64_t)LogStoreFormat::DATA_OFFSET && offset < size_) {
+        pos_ = offset;
+      }
+    }
+    seek_ = time;
+    seeking_ = true;
+  }
+
+  bool read(Record& record) {
+    while (map_ != NULL) {
+      if (readRecord(record)) {
+        if (seeking_ && LogStoreFormat::before(record.time, seek_)) {
+          continue;
+        }
+        seeking_ = false;
+        return true;
+      }
+      current_++;
+      if (!mapCurrent()) {
+        return false;
+      }
+    }
+    return false;
+  }
+
+private:
+  bool readRecord(Record& record) {
+    if (pos_ + LogStoreFormat::RECORD_HEADER_SIZE + 5 > size_) {
+      return false;
+    }
+    const uint8_t* in = map_ + pos_;
+    uint32_t size = LogStoreFormat::get32(in);
+    // records past the published end are read as long as they are whole
+    if (size < 5 || pos_ + LogStoreFormat::RECORD_HEADER_SIZE + size > size_
+        || LogStoreFormat::get32(in + LogStoreFormat::RECORD_HEADER_SIZE + 1) != size - 5) {
+      return false;
+    }
+    record.time = Time(LogStoreFormat::get32(in + 4), LogStoreFormat::get32(in + 8));
+    record.level = in[LogStoreFormat::RECORD_HEADER_SIZE];
+    record.msg = (const char*)in + LogStoreFormat::RECORD_HEADER_SIZE + 5;
+    record.length = size - 5;
+    pos_ += LogStoreFormat::RECORD_HEADER_SIZE + size;
+    return true;
+  }
+
+  static bool firstTime(const std::string& path, Time& time) {
+    uint8_t header[LogStoreFormat::HEADER_SIZE + LogStoreFormat::ENTRY_SIZE];
+    FILE* file = fopen(path.c_str(), "rb");
+    if (file == NULL) {
+      return false;
+    }
+    bool ok = fread(header, 1, sizeof(header), file) == sizeof(header)
+      && memcmp(header, LogStoreFormat::magic(), 16) == 0 && LogStoreFormat::get32(header + 24) > 0;
+    fclose(file);
+    if (ok) {
+      time = Time(LogStoreFormat::get32(header + LogStoreFormat::HEADER_SIZE),
+        LogStoreFormat::get32(header + LogStoreFormat::HEADER_SIZE + 4));
+    }
+    return ok;
+  }
+
+  /* maps paths_[current_], skipping files that are no segments */
+  bool mapCurrent() {
+    unmap();
+    seeking_ = false;
+    for (; current_ < paths_.size(); current_++) {
+      int fd = ::open(paths_[current_].c_str(), O_RDONLY);
+      if (fd < 0) {
+        continue;
+      }
+      struct stat st;
+      void* map = MAP_FAILED;
+      if (fstat(fd, &st) == 0 && st.st_size >= LogStoreFormat::DATA_OFFSET) {
+        map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      }
+      ::close(fd);
+      if (map == MAP_FAILED) {
+        continue;
+      }
+      map_ = (const uint8_t*)map;
+      size_ = (size_t)st.st_size;
+      if (memcmp(map_, LogStoreFormat::magic(), 16) != 0) {
+        unmap();
+        continue;
+      }
+      pos_ = LogStoreFormat::DATA_OFFSET;
+      return true;
+    }
+    return false;
+  }
+
+  void unmap() {
+    if (map_ != NULL) {
+      munmap((void*)map_, size_);
+    }
+    map_ = NULL;
+    size_ = 0;
+  }
+
+  std::vector<std::string> paths_;
+  size_t current_;
+  const uint8_t* map_;
+  size_t size_;
+  uint64_t pos_;
+  Time seek_;
+  bool seeking_;
+};
+
+}
+
+#endif
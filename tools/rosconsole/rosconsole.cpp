@@ -5,15 +5,21 @@
 #include <netinet/in.h>   
 #include <arpa/inet.h> 
 #include <sys/stat.h> 
+#include <fnmatch.h>
+#include <vector>
+#include <algorithm>
 #include "tiny_ros/ros.h"
 #include "tiny_ros/tinyros_msgs/Log.h"
 #include "spdlog/spdlog.h"
 #include "spdlog/sinks/stdout_sinks.h"
 #include "spdlog/sinks/basic_file_sink.h"
 #include "spdlog/sinks/rotating_file_sink.h"
+#include "log_store.h"
 
 #define LOG_ROTATION_SIZE    (10*1024*1024) //10MB
 #define LOG_ROTATION_FILES   (5)
+#define LOG_SEGMENT_SIZE     (16*1024*1024) //16MB
+#define LOG_SEGMENT_FILES    (8)
 
 enum { LEVEL_DEBUG = 0 };
 enum { LEVEL_INFO = 1 };
@@ -25,20 +31,37 @@ static int level_ = LEVEL_DEBUG;
 enum { OPTION_P = 0 };
 enum { OPTION_F = 1 };
 enum { OPTION_D = 2 };
+enum { OPTION_B = 3 };
 static int option_ = OPTION_P;
 
 static std::string param_ = "";
 
 static std::string dir_ = "";
 
+// node=level arguments, node may be a pattern
+static std::vector<std::pair<std::string, int> > overrides_;
+static std::string overrides_text_ = "";
+
+static tinyros::LogStoreWriter store_;
+
+static const char* level_names_[] = { "debug", "info", "warning", "error", "critical" };
+
 
 static void print_usage() {
   printf("\nUsage: tinyrosconsole [OPTION] [VAR=LOG_LEVEL]...\n");
+  printf("       tinyrosconsole cat PATH [-l LOG_LEVEL] [-n NODE] [-g TEXT] [-s TIME] [-e TIME]\n");
   printf("\nOPTION:\n");
   printf(" -h : display this help and exit.\n");
   printf(" -p : output log to screen.\n");
   printf(" -f : output log to the specified file.\n");
   printf(" -d : output log to the specified directory.\n");
+  printf(" -b : store log records in binary segments in the specified directory, read them with cat.\n");
+  printf("\nCAT:\n");
+  printf(" PATH : a directory of -b segments, or one segment.\n");
+  printf(" -l : lowest level to print.\n");
+  printf(" -n : only nodes matching NODE, which may be a pattern.\n");
+  printf(" -g : only messages containing TEXT.\n");
+  printf(" -s, -e : only messages from, until TIME, \"YYYY-MM-DD HH:MM:SS[.mmm]\" or seconds since the epoch.\n");
   printf("\nLOG_LEVEL:\n");
   printf(" 0 : log level is debug.\n");
   printf(" 1 : log level is info.\n");
@@ -51,7 +74,11 @@ static void print_usage() {
   printf(" tinyrosconsole -f 1 log.txt : output log to log.txt with info level\n");
   printf(" tinyrosconsole -f 1 log.txt 127.0.0.1: output log to log.txt with info level & tinyrosdds address\n");
   printf(" tinyrosconsole -d 2 tinyros_logs : output log to folder \"tinyros_logs\" with warn level\n");
-  printf(" tinyrosconsole -d 2 tinyros_logs 127.0.0.1: output log to folder \"tinyros_logs\" with warn level & tinyrosdds address\n\n");
+  printf(" tinyrosconsole -d 2 tinyros_logs 127.0.0.1: output log to folder \"tinyros_logs\" with warn level & tinyrosdds address\n");
+  printf(" tinyrosconsole -b 0 tinyros_logs : store log with debug level in binary segments in folder \"tinyros_logs\"\n");
+  printf(" tinyrosconsole cat tinyros_logs -l 2 -s \"2024-01-01 12:00:00\" : print warnings and up from 12:00 on\n");
+  printf(" tinyrosconsole -p 2 planner=0 camera_*=1 : warn level, but debug for node planner and info for nodes camera_*\n");
+  printf("\nNodes only send the levels some tinyrosconsole asks for.\n\n");
 }
 
 
@@ -90,26 +117,172 @@ static int create_dir(const char *dirname) {
     return ret;
 }
 
+/* the node a message comes from, "[node] text" */
+static bool message_node(const char* msg, uint32_t length, std::string& node) {
+  if (length == 0 || msg[0] != '[') {
+    return false;
+  }
+  const char* end = (const char*)memchr(msg, ']', length);
+  if (end == NULL) {
+    return false;
+  }
+  node.assign(msg + 1, end - msg - 1);
+  return true;
+}
+
+/* level for the node the message comes from */
+static int node_level(const char* msg, uint32_t length) {
+  std::string node;
+  if (overrides_.empty() || !message_node(msg, length, node)) {
+    return level_;
+  }
+  for (size_t i = 0; i < overrides_.size(); i++) {
+    if (overrides_[i].first == node || fnmatch(overrides_[i].first.c_str(), node.c_str(), 0) == 0) {
+      return overrides_[i].second;
+    }
+  }
+  return level_;
+}
+
 static void messageCb(const tinyros::tinyros_msgs::Log& l) {
-  if(l.level == tinyros::tinyros_msgs::Log::ROSDEBUG && level_ <= LEVEL_DEBUG) {
+  int level = node_level(l.msg.data(), (uint32_t)l.msg.size());
+  if(l.level == tinyros::tinyros_msgs::Log::ROSDEBUG && level <= LEVEL_DEBUG) {
     if (spdlog::get("logger")) spdlog::get("logger")->debug("{0}", l.msg);
-  } else if(l.level == tinyros::tinyros_msgs::Log::ROSINFO && level_ <= LEVEL_INFO) {
+  } else if(l.level == tinyros::tinyros_msgs::Log::ROSINFO && level <= LEVEL_INFO) {
     if (spdlog::get("logger")) spdlog::get("logger")->info("{0}", l.msg); 
-  } else if(l.level == tinyros::tinyros_msgs::Log::ROSWARN && level_ <= LEVEL_WARN) {
+  } else if(l.level == tinyros::tinyros_msgs::Log::ROSWARN && level <= LEVEL_WARN) {
     if (spdlog::get("logger")) spdlog::get("logger")->warn("{0}", l.msg);
-  } else if(l.level == tinyros::tinyros_msgs::Log::ROSERROR && level_ <= LEVEL_ERROR) {
+  } else if(l.level == tinyros::tinyros_msgs::Log::ROSERROR && level <= LEVEL_ERROR) {
     if (spdlog::get("logger")) spdlog::get("logger")->error("{0}", l.msg);
-  } else if(l.level == tinyros::tinyros_msgs::Log::ROSFATAL && level_ <= LEVEL_FATAL) {
+  } else if(l.level == tinyros::tinyros_msgs::Log::ROSFATAL && level <= LEVEL_FATAL) {
     if (spdlog::get("logger")) spdlog::get("logger")->critical("{0}", l.msg);
   }
 }
 
 static tinyros::Subscriber<tinyros::tinyros_msgs::Log> sub(TINYROS_LOG_TOPIC, messageCb);
 
+/* -b: the serialized Log is stored as it came, level and length first */
+static void storeCb(const tinyros::Span<uint8_t>& log) {
+  if (log.size() < 5) {
+    return;
+  }
+  const char* msg = (const char*)log.data() + 5;
+  uint32_t length;
+  tinyros::Msg::arrToVar(length, log.data() + 1);
+  if (length > log.size() - 5 || log.data()[0] < node_level(msg, length)) {
+    return;
+  }
+  store_.write(tinyros::Time::now(), log.data(), 5 + length);
+}
+
+static tinyros::RawSubscriber store_sub(TINYROS_LOG_TOPIC, storeCb,
+  tinyros::tinyros_msgs::Log().getType(), tinyros::tinyros_msgs::Log().getMD5());
+
+/* "YYYY-MM-DD HH:MM:SS[.mmm]" in local time, or seconds since the epoch */
+static bool parse_time(const char* text, tinyros::Time& time) {
+  struct tm tm;
+  memset(&tm, 0, sizeof(tm));
+  const char* rest = strptime(text, "%Y-%m-%d %H:%M:%S", &tm);
+  double fraction = 0;
+  if (rest != NULL) {
+    tm.tm_isdst = -1;
+    time_t sec = mktime(&tm);
+    if (sec < 0) {
+      return false;
+    }
+    if (*rest == '.') {
+      fraction = atof(rest);
+    }
+    time = tinyros::Time((uint32_t)sec, (uint32_t)(fraction * 1e9));
+    return true;
+  }
+  char* end;
+  double sec = strtod(text, &end);
+  if (end == text || *end != '\0' || sec < 0) {
+    return false;
+  }
+  time = tinyros::Time((uint32_t)sec, (uint32_t)((sec - (uint32_t)sec) * 1e9));
+  return true;
+}
+
+/* tinyrosconsole cat: prints -b segments as -p would have */
+static int cat_main(int argc, char *argv[]) {
+  if (argc < 3) {
+    print_usage();
+    return 0;
+  }
+  int level = LEVEL_DEBUG;
+  std::string node_pattern, text;
+  tinyros::Time start, end(UINT32_MAX, 999999999);
+  bool seek = false;
+  for (int i = 3; i < argc; i++) {
+    if (i + 1 >= argc) {
+      print_usage();
+      return 0;
+    }
+    const char* value = argv[++i];
+    if (!strcmp(argv[i - 1], "-l")) {
+      level = atoi(value);
+    } else if (!strcmp(argv[i - 1], "-n")) {
+      node_pattern = value;
+    } else if (!strcmp(argv[i - 1], "-g")) {
+      text = value;
+    } else if (!strcmp(argv[i - 1], "-s") || !strcmp(argv[i - 1], "-e")) {
+      bool from = !strcmp(argv[i - 1], "-s");
+      if (!parse_time(value, from ? start : end)) {
+        printf("Invalid time: %s\n", value);
+        return 0;
+      }
+      seek = seek || from;
+    } else {
+      print_usage();
+      return 0;
+    }
+  }
+
+  tinyros::LogStoreReader reader;
+  if (!reader.open(argv[2])) {
+    printf("No log segments in %s\n", argv[2]);
+    return 0;
+  }
+  if (seek) {
+    reader.seek(start);
+  }
+  tinyros::LogStoreReader::Record record;
+  std::string node;
+  char line[512];
+  while (reader.read(record)) {
+    if (tinyros::LogStoreFormat::before(end, record.time)) {
+      break;
+    }
+    if (record.level < level || record.level > LEVEL_FATAL) {
+      continue;
+    }
+    if (!node_pattern.empty() && (!message_node(record.msg, record.length, node)
+        || (node != node_pattern && fnmatch(node_pattern.c_str(), node.c_str(), 0) != 0))) {
+      continue;
+    }
+    if (!text.empty() && std::search(record.msg, record.msg + record.length, text.begin(), text.end()) == record.msg + record.length) {
+      continue;
+    }
+    time_t sec = record.time.sec;
+    struct tm tm;
+    localtime_r(&sec, &tm);
+    size_t n = strftime(line, sizeof(line), "[%Y-%m-%d %H:%M:%S", &tm);
+    n += snprintf(line + n, sizeof(line) - n, ".%03u] [%s] ", record.time.nsec / 1000000, level_names_[record.level]);
+    fwrite(line, 1, n, stdout);
+    fwrite(record.msg, 1, record.length, stdout);
+    fputc('\n', stdout);
+  }
+  return 0;
+}
+
 static void init_log_environment() {
   std::shared_ptr<spdlog::sinks::sink> log_sink = nullptr;
   if (option_ == OPTION_P) {
     log_sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
+  } else if (option_ == OPTION_B) {
+    return;
   } else {
     if (option_ == OPTION_D) {
       log_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt> (
@@ -131,6 +304,22 @@ static void init_log_environment() {
 
 int main(int argc, char *argv[]) {
   std::string ip = "127.0.0.1";
+
+  if (argc >= 2 && !strcmp(argv[1], "cat")) {
+    return cat_main(argc, argv);
+  }
+
+  int n = 1;
+  for (int i = 1; i < argc; i++) {
+    const char* equal = strchr(argv[i], '=');
+    if (equal != NULL && equal != argv[i]) {
+      overrides_.push_back(std::make_pair(std::string(argv[i], equal - argv[i]), atoi(equal + 1)));
+      overrides_text_ += overrides_text_.empty() ? argv[i] : std::string(" ") + argv[i];
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argc = n;
   
   if(argc >= 2) {
     if(!strcmp(argv[1], "-h")) {
@@ -159,14 +348,14 @@ int main(int argc, char *argv[]) {
           ip = argv[4];
         }
       }
-    } else if(!strcmp(argv[1], "-d")){
+    } else if(!strcmp(argv[1], "-d") || !strcmp(argv[1], "-b")){
       if (argc < 4) {
         print_usage();
         return 0;
       } else {
         level_ = atoi(argv[2]);
         param_ = argv[3];
-        option_ = OPTION_D;
+        option_ = !strcmp(argv[1], "-d") ? (int)OPTION_D : (int)OPTION_B;
         if (argc >= 5) {
           ip = argv[4];
         }
@@ -185,7 +374,7 @@ int main(int argc, char *argv[]) {
     return 0;
   }
   
-  if (option_ == OPTION_F || option_ == OPTION_D) {
+  if (option_ == OPTION_F || option_ == OPTION_D || option_ == OPTION_B) {
     if (*(param_.begin()) != '/') {
       char buffer[1024];
       char* ret = getcwd(buffer, sizeof(buffer));
@@ -193,8 +382,21 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  if (option_ == OPTION_B) {
+    create_dir(param_.c_str());
+    if (!store_.open(param_, LOG_SEGMENT_SIZE, LOG_SEGMENT_FILES)) {
+      printf("Cannot create log segments in %s\n", param_.c_str());
+      return 0;
+    }
+  }
+
   init_log_environment();
   tinyros::init("tinyrosconsole", ip);
-  tinyros::nh()->subscribe(sub);
+  if (option_ == OPTION_B) {
+    tinyros::nh()->subscribe(store_sub);
+  } else {
+    tinyros::nh()->subscribe(sub);
+  }
+  tinyros::nh()->requestLogLevel(level_, overrides_text_);
   while(1) sleep(10);
 }
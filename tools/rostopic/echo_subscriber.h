@@ -0,0 +1,66 @@
+#ifndef TINYROS_ECHO_SUBSCRIBER_H_
+#define TINYROS_ECHO_SUBSCRIBER_H_
+#include <map>
+#include <mutex>
+#include <string>
+#include "tiny_ros/ros.h"
+
+namespace tinyros
+{
+extern tinyros::Writer::Options rostopic_echo_options;
+
+/* prints one echoed message, in rostopic.cpp */
+void rostopic_echo_print(const std::string& topic, const std::string& type, const std::string& text);
+
+/* Deserializes into msg and formats into writer_, both are reused */
+template<typename MsgT>
+class EchoSubscriber: public tinyros::Subscriber_
+{
+public:
+  MsgT msg;
+  virtual void callback(unsigned char* data)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    msg.deserialize(data);
+    writer_.clear();
+    writer_.setOptions(rostopic_echo_options);
+    msg.echo(writer_);
+    rostopic_echo_print(topic_, getMsgType(), writer_.str());
+  }
+  virtual std::string getMsgType()
+  {
+    return this->msg.getType();
+  }
+  virtual std::string getMsgMD5()
+  {
+    return this->msg.getMD5();
+  }
+  virtual int getEndpointType()
+  {
+    return tinyros_msgs::TopicInfo::ID_SUBSCRIBER;
+  }
+
+private:
+  std::mutex mutex_;
+  tinyros::Writer writer_;
+};
+
+typedef Subscriber_* (*EchoSubscriberFactory)();
+typedef std::map<std::string, EchoSubscriberFactory> EchoSubscriberRegistry;
+
+template<typename MsgT>
+Subscriber_* createEchoSubscriber()
+{
+  return new EchoSubscriber<MsgT>();
+}
+
+/*
+ * A new EchoSubscriber for the message type, NULL if the type was not
+ * built in. Generated into rostopic_subscribers.cpp, the subscribers of
+ * each package into a rostopic_subscribers_<package>.cpp of their own.
+ */
+Subscriber_* rostopic_create_subscriber(const std::string& type);
+
+}
+
+#endif
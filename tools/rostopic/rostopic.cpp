@@ -1,9 +1,24 @@
 #include <stdio.h>
+#include <signal.h>
+#include <cmath>
+#include <iostream>
 #include <thread>
+#include <chrono>
+#include <deque>
+#include <condition_variable>
 #include "spdlog/spdlog.h"
 #include "spdlog/sinks/stdout_sinks.h"
-#include "spdlog/sinks/basic_file_sink.h"
-#include "rostopic_subscribers.cpp"
+#include "tiny_ros/ros/bag.h"
+#include "echo_subscriber.h"
+
+namespace tinyros
+{
+tinyros::Writer::Options rostopic_echo_options;
+
+void rostopic_echo_print(const std::string& topic, const std::string& type, const std::string& text) {
+  spdlog::get("logger")->info("{0}[{1}]->>{2}", topic, type, text);
+}
+}
 
 static void print_usage() {
   printf("\n\nUsage:\n");
@@ -12,14 +27,205 @@ static void print_usage() {
   printf(" tinyrostopic help : display this help usage\n");
   printf(" tinyrostopic list : list active topics\n");
   printf(" tinyrostopic echo /topic [options] : echo messages to screen\n");
-  printf(" tinyrostopic echo -b [options] /topic [options] : echo messages to \".bag\" file\n\n");
+  printf(" tinyrostopic echo -b [options] /topic [options] : record messages to \".bag\" file\n");
+  printf(" tinyrostopic info file.bag : summarize the contents of a \".bag\" file\n");
+  printf(" tinyrostopic play file.bag [options] : publish the messages of a \".bag\" file\n");
+  printf(" tinyrostopic record start|stop|status [options] : record topics to a \".bag\" file inside tinyrosdds\n");
+  printf(" tinyrostopic delay /topic [options] : display per-hop delay of traced messages\n");
+  printf(" tinyrostopic hz /topic [options] : display publishing rate of topic\n");
+  printf(" tinyrostopic bw /topic [options] : display bandwidth used by topic\n\n");
+  printf("Echo options:\n");
+  printf(" --max-array=N : print at most N elements of each array\n");
+  printf(" --bytes=base64 : print uint8[] arrays as base64\n\n");
+  printf("Bag options:\n");
+  printf(" --compression=zlib : compress the chunks of the bag\n");
+  printf(" --chunk-size=KB : size of the chunks of the bag, 768 by default\n\n");
+  printf("Hz/bw options:\n");
+  printf(" --window=N : measure over the last N messages, 100 by default\n\n");
+  printf("Play options:\n");
+  printf(" --rate=R : publish R times as fast as recorded, --rate=max publishes without waiting\n");
+  printf(" --topics=/a,/b : publish only these topics\n");
+  printf(" --start=S : start S seconds into the bag\n");
+  printf(" --loop : start over at the end of the bag\n\n");
   printf("Example:\n");
   printf(" tinyrostopic list : list active topics\n");
   printf(" tinyrostopic list 127.0.0.1: list active topics with tinyrosdds address\n");
   printf(" tinyrostopic echo /topic : echo messages to screen with topic\n");
   printf(" tinyrostopic echo /topic 127.0.0.1: echo messages to screen with topic & tinyrosdds address\n");
-  printf(" tinyrostopic echo -b topic.bag /topic: echo messages to \".bag\" file with topic\n");
-  printf(" tinyrostopic echo -b topic.bag /topic 127.0.0.1: echo messages to \".bag\" file with topic & tinyrosdds address\n\n");
+  printf(" tinyrostopic echo -b topic.bag /topic: record messages to \".bag\" file with topic, until Ctrl-C\n");
+  printf(" tinyrostopic echo -b topic.bag /topic 127.0.0.1: record messages to \".bag\" file with topic & tinyrosdds address\n");
+  printf(" tinyrostopic echo -b topic.bag /image --compression=zlib: record messages to \".bag\" file with compressed chunks\n");
+  printf(" tinyrostopic info topic.bag : display the topics, message counts and time range of a bag\n");
+  printf(" tinyrostopic play topic.bag 127.0.0.1 : publish the messages of a bag with tinyrosdds address\n");
+  printf(" tinyrostopic play topic.bag --rate=2 --topics=/scan --start=10 --loop : replay /scan twice as fast from 10s on\n");
+  printf(" tinyrostopic play topic.bag --rate=max : publish the messages of a bag as fast as possible\n");
+  printf(" tinyrostopic record start topic.bag /scan,/camera/* : tinyrosdds records /scan and the /camera/ topics to topic.bag\n");
+  printf(" tinyrostopic record start topic.bag /scan 127.0.0.1 --compression=zlib : the same with tinyrosdds address, compressed\n");
+  printf(" tinyrostopic record status : display what tinyrosdds records\n");
+  printf(" tinyrostopic record stop : stop recording and write the index of the bag\n");
+  printf(" tinyrostopic echo /image --max-array=16 --bytes=base64 : echo messages with arrays cut to 16 elements\n");
+  printf(" tinyrostopic delay /topic : display delay of topic, the publisher must enable trace with nh()->setTrace(true)\n");
+  printf(" tinyrostopic delay /topic 127.0.0.1: display delay of topic with tinyrosdds address\n");
+  printf(" tinyrostopic hz /topic : display rate and period of topic\n");
+  printf(" tinyrostopic hz /topic 127.0.0.1 --window=1000 : display rate of topic over the last 1000 messages\n");
+  printf(" tinyrostopic bw /topic : display bytes per second and message size of topic\n\n");
+}
+
+/* Arrival time and size of the last messages of a topic, for hz and bw */
+class TopicMeter
+{
+public:
+  struct Sample
+  {
+    double time;  // seconds, steady clock
+    uint32_t size;
+  };
+
+  TopicMeter(size_t window) : window_(window > 0 ? window : 1), count_(0) {}
+
+  void add(uint32_t size) {
+    Sample sample;
+    sample.time = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    sample.size = size;
+    std::unique_lock<std::mutex> lock(mutex_);
+    samples_.push_back(sample);
+    if (samples_.size() > window_) {
+      samples_.pop_front();
+    }
+    count_++;
+  }
+
+  /* copy of the window, and the count of messages received so far */
+  uint64_t samples(std::deque<Sample>& samples) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    samples = samples_;
+    return count_;
+  }
+
+private:
+  size_t window_;
+  std::deque<Sample> samples_;
+  uint64_t count_;
+  std::mutex mutex_;
+};
+
+/*
+ * Messages of a bag on their way to the publishers. A thread of its own
+ * copies them out of the mapped file ahead of their time, so that page
+ * faults and inflating chunks do not delay publishing; it stays at most
+ * MAX_BYTES ahead.
+ */
+class BagPrefetcher
+{
+public:
+  enum { MAX_BYTES = 64 * 1024 * 1024, MAX_MESSAGES = 65536 };
+
+  struct Item
+  {
+    int publisher;  // -1 marks the end of the bag
+    double at;  // seconds since the start of playback, in bag time
+    std::string data;
+  };
+
+  BagPrefetcher(tinyros::BagReader* reader, const std::vector<int>& publishers, size_t first, bool loop)
+    : reader_(reader), publishers_(publishers), first_(first), loop_(loop), bytes_(0), stop_(false) {
+    thread_ = std::thread(&BagPrefetcher::run, this);
+  }
+
+  ~BagPrefetcher() {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      stop_ = true;
+      cond_.notify_all();
+    }
+    thread_.join();
+  }
+
+  /* waits for the next message, item.data is swapped with the previous one */
+  void pop(Item& item) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (items_.empty()) {
+      cond_.wait(lock);
+    }
+    Item& front = items_.front();
+    item.publisher = front.publisher;
+    item.at = front.at;
+    item.data.swap(front.data);
+    bytes_ -= item.data.size();
+    spare_.push_back(std::string());
+    spare_.back().swap(front.data);
+    items_.pop_front();
+    cond_.notify_all();
+  }
+
+private:
+  void run() {
+    tinyros::BagReader::Message msg;
+    tinyros::Time begin = reader_->getTime(first_ < reader_->size() ? first_ : 0);
+    double span = reader_->size() > 0 ? reader_->getTime(reader_->size() - 1).toSec() - begin.toSec() : 0;
+    double offset = 0;
+    bool found = false;
+    do {
+      for (size_t i = first_; i < reader_->size(); i++) {
+        const tinyros::BagReader::Connection* connection = reader_->getConnection(i);
+        int publisher = connection != NULL ? publishers_[connection->id] : -1;
+        if (publisher < 0 || !reader_->read(i, msg)) {
+          continue;
+        }
+        found = true;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!stop_ && (bytes_ >= MAX_BYTES || items_.size() >= MAX_MESSAGES)) {
+          cond_.wait(lock);
+        }
+        if (stop_) {
+          return;
+        }
+        items_.push_back(Item());
+        Item& item = items_.back();
+        item.publisher = publisher;
+        item.at = offset + (msg.time.toSec() - begin.toSec());
+        if (!spare_.empty()) {
+          item.data.swap(spare_.back());
+          spare_.pop_back();
+        }
+        item.data.assign((const char*)msg.data, msg.size);
+        bytes_ += msg.size;
+        cond_.notify_all();
+      }
+      offset += span;
+    } while (loop_ && found && !stop_);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    items_.push_back(Item());
+    items_.back().publisher = -1;
+    items_.back().at = offset;
+    cond_.notify_all();
+  }
+
+  tinyros::BagReader* reader_;
+  std::vector<int> publishers_;  // publisher by connection id, -1 if filtered out
+  size_t first_;
+  bool loop_;
+  std::deque<Item> items_;
+  std::vector<std::string> spare_;  // buffers of published items, to reuse
+  size_t bytes_;
+  bool stop_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::thread thread_;
+};
+
+static tinyros::BagFormat::Compression rostopic_bag_compression = tinyros::BagFormat::COMPRESSION_NONE;
+static uint32_t rostopic_bag_chunk_size = tinyros::BagWriter::DEFAULT_CHUNK_SIZE;
+static double rostopic_play_rate = 1.0;  // 0 publishes without waiting
+static std::vector<std::string> rostopic_play_topics;
+static double rostopic_play_start = 0;
+static bool rostopic_play_loop = false;
+static size_t rostopic_meter_window = 100;
+static volatile sig_atomic_t rostopic_stop = 0;
+
+static void rostopic_signal(int) {
+  rostopic_stop = 1;
 }
 
 static std::vector<std::string> string_split(const std::string& s, const std::string& delim="\n") {
@@ -30,7 +236,7 @@ static std::vector<std::string> string_split(const std::string& s, const std::st
   if (delim_len == 0) return elems;
   while (pos < len) {
     std::size_t find_pos = s.find(delim, pos);
-    if (find_pos < 0) {
+    if (find_pos == std::string::npos) {
       elems.push_back(s.substr(pos, len - pos));
       break;
     }
@@ -40,23 +246,20 @@ static std::vector<std::string> string_split(const std::string& s, const std::st
   return elems;
 }
 
-static void init_log_environment(std::string bag) {
-  std::shared_ptr<spdlog::sinks::sink> log_sink = nullptr;
-  if (bag.empty()) {
-    log_sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
-  } else {
-    std::string suffix = "";
-    std::size_t suffix_pos = bag.rfind(".");
-    if (suffix_pos != std::string::npos) {
-      suffix = bag.substr(suffix_pos);
-    }
-    if (suffix != ".bag") {
-      bag += ".bag";
-    }
-    
-    log_sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(bag);
+static std::string bag_file_name(std::string bag) {
+  std::string suffix = "";
+  std::size_t suffix_pos = bag.rfind(".");
+  if (suffix_pos != std::string::npos) {
+    suffix = bag.substr(suffix_pos);
   }
+  if (suffix != ".bag") {
+    bag += ".bag";
+  }
+  return bag;
+}
 
+static void init_log_environment() {
+  std::shared_ptr<spdlog::sinks::sink> log_sink = std::make_shared<spdlog::sinks::stdout_sink_mt>();
   if (log_sink != nullptr) {
     log_sink->set_level(spdlog::level::trace);
     auto logger = std::make_shared<spdlog::logger>("logger", log_sink);
@@ -86,7 +289,7 @@ static void rostopic_cmd_list() {
   exit(0);
 }
 
-static void rostopic_cmd_echo(std::string topic) {
+static void rostopic_lookup(std::string topic, std::string& type, std::string& md5) {
   while(!tinyros::nh()->ok()) {
 #ifdef WIN32
     Sleep(1000);
@@ -100,8 +303,6 @@ static void rostopic_cmd_echo(std::string topic) {
     topiclist = tinyros::nh()->getTopicList(3000);
   }
 
-  std::string type = "";
-  std::string md5 = "";
   bool old = (topiclist.find("topic_list:") != std::string::npos);
   std::vector<std::string> topics = string_split(topiclist);
   for (std::size_t i = 0; i < topics.size(); i++) {
@@ -149,12 +350,19 @@ static void rostopic_cmd_echo(std::string topic) {
     std::cout << "ERROR: Your topic[" << topic << "] seems invalid.\n" << std::endl;
     exit(0);
   }
+}
+
+static void rostopic_cmd_echo(std::string topic) {
+  std::string type = "";
+  std::string md5 = "";
+  rostopic_lookup(topic, type, md5);
   
-  if (tinyros::rostopic_subscribers.count(type)) {
-    tinyros::rostopic_subscribers[type]->topic_ = topic;
-    tinyros::nh()->subscribe(*(tinyros::rostopic_subscribers[type]));
+  tinyros::Subscriber_* sub = tinyros::rostopic_create_subscriber(type);
+  if (sub != NULL) {
+    sub->topic_ = topic;
+    tinyros::nh()->subscribe(*sub);
     
-    std::string native_md5 = tinyros::rostopic_subscribers[type]->getMsgMD5();
+    std::string native_md5 = sub->getMsgMD5();
     if (!md5.empty() && native_md5 != md5) {
       std::cout << "WARNING: Message MD5 does not match [remote:" << md5 << ", native: " << native_md5 << "]" << std::endl;
     }
@@ -164,9 +372,354 @@ static void rostopic_cmd_echo(std::string topic) {
   }
 }
 
+static void rostopic_cmd_record(std::string bag, std::string topic) {
+  std::string type = "";
+  std::string md5 = "";
+  rostopic_lookup(topic, type, md5);
+
+  bag = bag_file_name(bag);
+  tinyros::BagWriter* writer = new tinyros::BagWriter();
+  if (!writer->open(bag, rostopic_bag_compression, rostopic_bag_chunk_size)) {
+    std::cout << "ERROR: Cannot open [" << bag << "] for writing.\n" << std::endl;
+    exit(0);
+  }
+
+  signal(SIGINT, rostopic_signal);
+  signal(SIGTERM, rostopic_signal);
+  // the payloads go to the bag as they are, without deserializing them
+  tinyros::RawSubscriber* sub = new tinyros::RawSubscriber(topic,
+    [writer, topic, type, md5](const tinyros::Span<uint8_t>& payload) {
+      writer->write(topic, type, md5, tinyros::Time::now(), payload.data(), payload.size());
+    }, type, md5);
+  tinyros::nh()->subscribe(*sub);
+  std::cout << "recording [" << topic << "] to [" << bag << "], Ctrl-C to stop" << std::endl;
+
+  while (!rostopic_stop) {
+#ifdef WIN32
+    Sleep(100);
+#else
+    usleep(100 * 1000);
+#endif
+  }
+
+  writer->close();
+  std::cout << "recorded " << writer->getMessages() << " messages to [" << bag << "]";
+  if (writer->getDropped() > 0) {
+    std::cout << ", dropped " << writer->getDropped() << " the disk could not keep up with";
+  }
+  std::cout << std::endl;
+  if (writer->failed()) {
+    std::cout << "ERROR: Writing [" << bag << "] failed, the bag is incomplete.\n" << std::endl;
+  }
+  fflush(stdout);
+  _exit(0);
+}
+
+static void rostopic_cmd_info(std::string bag) {
+  tinyros::BagReader reader;
+  if (!reader.open(bag)) {
+    std::cout << "ERROR: Cannot read [" << bag << "], is it a bag file?\n" << std::endl;
+    exit(0);
+  }
+
+  const std::vector<tinyros::BagReader::Connection>& connections = reader.getConnections();
+  std::vector<uint64_t> counts(connections.size(), 0);
+  for (size_t i = 0; i < reader.size(); i++) {
+    const tinyros::BagReader::Connection* connection = reader.getConnection(i);
+    if (connection != NULL) {
+      counts[connection->id]++;
+    }
+  }
+
+  std::cout << "path:     " << bag << (reader.indexed() ? "" : " (not closed, index rebuilt)") << std::endl;
+  if (reader.size() > 0) {
+    double begin = reader.getTime(0).toSec();
+    double end = reader.getTime(reader.size() - 1).toSec();
+    printf("duration: %.3fs\n", end - begin);
+    printf("start:    %.3f\n", begin);
+    printf("end:      %.3f\n", end);
+  }
+  std::cout << "messages: " << reader.size() << std::endl;
+  std::cout << "chunks:   " << reader.getChunks() << std::endl;
+  std::cout << "topics:" << std::endl;
+  for (size_t i = 0; i < connections.size(); i++) {
+    std::cout << "  " << connections[i].topic << " " << counts[i] << " msgs [type:"
+      << connections[i].type << ", md5:" << connections[i].md5 << "]" << std::endl;
+  }
+  exit(0);
+}
+
+static void rostopic_cmd_play(std::string bag) {
+  tinyros::BagReader reader;
+  if (!reader.open(bag)) {
+    std::cout << "ERROR: Cannot read [" << bag << "], is it a bag file?\n" << std::endl;
+    exit(0);
+  }
+
+  const std::vector<tinyros::BagReader::Connection>& connections = reader.getConnections();
+  std::vector<tinyros::RawPublisher*> publishers;
+  std::vector<int> connection_publishers(connections.size(), -1);
+  for (size_t i = 0; i < connections.size(); i++) {
+    if (!rostopic_play_topics.empty() && std::find(rostopic_play_topics.begin(),
+      rostopic_play_topics.end(), connections[i].topic) == rostopic_play_topics.end()) {
+      continue;
+    }
+    connection_publishers[i] = (int)publishers.size();
+    publishers.push_back(new tinyros::RawPublisher(connections[i].topic, connections[i].type, connections[i].md5));
+  }
+  if (publishers.empty() || reader.size() == 0) {
+    std::cout << "ERROR: No messages to play in [" << bag << "].\n" << std::endl;
+    exit(0);
+  }
+
+  while(!tinyros::nh()->ok()) {
+#ifdef WIN32
+    Sleep(1000);
+#else
+    sleep(1);
+#endif
+  }
+  for (size_t i = 0; i < publishers.size(); i++) {
+    tinyros::nh()->advertise(*publishers[i]);
+  }
+  // give tinyrosdds and the subscribers time to see the new publishers
+#ifdef WIN32
+  Sleep(1000);
+#else
+  sleep(1);
+#endif
+
+  signal(SIGINT, rostopic_signal);
+  signal(SIGTERM, rostopic_signal);
+  // added as a Duration, a double of the absolute time would round past the first message
+  tinyros::Time start = reader.getTime(0);
+  tinyros::Duration skip;
+  skip.fromSec(rostopic_play_start);
+  start += skip;
+  size_t first = reader.seek(start);
+  BagPrefetcher prefetcher(&reader, connection_publishers, first, rostopic_play_loop);
+  std::cout << "playing [" << bag << "] from " << rostopic_play_start << "s, Ctrl-C to stop" << std::endl;
+
+  typedef std::chrono::steady_clock clock;
+  clock::time_point begin = clock::now();
+  clock::time_point report = begin;
+  BagPrefetcher::Item item;
+  uint64_t count = 0;
+  double late_total = 0;
+  double late_max = 0;
+  while (!rostopic_stop) {
+    prefetcher.pop(item);
+    if (item.publisher < 0) {
+      break;
+    }
+    if (rostopic_play_rate > 0) {
+      clock::time_point due = begin + std::chrono::duration_cast<clock::duration>(
+        std::chrono::duration<double>(item.at / rostopic_play_rate));
+      // sleep until shortly before the message is due, then spin to it
+      clock::duration ahead = due - clock::now();
+      if (ahead > std::chrono::milliseconds(2)) {
+        std::this_thread::sleep_for(ahead - std::chrono::milliseconds(1));
+      }
+      while (clock::now() < due) {
+        std::this_thread::yield();
+      }
+      double late = std::chrono::duration<double>(clock::now() - due).count();
+      late_total += late;
+      late_max = late > late_max ? late : late_max;
+    }
+    publishers[item.publisher]->publish((const uint8_t*)item.data.data(), (uint32_t)item.data.size());
+    count++;
+
+    clock::time_point now = clock::now();
+    if (now - report >= std::chrono::seconds(1)) {
+      report = now;
+      printf("\r [RUNNING] bag time: %.3fs, published: %llu", item.at, (unsigned long long)count);
+      fflush(stdout);
+    }
+  }
+
+  printf("\rpublished %llu messages", (unsigned long long)count);
+  if (rostopic_play_rate > 0 && count > 0) {
+    printf(", late by %.3fms on average and %.3fms at most", late_total / count * 1000, late_max * 1000);
+  }
+  printf("\n");
+  fflush(stdout);
+  // let the writer thread send what is queued
+#ifdef WIN32
+  Sleep(1000);
+#else
+  sleep(1);
+#endif
+  _exit(0);
+}
+
+/* the bag path is relative to the working directory of tinyrosdds */
+static void rostopic_cmd_record_remote(std::string action, std::string bag, std::string topics) {
+  while(!tinyros::nh()->ok()) {
+#ifdef WIN32
+    Sleep(1000);
+#else
+    sleep(1);
+#endif
+  }
+
+  std::string command = action;
+  if (action == "start") {
+    command += " " + bag_file_name(bag);
+    if (rostopic_bag_compression == tinyros::BagFormat::COMPRESSION_ZLIB) {
+      command += " --compression=zlib";
+    }
+    std::ostringstream chunk_size;
+    chunk_size << " --chunk-size=" << rostopic_bag_chunk_size / 1024;
+    command += chunk_size.str();
+    std::vector<std::string> patterns = string_split(topics, ",");
+    for (size_t i = 0; i < patterns.size(); i++) {
+      command += " " + patterns[i];
+    }
+  }
+
+  std::string reply = tinyros::nh()->record(command);
+  if (!reply.empty()) {
+    std::cout << reply << std::endl;
+  }
+  exit(0);
+}
+
+static std::string format_bytes(double bytes) {
+  char text[32];
+  if (bytes < 1000) {
+    snprintf(text, sizeof(text), "%.2fB", bytes);
+  } else if (bytes < 1000 * 1000) {
+    snprintf(text, sizeof(text), "%.2fKB", bytes / 1000);
+  } else {
+    snprintf(text, sizeof(text), "%.2fMB", bytes / 1000 / 1000);
+  }
+  return text;
+}
+
+/* hz with bandwidth false, bw with bandwidth true */
+static void rostopic_cmd_meter(std::string topic, bool bandwidth) {
+  std::string type = "";
+  std::string md5 = "";
+  rostopic_lookup(topic, type, md5);
+
+  TopicMeter* meter = new TopicMeter(rostopic_meter_window);
+  tinyros::RawSubscriber* sub = new tinyros::RawSubscriber(topic,
+    [meter](const tinyros::Span<uint8_t>& payload) { meter->add(payload.size()); }, type, md5);
+  tinyros::nh()->subscribe(*sub);
+  std::cout << "subscribed to [" << topic << "]" << std::endl;
+
+  std::deque<TopicMeter::Sample> samples;
+  uint64_t last_count = 0;
+  while (true) {
+    sleep(1);
+    uint64_t count = meter->samples(samples);
+    if (count == last_count) {
+      std::cout << "no new messages" << std::endl;
+      continue;
+    }
+    last_count = count;
+    if (samples.size() < 2) {
+      continue;
+    }
+
+    size_t n = samples.size();
+    if (!bandwidth) {
+      double min = 0, max = 0, sum = 0, sum_squares = 0;
+      for (size_t i = 1; i < n; i++) {
+        double period = samples[i].time - samples[i - 1].time;
+        min = (i == 1 || period < min) ? period : min;
+        max = (i == 1 || period > max) ? period : max;
+        sum += period;
+        sum_squares += period * period;
+      }
+      double mean = sum / (n - 1);
+      double variance = sum_squares / (n - 1) - mean * mean;
+      printf("average rate: %.3f\n\tmin: %.3fs max: %.3fs std dev: %.5fs window: %zu\n",
+        mean > 0 ? 1.0 / mean : 0.0, min, max, variance > 0 ? sqrt(variance) : 0.0, n);
+    } else {
+      double now = std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+      double total = 0;
+      uint32_t min = samples[0].size, max = samples[0].size;
+      for (size_t i = 0; i < n; i++) {
+        total += samples[i].size;
+        min = samples[i].size < min ? samples[i].size : min;
+        max = samples[i].size > max ? samples[i].size : max;
+      }
+      double elapsed = now - samples[0].time;
+      printf("average: %s/s\n\tmean: %s min: %s max: %s window: %zu\n",
+        format_bytes(elapsed > 0 ? total / elapsed : 0).c_str(), format_bytes(total / n).c_str(),
+        format_bytes(min).c_str(), format_bytes(max).c_str(), n);
+    }
+    fflush(stdout);
+  }
+}
+
+static void rostopic_cmd_delay(std::string topic) {
+  std::string type = "";
+  std::string md5 = "";
+  rostopic_lookup(topic, type, md5);
+
+  tinyros::nh()->setTrace(true);
+  tinyros::RawSubscriber* sub = new tinyros::RawSubscriber(topic,
+    [](const tinyros::Span<uint8_t>&) { }, type, md5);
+  tinyros::nh()->subscribe(*sub);
+
+  tinyros::TraceStatsPtr stats = tinyros::nh()->getTraceStats(topic);
+  while (true) {
+    sleep(1);
+    std::string report = stats->report();
+    if (report.empty()) {
+      std::cout << "no traced messages received on [" << topic << "], is trace enabled on the publisher?" << std::endl;
+    } else {
+      std::cout << topic << " [type:" << type << "]" << std::endl << report << std::endl;
+    }
+  }
+}
+
+/* takes the --options out of argv, false if one is not known */
+static bool parse_options(int& argc, char** argv) {
+  int n = 1;
+  for (int i = 1; i < argc; i++) {
+    if (!strncmp(argv[i], "--max-array=", 12)) {
+      tinyros::rostopic_echo_options.max_array = (uint32_t)atoi(argv[i] + 12);
+    } else if (!strcmp(argv[i], "--bytes=base64")) {
+      tinyros::rostopic_echo_options.bytes = tinyros::Writer::BYTES_BASE64;
+    } else if (!strcmp(argv[i], "--compression=zlib")) {
+      rostopic_bag_compression = tinyros::BagFormat::COMPRESSION_ZLIB;
+    } else if (!strncmp(argv[i], "--chunk-size=", 13)) {
+      rostopic_bag_chunk_size = (uint32_t)atoi(argv[i] + 13) * 1024;
+    } else if (!strcmp(argv[i], "--rate=max")) {
+      rostopic_play_rate = 0;
+    } else if (!strncmp(argv[i], "--rate=", 7)) {
+      rostopic_play_rate = atof(argv[i] + 7);
+    } else if (!strncmp(argv[i], "--window=", 9)) {
+      rostopic_meter_window = (size_t)atoi(argv[i] + 9);
+    } else if (!strncmp(argv[i], "--topics=", 9)) {
+      rostopic_play_topics = string_split(argv[i] + 9, ",");
+    } else if (!strncmp(argv[i], "--start=", 8)) {
+      rostopic_play_start = atof(argv[i] + 8);
+    } else if (!strcmp(argv[i], "--loop")) {
+      rostopic_play_loop = true;
+    } else if (!strncmp(argv[i], "--", 2)) {
+      std::cout << "ERROR: Unknown option " << argv[i] << "\n" << std::endl;
+      return false;
+    } else {
+      argv[n++] = argv[i];
+    }
+  }
+  argc = n;
+  return true;
+}
+
 int main(int argc, char **argv) {
   std::string ip = "127.0.0.1";
   std::string file = "";
+
+  if (!parse_options(argc, argv)) {
+    print_usage();
+    return 0;
+  }
   
   if(argc >= 2) {
     if(!strcmp(argv[1], "help")) {
@@ -189,23 +742,90 @@ int main(int argc, char **argv) {
 
           file = argv[3];
           tinyros::init("tinyrostopic", ip);
-          init_log_environment(file);
-          rostopic_cmd_echo(argv[4]);
+          init_log_environment();
+          rostopic_cmd_record(file, argv[4]);
         } else {
           if (argc >= 4) {
             ip = argv[3];
           }
           tinyros::init("tinyrostopic", ip);
-          init_log_environment(file);
+          init_log_environment();
           rostopic_cmd_echo(argv[2]);
         }
       }
+    } else if (!strcmp(argv[1], "delay")) {
+      if (argc < 3) {
+        print_usage();
+        return 0;
+      }
+      if (argc >= 4) {
+        ip = argv[3];
+      }
+      tinyros::init("tinyrostopic", ip);
+      init_log_environment();
+      rostopic_cmd_delay(argv[2]);
+    } else if (!strcmp(argv[1], "hz") || !strcmp(argv[1], "bw")) {
+      if (argc < 3) {
+        print_usage();
+        return 0;
+      }
+      if (argc >= 4) {
+        ip = argv[3];
+      }
+      tinyros::init("tinyrostopic", ip);
+      init_log_environment();
+      rostopic_cmd_meter(argv[2], !strcmp(argv[1], "bw"));
+    } else if (!strcmp(argv[1], "info")) {
+      if (argc < 3) {
+        print_usage();
+        return 0;
+      }
+      rostopic_cmd_info(argv[2]);
+    } else if (!strcmp(argv[1], "play")) {
+      if (argc < 3) {
+        print_usage();
+        return 0;
+      }
+      if (argc >= 4) {
+        ip = argv[3];
+      }
+      tinyros::init("tinyrostopic", ip);
+      init_log_environment();
+      rostopic_cmd_play(argv[2]);
+    } else if (!strcmp(argv[1], "record")) {
+      if (argc < 3) {
+        print_usage();
+        return 0;
+      }
+      std::string action = argv[2];
+      if (action == "start") {
+        if (argc < 5) {
+          print_usage();
+          return 0;
+        }
+        if (argc >= 6) {
+          ip = argv[5];
+        }
+        tinyros::init("tinyrostopic", ip);
+        init_log_environment();
+        rostopic_cmd_record_remote(action, argv[3], argv[4]);
+      } else if (action == "stop" || action == "status") {
+        if (argc >= 4) {
+          ip = argv[3];
+        }
+        tinyros::init("tinyrostopic", ip);
+        init_log_environment();
+        rostopic_cmd_record_remote(action, "", "");
+      } else {
+        print_usage();
+        return 0;
+      }
     } else if (!strcmp(argv[1], "list")) {
       if (argc >= 3) {
         ip = argv[2];
       }
       tinyros::init("tinyrostopic", ip);
-      init_log_environment(file);
+      init_log_environment();
       rostopic_cmd_list();
     } else {
       print_usage();